@@ -0,0 +1,27 @@
+###
+ # THIS FILE IS AUTOMATICALLY GENERATED
+ # Do not edit this file. It will be overwritten when the configure script is run.
+###
+
+######
+# Build ID: 962a0f8ea7a333a0
+# Executable: ./bin/champsim
+# Module Names: ('btbDbasic_btb', 'btbDmulti_level_btb', 'branchDbimodal', 'branchDgshare', 'branchDhashed_perceptron', 'branchDperceptron', 'prefetcherDberti', 'prefetcherDberti_gaze', 'prefetcherDberti_micro', 'prefetcherDcmc', 'prefetcherDip_stride', 'prefetcherDipcp', 'prefetcherDnext_line', 'prefetcherDno', 'prefetcherDpythia', 'prefetcherDsberti', 'prefetcherDsmart_stride', 'prefetcherDsms', 'prefetcherDspp_dev', 'prefetcherDtriage', 'prefetcherDva_ampm_lite', 'replacementDdrrip', 'replacementDhawkeye', 'replacementDlru', 'replacementDmockingjay', 'replacementDoracle_min', 'replacementDrandom', 'replacementDship', 'replacementDsrrip')
+######
+
+BIN_ROOT := bin
+compile_commands $(BIN_ROOT)/champsim: build_id := \
+  962a0f8ea7a333a0
+nonbase_module_objs += $(filter-out $(base_module_objs),$(call get_module_list, btb/basic_btb \
+  btb/multi_level_btb branch/bimodal branch/gshare \
+  branch/hashed_perceptron branch/perceptron prefetcher/berti \
+  prefetcher/berti_gaze prefetcher/berti_micro prefetcher/cmc \
+  prefetcher/ip_stride prefetcher/ipcp prefetcher/next_line \
+  prefetcher/no prefetcher/pythia prefetcher/sberti \
+  prefetcher/smart_stride prefetcher/sms prefetcher/spp_dev \
+  prefetcher/triage prefetcher/va_ampm_lite replacement/drrip \
+  replacement/hawkeye replacement/lru replacement/mockingjay \
+  replacement/oracle_min replacement/random replacement/ship \
+  replacement/srrip ))
+build_ids += 962a0f8ea7a333a0
+executable_name += $(BIN_ROOT)/champsim
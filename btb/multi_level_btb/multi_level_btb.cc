@@ -0,0 +1,233 @@
+
+/*
+ * This file implements a hierarchical Branch Target Buffer (BTB).
+ * Branches are looked up in a series of set-associative levels, from a small
+ * L0 that redirects fetch immediately to larger levels that insert fetch
+ * bubbles. The targets of indirect branches are predicted by an ITTAGE-style
+ * predictor, and the targets of returns by a deep Return Address Stack (RAS).
+ */
+
+#include "multi_level_btb.h"
+
+#include <algorithm>
+#include <iterator>
+#include <optional>
+
+#include "instruction.h"
+#include "msl/bits.h"
+
+namespace
+{
+uint64_t fold(uint64_t value, unsigned length, unsigned bits)
+{
+  if (length < 64) {
+    value &= (uint64_t{1} << length) - 1;
+  }
+
+  uint64_t result = 0;
+  for (; value != 0; value >>= bits) {
+    result ^= value & ((uint64_t{1} << bits) - 1);
+  }
+  return result;
+}
+
+multi_level_btb::branch_info classify(uint8_t branch_type)
+{
+  if ((branch_type == BRANCH_INDIRECT) || (branch_type == BRANCH_INDIRECT_CALL))
+    return multi_level_btb::branch_info::INDIRECT;
+  if (branch_type == BRANCH_RETURN)
+    return multi_level_btb::branch_info::RETURN;
+  if (branch_type == BRANCH_CONDITIONAL)
+    return multi_level_btb::branch_info::CONDITIONAL;
+  return multi_level_btb::branch_info::ALWAYS_TAKEN;
+}
+} // namespace
+
+multi_level_btb::multi_level_btb(O3_CPU* cpu)
+    : btb(cpu), levels(make_levels(std::empty(configured_levels()) ? std::vector(std::begin(default_level_configs), std::end(default_level_configs))
+                                                                    : configured_levels()))
+{
+}
+
+multi_level_btb::multi_level_btb(O3_CPU* cpu, const std::vector<champsim::btb_level_config>& configs) : btb(cpu), levels(make_levels(configs)) {}
+
+std::vector<multi_level_btb::btb_level> multi_level_btb::make_levels(const std::vector<champsim::btb_level_config>& configs)
+{
+  std::vector<btb_level> retval{};
+  for (auto config : configs) {
+    retval.push_back({champsim::msl::lru_table<btb_entry_t>{config.sets, config.ways}, config.latency});
+  }
+  return retval;
+}
+
+auto multi_level_btb::btb_prediction(champsim::address ip) -> prediction
+{
+  auto level = std::begin(levels);
+  std::optional<btb_entry_t> btb_entry{};
+  for (; level != std::end(levels) && !btb_entry.has_value(); ++level) {
+    btb_entry = level->table.check_hit({ip, champsim::address{}, branch_info::ALWAYS_TAKEN});
+  }
+
+  // no prediction for this IP
+  if (!btb_entry.has_value())
+    return {champsim::address{}, false};
+
+  level = std::prev(level);
+  auto level_idx = static_cast<std::size_t>(std::distance(std::begin(levels), level));
+
+  // promote the entry into the faster levels
+  std::for_each(std::begin(levels), level, [&btb_entry](auto& lvl) { lvl.table.fill(*btb_entry); });
+
+  if (btb_entry->type == branch_info::RETURN)
+    return {ras.prediction(), true, level->bubbles, level_idx};
+
+  if (btb_entry->type == branch_info::INDIRECT)
+    return {indirect.prediction(ip), true, level->bubbles, level_idx};
+
+  return {btb_entry->target, btb_entry->type != branch_info::CONDITIONAL, level->bubbles, level_idx};
+}
+
+void multi_level_btb::update_btb(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type)
+{
+  // add something to the RAS
+  if (branch_type == BRANCH_DIRECT_CALL || branch_type == BRANCH_INDIRECT_CALL)
+    ras.push(ip);
+
+  // updates for indirect branches
+  if ((branch_type == BRANCH_INDIRECT) || (branch_type == BRANCH_INDIRECT_CALL)) {
+    using namespace champsim::data::data_literals;
+    indirect.update_target(ip, branch_target);
+    indirect.update_history(branch_target.slice_upper<2_b>().to<uint64_t>(), 2);
+  }
+
+  if (branch_type == BRANCH_CONDITIONAL)
+    indirect.update_history(taken ? 1 : 0, 1);
+
+  if (branch_type == BRANCH_RETURN)
+    ras.calibrate_call_size(branch_target);
+
+  // the levels are inclusive, so every level is updated
+  auto type = classify(branch_type);
+  for (auto& level : levels) {
+    auto opt_entry = level.table.check_hit({ip, branch_target, type});
+    if (opt_entry.has_value()) {
+      opt_entry->type = type;
+      if (branch_target != champsim::address{})
+        opt_entry->target = branch_target;
+    }
+
+    if (branch_target != champsim::address{}) {
+      level.table.fill(opt_entry.value_or(btb_entry_t{ip, branch_target, type}));
+    }
+  }
+}
+
+std::size_t multi_level_btb::ittage::index(std::size_t table, champsim::address ip) const
+{
+  using namespace champsim::data::data_literals;
+  constexpr auto index_bits = static_cast<unsigned>(champsim::msl::lg2(table_size));
+  auto ip_bits = ip.slice_upper<2_b>().to<uint64_t>();
+  return static_cast<std::size_t>((ip_bits ^ (ip_bits >> index_bits) ^ fold(history, history_lengths.at(table), index_bits)) % table_size);
+}
+
+uint64_t multi_level_btb::ittage::tag(std::size_t table, champsim::address ip) const
+{
+  using namespace champsim::data::data_literals;
+  auto ip_bits = ip.slice_upper<2_b>().to<uint64_t>();
+  return (ip_bits ^ (fold(history, history_lengths.at(table), tag_bits - 1) << 1)) & ((uint64_t{1} << tag_bits) - 1);
+}
+
+champsim::address multi_level_btb::ittage::prediction(champsim::address ip) const
+{
+  using namespace champsim::data::data_literals;
+
+  // the longest matching history provides the prediction
+  for (auto table = std::size(tables); table > 0; --table) {
+    const auto& entry = tables.at(table - 1).at(index(table - 1, ip));
+    if (entry.valid && entry.tag == tag(table - 1, ip))
+      return entry.target;
+  }
+
+  return base.at(ip.slice_upper<2_b>().to<std::size_t>() % base_size);
+}
+
+void multi_level_btb::ittage::update_target(champsim::address ip, champsim::address branch_target)
+{
+  using namespace champsim::data::data_literals;
+
+  auto provider = std::size(tables);
+  for (auto table = std::size(tables); table > 0 && provider == std::size(tables); --table) {
+    const auto& entry = tables.at(table - 1).at(index(table - 1, ip));
+    if (entry.valid && entry.tag == tag(table - 1, ip))
+      provider = table - 1;
+  }
+
+  auto& base_entry = base.at(ip.slice_upper<2_b>().to<std::size_t>() % base_size);
+  bool correct = false;
+  if (provider < std::size(tables)) {
+    auto& entry = tables.at(provider).at(index(provider, ip));
+    correct = (entry.target == branch_target);
+    if (correct) {
+      entry.confidence = static_cast<uint8_t>(std::min(entry.confidence + 1, int{max_confidence}));
+    } else if (entry.confidence > 0) {
+      --entry.confidence;
+    } else {
+      entry.target = branch_target;
+    }
+  } else {
+    correct = (base_entry == branch_target);
+    base_entry = branch_target;
+  }
+
+  // on a misprediction, allocate an entry with a longer history
+  if (!correct) {
+    auto first_longer = (provider < std::size(tables)) ? provider + 1 : 0;
+    for (auto table = first_longer; table < std::size(tables); ++table) {
+      auto& entry = tables.at(table).at(index(table, ip));
+      if (!entry.valid || entry.confidence == 0) {
+        entry = tagged_entry{tag(table, ip), branch_target, 0, true};
+        break;
+      }
+      --entry.confidence;
+    }
+  }
+}
+
+void multi_level_btb::ittage::update_history(uint64_t bits, unsigned count)
+{
+  history = (history << count) ^ bits;
+}
+
+champsim::address multi_level_btb::return_stack::prediction() const
+{
+  if (std::empty(stack))
+    return champsim::address{};
+
+  // peek at the top of the RAS and adjust for the size of the call instr
+  auto target = stack.back();
+  auto size = call_size_trackers.at(target.slice_lower<champsim::data::bits{champsim::msl::lg2(num_call_size_trackers)}>().to<std::size_t>());
+
+  return target + size;
+}
+
+void multi_level_btb::return_stack::push(champsim::address ip)
+{
+  stack.push_back(ip);
+  if (std::size(stack) > max_size)
+    stack.pop_front();
+}
+
+void multi_level_btb::return_stack::calibrate_call_size(champsim::address branch_target)
+{
+  if (!std::empty(stack)) {
+    // recalibrate call-return offset if our return prediction got us close, but not exact
+    auto call_ip = stack.back();
+    stack.pop_back();
+
+    auto estimated_call_instr_size = call_ip > branch_target ? champsim::uoffset(branch_target, call_ip) : champsim::uoffset(call_ip, branch_target);
+    if (estimated_call_instr_size <= 10) {
+      call_size_trackers.at(call_ip.slice_lower<champsim::data::bits{champsim::msl::lg2(num_call_size_trackers)}>().to<std::size_t>()) =
+          estimated_call_instr_size;
+    }
+  }
+}
@@ -0,0 +1,108 @@
+#ifndef BTB_MULTI_LEVEL_BTB_H
+#define BTB_MULTI_LEVEL_BTB_H
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "address.h"
+#include "btb_level_config.h"
+#include "modules.h"
+#include "msl/lru_table.h"
+
+class multi_level_btb : champsim::modules::btb
+{
+public:
+  enum class branch_info {
+    INDIRECT,
+    RETURN,
+    ALWAYS_TAKEN,
+    CONDITIONAL,
+  };
+
+  struct btb_entry_t {
+    champsim::address ip_tag{};
+    champsim::address target{};
+    branch_info type = branch_info::ALWAYS_TAKEN;
+
+    auto index() const
+    {
+      using namespace champsim::data::data_literals;
+      return ip_tag.slice_upper<2_b>();
+    }
+    auto tag() const
+    {
+      using namespace champsim::data::data_literals;
+      return ip_tag.slice_upper<2_b>();
+    }
+  };
+
+  // A small, zero-bubble L0 in front of progressively larger and slower levels, used if the core does not specify its BTB levels
+  static constexpr std::array<champsim::btb_level_config, 3> default_level_configs{{{1, 16, 0}, {64, 4, 1}, {1024, 8, 2}}};
+
+private:
+  struct btb_level {
+    champsim::msl::lru_table<btb_entry_t> table;
+    long bubbles;
+  };
+
+  /*
+   * An ITTAGE-style indirect target predictor: a tagless base table, backed by tagged tables indexed with geometrically increasing lengths of
+   * global history. The matching table with the longest history provides the prediction.
+   */
+  struct ittage {
+    static constexpr std::size_t base_size = 1024;
+    static constexpr std::size_t table_size = 256;
+    static constexpr std::array<unsigned, 3> history_lengths{{4, 12, 32}};
+    static constexpr unsigned tag_bits = 12;
+    static constexpr uint8_t max_confidence = 3;
+
+    struct tagged_entry {
+      uint64_t tag = 0;
+      champsim::address target{};
+      uint8_t confidence = 0;
+      bool valid = false;
+    };
+
+    std::array<champsim::address, base_size> base{};
+    std::array<std::array<tagged_entry, table_size>, std::size(history_lengths)> tables{};
+    uint64_t history = 0;
+
+    [[nodiscard]] std::size_t index(std::size_t table, champsim::address ip) const;
+    [[nodiscard]] uint64_t tag(std::size_t table, champsim::address ip) const;
+    [[nodiscard]] champsim::address prediction(champsim::address ip) const;
+    void update_target(champsim::address ip, champsim::address branch_target);
+    void update_history(uint64_t bits, unsigned count);
+  };
+
+  struct return_stack {
+    static constexpr std::size_t max_size = 256;
+    static constexpr std::size_t num_call_size_trackers = 1024;
+
+    using offset_type = typename champsim::address::difference_type;
+
+    std::deque<champsim::address> stack{};
+    std::vector<offset_type> call_size_trackers = std::vector<offset_type>(num_call_size_trackers, 4);
+
+    [[nodiscard]] champsim::address prediction() const;
+    void push(champsim::address ip);
+    void calibrate_call_size(champsim::address branch_target);
+  };
+
+  std::vector<btb_level> levels;
+  ittage indirect{};
+  return_stack ras{};
+
+  static std::vector<btb_level> make_levels(const std::vector<champsim::btb_level_config>& configs);
+
+public:
+  explicit multi_level_btb(O3_CPU* cpu);
+  multi_level_btb(O3_CPU* cpu, const std::vector<champsim::btb_level_config>& configs);
+  multi_level_btb() : multi_level_btb(nullptr, {std::begin(default_level_configs), std::end(default_level_configs)}) {}
+
+  prediction btb_prediction(champsim::address ip);
+  void update_btb(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type);
+};
+
+#endif
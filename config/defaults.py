@@ -62,11 +62,15 @@ def list_defaults_for_core(cpu, caches):
     def connect_translator(cache, tlb):
         return {'name': cache['name'], 'lower_translate': tlb['name']}
 
+    # Only the name is carried along, since list values (such as several prefetchers) would be joined with themselves when the defaults are merged back
+    def with_defaults(cache, members):
+        return util.chain({'name': cache['name']}, members)
+
     return (
-        map(util.chain, icache_path[0], l1i_members), #L1I path
-        map(util.chain, dcache_path[0], l1d_members), #L1D path
-        map(util.chain, itlb_path[0], itlb_members), #ITLB path
-        map(util.chain, dtlb_path[0], dtlb_members), #DTLB path
+        map(with_defaults, icache_path[0], l1i_members), #L1I path
+        map(with_defaults, dcache_path[0], l1d_members), #L1D path
+        map(with_defaults, itlb_path[0], itlb_members), #ITLB path
+        map(with_defaults, dtlb_path[0], dtlb_members), #DTLB path
         map(connect_translator, icache_path[1], itlb_path[1]), #L1I translation path
         map(connect_translator, dcache_path[1], dtlb_path[1]) #L1D translation path
     )
@@ -44,6 +44,10 @@ core_builder_parts = {
     'sq_width': '.sq_width(champsim::bandwidth::maximum_type{{{sq_width}}})',
     'retire_width': '.retire_width(champsim::bandwidth::maximum_type{{{retire_width}}})',
     'mispredict_penalty': '.mispredict_penalty({mispredict_penalty})',
+    'ssit_size': '.ssit_size({ssit_size})',
+    'lfst_size': '.lfst_size({lfst_size})',
+    'store_buffer_size': '.store_buffer_size({store_buffer_size})',
+    'memory_violation_penalty': '.memory_violation_penalty({memory_violation_penalty})',
     'decode_latency': '.decode_latency({decode_latency})',
     'dispatch_latency': '.dispatch_latency({dispatch_latency})',
     'schedule_latency': '.schedule_latency({schedule_latency})',
@@ -73,6 +77,22 @@ cache_builder_parts = {
     'ways': '.ways({ways})',
     'log2_ways': '.log2_ways({log2_ways})',
     'pq_size': '.pq_size({pq_size})',
+    'prefetch_filter_sets': '.prefetch_filter_sets({prefetch_filter_sets})',
+    'prefetch_filter_ways': '.prefetch_filter_ways({prefetch_filter_ways})',
+    'prefetch_throttle_interval': '.prefetch_throttle_interval({prefetch_throttle_interval})',
+    'prefetch_arbitration': '.prefetch_arbitration(champsim::prefetch_arbiter::policy::{^prefetch_arbitration_policy})',
+    'inclusion': '.inclusion(champsim::inclusion_policy::{^inclusion_policy})',
+    'directory_sets': '.directory_sets({directory_sets})',
+    'directory_ways': '.directory_ways({directory_ways})',
+    'victim_cache_size': '.victim_cache_size({victim_cache_size})',
+    'write_combining_buffer_size': '.write_combining_buffer_size({write_combining_buffer_size})',
+    'compression_model': '.compression_model("{compression_model}")',
+    'compression_size_file': '.compression_size_file("{compression_size_file}")',
+    'compression_tag_factor': '.compression_tag_factor({compression_tag_factor})',
+    'way_partition': '.way_partition({{{^way_partition_string}}})',
+    'utility_partition_interval': '.utility_partition_interval({utility_partition_interval})',
+    'metadata_ways': '.metadata_ways({metadata_ways})',
+    'metadata_entries_per_block': '.metadata_entries_per_block({metadata_entries_per_block})',
     'mshr_size': '.mshr_size({mshr_size})',
     'latency': '.latency({latency})',
     'hit_latency': '.hit_latency({hit_latency})',
@@ -98,6 +118,11 @@ ptw_builder_parts = {
     'frequency': '.clock_period(champsim::chrono::picoseconds{{{^clock_period}}})'
 }
 
+def btb_level_parts(cpu):
+    ''' Generate one builder part for each level of a hierarchical BTB, in order from the level nearest to fetch '''
+    for level in cpu.get('btb_levels', []):
+        yield f'.btb_level({level["sets"]}, {level["ways"]}, {level.get("latency", 0)})'
+
 def vector_string(iterable):
     ''' Produce a string that avoids a warning on clang under -Wbraced-scalar-init if there is only one member '''
     hoisted = list(iterable)
@@ -105,9 +130,34 @@ def vector_string(iterable):
         return hoisted[0]
     return '{'+', '.join(hoisted)+'}'
 
-def get_cpu_builder(cpu, caches, ul_pairs):
+# These parts of a core builder depend on the rest of the system, so they cannot be part of a compile-time shape
+core_runtime_keys = ('L1I', 'L1D', '_branch_predictor_data', '_btb_data', '_index')
+
+def get_cpu_shape_name(cpu, build_id):
+    ''' The name of the constexpr builder that fixes the shape of the given core '''
+    return f'champsim::configured::core_shape_{build_id}_{cpu["_index"]}'
+
+def get_cpu_shape(cpu):
+    '''
+    Generate a constexpr champsim::core_builder that holds only the dimensions of the core
+    '''
+    local_params = {}
+    if 'frequency' in cpu:
+        local_params['^clock_period'] = int(1000000/cpu['frequency'])
+
+    builder_parts = itertools.chain(util.multiline(itertools.chain(
+        ('champsim::core_builder{{ champsim::defaults::default_core }}',),
+        *(util.wrap_list(v) for k,v in core_builder_parts.items() if k in cpu and k not in core_runtime_keys),
+        (v for k,v in dib_builder_parts.items() if k in cpu.get('DIB',{})),
+        btb_level_parts(cpu)
+    ), indent=1, line_end=''))
+    yield from (part.format(**cpu, **local_params) for part in builder_parts)
+
+def get_cpu_builder(cpu, caches, ul_pairs, build_id=None):
     '''
     Generate a champsim::core_builder
+
+    If the core has a fixed shape, the builder starts from the core's constexpr shape and adds only the parts that depend on the rest of the system.
     '''
     required_parts = [
     ]
@@ -126,14 +176,32 @@ def get_cpu_builder(cpu, caches, ul_pairs):
     if 'frequency' in cpu:
         local_params['^clock_period'] = int(1000000/cpu['frequency'])
 
+    if cpu.get('fixed_shape', False):
+        head = f'champsim::core_builder{{{{ {get_cpu_shape_name(cpu, build_id)} }}}}'
+        parts = (util.wrap_list(v) for k,v in core_builder_parts.items() if k in cpu and k in core_runtime_keys)
+        dib_parts = ()
+        btb_parts = ()
+    else:
+        head = 'champsim::core_builder{{ champsim::defaults::default_core }}'
+        parts = (util.wrap_list(v) for k,v in core_builder_parts.items() if k in cpu)
+        dib_parts = (v for k,v in dib_builder_parts.items() if k in cpu.get('DIB',{}))
+        btb_parts = btb_level_parts(cpu)
+
     builder_parts = itertools.chain(util.multiline(itertools.chain(
-        ('champsim::core_builder{{ champsim::defaults::default_core }}',),
+        (head,),
         required_parts,
-        *(util.wrap_list(v) for k,v in core_builder_parts.items() if k in cpu),
-        (v for k,v in dib_builder_parts.items() if k in cpu.get('DIB',{}))
+        *parts,
+        dib_parts,
+        btb_parts
     ), indent=1, line_end=''))
     yield from (part.format(**cpu, **local_params) for part in builder_parts)
 
+def get_cpu_type(cpu, build_id):
+    ''' The C++ type of the given core '''
+    if cpu.get('fixed_shape', False):
+        return f'champsim::fixed_core<{get_cpu_shape_name(cpu, build_id)}>'
+    return 'O3_CPU'
+
 def get_cache_builder(elem, ul_pairs):
     '''
     Generate a champsim::cache_builder
@@ -149,7 +217,19 @@ def get_cache_builder(elem, ul_pairs):
         ('wq_check_full_addr', True): '.set_wq_checks_full_addr()',
         ('wq_check_full_addr', False): '.reset_wq_checks_full_addr()',
         ('virtual_prefetch', True): '.set_virtual_prefetch()',
-        ('virtual_prefetch', False): '.reset_virtual_prefetch()'
+        ('virtual_prefetch', False): '.reset_virtual_prefetch()',
+        ('prefetch_throttle', True): '.set_prefetch_throttle()',
+        ('prefetch_throttle', False): '.reset_prefetch_throttle()',
+        ('utility_partition', True): '.set_utility_partition()',
+        ('utility_partition', False): '.reset_utility_partition()',
+        ('packed_tags', True): '.set_packed_tags()',
+        ('packed_tags', False): '.reset_packed_tags()',
+        ('metadata_offchip', True): '.set_metadata_offchip()',
+        ('metadata_offchip', False): '.reset_metadata_offchip()',
+        ('write_allocate', True): '.set_write_allocate()',
+        ('write_allocate', False): '.reset_write_allocate()',
+        ('full_line_write_elision', True): '.set_full_line_write_elision()',
+        ('full_line_write_elision', False): '.reset_full_line_write_elision()'
     }
 
     uppers = (v for v in ul_pairs if v[0] == elem.get('name'))
@@ -163,16 +243,26 @@ def get_cache_builder(elem, ul_pairs):
     }
     if 'frequency' in elem:
         local_params['^clock_period'] = int(1000000/elem['frequency'])
+    if 'prefetch_arbitration' in elem:
+        local_params['^prefetch_arbitration_policy'] = elem['prefetch_arbitration'].upper()
+    if 'inclusion' in elem:
+        local_params['^inclusion_policy'] = elem['inclusion'].upper()
+    if 'way_partition' in elem:
+        local_params['^way_partition_string'] = ', '.join(hex(int(m, 0) if isinstance(m, str) else m) for m in elem['way_partition'])
     if 'lower_translate' in elem:
         local_params.update({
             '^lower_translate_queues': f'channels.at({ul_pairs.index((elem.get("lower_translate"), elem.get("name")))})'
         })
 
+    # Off-chip metadata is kept in physical memory that translations may not use
+    reserved_parts = ('.metadata_region(vmem.reserve_region(CACHE::metadata_region_size))',) if elem.get('metadata_offchip', False) else ()
+
     builder_parts = itertools.chain(util.multiline(itertools.chain(
         ('champsim::cache_builder{{ {^defaults} }}',),
         required_parts,
         (v for k,v in cache_builder_parts.items() if k in elem),
-        (v for k,v in local_cache_builder_parts.items() if k[0] in elem and k[1] == elem[k[0]])
+        (v for k,v in local_cache_builder_parts.items() if k[0] in elem and k[1] == elem[k[0]]),
+        reserved_parts
     ), indent=1, line_end=''))
     yield from (part.format(**elem, **local_params) for part in builder_parts)
 
@@ -234,7 +324,15 @@ def get_builder_function_call(class_name, builders):
     :param builders: A sequence of builders to pass as parameters.
     '''
     yield f'build<{class_name}>('
+    yield from get_builder_list(builders)
+    yield ')'
+
+def get_builder_list(builders):
+    '''
+    Generate a comma-separated list of builders.
 
+    :param builders: A sequence of builders
+    '''
     builder_head, builder_tail = util.cut(builders, n=-1)
     for b in builder_head:
         head, tail = util.cut(b, n=-1)
@@ -244,7 +342,24 @@ def get_builder_function_call(class_name, builders):
     for b in builder_tail:
         yield from ('  '+l for l in b)
 
-    yield ')'
+def has_fixed_cores(cores):
+    ''' Whether any core in the system has its shape fixed at compile time '''
+    return any(c.get('fixed_shape', False) for c in cores)
+
+def get_core_instantiation_body(cores, caches, ul_pairs, build_id):
+    '''
+    Generate the member initializer for the cores.
+
+    If any core has a fixed shape, the cores are held in a std::tuple, which is initialized directly from the builders.
+    The tuple holds the cores in the same order as the std::forward_list produced by build<>().
+    '''
+    builders = map(functools.partial(get_cpu_builder, caches=caches, ul_pairs=ul_pairs, build_id=build_id), cores)
+    yield 'cores {'
+    if has_fixed_cores(cores):
+        yield from get_builder_list(reversed(list(builders)))
+    else:
+        yield from get_builder_function_call('O3_CPU', builders)
+    yield '}'
 
 def cache_queue_defaults(cache):
     return {
@@ -374,12 +489,7 @@ def get_instantiation_lines(cores, caches, ptws, pmem, vmem, build_id):
         '},'
     )
 
-    core_instantiation_body = (
-        'cores {',
-        *get_builder_function_call('O3_CPU',
-                                   map(functools.partial(get_cpu_builder, caches=caches, ul_pairs=ul_pairs), cores)),
-        '}'
-    )
+    core_instantiation_body = tuple(get_core_instantiation_body(cores, caches, ul_pairs, build_id))
 
     yield f'champsim::configured::generated_environment<0x{build_id}>::generated_environment() :'
     yield from itertools.chain(
@@ -387,14 +497,26 @@ def get_instantiation_lines(cores, caches, ptws, pmem, vmem, build_id):
     yield from channel_instantiation_body
     yield from pmem_instantiation_body
     yield from vmem_instantiation_body
-    yield from ptw_instantiation_body
     yield from cache_instantiation_body
+    yield from ptw_instantiation_body
     yield from core_instantiation_body
     yield '{'
+    if vmem.get('shared_address_space', False):
+        yield '  vmem.shared_address_space = true;'
     yield '}'
     yield ''
 
-    yield from get_ref_vector_function('O3_CPU', f'{classname}::cpu_view', 'cores')
+    if has_fixed_cores(cores):
+        yield from cxx.function(f'{classname}::cpu_view', (
+            'std::vector<std::reference_wrapper<O3_CPU>> retval{};',
+            'std::apply([&](auto&... x){ (..., retval.push_back(std::ref<O3_CPU>(x))); }, cores);',
+            'return retval;'
+        ), rtype='std::vector<std::reference_wrapper<O3_CPU>>')
+        yield ''
+        core_operable_line = 'std::apply([&](auto&... x){ (..., retval.push_back(std::ref<champsim::operable>(x))); }, cores);'
+    else:
+        yield from get_ref_vector_function('O3_CPU', f'{classname}::cpu_view', 'cores')
+        core_operable_line = 'std::transform(std::begin(cores), std::end(cores), std::back_inserter(retval), make_ref);'
     yield ''
 
     yield from get_ref_vector_function('CACHE', f'{classname}::cache_view', 'caches')
@@ -406,7 +528,7 @@ def get_instantiation_lines(cores, caches, ptws, pmem, vmem, build_id):
     yield from cxx.function(f'{classname}::operable_view', (
         'std::vector<std::reference_wrapper<champsim::operable>> retval{};',
         'auto make_ref = [](auto& x){ return std::ref<champsim::operable>(x); };',
-        'std::transform(std::begin(cores), std::end(cores), std::back_inserter(retval), make_ref);',
+        core_operable_line,
         'std::transform(std::begin(caches), std::end(caches), std::back_inserter(retval), make_ref);',
         'std::transform(std::begin(ptws), std::end(ptws), std::back_inserter(retval), make_ref);',
         'retval.push_back(std::ref<champsim::operable>(DRAM));',
@@ -417,19 +539,35 @@ def get_instantiation_lines(cores, caches, ptws, pmem, vmem, build_id):
     yield from cxx.function(f'{classname}::dram_view', [f'return {pmem["name"]};'], rtype='MEMORY_CONTROLLER&')
     yield ''
 
-def get_instantiation_header(num_cpus, env, build_id):
+def get_instantiation_header(num_cpus, env, build_id, cores=tuple()):
     yield '#include "environment.h"'
     yield '#include "vmem.h"'
     yield '#include <forward_list>'
+
+    if has_fixed_cores(cores):
+        yield '#include <tuple>'
+        yield '#include "defaults.hpp"'
+        yield '#include "fixed_core.h"'
+        yield 'namespace champsim::configured {'
+        for cpu in filter(operator.methodcaller('get', 'fixed_shape', False), cores):
+            head, tail = util.cut(get_cpu_shape(cpu), n=-1)
+            yield f'inline constexpr auto {get_cpu_shape_name(cpu, build_id).split("::")[-1]} ='
+            yield from ('  '+l for l in head)
+            yield from ('  '+l+';' for l in tail)
+        yield '}'
+        core_member = f'std::tuple<{", ".join(get_cpu_type(cpu, build_id) for cpu in reversed(cores))}> cores;'
+    else:
+        core_member = 'std::forward_list<O3_CPU> cores;'
+
     yield 'template <>'
     struct_body = (
         'private:',
         'std::vector<champsim::channel> channels;',
         'MEMORY_CONTROLLER DRAM;',
         'VirtualMemory vmem;',
+        'std::forward_list<CACHE> caches;', # Caches may reserve physical memory, which must happen before the walkers make any translation
         'std::forward_list<PageTableWalker> ptws;',
-        'std::forward_list<CACHE> caches;',
-        'std::forward_list<O3_CPU> cores;',
+        core_member,
 
         'public:',
         f'constexpr static std::size_t num_cpus = {num_cpus};',
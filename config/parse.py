@@ -233,8 +233,8 @@ class NormalizedConfiguration:
             (
                 'frequency', 'ifetch_buffer_size', 'decode_buffer_size', 'dispatch_buffer_size', 'register_file_size', 'rob_size', 'lq_size',
                 'sq_size', 'fetch_width', 'decode_width', 'dispatch_width', 'execute_width', 'lq_width', 'sq_width',
-                'retire_width', 'mispredict_penalty', 'scheduler_size', 'decode_latency', 'dispatch_latency',
-                'schedule_latency', 'execute_latency', 'branch_predictor', 'btb', 'DIB'
+                'retire_width', 'mispredict_penalty', 'ssit_size', 'lfst_size', 'store_buffer_size', 'memory_violation_penalty', 'scheduler_size', 'decode_latency', 'dispatch_latency',
+                'schedule_latency', 'execute_latency', 'branch_predictor', 'btb', 'btb_levels', 'DIB', 'fixed_shape'
             )
         )
         self.cores = [util.chain(cpu, core_from_config, {'name': f'cpu{i}'}) for i,cpu in enumerate(self.cores)]
@@ -18,6 +18,7 @@
 #define BLOCK_H
 
 #include "champsim.h"
+#include "chrono.h"
 
 namespace champsim
 {
@@ -25,12 +26,18 @@ struct cache_block {
   bool valid = false;
   bool prefetch = false;
   bool dirty = false;
+  bool owned = false; // the block was filled for ownership, so a store to it need not ask a directory below
 
   champsim::address address{};
   champsim::address v_address{};
   champsim::address data{};
 
   uint32_t pf_metadata = 0;
+  uint32_t pf_source = 0; // the prefetcher module that filled the block, if it was prefetched
+  uint32_t cpu = 0;       // the core whose request filled the block
+  uint32_t segments = 0;  // the segments of the data array that the block occupies, in a compressed cache
+
+  champsim::chrono::clock::time_point fill_time{};
 };
 } // namespace champsim
 
@@ -0,0 +1,34 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BTB_LEVEL_CONFIG_H
+#define BTB_LEVEL_CONFIG_H
+
+#include <cstddef>
+
+namespace champsim
+{
+/**
+ * The geometry of one level of a hierarchical BTB.
+ */
+struct btb_level_config {
+  std::size_t sets;
+  std::size_t ways;
+  long latency; // cycles that fetch is idle after a taken branch whose target was found in this level
+};
+} // namespace champsim
+
+#endif
@@ -29,6 +29,7 @@
 #include <iterator> // for size
 #include <limits>   // for numeric_limits
 #include <memory>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
@@ -42,10 +43,22 @@
 #include "champsim.h"
 #include "channel.h"
 #include "chrono.h"
+#include "coherence_directory.h"
+#include "compression_model.h"
+#include "metadata_store.h"
 #include "modules.h"
+#include "msl/lru_table.h"
+#include "next_use_index.h"
 #include "operable.h"
+#include "prefetch_ensemble.h"
+#include "prefetch_throttle.h"
+#include "tag_store.h"
 #include "util/to_underlying.h" // for to_underlying
+#include "util/type_name.h"
+#include "victim_cache.h"
+#include "way_partition.h"
 #include "waitable.h"
+#include "write_combining_buffer.h"
 #include <fstream>
 
 class CACHE : public champsim::operable
@@ -64,6 +77,7 @@ class CACHE : public champsim::operable
   using response_type = typename channel_type::response_type;
   // std::ofstream trace_file;
   FILE* trace_file = nullptr;
+  std::unique_ptr<champsim::next_use_index::recorder> oracle_recorder;
 
   struct tag_lookup_type {
     champsim::address address;
@@ -73,6 +87,7 @@ class CACHE : public champsim::operable
     uint64_t instr_id;
 
     uint32_t pf_metadata;
+    uint32_t pf_source = 0;
     uint32_t cpu;
 
     access_type type;
@@ -81,9 +96,14 @@ class CACHE : public champsim::operable
     bool is_translated;
     bool translate_issued = false;
     bool is_instr = false;
+    bool page_walked = false;
+    bool clean_victim = false;
+    bool full_line = false;
 
     uint8_t asid[2] = {std::numeric_limits<uint8_t>::max(), std::numeric_limits<uint8_t>::max()};
 
+    channel_type* source_channel = nullptr; // the upper level that sent this request, if any
+
     champsim::chrono::clock::time_point event_cycle = champsim::chrono::clock::time_point::max();
 
     std::vector<uint64_t> instr_depend_on_me{};
@@ -103,13 +123,18 @@ public:
     struct returned_value {
       champsim::address data;
       uint32_t pf_metadata;
+      uint8_t miss_depth;
+      bool page_walked;
     };
     champsim::waitable<returned_value> data_promise{};
+    uint32_t pf_source = 0;
     uint32_t cpu;
 
     access_type type;
     bool prefetch_from_this;
     bool is_instr = false;
+    bool page_walked = false;
+    bool clean_victim = false;
 
     uint8_t asid[2] = {std::numeric_limits<uint8_t>::max(), std::numeric_limits<uint8_t>::max()};
 
@@ -127,6 +152,7 @@ private:
   bool handle_fill(const mshr_type& fill_mshr);
   bool handle_miss(const tag_lookup_type& handle_pkt);
   bool handle_write(const tag_lookup_type& handle_pkt);
+  bool handle_write_around(const tag_lookup_type& handle_pkt);
   void finish_packet(const response_type& packet);
   void finish_translation(const response_type& packet);
 
@@ -143,6 +169,44 @@ private:
   [[nodiscard]] std::pair<set_type::const_iterator, set_type::const_iterator> get_set_span(champsim::address address) const;
   [[nodiscard]] long get_set_index(champsim::address address) const;
 
+  std::optional<champsim::tag_store> packed_tags{};
+
+  set_type::iterator find_valid_block(set_type::iterator set_begin, set_type::iterator set_end, champsim::address address);
+  set_type::iterator find_invalid_block(set_type::iterator set_begin, set_type::iterator set_end, uint64_t allowed_ways);
+  void update_packed_tag(set_type::const_iterator way);
+
+  bool issue_writeback(const BLOCK& victim, uint32_t triggering_cpu, uint64_t instr_id);
+  bool issue_upgrade(const BLOCK& shared_block, uint32_t triggering_cpu);
+  void invalidate_block(set_type::iterator way);
+  void send_back_invalidation(champsim::address address);
+  void apply_back_invalidation(champsim::address address);
+  void apply_downgrade(champsim::address address);
+
+  std::optional<champsim::coherence_directory> directory{};
+  std::vector<channel_type*> directory_requesters{}; // the upper levels in a fixed order, since upper_levels is rotated for fairness
+
+  void directory_access(const tag_lookup_type& handle_pkt);
+
+  std::optional<champsim::way_partition> partition{};
+
+  // The ways that a core may fill, as a mask for the replacement policy
+  [[nodiscard]] uint64_t fill_ways(uint32_t triggering_cpu) const;
+
+  // Account for a tag check once it is final, which is exactly once per access: a miss may be retried before it is
+  void finish_tag_check(const tag_lookup_type& handle_pkt, bool hit);
+
+  std::optional<champsim::victim_cache> victims{};
+  std::optional<champsim::write_combining_buffer> write_combiner{};
+
+  set_type::iterator swap_from_victim_cache(set_type::iterator set_begin, set_type::iterator set_end, const tag_lookup_type& handle_pkt);
+
+  // In a compressed cache, each set holds more tags than ways, and its blocks share a data array of this many segments
+  std::optional<champsim::compression_model> compression{};
+  uint32_t data_segments_per_set = 0;
+
+  std::vector<set_type::iterator> compression_victims(set_type::iterator set_begin, set_type::iterator set_end, set_type::iterator way, uint32_t segments,
+                                                      uint32_t triggering_cpu, uint64_t instr_id, champsim::address ip, champsim::address full_addr);
+
   template <typename T>
   bool should_activate_prefetcher(const T& pkt) const;
 
@@ -162,7 +226,75 @@ private:
   std::deque<tag_lookup_type> inflight_tag_check{};
   std::deque<tag_lookup_type> translation_stash{};
 
+  // The most recent prefetched block that each set evicted without a demand hit, to detect prefetches that arrived too early
+  std::vector<std::optional<champsim::address>> evicted_unused_prefetch{};
+
+  // The most recent block that each set evicted to make room for a prefetch, to detect demand misses caused by prefetch pollution
+  std::vector<std::optional<champsim::address>> evicted_by_prefetch{};
+
+  // A demand used a block that this cache prefetched. A prefetch is late if the demand found it still in the MSHR, and timely if it had filled.
+  void record_prefetch_use(uint32_t pf_source, bool late);
+
+  // Give each prefetcher module a fresh budget of prefetches under the throttled degree
+  void reset_prefetch_budget();
+
+  std::vector<BLOCK> functional_fill(const tag_lookup_type& pkt, bool train_prefetcher);
+
+  struct prefetch_filter_entry {
+    uint64_t block_number;
+    bool resident; // the block was filled into this cache, rather than only prefetched
+
+    [[nodiscard]] auto index() const { return block_number; }
+    [[nodiscard]] auto tag() const { return block_number; }
+  };
+
+  // Recently prefetched and filled blocks, to drop redundant prefetches before they consume tag bandwidth
+  std::optional<champsim::msl::lru_table<prefetch_filter_entry>> prefetch_filter{};
+
+  [[nodiscard]] uint64_t prefetch_filter_key(champsim::address addr) const;
+  void prefetch_filter_insert(champsim::address addr, bool resident);
+  void prefetch_filter_remove(champsim::address addr);
+
+  std::size_t pf_components = 1; // the number of prefetcher modules, each of which owns a slice of the prefetch metadata
+  uint32_t useful_pf_source = 0; // the module that issued the prefetched block of the current hit, to route usefulness feedback to it
+  bool pf_metadata_sliced = false; // the metadata of the current access was divided into slices by this cache's modules, rather than by another level
+
+  struct prefetch_candidate {
+    champsim::address address;
+    bool fill_this_level;
+    uint32_t metadata;
+    uint32_t source;
+  };
+
+  // Prefetches that compete for the internal prefetch queue in this cycle, if the cache arbitrates between its prefetchers
+  std::vector<prefetch_candidate> pf_candidates{};
+  std::optional<champsim::prefetch_arbiter> pf_arbiter{};
+
+  bool issue_prefetch(champsim::address pf_addr, bool fill_this_level, uint32_t prefetch_metadata, uint32_t source);
+  bool prefetch_filtered(champsim::address pf_addr);
+  void arbitrate_prefetches();
+
+  std::optional<champsim::metadata_store> pf_metadata_store{};
+  std::optional<champsim::address> metadata_region{}; // the base of the reserved physical memory that holds off-chip metadata
+  long pending_metadata_accesses = 0;                 // metadata accesses that have yet to consume tag bandwidth
+
+  struct metadata_fetch_type {
+    champsim::address address;
+    uint64_t key;
+    bool issued = false;
+  };
+  std::deque<metadata_fetch_type> inflight_metadata_reads{}; // off-chip metadata that is not yet visible to the prefetchers
+
+  [[nodiscard]] champsim::address metadata_address(uint64_t key) const;
+  void charge_metadata_access(uint64_t key, const champsim::metadata_store::access_result& result);
+  void issue_metadata_reads();
+  bool finish_metadata_read(const response_type& packet);
+
 public:
+  constexpr static uint64_t metadata_region_entries = 1 << 24;
+  constexpr static champsim::data::bytes metadata_entry_size{4};
+  constexpr static champsim::data::bytes metadata_region_size{metadata_region_entries * metadata_entry_size.count()};
+
   std::vector<channel_type*> upper_levels;
   channel_type* lower_level;
   channel_type* lower_translate;
@@ -179,12 +311,21 @@ public:
   bool prefetch_as_load;
   bool match_offset_bits;
   bool virtual_prefetch;
+  bool write_allocate;
+  bool full_line_write_elision;
   std::vector<access_type> pref_activate_mask;
+  champsim::inclusion_policy inclusion = champsim::inclusion_policy::NINE;
 
   using stats_type = cache_stats;
 
   stats_type sim_stats, roi_stats;
 
+  uint32_t active_pf_source = 0;     // the position of the prefetcher module that is currently running, to attribute its prefetches
+  // The prefetches that each module has issued for the current triggering access, or in the current cycle, to clamp them to the throttled degree
+  std::vector<uint32_t> pf_activation_issued{};
+
+  std::optional<champsim::prefetch_throttle> pf_throttle{};
+
   std::deque<mshr_type> MSHR;
   std::deque<mshr_type> inflight_writes;
 
@@ -223,8 +364,41 @@ public:
   [[deprecated("This function should not be used to access the blocks directly.")]] [[nodiscard]] uint64_t get_way(uint64_t address, uint64_t set) const;
 
   long invalidate_entry(champsim::address inval_addr);
+
+  /**
+   * The way of the set that holds a valid copy of the block, or NUM_WAY if the block is not in the cache
+   */
+  [[nodiscard]] long lookup_way(champsim::address address);
+
   bool prefetch_line(champsim::address pf_addr, bool fill_this_level, uint32_t prefetch_metadata);
 
+  /**
+   * Whether this cache reserves ways for the metadata of temporal prefetchers
+   */
+  [[nodiscard]] bool has_metadata_store() const;
+
+  /**
+   * Look up an entry in the metadata store. Each access consumes tag bandwidth, and accesses that miss on chip may be sent to the lower level.
+   */
+  std::optional<uint64_t> metadata_read(uint64_t key);
+
+  /**
+   * Insert or replace an entry in the metadata store.
+   */
+  void metadata_write(uint64_t key, uint64_t value);
+
+  struct functional_result {
+    bool hit = false;
+    std::vector<BLOCK> evicted{};
+  };
+
+  /**
+   * Look up a block, and fill it on a miss, at once, without queues, bandwidth or latency. This is the cache model of functional warmup.
+   * The replacement state is updated as in the detailed model. If asked, the prefetcher is trained, and its prefetches are filled into this cache only.
+   * The blocks that left the cache are returned for the caller to pass to the lower level.
+   */
+  functional_result functional_access(const request_type& req, bool train_prefetcher);
+
   [[deprecated]] bool prefetch_line(uint64_t pf_addr, bool fill_this_level, uint32_t prefetch_metadata);
 
   [[deprecated("Use CACHE::prefetch_line(pf_addr, fill_this_level, prefetch_metadata) instead.")]] bool
@@ -247,6 +421,7 @@ public:
     virtual void impl_prefetcher_cycle_operate() = 0;
     virtual void impl_prefetcher_final_stats() = 0;
     virtual void impl_prefetcher_branch_operate(champsim::address ip, uint8_t branch_type, champsim::address branch_target) = 0;
+    [[nodiscard]] virtual std::vector<std::string> impl_prefetcher_names() const = 0;
   };
 
   struct replacement_module_concept {
@@ -256,7 +431,7 @@ public:
 
     virtual void impl_initialize_replacement() = 0;
     virtual long impl_find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, const BLOCK* current_set, champsim::address ip,
-                                  champsim::address full_addr, access_type type) = 0;
+                                  champsim::address full_addr, access_type type, uint64_t allowed_ways) = 0;
     virtual void impl_update_replacement_state(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
                                                champsim::address victim_addr, access_type type, bool hit) = 0;
     virtual void impl_replacement_cache_fill(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
@@ -267,12 +442,22 @@ public:
   template <typename... Ps>
   struct prefetcher_module_model final : prefetcher_module_concept {
     std::tuple<Ps...> intern_;
-    explicit prefetcher_module_model(CACHE* cache) : intern_(Ps{cache}...) { (void)cache; /* silence -Wunused-but-set-parameter when sizeof...(Ps) == 0 */ }
+    CACHE* cache_;
+    explicit prefetcher_module_model(CACHE* cache) : intern_(Ps{cache}...), cache_(cache) {}
     void bind(CACHE* cache)
     {
+      cache_ = cache;
       std::apply([cache = cache](auto&... p) { (..., p.bind(cache)); }, intern_);
     }
 
+    // The position of the module in the list of prefetchers
+    template <typename P>
+    [[nodiscard]] uint32_t position_of(const P& p) const;
+
+    // Mark the module as the source of any prefetches issued until the next module runs
+    template <typename P>
+    void activate(const P& p) const;
+
     void impl_prefetcher_initialize() final;
     [[nodiscard]] uint32_t impl_prefetcher_cache_operate(champsim::address addr, champsim::address ip, bool cache_hit, bool useful_prefetch, access_type type,
                                                          uint32_t metadata_in) final;
@@ -281,6 +466,7 @@ public:
     void impl_prefetcher_cycle_operate() final;
     void impl_prefetcher_final_stats() final;
     void impl_prefetcher_branch_operate(champsim::address ip, uint8_t branch_type, champsim::address branch_target) final;
+    [[nodiscard]] std::vector<std::string> impl_prefetcher_names() const final;
   };
 
   template <typename... Rs>
@@ -288,6 +474,11 @@ public:
     // Assert that at least one has an update state
     // static_assert(std::disjunction<champsim::is_detected<has_update_state, Rs>...>::value, "At least one replacement policy must update its state");
 
+    // Whether a module chooses its victims only among the ways that the cache allows
+    constexpr static bool restricts_ways = (champsim::modules::replacement::has_find_victim<Rs, uint32_t, uint64_t, long, const BLOCK*, champsim::address,
+                                                                                            champsim::address, access_type, uint64_t>
+                                            || ...);
+
     std::tuple<Rs...> intern_;
     explicit replacement_module_model(CACHE* cache) : intern_(Rs{cache}...) { (void)cache; /* silence -Wunused-but-set-parameter when sizeof...(Rs) == 0 */ }
     void bind(CACHE* cache)
@@ -297,7 +488,7 @@ public:
 
     void impl_initialize_replacement() final;
     [[nodiscard]] long impl_find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, const BLOCK* current_set, champsim::address ip,
-                                        champsim::address full_addr, access_type type) final;
+                                        champsim::address full_addr, access_type type, uint64_t allowed_ways) final;
     void impl_update_replacement_state(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
                                        champsim::address victim_addr, access_type type, bool hit) final;
     void impl_replacement_cache_fill(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
@@ -320,7 +511,8 @@ public:
 
   void impl_initialize_replacement() const;
   [[nodiscard]] long impl_find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, const BLOCK* current_set, champsim::address ip,
-                                      champsim::address full_addr, access_type type) const;
+                                      champsim::address full_addr, access_type type,
+                                      uint64_t allowed_ways = champsim::modules::replacement::all_ways) const;
   void impl_update_replacement_state(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
                                      champsim::address victim_addr, access_type type, bool hit) const;
   void impl_replacement_cache_fill(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
@@ -331,11 +523,58 @@ public:
   template <typename... Ps, typename... Rs>
   explicit CACHE(champsim::cache_builder<champsim::cache_builder_module_type_holder<Ps...>, champsim::cache_builder_module_type_holder<Rs...>> b)
       : champsim::operable(b.m_clock_period), upper_levels(b.m_uls), lower_level(b.m_ll), lower_translate(b.m_lt), NAME(b.m_name), NUM_SET(b.get_num_sets()),
-        NUM_WAY(b.get_num_ways()), MSHR_SIZE(b.get_num_mshrs()), PQ_SIZE(b.m_pq_size), HIT_LATENCY(b.get_hit_latency() * b.m_clock_period),
+        NUM_WAY(b.get_num_tag_ways()), MSHR_SIZE(b.get_num_mshrs()), PQ_SIZE(b.m_pq_size), HIT_LATENCY(b.get_hit_latency() * b.m_clock_period),
         FILL_LATENCY(b.get_fill_latency() * b.m_clock_period), OFFSET_BITS(b.m_offset_bits), MAX_TAG(b.get_tag_bandwidth()), MAX_FILL(b.get_fill_bandwidth()),
-        prefetch_as_load(b.m_pref_load), match_offset_bits(b.m_wq_full_addr), virtual_prefetch(b.m_va_pref), pref_activate_mask(b.m_pref_act_mask),
+        prefetch_as_load(b.m_pref_load), match_offset_bits(b.m_wq_full_addr), virtual_prefetch(b.m_va_pref), write_allocate(b.m_write_allocate),
+        full_line_write_elision(b.m_full_line_elision), pref_activate_mask(b.m_pref_act_mask),
         pref_module_pimpl(std::make_unique<prefetcher_module_model<Ps...>>(this)), repl_module_pimpl(std::make_unique<replacement_module_model<Rs...>>(this))
   {
+    evicted_unused_prefetch.resize(NUM_SET);
+    evicted_by_prefetch.resize(NUM_SET);
+    if (b.m_pf_filter_sets > 0)
+      prefetch_filter.emplace(b.m_pf_filter_sets, b.m_pf_filter_ways);
+    if (b.m_pf_throttle)
+      pf_throttle.emplace(b.m_pf_throttle_interval);
+    pf_components = std::max(sizeof...(Ps), std::size_t{1});
+    pf_activation_issued.resize(pf_components);
+    if (b.m_pf_arbitration.has_value())
+      pf_arbiter.emplace(*b.m_pf_arbitration, pf_components);
+    inclusion = b.m_inclusion;
+    if (inclusion == champsim::inclusion_policy::EXCLUSIVE && !write_allocate)
+      throw std::invalid_argument{"An exclusive cache must allocate the blocks written to it"};
+    if (b.m_directory_sets > 0) {
+      if (std::size(upper_levels) > champsim::coherence_directory::max_requesters)
+        throw std::invalid_argument{"The coherence directory tracks at most 64 upper levels"};
+      directory.emplace(b.m_directory_sets, b.m_directory_ways);
+      directory_requesters = upper_levels;
+    }
+    if (b.m_utility_partition && !std::empty(b.m_way_partition))
+      throw std::invalid_argument{"A cache may not have both a static and a utility-based way partition"};
+    if (b.m_utility_partition)
+      partition.emplace(NUM_SET, NUM_WAY, b.m_utility_partition_interval);
+    else if (!std::empty(b.m_way_partition))
+      partition.emplace(NUM_SET, NUM_WAY, b.m_way_partition);
+    if (partition.has_value() && !replacement_module_model<Rs...>::restricts_ways)
+      throw std::invalid_argument{"A cache with a way partition needs a replacement policy that chooses among the allowed ways"};
+    if (b.m_packed_tags)
+      packed_tags.emplace(NUM_SET, NUM_WAY);
+    if (b.is_compressed() && b.m_victim_cache_size > 0)
+      throw std::invalid_argument{"A compressed cache may not have a victim cache"};
+    if (b.is_compressed() && NUM_WAY > std::numeric_limits<uint64_t>::digits)
+      throw std::invalid_argument{"A compressed cache may have at most 64 tag ways"};
+    if (b.is_compressed()) {
+      compression.emplace(b.m_compression_model, b.m_compression_size_file, OFFSET_BITS);
+      data_segments_per_set = b.get_num_data_ways() * compression->block_segments();
+    }
+    if (b.m_victim_cache_size > 0)
+      victims.emplace(b.m_victim_cache_size, OFFSET_BITS);
+    if (b.m_write_combining_size > 0)
+      write_combiner.emplace(b.m_write_combining_size, OFFSET_BITS);
+    if (b.m_metadata_ways > 0)
+      pf_metadata_store.emplace(NUM_SET, b.m_metadata_ways, b.m_metadata_entries_per_block, b.m_metadata_offchip);
+    if (b.m_metadata_ways > 0 && b.m_metadata_offchip && !b.m_metadata_region.has_value())
+      throw std::invalid_argument{"An off-chip metadata store must be given a reserved region of memory"};
+    metadata_region = b.m_metadata_region;
   }
 
   CACHE(const CACHE&) = delete;
@@ -365,22 +604,32 @@ uint32_t CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_cache_operate(ch
   using return_type = uint32_t;
   [[maybe_unused]] auto process_one = [&](auto& p) {
     using namespace champsim::modules;
+    activate(p);
+
+    // Each module sees only its own slice of the metadata, and is told a prefetch was useful only if it issued that prefetch.
+    // Metadata from another level may be divided differently, so it is given whole to each module.
+    const auto position = position_of(p);
+    const auto slice_in = cache_->pf_metadata_sliced ? champsim::get_metadata_slice(metadata_in, position, sizeof...(Ps)) : metadata_in;
+    const auto useful_to_this = useful_prefetch && (sizeof...(Ps) == 1 || cache_->useful_pf_source == position);
+    auto slice_out = return_type{};
+
     /* Strong addresses */
     if constexpr (prefetcher::has_cache_operate<decltype(p), champsim::address, champsim::address, bool, bool, access_type, uint32_t>)
-      return return_type{p.prefetcher_cache_operate(addr, ip, cache_hit, useful_prefetch, type, metadata_in)};
+      slice_out = return_type{p.prefetcher_cache_operate(addr, ip, cache_hit, useful_to_this, type, slice_in)};
 
     /* Strong addresses, raw integer access type */
-    if constexpr (prefetcher::has_cache_operate<decltype(p), champsim::address, champsim::address, bool, bool, std::underlying_type_t<access_type>, uint32_t>)
-      return return_type{p.prefetcher_cache_operate(addr, ip, cache_hit, useful_prefetch, champsim::to_underlying(type), metadata_in)};
+    else if constexpr (prefetcher::has_cache_operate<decltype(p), champsim::address, champsim::address, bool, bool, std::underlying_type_t<access_type>,
+                                                     uint32_t>)
+      slice_out = return_type{p.prefetcher_cache_operate(addr, ip, cache_hit, useful_to_this, champsim::to_underlying(type), slice_in)};
 
     /* Raw integer addresses, no useful_prefetch parameter, raw integer access type */
-    if constexpr (prefetcher::has_cache_operate<decltype(p), uint64_t, uint64_t, bool, std::underlying_type_t<access_type>, uint32_t>)
-      return return_type{p.prefetcher_cache_operate(addr.to<uint64_t>(), ip.to<uint64_t>(), cache_hit, champsim::to_underlying(type), metadata_in)};
+    else if constexpr (prefetcher::has_cache_operate<decltype(p), uint64_t, uint64_t, bool, std::underlying_type_t<access_type>, uint32_t>)
+      slice_out = return_type{p.prefetcher_cache_operate(addr.to<uint64_t>(), ip.to<uint64_t>(), cache_hit, champsim::to_underlying(type), slice_in)};
 
-    return return_type{};
+    return champsim::set_metadata_slice(return_type{}, slice_out, position, sizeof...(Ps));
   };
 
-  return std::apply([&](auto&... p) { return (return_type{} ^ ... ^ process_one(p)); }, intern_);
+  return std::apply([&](auto&... p) { return (return_type{} | ... | process_one(p)); }, intern_);
 }
 
 template <typename... Ps>
@@ -390,14 +639,19 @@ uint32_t CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_cache_fill(champ
   using return_type = uint32_t;
   [[maybe_unused]] auto process_one = [&](auto& p) {
     using namespace champsim::modules;
+    activate(p);
+
+    const auto position = position_of(p);
+    const auto slice_in = cache_->pf_metadata_sliced ? champsim::get_metadata_slice(metadata_in, position, sizeof...(Ps)) : metadata_in;
+    auto slice_out = return_type{};
     if constexpr (prefetcher::has_cache_fill<decltype(p), champsim::address, long, long, bool, champsim::address, uint32_t>)
-      return return_type{p.prefetcher_cache_fill(addr, set, way, prefetch, evicted_addr, metadata_in)};
-    if constexpr (prefetcher::has_cache_fill<decltype(p), uint64_t, long, long, bool, uint64_t, uint32_t>)
-      return return_type{p.prefetcher_cache_fill(addr.to<uint64_t>(), set, way, prefetch, evicted_addr.to<uint64_t>(), metadata_in)};
-    return return_type{};
+      slice_out = return_type{p.prefetcher_cache_fill(addr, set, way, prefetch, evicted_addr, slice_in)};
+    else if constexpr (prefetcher::has_cache_fill<decltype(p), uint64_t, long, long, bool, uint64_t, uint32_t>)
+      slice_out = return_type{p.prefetcher_cache_fill(addr.to<uint64_t>(), set, way, prefetch, evicted_addr.to<uint64_t>(), slice_in)};
+    return champsim::set_metadata_slice(return_type{}, slice_out, position, sizeof...(Ps));
   };
 
-  return std::apply([&](auto&... p) { return (return_type{} ^ ... ^ process_one(p)); }, intern_);
+  return std::apply([&](auto&... p) { return (return_type{} | ... | process_one(p)); }, intern_);
 }
 
 template <typename... Ps>
@@ -405,6 +659,7 @@ void CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_cycle_operate()
 {
   [[maybe_unused]] auto process_one = [&](auto& p) {
     using namespace champsim::modules;
+    activate(p);
     if constexpr (prefetcher::has_cycle_operate<decltype(p)>)
       p.prefetcher_cycle_operate();
   };
@@ -429,6 +684,7 @@ void CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_branch_operate(champ
 {
   [[maybe_unused]] auto process_one = [&](auto& p) {
     using namespace champsim::modules;
+    activate(p);
     if constexpr (prefetcher::has_branch_operate<decltype(p), champsim::address, uint8_t, champsim::address>)
       p.prefetcher_branch_operate(ip, branch_type, branch_target);
     if constexpr (prefetcher::has_branch_operate<decltype(p), uint64_t, uint8_t, uint64_t>)
@@ -438,6 +694,35 @@ void CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_branch_operate(champ
   std::apply([&](auto&... p) { (..., process_one(p)); }, intern_);
 }
 
+template <typename... Ps>
+template <typename P>
+uint32_t CACHE::prefetcher_module_model<Ps...>::position_of(const P& p) const
+{
+  uint32_t position = 0;
+  bool found = false;
+  auto count_until = [&](const void* q) {
+    found = found || (q == static_cast<const void*>(&p));
+    if (!found)
+      ++position;
+  };
+
+  std::apply([&](const auto&... q) { (..., count_until(&q)); }, intern_);
+  return position;
+}
+
+template <typename... Ps>
+template <typename P>
+void CACHE::prefetcher_module_model<Ps...>::activate(const P& p) const
+{
+  cache_->active_pf_source = position_of(p);
+}
+
+template <typename... Ps>
+std::vector<std::string> CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_names() const
+{
+  return {champsim::type_name<Ps>()...};
+}
+
 template <typename... Rs>
 void CACHE::replacement_module_model<Rs...>::impl_initialize_replacement()
 {
@@ -452,12 +737,17 @@ void CACHE::replacement_module_model<Rs...>::impl_initialize_replacement()
 
 template <typename... Rs>
 long CACHE::replacement_module_model<Rs...>::impl_find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, const BLOCK* current_set,
-                                                              champsim::address ip, champsim::address full_addr, access_type type)
+                                                              champsim::address ip, champsim::address full_addr, access_type type, uint64_t allowed_ways)
 {
   using return_type = long;
   [[maybe_unused]] auto process_one = [&](auto& r) {
     using namespace champsim::modules;
 
+    /* Strong addresses, restricted to the allowed ways */
+    if constexpr (replacement::has_find_victim<decltype(r), uint32_t, uint64_t, long, const BLOCK*, champsim::address, champsim::address, access_type,
+                                               uint64_t>)
+      return return_type{r.find_victim(triggering_cpu, instr_id, set, current_set, ip, full_addr, type, allowed_ways)};
+
     /* Strong addresses */
     if constexpr (replacement::has_find_victim<decltype(r), uint32_t, uint64_t, long, const BLOCK*, champsim::address, champsim::address, access_type>)
       return return_type{r.find_victim(triggering_cpu, instr_id, set, current_set, ip, full_addr, type)};
@@ -22,10 +22,15 @@
 #include <cstdint>
 #include <limits>
 #include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "champsim.h"
 #include "channel.h"
 #include "chrono.h"
+#include "prefetch_ensemble.h"
+#include "prefetch_throttle.h"
 #include "util/bits.h"
 #include "util/to_underlying.h"
 
@@ -33,6 +38,16 @@ class CACHE;
 namespace champsim
 {
 class channel;
+
+/**
+ * How the contents of a cache relate to the contents of the caches above it
+ */
+enum class inclusion_policy {
+  NINE,      // neither inclusive nor exclusive: blocks are filled at every level, and evicted independently
+  INCLUSIVE, // every block above is also here: evicting a block invalidates it above
+  EXCLUSIVE  // no block above is also here: blocks move up on a hit, and blocks evicted above are filled here
+};
+
 template <typename... Ts>
 class cache_builder_module_type_holder
 {
@@ -47,6 +62,27 @@ struct cache_builder_base {
   double m_sets_factor{64};
   std::optional<uint32_t> m_ways{};
   std::size_t m_pq_size{std::numeric_limits<std::size_t>::max()};
+  uint32_t m_pf_filter_sets{};
+  uint32_t m_pf_filter_ways{4};
+  bool m_pf_throttle{};
+  uint64_t m_pf_throttle_interval{champsim::prefetch_throttle::default_interval};
+  std::optional<champsim::prefetch_arbiter::policy> m_pf_arbitration{};
+  bool m_packed_tags{};
+  champsim::inclusion_policy m_inclusion{champsim::inclusion_policy::NINE};
+  uint32_t m_directory_sets{};
+  uint32_t m_directory_ways{16};
+  std::size_t m_victim_cache_size{};
+  std::size_t m_write_combining_size{};
+  std::string m_compression_model{};
+  std::string m_compression_size_file{};
+  uint32_t m_compression_tag_factor{2};
+  std::vector<uint64_t> m_way_partition{};
+  bool m_utility_partition{};
+  uint64_t m_utility_partition_interval{1000000};
+  uint32_t m_metadata_ways{};
+  uint32_t m_metadata_entries_per_block{16};
+  bool m_metadata_offchip{};
+  std::optional<champsim::address> m_metadata_region{};
   std::optional<uint32_t> m_mshr_size{};
   std::optional<uint64_t> m_hit_lat{};
   std::optional<uint64_t> m_fill_lat{};
@@ -57,6 +93,8 @@ struct cache_builder_base {
   bool m_pref_load{};
   bool m_wq_full_addr{};
   bool m_va_pref{};
+  bool m_write_allocate{true};
+  bool m_full_line_elision{};
 
   std::vector<access_type> m_pref_act_mask{access_type::LOAD, access_type::PREFETCH};
   std::vector<champsim::channel*> m_uls{};
@@ -81,6 +119,9 @@ class cache_builder : public detail::cache_builder_base
 
   uint32_t get_num_sets() const;
   uint32_t get_num_ways() const;
+  uint32_t get_num_data_ways() const;
+  uint32_t get_num_tag_ways() const;
+  bool is_compressed() const;
   uint32_t get_num_mshrs() const;
   champsim::bandwidth::maximum_type get_tag_bandwidth() const;
   champsim::bandwidth::maximum_type get_fill_bandwidth() const;
@@ -140,6 +181,160 @@ public:
    */
   self_type& pq_size(uint32_t pq_size_);
 
+  /**
+   * Specify the number of sets in the filter of recently prefetched and filled blocks, which drops redundant prefetches before they enter the internal prefetch queue.
+   * The filter is disabled if this is zero, which is the default.
+   */
+  self_type& prefetch_filter_sets(uint32_t pf_filter_sets_);
+
+  /**
+   * Specify the number of ways in the prefetch filter.
+   */
+  self_type& prefetch_filter_ways(uint32_t pf_filter_ways_);
+
+  /**
+   * Specify that the cache should throttle its prefetchers by their accuracy, lateness, and pollution, and by the DRAM bandwidth.
+   */
+  self_type& set_prefetch_throttle();
+
+  /**
+   * Specify that the cache should not throttle its prefetchers.
+   */
+  self_type& reset_prefetch_throttle();
+
+  /**
+   * Specify the number of evictions between adjustments of the prefetch throttle.
+   */
+  self_type& prefetch_throttle_interval(uint64_t pf_throttle_interval_);
+
+  /**
+   * Specify that the prefetches of the cache's prefetchers should compete for the internal prefetch queue under the given policy.
+   * If this is not specified, prefetches enter the queue in the order they are issued.
+   */
+  self_type& prefetch_arbitration(champsim::prefetch_arbiter::policy pf_arbitration_);
+
+  /**
+   * Specify the relationship between the contents of the cache and the contents of the caches above it.
+   * If this is not specified, the cache is neither inclusive nor exclusive.
+   */
+  self_type& inclusion(champsim::inclusion_policy inclusion_);
+
+  /**
+   * Specify the number of sets in the coherence directory, which tracks the copies of blocks held by the upper levels.
+   * The directory is disabled if this is zero, which is the default.
+   */
+  self_type& directory_sets(uint32_t directory_sets_);
+
+  /**
+   * Specify the number of ways in the coherence directory.
+   */
+  self_type& directory_ways(uint32_t directory_ways_);
+
+  /**
+   * Specify the number of blocks in the victim cache, which keeps the most recently evicted blocks to serve conflict misses.
+   * The victim cache is disabled if this is zero, which is the default.
+   */
+  self_type& victim_cache_size(std::size_t victim_cache_size_);
+
+  /**
+   * Specify the number of blocks in the write-combining buffer, which holds writebacks on their way to the lower level and combines those to the same block.
+   * The buffer is disabled if this is zero, which is the default.
+   */
+  self_type& write_combining_buffer_size(std::size_t write_combining_size_);
+
+  /**
+   * Specify that the cache should store its blocks compressed, with sizes drawn from the named model ("bdi" or "fpc").
+   * The data array keeps the capacity given by the size and ways, but each set holds more tags, so that it can hold more blocks than ways.
+   */
+  self_type& compression_model(std::string compression_model_);
+
+  /**
+   * Specify a file of compressed block sizes, one ``<block address> <bytes>`` line per block, that overrides the compression model.
+   */
+  self_type& compression_size_file(std::string compression_size_file_);
+
+  /**
+   * Specify how many tags a compressed cache keeps in each set, as a multiple of its ways.
+   */
+  self_type& compression_tag_factor(uint32_t compression_tag_factor_);
+
+  /**
+   * Specify a static partition of the ways among the cores. Core i may only fill the ways set in the i-th mask, though it may hit in any way.
+   */
+  self_type& way_partition(std::vector<uint64_t> way_partition_);
+
+  /**
+   * Specify that the ways should be partitioned among the cores by their utility, as measured by utility monitors.
+   */
+  self_type& set_utility_partition();
+
+  /**
+   * Specify that the ways should not be partitioned by utility. This is the default.
+   */
+  self_type& reset_utility_partition();
+
+  /**
+   * Specify the number of monitored accesses between utility-based repartitions.
+   */
+  self_type& utility_partition_interval(uint64_t utility_partition_interval_);
+
+  /**
+   * Specify that the cache should keep a packed copy of its tags, for faster lookup.
+   */
+  self_type& set_packed_tags();
+
+  /**
+   * Specify that the cache should look up its tags in the blocks themselves. This is the default.
+   */
+  self_type& reset_packed_tags();
+
+  /**
+   * Specify the number of ways of each set to reserve for the metadata of temporal prefetchers. These ways are not available to data.
+   * The metadata store is disabled if this is zero, which is the default.
+   */
+  self_type& metadata_ways(uint32_t metadata_ways_);
+
+  /**
+   * Specify the number of metadata entries that fit in each reserved block.
+   */
+  self_type& metadata_entries_per_block(uint32_t metadata_entries_per_block_);
+
+  /**
+   * Specify that metadata evicted from the reserved ways should be written back to the lower level, and read back from it on a miss.
+   */
+  self_type& set_metadata_offchip();
+
+  /**
+   * Specify that metadata evicted from the reserved ways should be dropped.
+   */
+  self_type& reset_metadata_offchip();
+
+  /**
+   * Specify the base of the physical memory that holds the off-chip metadata. This range must be reserved from the virtual memory system.
+   * An off-chip metadata store requires this.
+   */
+  self_type& metadata_region(champsim::address metadata_region_);
+
+  /**
+   * Specify that writes that miss should allocate the block. This is the default.
+   */
+  self_type& set_write_allocate();
+
+  /**
+   * Specify that writes that miss should be sent on to the lower level without allocating the block.
+   */
+  self_type& reset_write_allocate();
+
+  /**
+   * Specify that stores that write a whole block and miss should be filled at once, without reading the block for ownership.
+   */
+  self_type& set_full_line_write_elision();
+
+  /**
+   * Specify that every store that misses should read the block for ownership. This is the default.
+   */
+  self_type& reset_full_line_write_elision();
+
   /**
    * Specify the number of MSHRs.
    * If this is not specified, it will be derived from the number of sets, fill latency, and fill bandwidth.
@@ -270,6 +465,31 @@ auto champsim::cache_builder<P, R>::get_num_ways() const -> uint32_t
   return 1;
 }
 
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::get_num_data_ways() const -> uint32_t
+{
+  auto ways = get_num_ways();
+  if (m_metadata_ways >= ways)
+    throw std::invalid_argument{"The metadata ways must leave at least one way for data"};
+  return ways - m_metadata_ways;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::is_compressed() const -> bool
+{
+  return !std::empty(m_compression_model) || !std::empty(m_compression_size_file);
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::get_num_tag_ways() const -> uint32_t
+{
+  if (!is_compressed())
+    return get_num_data_ways();
+  if (m_compression_tag_factor == 0)
+    throw std::invalid_argument{"A compressed cache must keep at least one tag per way"};
+  return get_num_data_ways() * m_compression_tag_factor;
+}
+
 template <typename P, typename R>
 auto champsim::cache_builder<P, R>::get_num_mshrs() const -> uint32_t
 {
@@ -388,6 +608,209 @@ auto champsim::cache_builder<P, R>::pq_size(uint32_t pq_size_) -> self_type&
   return *this;
 }
 
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::prefetch_filter_sets(uint32_t pf_filter_sets_) -> self_type&
+{
+  m_pf_filter_sets = pf_filter_sets_;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::prefetch_filter_ways(uint32_t pf_filter_ways_) -> self_type&
+{
+  m_pf_filter_ways = pf_filter_ways_;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::set_prefetch_throttle() -> self_type&
+{
+  m_pf_throttle = true;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::reset_prefetch_throttle() -> self_type&
+{
+  m_pf_throttle = false;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::prefetch_throttle_interval(uint64_t pf_throttle_interval_) -> self_type&
+{
+  m_pf_throttle_interval = pf_throttle_interval_;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::prefetch_arbitration(champsim::prefetch_arbiter::policy pf_arbitration_) -> self_type&
+{
+  m_pf_arbitration = pf_arbitration_;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::inclusion(champsim::inclusion_policy inclusion_) -> self_type&
+{
+  m_inclusion = inclusion_;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::directory_sets(uint32_t directory_sets_) -> self_type&
+{
+  m_directory_sets = directory_sets_;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::directory_ways(uint32_t directory_ways_) -> self_type&
+{
+  m_directory_ways = directory_ways_;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::victim_cache_size(std::size_t victim_cache_size_) -> self_type&
+{
+  m_victim_cache_size = victim_cache_size_;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::write_combining_buffer_size(std::size_t write_combining_size_) -> self_type&
+{
+  m_write_combining_size = write_combining_size_;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::compression_model(std::string compression_model_) -> self_type&
+{
+  m_compression_model = compression_model_;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::compression_size_file(std::string compression_size_file_) -> self_type&
+{
+  m_compression_size_file = compression_size_file_;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::compression_tag_factor(uint32_t compression_tag_factor_) -> self_type&
+{
+  m_compression_tag_factor = compression_tag_factor_;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::way_partition(std::vector<uint64_t> way_partition_) -> self_type&
+{
+  m_way_partition = way_partition_;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::set_utility_partition() -> self_type&
+{
+  m_utility_partition = true;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::reset_utility_partition() -> self_type&
+{
+  m_utility_partition = false;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::utility_partition_interval(uint64_t utility_partition_interval_) -> self_type&
+{
+  m_utility_partition_interval = utility_partition_interval_;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::set_packed_tags() -> self_type&
+{
+  m_packed_tags = true;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::reset_packed_tags() -> self_type&
+{
+  m_packed_tags = false;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::metadata_ways(uint32_t metadata_ways_) -> self_type&
+{
+  m_metadata_ways = metadata_ways_;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::metadata_entries_per_block(uint32_t metadata_entries_per_block_) -> self_type&
+{
+  m_metadata_entries_per_block = metadata_entries_per_block_;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::set_metadata_offchip() -> self_type&
+{
+  m_metadata_offchip = true;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::reset_metadata_offchip() -> self_type&
+{
+  m_metadata_offchip = false;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::metadata_region(champsim::address metadata_region_) -> self_type&
+{
+  m_metadata_region = metadata_region_;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::set_write_allocate() -> self_type&
+{
+  m_write_allocate = true;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::reset_write_allocate() -> self_type&
+{
+  m_write_allocate = false;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::set_full_line_write_elision() -> self_type&
+{
+  m_full_line_elision = true;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::reset_full_line_write_elision() -> self_type&
+{
+  m_full_line_elision = false;
+  return *this;
+}
+
 template <typename P, typename R>
 auto champsim::cache_builder<P, R>::mshr_size(uint32_t mshr_size_) -> self_type&
 {
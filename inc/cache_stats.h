@@ -1,22 +1,84 @@
 #ifndef CACHE_STATS_H
 #define CACHE_STATS_H
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "channel.h"
 #include "event_counter.h"
 
+/**
+ * The prefetches attributed to one prefetcher module, when several are combined in one cache
+ */
+struct prefetch_source_stats {
+  std::string name;
+  uint64_t issued = 0;
+  uint64_t useful = 0;
+  uint64_t late = 0;
+  uint64_t useless = 0;
+};
+
 struct cache_stats {
   std::string name;
   // prefetch stats
   uint64_t pf_requested = 0;
   uint64_t pf_issued = 0;
   uint64_t pf_useful = 0;
+  uint64_t pf_timely = 0; // useful prefetches that were filled before the demand arrived
+  uint64_t pf_late = 0;   // useful prefetches that were still in flight when the demand arrived
+  uint64_t pf_early = 0;  // demand misses to a block whose prefetch was evicted from the set unused
   uint64_t pf_useless = 0;
   uint64_t pf_fill = 0;
+  uint64_t pf_filtered_duplicate = 0;  // prefetches dropped because the block was recently prefetched
+  uint64_t pf_filtered_resident = 0;   // prefetches dropped because the block is in the cache
+  uint64_t pf_throttled = 0;           // prefetches dropped because the prefetcher exceeded the throttled degree
+  uint64_t pf_polluting_misses = 0;    // demand misses to a block that was evicted to make room for a prefetch
+  uint64_t pf_arbitration_dropped = 0; // prefetches that lost arbitration for the internal prefetch queue
+
+  uint64_t back_invalidations = 0; // blocks evicted from this inclusive cache, and so invalidated above
+  uint64_t back_invalidated = 0;   // blocks that this cache lost to a back-invalidation from below
+  uint64_t victim_fills = 0;       // blocks evicted above and filled into this exclusive cache
+
+  uint64_t coherence_misses = 0;        // misses to blocks that were invalidated above by another upper level's write
+  uint64_t coherence_invalidations = 0; // invalidations that the coherence directory sent to the upper levels
+  uint64_t coherence_downgrades = 0;    // downgrades that the coherence directory sent to the upper levels
+  uint64_t directory_evictions = 0;     // directory entries replaced, whose sharers were invalidated
+  uint64_t coherence_upgrades = 0;      // stores that hit a block held shared, and so asked the directory below for ownership
+
+  uint64_t victim_cache_hits = 0;       // misses served by swapping the block back from the victim cache
+  uint64_t victim_cache_writebacks = 0; // blocks displaced from the victim cache and written back
+  uint64_t wcb_writes = 0;              // writebacks that entered the write-combining buffer
+  uint64_t wcb_combined = 0;            // writebacks combined with one already in the write-combining buffer
+
+  uint64_t compressed_fills = 0;      // blocks filled into a compressed cache
+  uint64_t compressed_fill_bytes = 0; // the compressed size of those blocks, before rounding to segments
+  uint64_t compression_evictions = 0; // blocks evicted beyond the victim, to make room in the data array
+  uint64_t resident_blocks = 0;       // valid blocks in a compressed cache, at the end of the phase
+  uint64_t capacity_blocks = 0;       // the uncompressed blocks that fit in the data array of a compressed cache
+
+  uint64_t rfo_elided = 0;           // full-line stores that missed and were filled without reading the block for ownership
+  uint64_t writes_not_allocated = 0; // writes that missed and were sent on to the lower level without allocating
+
+  std::vector<uint64_t> occupancy{};      // per core, the valid blocks that its requests filled, at the end of the phase
+  std::vector<uint64_t> partition_ways{}; // per core, the ways it may fill, at the end of the phase
+  uint64_t repartitions = 0;              // utility-based repartitions since the start of the simulation
+
+  uint64_t metadata_reads = 0;
+  uint64_t metadata_read_hits = 0;
+  uint64_t metadata_writes = 0;
+  uint64_t metadata_evictions = 0;
+  uint64_t metadata_offchip_reads = 0;  // metadata reads sent to the lower level
+  uint64_t metadata_offchip_writes = 0; // evicted metadata written to the lower level
+
+  // Cycles between a prefetch fill and the first demand hit, bucketed by powers of two.
+  // Bucket k holds distances in [2^(k-1), 2^k), and bucket 0 holds distances of zero.
+  champsim::stats::event_counter<std::size_t> pf_fill_to_use = {};
+
+  std::vector<prefetch_source_stats> pf_sources = {}; // indexed by the position of the module in the cache's prefetcher list
 
   champsim::stats::event_counter<std::pair<access_type, std::remove_cv_t<decltype(NUM_CPUS)>>> hits = {};
   champsim::stats::event_counter<std::pair<access_type, std::remove_cv_t<decltype(NUM_CPUS)>>> misses = {};
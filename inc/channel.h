@@ -53,6 +53,8 @@ class channel
     bool forward_checked = false;
     bool is_translated = true;
     bool response_requested = true;
+    bool clean_victim = false; // a write of a block that was evicted clean, sent only to an exclusive lower level
+    bool full_line = false;    // a write of every word of the block, which need not read the block first
 
     uint8_t asid[2] = {std::numeric_limits<uint8_t>::max(), std::numeric_limits<uint8_t>::max()};
     access_type type{access_type::LOAD};
@@ -77,6 +79,10 @@ class channel
     uint32_t pf_metadata = 0;
     std::vector<uint64_t> instr_depend_on_me{};
 
+    // The number of caches that missed before this response was found, and whether its translation required a page walk
+    uint8_t miss_depth = 0;
+    bool page_walked = false;
+
     response(champsim::address addr, champsim::address v_addr, champsim::address data_, uint32_t pf_meta, std::vector<uint64_t> deps)
         : address(addr), v_address(v_addr), data(data_), pf_metadata(pf_meta), instr_depend_on_me(deps)
     {
@@ -101,6 +107,21 @@ public:
   std::deque<request_type> RQ{}, PQ{}, WQ{};
   std::deque<response_type> returned{};
 
+  // Back-invalidations from the lower level, for the upper level to apply to its own copies
+  std::deque<champsim::address> invalidations{};
+
+  // Coherence downgrades from the lower level, for the upper level to write back its dirty copies
+  std::deque<champsim::address> downgrades{};
+
+  // Set by a cache above this channel, so that back-invalidations are sent only where a copy may be kept
+  bool upper_holds_copies = false;
+
+  // Set by an exclusive cache below this channel, so that blocks evicted clean above are sent down as well as dirty ones
+  bool lower_is_exclusive = false;
+
+  // Set by a cache below this channel that has a coherence directory, or is above one, so that stores to blocks held shared ask for ownership
+  bool lower_tracks_ownership = false;
+
   stats_type sim_stats{}, roi_stats{};
 
   channel() = default;
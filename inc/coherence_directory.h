@@ -0,0 +1,83 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COHERENCE_DIRECTORY_H
+#define COHERENCE_DIRECTORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "msl/lru_table.h"
+
+namespace champsim
+{
+/**
+ * A sparse directory for the MESI protocol, attached to a shared cache.
+ *
+ * Each entry records which of the upper levels (requesters) may hold a block, and which one, if any, holds it exclusively (in the E or M state).
+ * A read by a requester downgrades an exclusive copy held by another requester to shared. A read for ownership invalidates the copies of every
+ * other requester. Requesters that lose a copy this way are remembered, so that their next miss to the block is counted as a coherence miss.
+ *
+ * The directory has a fixed number of entries. When an entry is replaced, the copies of its sharers must be invalidated, so that no block is
+ * held above without being tracked.
+ *
+ * The upper levels do not report the blocks they evict clean, and a writeback gives up only ownership. The recorded sharers are therefore a
+ * superset of the copies actually held above. An invalidation or downgrade sent for a copy that is already gone finds nothing, but is counted.
+ */
+class coherence_directory
+{
+public:
+  using mask_type = uint64_t;
+  constexpr static std::size_t max_requesters = 64;
+
+private:
+  struct entry_type {
+    uint64_t block;
+    mask_type sharers = 0;
+    mask_type lost = 0; // requesters whose copies were invalidated by another requester's write
+    std::optional<std::size_t> owner{};
+
+    [[nodiscard]] auto index() const { return block; }
+    [[nodiscard]] auto tag() const { return block; }
+  };
+
+  champsim::msl::lru_table<entry_type> entries;
+
+public:
+  struct action {
+    mask_type invalidate = 0;      // requesters whose copies must be invalidated
+    mask_type downgrade = 0;       // requesters whose exclusive copies must be downgraded to shared
+    bool coherence_miss = false;   // the requester lost its copy to another requester's write
+    std::optional<uint64_t> evicted_block{};
+    mask_type evicted_sharers = 0; // requesters whose copies of the evicted block must be invalidated
+  };
+
+  coherence_directory(std::size_t sets, std::size_t ways);
+
+  /**
+   * Record a request by the given requester for a block, either to read it or to own it
+   */
+  action access(uint64_t block, std::size_t requester, bool exclusive);
+
+  /**
+   * Record that the given requester has written back its copy of a block
+   */
+  void writeback(uint64_t block, std::size_t requester);
+};
+} // namespace champsim
+
+#endif
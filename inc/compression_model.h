@@ -0,0 +1,91 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef COMPRESSION_MODEL_H
+#define COMPRESSION_MODEL_H
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "address.h"
+#include "util/units.h"
+
+namespace champsim
+{
+/**
+ * The compressed size of each block of a compressed cache.
+ *
+ * The traces carry no data values, so the size of a block is drawn from a distribution of size classes, in the manner of a compression algorithm.
+ * The draw hashes the block address, so a block has the same size each time it is filled. Sizes may instead be read from a side file
+ * of ``<block address> <bytes>`` lines, with the address in hexadecimal; blocks that the file does not list are drawn from the distribution.
+ * Sizes are rounded up to whole segments of the data array.
+ */
+class compression_model
+{
+public:
+  struct size_class {
+    uint32_t bytes;
+    uint32_t weight;
+  };
+
+  constexpr static uint32_t segment_size = 8; // bytes
+
+  /**
+   * Base-Delta-Immediate (Pekhimenko et al., PACT 2012): zero and repeated-value blocks, then each base and delta width, then uncompressed blocks
+   */
+  static std::vector<size_class> bdi_classes();
+
+  /**
+   * Frequent Pattern Compression (Alameldeen and Wood, 2004), in steps of one segment
+   */
+  static std::vector<size_class> fpc_classes();
+
+  /**
+   * Every block is stored uncompressed
+   */
+  static std::vector<size_class> uncompressed_classes();
+
+  compression_model(std::vector<size_class> classes, champsim::data::bits offset_bits);
+  compression_model(const std::string& model_name, const std::string& size_file, champsim::data::bits offset_bits);
+
+  void read_sizes(std::istream& stream);
+
+  /**
+   * The size of the block, in bytes, as it would be compressed
+   */
+  [[nodiscard]] uint32_t compressed_size(champsim::address address) const;
+
+  /**
+   * The segments of the data array that the block occupies
+   */
+  [[nodiscard]] uint32_t segments(champsim::address address) const;
+
+  [[nodiscard]] uint32_t block_size() const;
+  [[nodiscard]] uint32_t block_segments() const;
+
+private:
+  std::vector<size_class> classes;
+  uint32_t total_weight = 0;
+  champsim::data::bits offset_bits;
+  std::unordered_map<uint64_t, uint32_t> file_sizes{};
+};
+} // namespace champsim
+
+#endif
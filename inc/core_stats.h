@@ -1,12 +1,29 @@
 #ifndef CORE_STATS_H
 #define CORE_STATS_H
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <string_view>
 
 #include "event_counter.h"
 #include "instruction.h"
 
+/**
+ * The reasons a cycle may pass without retiring any instruction.
+ *
+ * FRONTEND and BAD_SPECULATION cycles find the ROB empty, the latter while fetch is halted for a branch misprediction.
+ * CORE cycles find the head of the ROB unexecuted, or executing.
+ * The remaining types find the head of the ROB waiting on a load, and are distinguished by where the load was serviced:
+ * TRANSLATION if its address translation required a page walk, otherwise by how many caches it missed (L1 for none, DRAM for three or more).
+ */
+enum class stall_type { FRONTEND, BAD_SPECULATION, CORE, TRANSLATION, L1, L2, L3, DRAM, NUM_TYPES };
+
+using namespace std::literals::string_view_literals;
+inline constexpr std::array<std::string_view, static_cast<std::size_t>(stall_type::NUM_TYPES)> stall_type_names{
+    "FRONTEND"sv, "BAD_SPECULATION"sv, "CORE"sv, "TRANSLATION"sv, "L1"sv, "L2"sv, "L3"sv, "DRAM"sv};
+
 struct cpu_stats {
   std::string name;
   long long begin_instrs = 0;
@@ -15,9 +32,22 @@ struct cpu_stats {
   long long end_cycles = 0;
   uint64_t total_rob_occupancy_at_branch_mispredict = 0;
 
+  uint64_t memory_dependences_predicted = 0;
+  uint64_t memory_dependences_false = 0;
+  uint64_t memory_order_violations = 0;
+
+  uint64_t stores_coalesced = 0; // committed stores merged into a store buffer entry for the same block
+  uint64_t full_line_stores = 0; // store buffer entries that wrote every word of their block
+
   champsim::stats::event_counter<branch_type> total_branch_types = {};
   champsim::stats::event_counter<branch_type> branch_type_misses = {};
 
+  champsim::stats::event_counter<stall_type> retire_stall_cycles = {};
+
+  uint64_t btb_lookups = 0;
+  uint64_t btb_bubble_cycles = 0;
+  champsim::stats::event_counter<std::size_t> btb_level_hits = {}; // indexed by the BTB level that provided the target
+
   [[nodiscard]] auto instrs() const { return end_instrs - begin_instrs; }
   [[nodiscard]] auto cycles() const { return end_cycles - begin_cycles; }
 };
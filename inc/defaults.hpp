@@ -27,7 +27,7 @@
 
 namespace champsim::defaults
 {
-const auto default_core =
+constexpr auto default_core =
     champsim::core_builder<champsim::core_builder_module_type_holder<hashed_perceptron>, champsim::core_builder_module_type_holder<basic_btb>>{}
         .dib_set(32)
         .dib_way(8)
@@ -0,0 +1,89 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIXED_CORE_H
+#define FIXED_CORE_H
+
+#include <cstddef>
+
+#include "bandwidth.h"
+#include "chrono.h"
+#include "core_builder.h"
+#include "ooo_cpu.h"
+#include "ooo_cpu_pipeline.h"
+
+namespace champsim
+{
+/**
+ * The dimensions of a core, lifted from a constexpr core_builder into constant expressions.
+ *
+ * \tparam Builder A core_builder with static storage duration whose dimensions will be fixed at compile time.
+ */
+template <const auto& Builder>
+struct core_shape {
+  constexpr static std::size_t IFETCH_BUFFER_SIZE = Builder.m_ifetch_buffer_size;
+  constexpr static std::size_t DISPATCH_BUFFER_SIZE = Builder.m_dispatch_buffer_size;
+  constexpr static std::size_t DECODE_BUFFER_SIZE = Builder.m_decode_buffer_size;
+  constexpr static std::size_t ROB_SIZE = Builder.m_rob_size;
+  constexpr static std::size_t SQ_SIZE = Builder.m_sq_size;
+  constexpr static std::size_t DIB_HIT_BUFFER_SIZE = Builder.m_dib_hit_buffer_size;
+
+  constexpr static champsim::bandwidth::maximum_type FETCH_WIDTH = Builder.m_fetch_width;
+  constexpr static champsim::bandwidth::maximum_type DECODE_WIDTH = Builder.m_decode_width;
+  constexpr static champsim::bandwidth::maximum_type DISPATCH_WIDTH = Builder.m_dispatch_width;
+  constexpr static champsim::bandwidth::maximum_type SCHEDULER_SIZE = Builder.m_schedule_width;
+  constexpr static champsim::bandwidth::maximum_type EXEC_WIDTH = Builder.m_execute_width;
+  constexpr static champsim::bandwidth::maximum_type DIB_INORDER_WIDTH = Builder.m_dib_inorder_width;
+  constexpr static champsim::bandwidth::maximum_type LQ_WIDTH = Builder.m_lq_width;
+  constexpr static champsim::bandwidth::maximum_type SQ_WIDTH = Builder.m_sq_width;
+  constexpr static champsim::bandwidth::maximum_type RETIRE_WIDTH = Builder.m_retire_width;
+
+  constexpr static champsim::chrono::clock::duration DISPATCH_LATENCY = Builder.m_dispatch_latency * Builder.m_clock_period;
+  constexpr static champsim::chrono::clock::duration DECODE_LATENCY = Builder.m_decode_latency * Builder.m_clock_period;
+  constexpr static champsim::chrono::clock::duration SCHEDULING_LATENCY = Builder.m_schedule_latency * Builder.m_clock_period;
+  constexpr static champsim::chrono::clock::duration DIB_HIT_LATENCY = Builder.m_dib_hit_latency * Builder.m_clock_period;
+
+  // A DIB without ways can never hit, so its lookups and fills are elided entirely
+  constexpr static bool DIB_ENABLED = Builder.m_dib_way > 0;
+
+  // The bandwidth to the first-level caches is set by the caches themselves, so it is only known at runtime
+  champsim::bandwidth::maximum_type L1I_BANDWIDTH;
+  champsim::bandwidth::maximum_type L1D_BANDWIDTH;
+};
+
+/**
+ * A core whose pipeline dimensions are known at compile time.
+ *
+ * The core must be constructed from a builder derived from the same constexpr builder as its shape, so that the runtime members of O3_CPU agree
+ * with the compile-time shape. This is how the configuration system instantiates cores that set "fixed_shape".
+ */
+template <const auto& Builder>
+class fixed_core final : public O3_CPU
+{
+public:
+  using shape_type = core_shape<Builder>;
+  const shape_type shape;
+
+  template <typename B, typename T>
+  explicit fixed_core(champsim::core_builder<B, T> b) : O3_CPU(b), shape{L1I_BANDWIDTH, L1D_BANDWIDTH}
+  {
+  }
+
+  long operate_pipeline() final { return O3_CPU::operate_pipeline(shape); }
+};
+} // namespace champsim
+
+#endif
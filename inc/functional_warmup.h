@@ -0,0 +1,80 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FUNCTIONAL_WARMUP_H
+#define FUNCTIONAL_WARMUP_H
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <vector>
+
+#include "address.h"
+#include "environment.h"
+#include "instruction.h"
+
+class VirtualMemory;
+
+namespace champsim
+{
+/**
+ * A functional model of the cache hierarchy, to warm it up quickly before the detailed phase.
+ *
+ * Each instruction is passed straight to the first-level caches of its core: one fetch for each new instruction block, one load for each source operand
+ * in memory, and one store for each destination operand in memory. Each cache looks up the block and fills it on a miss at once (CACHE::functional_access),
+ * and a miss continues to the cache below. Addresses are translated by the virtual memory of the simulation, so that the detailed phase finds the same
+ * pages, and the TLBs are warmed along the way. Evicted blocks are written back, and inclusive caches invalidate the blocks they evict above them.
+ *
+ * There are no queues, no bandwidth, and no time: the cores, the page table walkers and DRAM do not operate, and no statistics are counted.
+ */
+class functional_warmup
+{
+  using request_type = typename champsim::channel::request_type;
+
+  struct core_caches {
+    CACHE* l1i = nullptr;
+    CACHE* l1d = nullptr;
+    std::optional<champsim::block_number> last_fetch{};
+  };
+
+  std::vector<core_caches> cores{};
+  std::map<const champsim::channel*, CACHE*> serving{};     // the cache that serves the requests of each channel
+  std::map<const CACHE*, std::vector<CACHE*>> above{}; // the caches whose lower level is each cache
+  VirtualMemory* vmem = nullptr;
+  bool train_prefetchers;
+  uint64_t access_count = 0;
+
+  [[nodiscard]] CACHE* below(const champsim::channel* chan) const;
+  champsim::address translate(const CACHE& cache, uint32_t cpu, champsim::address v_address);
+  void access(CACHE* cache, request_type req);
+  void invalidate_above(const CACHE& cache, champsim::address address);
+
+public:
+  functional_warmup(environment& env, bool train_prefetchers);
+
+  /**
+   * Pass the memory accesses of one instruction of the given core to its caches
+   */
+  void operate(uint32_t cpu, const ooo_model_instr& instr);
+
+  /**
+   * The number of cache lookups made so far, at every level
+   */
+  [[nodiscard]] uint64_t accesses() const;
+};
+} // namespace champsim
+
+#endif
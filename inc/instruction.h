@@ -119,6 +119,22 @@ struct ooo_model_instr : champsim::program_ordered<ooo_model_instr> {
   unsigned completed_mem_ops = 0;
   int num_reg_dependent = 0;
 
+  // The deepest level of the memory hierarchy that serviced one of this instruction's loads, and the cycles it held the head of the ROB while waiting
+  uint8_t mem_miss_depth = 0;
+  bool mem_page_walked = false;
+  long memory_stall_cycles = 0;
+
+  // The times at which this instruction entered each stage of the pipeline
+  struct stage_times {
+    champsim::chrono::clock::time_point fetch{};
+    champsim::chrono::clock::time_point decode{};
+    champsim::chrono::clock::time_point rename{};
+    champsim::chrono::clock::time_point dispatch{};
+    champsim::chrono::clock::time_point issue{};
+    champsim::chrono::clock::time_point complete{};
+  };
+  stage_times timing{};
+
   std::vector<PHYSICAL_REGISTER_ID> destination_registers = {}; // output registers
   std::vector<PHYSICAL_REGISTER_ID> source_registers = {};      // input registers
 
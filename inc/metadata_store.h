@@ -0,0 +1,74 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef METADATA_STORE_H
+#define METADATA_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+
+#include "msl/lru_table.h"
+
+namespace champsim
+{
+/**
+ * On-chip storage for the correlation metadata of temporal prefetchers, carved out of ways that a cache reserves from its data array.
+ *
+ * Each reserved block holds several compressed key-value entries, so the store holds (sets * reserved ways * entries per block) entries, replaced in LRU order.
+ * If the store is backed off-chip, evicted entries are written back to memory and entries that miss on chip are read back from it,
+ * in the manner of STMS and MISB. Otherwise, evicted entries are lost, as in Triage.
+ * The store only models the contents. The cache that owns it charges the bandwidth and memory traffic that each access reports.
+ */
+class metadata_store
+{
+  struct entry_type {
+    uint64_t key;
+    uint64_t value;
+
+    [[nodiscard]] auto index() const { return key; }
+    [[nodiscard]] auto tag() const { return key; }
+  };
+
+  std::size_t num_entries;
+  champsim::msl::lru_table<entry_type> table;
+  bool offchip;
+  std::unordered_map<uint64_t, uint64_t> offchip_entries{};
+
+  bool install(uint64_t key, uint64_t value);
+
+public:
+  struct access_result {
+    std::optional<uint64_t> value{}; // for reads, the value that was found
+    bool onchip_hit = false;         // the key was found on chip
+    bool offchip_read = false;       // the entry was read from memory
+    bool offchip_write = false;      // an evicted entry was written to memory
+    bool evicted = false;            // an entry was displaced from the store
+  };
+
+  metadata_store(std::size_t sets, std::size_t ways, std::size_t entries_per_block, bool offchip);
+
+  access_result read(uint64_t key);
+  access_result write(uint64_t key, uint64_t value);
+
+  /**
+   * The number of entries that fit on chip
+   */
+  [[nodiscard]] std::size_t capacity() const { return num_entries; }
+};
+} // namespace champsim
+
+#endif
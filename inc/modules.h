@@ -17,13 +17,18 @@
 #ifndef MODULES_H
 #define MODULES_H
 
+#include <cstddef>
 #include <cstdint>
+#include <limits>
+#include <optional>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "access_type.h"
 #include "address.h"
 #include "block.h"
+#include "btb_level_config.h"
 #include "champsim.h"
 
 class CACHE;
@@ -74,6 +79,36 @@ struct branch_predictor : public bound_to<O3_CPU> {
 struct btb : public bound_to<O3_CPU> {
   explicit btb(O3_CPU* cpu) : bound_to<O3_CPU>(cpu) {}
 
+  /**
+   * The levels of a hierarchical BTB given in the core's configuration, in order from the level nearest to fetch. This may be empty.
+   */
+  [[nodiscard]] std::vector<champsim::btb_level_config> configured_levels() const;
+
+  /**
+   * The result of a BTB lookup.
+   *
+   * A BTB may return a (target, always_taken) pair, or this type to also report the number of fetch bubble cycles that follow a taken branch,
+   * and which level of a hierarchical BTB provided the target.
+   */
+  struct prediction {
+    champsim::address target{};
+    bool always_taken = false;
+    long bubbles = 0;
+    std::optional<std::size_t> level{};
+
+    prediction() = default;
+    prediction(champsim::address target_, bool always_taken_, long bubbles_ = 0, std::optional<std::size_t> level_ = std::nullopt)
+        : target(target_), always_taken(always_taken_), bubbles(bubbles_), level(level_)
+    {
+    }
+
+    template <typename T, typename U>
+    prediction(std::pair<T, U> pair) // NOLINT(google-explicit-constructor): implicit conversion from legacy BTB return values is intended
+        : target(pair.first), always_taken(pair.second)
+    {
+    }
+  };
+
   template <typename T, typename... Args>
   static auto initialize_member_impl(int) -> decltype(std::declval<T>().initialize_btb(std::declval<Args>()...), std::true_type{});
   template <typename, typename...>
@@ -104,6 +139,16 @@ struct prefetcher : public bound_to<CACHE> {
   bool prefetch_line(champsim::address pf_addr, bool fill_this_level, uint32_t prefetch_metadata) const;
   [[deprecated]] bool prefetch_line(uint64_t pf_addr, bool fill_this_level, uint32_t prefetch_metadata) const;
 
+  /**
+   * The number of prefetches to issue per activation, as recommended by the cache's prefetch throttle, or the given default if the cache is not throttled.
+   */
+  unsigned recommended_degree(unsigned default_degree) const;
+
+  /**
+   * How many blocks ahead of the demand stream to prefetch, as recommended by the cache's prefetch throttle, or the given default if the cache is not throttled.
+   */
+  unsigned recommended_distance(unsigned default_distance) const;
+
   template <typename T, typename... Args>
   static auto initiailize_memory_impl(int) -> decltype(std::declval<T>().prefetcher_initialize(std::declval<Args>()...), std::true_type{});
   template <typename, typename...>
@@ -154,6 +199,14 @@ struct prefetcher : public bound_to<CACHE> {
 };
 
 struct replacement : public bound_to<CACHE> {
+  using way_mask = uint64_t;
+  constexpr static way_mask all_ways = std::numeric_limits<way_mask>::max();
+
+  /**
+   * Whether a victim may be chosen from the given way. Ways beyond the width of the mask are always allowed.
+   */
+  static bool allows(way_mask allowed_ways, long way) { return way >= std::numeric_limits<way_mask>::digits || ((allowed_ways >> way) & 1) != 0; }
+
   explicit replacement(CACHE* cache) : bound_to<CACHE>(cache) {}
   long get_set_sample_rate() const;
   long get_set_sample_category(long set, long set_sample_rate) const;
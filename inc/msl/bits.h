@@ -19,6 +19,7 @@
 
 #include <cstdint>
 #include <limits>
+#include <type_traits>
 
 #include "util/to_underlying.h"
 #include "util/units.h"
@@ -61,6 +62,37 @@ constexpr bool is_power_of_2(T n)
   return (n == T{1} << lg2(n));
 }
 
+/**
+ * A backport of ``std::popcount()``.
+ */
+template <typename T>
+constexpr int popcount(T n)
+{
+  static_assert(std::is_unsigned_v<T>);
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_popcountll(n);
+#else
+  int result = 0;
+  for (; n != 0; n &= (n - 1)) {
+    ++result;
+  }
+  return result;
+#endif
+}
+
+/**
+ * A backport of ``std::countr_zero()``.
+ */
+template <typename T>
+constexpr int countr_zero(T n)
+{
+  static_assert(std::is_unsigned_v<T>);
+  if (n == 0) {
+    return std::numeric_limits<T>::digits;
+  }
+  return popcount(static_cast<T>((n & (~n + 1)) - 1));
+}
+
 /**
  * Compute an integer power.
  * This function may overflow very easily. Use only for small bases or very small exponents.
@@ -138,7 +138,11 @@ public:
     return hit->data;
   }
 
-  void fill(const value_type& elem)
+  /**
+   * Insert the element, replacing a matching element if one exists and the least-recently-used element of the set otherwise.
+   * Returns the valid element that was displaced to make room, if any.
+   */
+  std::optional<value_type> fill(const value_type& elem)
   {
     auto tag = tag_projection(elem);
     auto [set_begin, set_end] = get_set_span(elem);
@@ -148,9 +152,12 @@ public:
       if (tag_projection(hit->data) == tag) {
         *hit = {++access_count, elem};
       } else {
-        *miss = {++access_count, elem};
+        auto victim = std::exchange(*miss, {++access_count, elem});
+        if (victim.last_used > 0)
+          return victim.data;
       }
     }
+    return std::nullopt;
   }
 
   std::optional<value_type> invalidate(const value_type& elem)
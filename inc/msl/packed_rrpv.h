@@ -0,0 +1,187 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MSL_PACKED_RRPV_H
+#define MSL_PACKED_RRPV_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "msl/bits.h"
+
+namespace champsim::msl
+{
+/**
+ * The re-reference prediction values (RRPVs) of the RRIP family of replacement policies, packed for every way of every set.
+ *
+ * The values are stored bit-sliced: for each set, bit b of every way's RRPV is held in one 64-bit word, one bit per way.
+ * Finding the way with the largest RRPV and aging the whole set are then a handful of word operations per bit,
+ * rather than a loop over the ways. Sets of more than 64 ways take several words per bit.
+ *
+ * \tparam BITS The width of each RRPV. RRIP commonly uses 2 or 3 bits.
+ */
+template <unsigned BITS>
+class packed_rrpv
+{
+public:
+  using value_type = unsigned;
+  constexpr static value_type max_rrpv = (1u << BITS) - 1;
+
+private:
+  using word_type = uint64_t;
+  constexpr static std::size_t word_bits = 64;
+
+  std::size_t num_ways;
+  std::size_t words_per_set;
+  std::vector<std::array<word_type, BITS>> planes; // indexed set * words_per_set + word
+
+  [[nodiscard]] word_type valid_mask(std::size_t word) const
+  {
+    const auto ways_in_word = std::min(word_bits, num_ways - word * word_bits);
+    return bitmask(champsim::data::bits{ways_in_word});
+  }
+
+  [[nodiscard]] std::size_t word_index(long set, long way) const
+  {
+    return static_cast<std::size_t>(set) * words_per_set + static_cast<std::size_t>(way) / word_bits;
+  }
+
+public:
+  packed_rrpv(long sets, long ways, value_type initial = max_rrpv)
+      : num_ways(static_cast<std::size_t>(ways)), words_per_set((num_ways + word_bits - 1) / word_bits),
+        planes(static_cast<std::size_t>(sets) * words_per_set)
+  {
+    for (std::size_t i = 0; i < std::size(planes); ++i) {
+      for (unsigned b = 0; b < BITS; ++b)
+        planes[i][b] = ((initial >> b) & 1) != 0 ? valid_mask(i % words_per_set) : 0;
+    }
+  }
+
+  [[nodiscard]] value_type get(long set, long way) const
+  {
+    const auto& word = planes.at(word_index(set, way));
+    const auto shamt = static_cast<std::size_t>(way) % word_bits;
+    value_type retval = 0;
+    for (unsigned b = 0; b < BITS; ++b)
+      retval |= static_cast<value_type>((word[b] >> shamt) & 1) << b;
+    return retval;
+  }
+
+  void set(long set, long way, value_type value)
+  {
+    auto& word = planes.at(word_index(set, way));
+    const auto bit = word_type{1} << (static_cast<std::size_t>(way) % word_bits);
+    for (unsigned b = 0; b < BITS; ++b)
+      word[b] = ((value >> b) & 1) != 0 ? (word[b] | bit) : (word[b] & ~bit);
+  }
+
+  /**
+   * Find the first way of the set with the largest RRPV, without changing any value.
+   * Only the ways set in the mask are searched. The mask covers the first 64 ways, and the ways beyond it are always searched.
+   */
+  [[nodiscard]] long max_way(long set, word_type allowed = ~word_type{0}) const { return max_search(set, allowed).first; }
+
+  /**
+   * Find the first way of the set with the largest RRPV, and age the ways searched so that this way reaches the maximum RRPV.
+   * The mask is as for max_way().
+   *
+   * \return The way index of the victim
+   */
+  long victim(long set, word_type allowed = ~word_type{0})
+  {
+    auto [victim_way, max_value] = max_search(set, allowed);
+    if (const auto diff = max_rrpv - max_value; diff != 0) {
+      const auto first = static_cast<std::size_t>(set) * words_per_set;
+      for (std::size_t w = 0; w < words_per_set; ++w)
+        add(planes[first + w], diff, searched_mask(w, allowed));
+    }
+    return victim_way;
+  }
+
+  /**
+   * Increment every way of the set whose RRPV is less than the limit, leaving the others unchanged.
+   */
+  void increment_below(long set, value_type limit)
+  {
+    const auto first = static_cast<std::size_t>(set) * words_per_set;
+    for (std::size_t w = 0; w < words_per_set; ++w) {
+      auto& word = planes[first + w];
+
+      // A bit-sliced comparison, from the most significant bit down
+      word_type less = 0;
+      word_type equal = valid_mask(w);
+      for (unsigned b = BITS; b-- > 0;) {
+        if (((limit >> b) & 1) != 0) {
+          less |= equal & ~word[b];
+          equal &= word[b];
+        } else {
+          equal &= ~word[b];
+        }
+      }
+      add(word, 1, less);
+    }
+  }
+
+private:
+  // Add the same value to every way in the mask with a bit-sliced ripple-carry adder. The caller ensures that no way overflows.
+  static void add(std::array<word_type, BITS>& word, value_type value, word_type mask)
+  {
+    word_type carry = 0;
+    for (unsigned b = 0; b < BITS; ++b) {
+      const word_type addend = ((value >> b) & 1) != 0 ? mask : 0;
+      const auto sum = word[b] ^ addend ^ carry;
+      carry = (word[b] & addend) | (carry & (word[b] ^ addend));
+      word[b] = sum;
+    }
+  }
+
+  [[nodiscard]] word_type searched_mask(std::size_t word, word_type allowed) const { return word == 0 ? (valid_mask(word) & allowed) : valid_mask(word); }
+
+  [[nodiscard]] std::pair<long, value_type> max_search(long set, word_type allowed) const
+  {
+    const auto first = static_cast<std::size_t>(set) * words_per_set;
+
+    // The ways whose bits above `lowest` match those of the maximum found so far
+    value_type max_value = 0;
+    auto candidates = [&, this](std::size_t w, unsigned lowest) {
+      auto retval = searched_mask(w, allowed);
+      for (unsigned b = BITS; b-- > lowest;)
+        retval &= ((max_value >> b) & 1) != 0 ? planes[first + w][b] : ~planes[first + w][b];
+      return retval;
+    };
+
+    // Decide the maximum from the most significant bit down: a bit is set if any remaining candidate has it
+    for (unsigned b = BITS; b-- > 0;) {
+      word_type any = 0;
+      for (std::size_t w = 0; w < words_per_set; ++w)
+        any |= candidates(w, b + 1) & planes[first + w][b];
+      if (any != 0)
+        max_value |= value_type{1} << b;
+    }
+
+    for (std::size_t w = 0; w < words_per_set; ++w) {
+      if (auto found = candidates(w, 0); found != 0)
+        return {static_cast<long>(w * word_bits) + countr_zero(found), max_value};
+    }
+    return {0, max_value};
+  }
+};
+} // namespace champsim::msl
+
+#endif
@@ -0,0 +1,111 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NEXT_USE_INDEX_H
+#define NEXT_USE_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "access_type.h"
+
+namespace champsim
+{
+/**
+ * The demand accesses of a cache, recorded by one simulation so that an oracle replacement policy can look into the future in the next.
+ *
+ * Each demand access is numbered by its position among the demand accesses to its set. The index holds a (block, position) record for every access,
+ * sorted, so that the next use of a block after any position is found by binary search. The recording simulation streams its records to disk
+ * in sorted runs, and merges them into the index when it ends. The replaying simulation maps the index into memory, so that neither need hold the
+ * whole stream.
+ */
+class next_use_index
+{
+public:
+  struct record_type {
+    uint64_t block;
+    uint64_t position;
+  };
+
+  constexpr static uint64_t never = std::numeric_limits<uint64_t>::max();
+
+  /**
+   * Records the demand accesses of a cache. Each run of records is sorted and written to a side file as it fills,
+   * and the runs are merged into the index when the recorder is destroyed.
+   */
+  class recorder
+  {
+    std::string path;
+    std::string runs_path;
+    std::ofstream runs;
+    std::vector<uint64_t> run_sizes{};
+    std::size_t run_capacity;
+    std::vector<uint64_t> set_position;
+    std::vector<record_type> pending{};
+
+    void spill();
+    void merge();
+
+  public:
+    constexpr static std::size_t default_run_capacity = std::size_t{1} << 22;
+
+    recorder(std::string index_path, long sets, std::size_t records_per_run = default_run_capacity);
+    ~recorder();
+
+    recorder(const recorder&) = delete;
+    recorder& operator=(const recorder&) = delete;
+
+    void record(long set, uint64_t block);
+  };
+
+  explicit next_use_index(const std::string& index_path);
+  ~next_use_index();
+
+  next_use_index(const next_use_index&) = delete;
+  next_use_index& operator=(const next_use_index&) = delete;
+
+  /**
+   * Only these accesses are recorded, and only these advance the position of a set. Writebacks and prefetches are not known to the program.
+   */
+  [[nodiscard]] static bool is_demand(access_type type);
+
+  /**
+   * The file that the named cache records to, and that an oracle policy in that cache reads from.
+   * It is placed beside the access traces, in CHAMPSIM_TRACE_DIR and named by CHAMPSIM_TRACE_ID.
+   */
+  [[nodiscard]] static std::string default_path(std::string_view cache_name);
+
+  /**
+   * The position of the first access to the block at or after the given position of its set, or never
+   */
+  [[nodiscard]] uint64_t next_use(uint64_t block, uint64_t from) const;
+
+  [[nodiscard]] std::size_t size() const;
+
+private:
+  void* mapping = nullptr;
+  std::size_t mapping_size = 0;
+  const record_type* first = nullptr;
+  std::size_t count = 0;
+};
+} // namespace champsim
+
+#endif
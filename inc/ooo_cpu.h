@@ -25,6 +25,7 @@
 #include <array>
 #include <bitset>
 #include <deque>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <optional>
@@ -41,7 +42,10 @@
 #include "instruction.h"
 #include "modules.h"
 #include "operable.h"
+#include "pipeline_trace.h"
 #include "register_allocator.h"
+#include "store_buffer.h"
+#include "store_set.h"
 #include "util/lru_table.h"
 #include "util/to_underlying.h"
 
@@ -61,6 +65,8 @@ public:
   CacheBus(uint32_t cpu_idx, champsim::channel* ll) : lower_level(ll), cpu(cpu_idx) {}
   bool issue_read(request_type packet);
   bool issue_write(request_type packet);
+
+  [[nodiscard]] channel_type* lower_channel() const { return lower_level; }
 };
 
 struct LSQ_ENTRY : champsim::program_ordered<LSQ_ENTRY> {
@@ -74,6 +80,16 @@ struct LSQ_ENTRY : champsim::program_ordered<LSQ_ENTRY> {
   uint64_t producer_id = std::numeric_limits<uint64_t>::max();
   std::vector<std::reference_wrapper<std::optional<LSQ_ENTRY>>> lq_depend_on_me{};
 
+  // An older store to the same address that this load was allowed to bypass. The load is checked for a violation when that store executes.
+  uint64_t bypassed_store_id = std::numeric_limits<uint64_t>::max();
+
+  // The younger loads to the same address that bypassed this store, which may have completed before it executes
+  std::vector<uint64_t> bypassing_loads{};
+
+  // Where the memory hierarchy found the data for this load
+  uint8_t miss_depth = 0;
+  bool page_walked = false;
+
   LSQ_ENTRY(champsim::address addr, champsim::program_ordered<LSQ_ENTRY>::id_type id, champsim::address ip, std::array<uint8_t, 2> asid);
   void finish(ooo_model_instr& rob_entry) const;
   void finish(std::deque<ooo_model_instr>::iterator begin, std::deque<ooo_model_instr>::iterator end) const;
@@ -127,6 +143,7 @@ public:
   champsim::bandwidth::maximum_type LQ_WIDTH, SQ_WIDTH;
   champsim::bandwidth::maximum_type RETIRE_WIDTH;
   champsim::chrono::clock::duration BRANCH_MISPREDICT_PENALTY;
+  champsim::chrono::clock::duration MEMORY_VIOLATION_PENALTY;
   champsim::chrono::clock::duration DISPATCH_LATENCY;
   champsim::chrono::clock::duration DECODE_LATENCY;
   champsim::chrono::clock::duration SCHEDULING_LATENCY;
@@ -135,10 +152,26 @@ public:
 
   champsim::bandwidth::maximum_type L1I_BANDWIDTH, L1D_BANDWIDTH;
 
+  // The geometry of a hierarchical BTB module, if one was configured
+  std::vector<champsim::btb_level_config> BTB_LEVELS;
+
+  // The runtime-sized core always consults the DIB. Fixed shapes (see fixed_core.h) may compile it out.
+  constexpr static bool DIB_ENABLED = true;
+
   RegisterAllocator reg_allocator{REGISTER_FILE_SIZE};
 
+  // memory dependence prediction
+  champsim::store_set_predictor mem_dep_predictor;
+
+  // committed stores, coalesced on their way to the L1D
+  champsim::store_buffer store_buf;
+
   // branch
   champsim::chrono::clock::time_point fetch_resume_time{};
+  champsim::chrono::clock::time_point btb_bubble_end_time{}; // fetch is held after a taken branch whose target came from a slow BTB level
+
+  // If present, the timelines of retired instructions are written here
+  std::optional<champsim::pipeline_tracer> pipeline_trace{};
 
   const long IN_QUEUE_SIZE;
   std::deque<ooo_model_instr> input_queue;
@@ -151,32 +184,59 @@ public:
   void begin_phase() final;
   void end_phase(unsigned cpu) final;
 
-  void initialize_instruction();
-  long check_dib();
-  long fetch_instruction();
-  long promote_to_decode();
-  long decode_instruction();
-  long dispatch_instruction();
-  long schedule_instruction();
-  long execute_instruction();
-  long operate_lsq();
-  long complete_inflight_instruction();
-  long handle_memory_return();
-  long retire_rob();
+  /**
+   * Advance every pipeline stage by one cycle.
+   * The runtime-sized core operates with its own members as the shape. Specializations with compile-time dimensions override this.
+   */
+  virtual long operate_pipeline();
+
+  /*
+   * The pipeline stages are parameterized by a shape, which supplies the buffer sizes, widths, and latencies.
+   * Any type with members named like this class's constants may be used, including this class itself.
+   * The definitions are in ooo_cpu_pipeline.h
+   */
+  template <typename Shape>
+  long operate_pipeline(const Shape& shape);
+  template <typename Shape>
+  void initialize_instruction(const Shape& shape);
+  template <typename Shape>
+  long check_dib(const Shape& shape);
+  template <typename Shape>
+  long fetch_instruction(const Shape& shape);
+  template <typename Shape>
+  long promote_to_decode(const Shape& shape);
+  template <typename Shape>
+  long decode_instruction(const Shape& shape);
+  template <typename Shape>
+  long dispatch_instruction(const Shape& shape);
+  template <typename Shape>
+  long schedule_instruction(const Shape& shape);
+  template <typename Shape>
+  long execute_instruction(const Shape& shape);
+  template <typename Shape>
+  long operate_lsq(const Shape& shape);
+  template <typename Shape>
+  long complete_inflight_instruction(const Shape& shape);
+  template <typename Shape>
+  long handle_memory_return(const Shape& shape);
+  template <typename Shape>
+  long retire_rob(const Shape& shape);
 
   bool do_init_instruction(ooo_model_instr& instr);
   bool do_predict_branch(ooo_model_instr& instr);
   void do_check_dib(ooo_model_instr& instr);
   bool do_fetch_instruction(std::deque<ooo_model_instr>::iterator begin, std::deque<ooo_model_instr>::iterator end);
   void do_dib_update(const ooo_model_instr& instr);
-  void do_scheduling(ooo_model_instr& instr);
   void do_execution(ooo_model_instr& instr);
   void do_memory_scheduling(ooo_model_instr& instr);
   void do_complete_execution(ooo_model_instr& instr);
+  void do_stall_accounting();
+  void do_retire_accounting(const ooo_model_instr& instr);
   void do_sq_forward_to_lq(LSQ_ENTRY& sq_entry, LSQ_ENTRY& lq_entry);
 
   void do_finish_store(const LSQ_ENTRY& sq_entry);
   bool do_complete_store(const LSQ_ENTRY& sq_entry);
+  long drain_store_buffer();
   bool execute_load(const LSQ_ENTRY& lq_entry);
 
   [[nodiscard]] auto roi_instr() const { return roi_stats.instrs(); }
@@ -201,7 +261,7 @@ public:
 
     virtual void impl_initialize_btb() = 0;
     virtual void impl_update_btb(champsim::address ip, champsim::address predicted_target, bool taken, uint8_t branch_type) = 0;
-    virtual std::pair<champsim::address, bool> impl_btb_prediction(champsim::address ip, uint8_t branch_type) = 0;
+    virtual champsim::modules::btb::prediction impl_btb_prediction(champsim::address ip, uint8_t branch_type) = 0;
   };
 
   template <typename... Bs>
@@ -221,7 +281,7 @@ public:
 
     void impl_initialize_btb() final;
     void impl_update_btb(champsim::address ip, champsim::address predicted_target, bool taken, uint8_t branch_type) final;
-    [[nodiscard]] std::pair<champsim::address, bool> impl_btb_prediction(champsim::address ip, uint8_t branch_type) final;
+    [[nodiscard]] champsim::modules::btb::prediction impl_btb_prediction(champsim::address ip, uint8_t branch_type) final;
   };
 
   std::unique_ptr<branch_module_concept> branch_module_pimpl;
@@ -234,7 +294,7 @@ public:
 
   void impl_initialize_btb() const;
   void impl_update_btb(champsim::address ip, champsim::address predicted_target, bool taken, uint8_t branch_type) const;
-  [[nodiscard]] std::pair<champsim::address, bool> impl_btb_prediction(champsim::address ip, uint8_t branch_type) const;
+  [[nodiscard]] champsim::modules::btb::prediction impl_btb_prediction(champsim::address ip, uint8_t branch_type) const;
   // NOLINTEND(readability-make-member-function-const)
 
   template <typename... Bs, typename... Ts>
@@ -245,11 +305,14 @@ public:
         REGISTER_FILE_SIZE(b.m_register_file_size), ROB_SIZE(b.m_rob_size), SQ_SIZE(b.m_sq_size), DIB_HIT_BUFFER_SIZE(b.m_dib_hit_buffer_size),
         FETCH_WIDTH(b.m_fetch_width), DECODE_WIDTH(b.m_decode_width), DISPATCH_WIDTH(b.m_dispatch_width), SCHEDULER_SIZE(b.m_schedule_width),
         EXEC_WIDTH(b.m_execute_width), DIB_INORDER_WIDTH(b.m_dib_inorder_width), LQ_WIDTH(b.m_lq_width), SQ_WIDTH(b.m_sq_width), RETIRE_WIDTH(b.m_retire_width),
-        BRANCH_MISPREDICT_PENALTY(b.m_mispredict_penalty * b.m_clock_period), DISPATCH_LATENCY(b.m_dispatch_latency * b.m_clock_period),
+        BRANCH_MISPREDICT_PENALTY(b.m_mispredict_penalty * b.m_clock_period),
+        MEMORY_VIOLATION_PENALTY(b.m_memory_violation_penalty * b.m_clock_period), DISPATCH_LATENCY(b.m_dispatch_latency * b.m_clock_period),
         DECODE_LATENCY(b.m_decode_latency * b.m_clock_period), SCHEDULING_LATENCY(b.m_schedule_latency * b.m_clock_period),
         EXEC_LATENCY(b.m_execute_latency * b.m_clock_period), DIB_HIT_LATENCY(b.m_dib_hit_latency * b.m_clock_period), L1I_BANDWIDTH(b.m_l1i_bw),
-        L1D_BANDWIDTH(b.m_l1d_bw), IN_QUEUE_SIZE(2 * champsim::to_underlying(b.m_fetch_width)), L1I_bus(b.m_cpu, b.m_fetch_queues),
-        L1D_bus(b.m_cpu, b.m_data_queues), l1i(b.m_l1i), branch_module_pimpl(std::make_unique<branch_module_model<Bs...>>(this)),
+        L1D_BANDWIDTH(b.m_l1d_bw), BTB_LEVELS(std::cbegin(b.m_btb_levels), std::next(std::cbegin(b.m_btb_levels), static_cast<long>(b.m_num_btb_levels))),
+        mem_dep_predictor(b.m_ssit_size, b.m_lfst_size),
+        store_buf(b.m_store_buffer_size, champsim::data::bits{LOG2_BLOCK_SIZE}, champsim::store_buffer::default_max_wait_cycles * b.m_clock_period), IN_QUEUE_SIZE(2 * champsim::to_underlying(b.m_fetch_width)),
+        L1I_bus(b.m_cpu, b.m_fetch_queues), L1D_bus(b.m_cpu, b.m_data_queues), l1i(b.m_l1i), branch_module_pimpl(std::make_unique<branch_module_model<Bs...>>(this)),
         btb_module_pimpl(std::make_unique<btb_module_model<Ts...>>(this))
   {
   }
@@ -339,9 +402,9 @@ void O3_CPU::btb_module_model<Ts...>::impl_update_btb(champsim::address ip, cham
 }
 
 template <typename... Ts>
-std::pair<champsim::address, bool> O3_CPU::btb_module_model<Ts...>::impl_btb_prediction(champsim::address ip, uint8_t branch_type)
+champsim::modules::btb::prediction O3_CPU::btb_module_model<Ts...>::impl_btb_prediction(champsim::address ip, uint8_t branch_type)
 {
-  using return_type = std::pair<champsim::address, bool>;
+  using return_type = champsim::modules::btb::prediction;
   [[maybe_unused]] auto process_one = [&](auto& t) {
     using namespace champsim::modules;
 
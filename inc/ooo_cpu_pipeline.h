@@ -0,0 +1,473 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OOO_CPU_PIPELINE_H
+#define OOO_CPU_PIPELINE_H
+
+#include <algorithm>
+#include <cassert>
+#include <fmt/core.h>
+
+#include "bandwidth.h"
+#include "champsim.h"
+#include "instruction.h"
+#include "ooo_cpu.h"
+#include "util/span.h"
+
+/*
+ * The pipeline stages of O3_CPU, parameterized by the shape of the core.
+ *
+ * This header is included by the translation unit for the runtime-sized core, and by any translation unit that instantiates a fixed_core.
+ * When the shape's members are constant expressions, the bandwidth loops have fixed trip counts and disabled features are compiled out.
+ */
+
+template <typename Shape>
+long O3_CPU::operate_pipeline(const Shape& shape)
+{
+  long progress{0};
+  progress += retire_rob(shape);                    // retire
+  progress += complete_inflight_instruction(shape); // finalize execution
+  progress += execute_instruction(shape);           // execute instructions
+  progress += schedule_instruction(shape);          // schedule instructions
+  progress += handle_memory_return(shape);          // finalize memory transactions
+  progress += operate_lsq(shape);                   // execute memory transactions
+
+  progress += dispatch_instruction(shape); // dispatch
+  progress += decode_instruction(shape);   // decode
+  progress += promote_to_decode(shape);
+
+  progress += fetch_instruction(shape); // fetch
+  progress += check_dib(shape);
+  initialize_instruction(shape);
+
+  return progress;
+}
+
+template <typename Shape>
+void O3_CPU::initialize_instruction(const Shape& shape)
+{
+  champsim::bandwidth instrs_to_read_this_cycle{
+      std::min(shape.FETCH_WIDTH, champsim::bandwidth::maximum_type{static_cast<long>(shape.IFETCH_BUFFER_SIZE - std::size(IFETCH_BUFFER))})};
+
+  bool stop_fetch = false;
+  bool fetch_ready = current_time >= fetch_resume_time && current_time >= btb_bubble_end_time;
+  while (fetch_ready && instrs_to_read_this_cycle.has_remaining() && !stop_fetch && !std::empty(input_queue)) {
+    instrs_to_read_this_cycle.consume();
+
+    stop_fetch = do_init_instruction(input_queue.front());
+
+    // Add to IFETCH_BUFFER
+    IFETCH_BUFFER.push_back(input_queue.front());
+    input_queue.pop_front();
+
+    IFETCH_BUFFER.back().ready_time = current_time;
+    IFETCH_BUFFER.back().timing.fetch = current_time;
+  }
+}
+
+template <typename Shape>
+long O3_CPU::check_dib(const Shape& shape)
+{
+  // scan through IFETCH_BUFFER to find instructions that hit in the decoded instruction buffer
+  auto begin = std::find_if(std::begin(IFETCH_BUFFER), std::end(IFETCH_BUFFER), [](const ooo_model_instr& x) { return !x.dib_checked; });
+  auto [window_begin, window_end] = champsim::get_span(begin, std::end(IFETCH_BUFFER), champsim::bandwidth{shape.FETCH_WIDTH});
+  std::for_each(window_begin, window_end, [this](auto& ifetch_entry) {
+    if constexpr (Shape::DIB_ENABLED) {
+      this->do_check_dib(ifetch_entry);
+    } else {
+      ifetch_entry.dib_checked = true;
+    }
+  });
+  return std::distance(window_begin, window_end);
+}
+
+template <typename Shape>
+long O3_CPU::fetch_instruction(const Shape& shape)
+{
+  long progress{0};
+
+  // Fetch a single cache line
+  auto fetch_ready = [](const ooo_model_instr& x) {
+    return x.dib_checked && !x.fetch_issued;
+  };
+
+  // Find the chunk of instructions in the block
+  auto no_match_ip = [](const auto& lhs, const auto& rhs) {
+    return champsim::block_number{lhs.ip} != champsim::block_number{rhs.ip};
+  };
+
+  auto l1i_req_begin = std::find_if(std::begin(IFETCH_BUFFER), std::end(IFETCH_BUFFER), fetch_ready);
+  for (champsim::bandwidth l1i_bw{shape.L1I_BANDWIDTH}; l1i_bw.has_remaining() && l1i_req_begin != std::end(IFETCH_BUFFER); l1i_bw.consume()) {
+    auto l1i_req_end = std::adjacent_find(l1i_req_begin, std::end(IFETCH_BUFFER), no_match_ip);
+    if (l1i_req_end != std::end(IFETCH_BUFFER)) {
+      l1i_req_end = std::next(l1i_req_end); // adjacent_find returns the first of the non-equal elements
+    }
+
+    // Issue to L1I
+    auto success = do_fetch_instruction(l1i_req_begin, l1i_req_end);
+    if (success) {
+      std::for_each(l1i_req_begin, l1i_req_end, [](auto& x) { x.fetch_issued = true; });
+      ++progress;
+    }
+
+    l1i_req_begin = std::find_if(l1i_req_end, std::end(IFETCH_BUFFER), fetch_ready);
+  }
+
+  return progress;
+}
+
+template <typename Shape>
+long O3_CPU::promote_to_decode(const Shape& shape)
+{
+  auto is_decoded = [](const ooo_model_instr& x) {
+    return x.decoded;
+  };
+
+  auto fetch_complete_and_ready = [time = current_time](const auto& x) {
+    return x.fetch_completed && x.ready_time <= time;
+  };
+
+  champsim::bandwidth available_fetch_bandwidth{
+      std::min(shape.FETCH_WIDTH, std::min(champsim::bandwidth::maximum_type{static_cast<long>(shape.DIB_HIT_BUFFER_SIZE - std::size(DIB_HIT_BUFFER))},
+                                     champsim::bandwidth::maximum_type{static_cast<long>(shape.DECODE_BUFFER_SIZE - std::size(DECODE_BUFFER))}))};
+
+  auto fetched_check_end = std::find_if(std::begin(IFETCH_BUFFER), std::end(IFETCH_BUFFER), [](const ooo_model_instr& x) { return !x.fetch_completed; });
+  // find the first not fetch completed
+  auto [window_begin, window_end] = champsim::get_span_p(std::begin(IFETCH_BUFFER), fetched_check_end, available_fetch_bandwidth, fetch_complete_and_ready);
+  auto decoded_window_end = std::stable_partition(window_begin, window_end, is_decoded); // reorder instructions
+  auto mark_for_decode = [time = current_time, lat = shape.DECODE_LATENCY, warmup = warmup](auto& x) {
+    x.timing.decode = time;
+    return x.ready_time = time + (warmup ? champsim::chrono::clock::duration{} : lat);
+  };
+  // to DIB_HIT_BUFFER
+  auto mark_for_dib = [time = current_time, lat = shape.DIB_HIT_LATENCY, warmup = warmup](auto& x) {
+    x.timing.decode = time;
+    return x.ready_time = time + lat;
+  };
+
+  std::for_each(window_begin, decoded_window_end, mark_for_dib); // assume DECODE_LATENCY = DIB_HIT_LATENCY
+  std::move(window_begin, decoded_window_end, std::back_inserter(DIB_HIT_BUFFER));
+  // to DECODE_BUFFER
+
+  std::for_each(decoded_window_end, window_end, mark_for_decode);
+  std::move(decoded_window_end, window_end, std::back_inserter(DECODE_BUFFER));
+
+  long progress{std::distance(window_begin, window_end)};
+  IFETCH_BUFFER.erase(window_begin, window_end);
+  return progress;
+}
+
+template <typename Shape>
+long O3_CPU::decode_instruction(const Shape& shape)
+{
+  auto is_ready = [time = current_time](const auto& x) {
+    return x.ready_time <= time;
+  };
+
+  auto dib_hit_buffer_begin = std::begin(DIB_HIT_BUFFER);
+  auto dib_hit_buffer_end = dib_hit_buffer_begin;
+  auto decode_buffer_begin = std::begin(DECODE_BUFFER);
+  auto decode_buffer_end = decode_buffer_begin;
+
+  champsim::bandwidth available_decode_bandwidth{shape.DECODE_WIDTH};
+
+  // bw move instructions to dispatch_buffer
+  champsim::bandwidth available_dib_inorder_bandwidth{
+      std::min(shape.DIB_INORDER_WIDTH, champsim::bandwidth::maximum_type{static_cast<long>(shape.DISPATCH_BUFFER_SIZE - std::size(DISPATCH_BUFFER))})};
+
+  // conditions choose how many instructions sent to dispatch_buffer
+  while (dib_hit_buffer_end != std::end(DIB_HIT_BUFFER) && decode_buffer_end != std::end(DECODE_BUFFER) && available_dib_inorder_bandwidth.has_remaining()
+         && available_decode_bandwidth.has_remaining() && is_ready(std::min(*dib_hit_buffer_end, *decode_buffer_end, ooo_model_instr::program_order))) {
+    if (ooo_model_instr::program_order(*dib_hit_buffer_end, *decode_buffer_end)) {
+      dib_hit_buffer_end++;
+      available_dib_inorder_bandwidth.consume();
+    } else {
+      decode_buffer_end++;
+      available_dib_inorder_bandwidth.consume();
+      available_decode_bandwidth.consume();
+    }
+  }
+  while (dib_hit_buffer_end != std::end(DIB_HIT_BUFFER) && available_dib_inorder_bandwidth.has_remaining() && is_ready(*dib_hit_buffer_end)
+         && (decode_buffer_end == std::end(DECODE_BUFFER) || ooo_model_instr::program_order(*dib_hit_buffer_end, *decode_buffer_end))) {
+    dib_hit_buffer_end++;
+    available_dib_inorder_bandwidth.consume();
+  }
+  while (decode_buffer_end != std::end(DECODE_BUFFER) && available_dib_inorder_bandwidth.has_remaining() && available_decode_bandwidth.has_remaining()
+         && is_ready(*decode_buffer_end)
+         && (dib_hit_buffer_end == std::end(DIB_HIT_BUFFER) || ooo_model_instr::program_order(*decode_buffer_end, *dib_hit_buffer_end))) {
+    decode_buffer_end++;
+    available_dib_inorder_bandwidth.consume();
+    available_decode_bandwidth.consume();
+  }
+
+  // decode instructions have not decoded, merge instructions with dib_hit_buffer then send to dispatch_buffer
+  auto do_decode = [&, this](auto& db_entry) {
+    if constexpr (Shape::DIB_ENABLED) {
+      this->do_dib_update(db_entry);
+    }
+
+    // Resume fetch
+    if (db_entry.branch_mispredicted) {
+      // These branches detect the misprediction at decode
+      if ((db_entry.branch == BRANCH_DIRECT_JUMP) || (db_entry.branch == BRANCH_DIRECT_CALL)
+          || (((db_entry.branch == BRANCH_CONDITIONAL) || (db_entry.branch == BRANCH_OTHER)) && db_entry.branch_taken == db_entry.branch_prediction)) {
+        // clear the branch_mispredicted bit so we don't attempt to resume fetch again at execute
+        db_entry.branch_mispredicted = 0;
+        // pay misprediction penalty
+        this->fetch_resume_time = this->current_time + BRANCH_MISPREDICT_PENALTY;
+      }
+    }
+    // Add to dispatch
+    db_entry.ready_time = this->current_time + (this->warmup ? champsim::chrono::clock::duration{} : this->DISPATCH_LATENCY);
+    db_entry.timing.rename = this->current_time;
+
+    if constexpr (champsim::debug_print) {
+      fmt::print("[DECODE] do_decode instr_id: {} time: {}\n", db_entry.instr_id, this->current_time.time_since_epoch() / this->clock_period);
+    }
+  };
+
+  auto do_dib_hit = [&, this](auto& dib_entry) {
+    dib_entry.ready_time = this->current_time + (this->warmup ? champsim::chrono::clock::duration{} : this->DISPATCH_LATENCY);
+    dib_entry.timing.rename = this->current_time;
+  };
+
+  std::for_each(decode_buffer_begin, decode_buffer_end, do_decode);
+  std::for_each(dib_hit_buffer_begin, dib_hit_buffer_end, do_dib_hit);
+
+  long progress{std::distance(dib_hit_buffer_begin, dib_hit_buffer_end) + std::distance(decode_buffer_begin, decode_buffer_end)};
+
+  std::merge(dib_hit_buffer_begin, dib_hit_buffer_end, decode_buffer_begin, decode_buffer_end, std::back_inserter(DISPATCH_BUFFER),
+             ooo_model_instr::program_order);
+  DECODE_BUFFER.erase(decode_buffer_begin, decode_buffer_end);
+  DIB_HIT_BUFFER.erase(dib_hit_buffer_begin, dib_hit_buffer_end);
+
+  return progress;
+}
+
+template <typename Shape>
+long O3_CPU::dispatch_instruction(const Shape& shape)
+{
+  champsim::bandwidth available_dispatch_bandwidth{shape.DISPATCH_WIDTH};
+
+  // dispatch DISPATCH_WIDTH instructions into the ROB
+  while (available_dispatch_bandwidth.has_remaining() && !std::empty(DISPATCH_BUFFER) && DISPATCH_BUFFER.front().ready_time <= current_time
+         && std::size(ROB) != shape.ROB_SIZE
+         && ((std::size_t)std::count_if(std::begin(LQ), std::end(LQ), [](const auto& lq_entry) { return !lq_entry.has_value(); })
+             >= std::size(DISPATCH_BUFFER.front().source_memory))
+         && ((std::size(DISPATCH_BUFFER.front().destination_memory) + std::size(SQ)) <= shape.SQ_SIZE)) {
+    ROB.push_back(std::move(DISPATCH_BUFFER.front()));
+    DISPATCH_BUFFER.pop_front();
+    ROB.back().timing.dispatch = current_time;
+    do_memory_scheduling(ROB.back());
+
+    available_dispatch_bandwidth.consume();
+    ROB.back().ready_time = current_time + (warmup ? champsim::chrono::clock::duration{} : shape.SCHEDULING_LATENCY);
+  }
+
+  return available_dispatch_bandwidth.amount_consumed();
+}
+
+template <typename Shape>
+long O3_CPU::schedule_instruction(const Shape& shape)
+{
+  // The scheduler searches the oldest instructions in the ROB, up to the SCHEDULER_SIZE-th that has not executed
+  champsim::bandwidth search_bw{shape.SCHEDULER_SIZE};
+  auto search_end = std::find_if(std::begin(ROB), std::end(ROB), [&search_bw](const auto& x) {
+    if (!search_bw.has_remaining()) {
+      return true;
+    }
+    if (!x.executed) {
+      search_bw.consume();
+    }
+    return false;
+  });
+
+  auto ready_to_schedule = [time = current_time](const ooo_model_instr& x) {
+    return !x.scheduled && x.ready_time <= time;
+  };
+
+  // if there aren't enough physical registers available for the next instruction, stop scheduling
+  auto renamed_end = reg_allocator.rename_group(std::begin(ROB), search_end, ready_to_schedule);
+
+  long progress{0};
+  std::for_each(std::begin(ROB), renamed_end, [&progress, ready_to_schedule](auto& x) {
+    if (ready_to_schedule(x)) {
+      x.scheduled = true;
+      ++progress;
+    }
+  });
+
+  return progress;
+}
+
+template <typename Shape>
+long O3_CPU::execute_instruction(const Shape& shape)
+{
+  champsim::bandwidth exec_bw{shape.EXEC_WIDTH};
+  for (auto rob_it = std::begin(ROB); rob_it != std::end(ROB) && exec_bw.has_remaining(); ++rob_it) {
+    if (rob_it->scheduled && !rob_it->executed && rob_it->ready_time <= current_time) {
+      bool ready = std::all_of(std::begin(rob_it->source_registers), std::end(rob_it->source_registers),
+                               [&alloc = std::as_const(reg_allocator)](auto srcreg) { return alloc.isValid(srcreg); });
+      if (ready) {
+        do_execution(*rob_it);
+        exec_bw.consume();
+      }
+    }
+  }
+
+  return exec_bw.amount_consumed();
+}
+
+template <typename Shape>
+long O3_CPU::operate_lsq(const Shape& shape)
+{
+  champsim::bandwidth store_bw{shape.SQ_WIDTH};
+
+  const auto complete_id = std::empty(ROB) ? std::numeric_limits<uint64_t>::max() : ROB.front().instr_id;
+  auto do_complete = [time = current_time, finished = LSQ_ENTRY::precedes(complete_id), this](const auto& x) {
+    return finished(x) && x.ready_time <= time && this->do_complete_store(x);
+  };
+
+  auto unfetched_begin = std::partition_point(std::begin(SQ), std::end(SQ), [](const auto& x) { return x.fetch_issued; });
+  auto [fetch_begin, fetch_end] =
+      champsim::get_span_p(unfetched_begin, std::end(SQ), store_bw, [time = current_time](const auto& x) { return !x.fetch_issued && x.ready_time <= time; });
+  store_bw.consume(std::distance(fetch_begin, fetch_end));
+  std::for_each(fetch_begin, fetch_end, [time = current_time, this](auto& sq_entry) {
+    this->do_finish_store(sq_entry);
+    sq_entry.fetch_issued = true;
+    sq_entry.ready_time = time;
+  });
+
+  auto [complete_begin, complete_end] = champsim::get_span_p(std::cbegin(SQ), std::cend(SQ), store_bw, do_complete);
+  store_bw.consume(std::distance(complete_begin, complete_end));
+  SQ.erase(complete_begin, complete_end);
+  auto drained = drain_store_buffer();
+
+  champsim::bandwidth load_bw{shape.LQ_WIDTH};
+
+  for (auto& lq_entry : LQ) {
+    if (load_bw.has_remaining() && lq_entry.has_value() && lq_entry->producer_id == std::numeric_limits<uint64_t>::max() && !lq_entry->fetch_issued
+        && lq_entry->ready_time < current_time) {
+      auto success = execute_load(*lq_entry);
+      if (success) {
+        load_bw.consume();
+        lq_entry->fetch_issued = true;
+      }
+    }
+  }
+
+  return store_bw.amount_consumed() + load_bw.amount_consumed() + drained;
+}
+
+template <typename Shape>
+long O3_CPU::complete_inflight_instruction(const Shape& shape)
+{
+  // update ROB entries with completed executions
+  champsim::bandwidth complete_bw{shape.EXEC_WIDTH};
+  for (auto rob_it = std::begin(ROB); rob_it != std::end(ROB) && complete_bw.has_remaining(); ++rob_it) {
+    if (rob_it->executed && !rob_it->completed && (rob_it->ready_time <= current_time) && rob_it->completed_mem_ops == rob_it->num_mem_ops()) {
+      do_complete_execution(*rob_it);
+      complete_bw.consume();
+    }
+  }
+
+  return complete_bw.amount_consumed();
+}
+
+template <typename Shape>
+long O3_CPU::handle_memory_return(const Shape& shape)
+{
+  long progress{0};
+
+  for (champsim::bandwidth fetch_bw{shape.FETCH_WIDTH}, l1i_bw{shape.L1I_BANDWIDTH};
+       fetch_bw.has_remaining() && l1i_bw.has_remaining() && !L1I_bus.lower_level->returned.empty(); l1i_bw.consume()) {
+    auto& l1i_entry = L1I_bus.lower_level->returned.front();
+
+    while (fetch_bw.has_remaining() && !l1i_entry.instr_depend_on_me.empty()) {
+      auto fetched = std::find_if(std::begin(IFETCH_BUFFER), std::end(IFETCH_BUFFER), ooo_model_instr::matches_id(l1i_entry.instr_depend_on_me.front()));
+      if (fetched != std::end(IFETCH_BUFFER) && champsim::block_number{fetched->ip} == champsim::block_number{l1i_entry.v_address} && fetched->fetch_issued) {
+        fetched->fetch_completed = true;
+        fetch_bw.consume();
+        ++progress;
+
+        if constexpr (champsim::debug_print) {
+          fmt::print("[IFETCH] {} instr_id: {} fetch completed\n", __func__, fetched->instr_id);
+        }
+      }
+
+      l1i_entry.instr_depend_on_me.erase(std::begin(l1i_entry.instr_depend_on_me));
+    }
+
+    // remove this entry if we have serviced all of its instructions
+    if (l1i_entry.instr_depend_on_me.empty()) {
+      L1I_bus.lower_level->returned.pop_front();
+      ++progress;
+    }
+  }
+
+  auto l1d_it = std::begin(L1D_bus.lower_level->returned);
+  for (champsim::bandwidth l1d_bw{shape.L1D_BANDWIDTH}; l1d_bw.has_remaining() && l1d_it != std::end(L1D_bus.lower_level->returned);
+       l1d_bw.consume(), ++l1d_it) {
+    for (auto& lq_entry : LQ) {
+      // Loads that bypassed an older store complete speculatively. The store checks them for a violation when it executes.
+      if (lq_entry.has_value() && lq_entry->fetch_issued && champsim::block_number{lq_entry->virtual_address} == champsim::block_number{l1d_it->v_address}) {
+        lq_entry->miss_depth = l1d_it->miss_depth;
+        lq_entry->page_walked = l1d_it->page_walked;
+        lq_entry->finish(std::begin(ROB), std::end(ROB));
+        lq_entry.reset();
+        ++progress;
+      }
+    }
+    ++progress;
+  }
+  L1D_bus.lower_level->returned.erase(std::begin(L1D_bus.lower_level->returned), l1d_it);
+
+  return progress;
+}
+
+template <typename Shape>
+long O3_CPU::retire_rob(const Shape& shape)
+{
+  auto [retire_begin, retire_end] =
+      champsim::get_span_p(std::cbegin(ROB), std::cend(ROB), champsim::bandwidth{shape.RETIRE_WIDTH}, [](const auto& x) { return x.completed; });
+  assert(std::distance(retire_begin, retire_end) >= 0); // end succeeds begin
+  if constexpr (champsim::debug_print) {
+    std::for_each(retire_begin, retire_end, [cycle = current_time.time_since_epoch() / clock_period](const auto& x) {
+      fmt::print("[ROB] retire_rob instr_id: {} is retired cycle: {}\n", x.instr_id, cycle);
+    });
+  }
+
+  // commit register writes to backend RAT
+  // and recycle the old physical registers
+  for (auto rob_it = retire_begin; rob_it != retire_end; ++rob_it) {
+    for (auto dreg : rob_it->destination_registers) {
+      reg_allocator.retire_dest_register(dreg);
+    }
+    do_retire_accounting(*rob_it);
+  }
+
+  auto retire_count = std::distance(retire_begin, retire_end);
+  if (retire_count == 0) {
+    do_stall_accounting();
+  }
+
+  num_retired += retire_count;
+  ROB.erase(retire_begin, retire_end);
+
+  return retire_count;
+}
+
+#endif
@@ -36,6 +36,8 @@ struct phase_info {
   long long length;
   std::vector<std::size_t> trace_index;
   std::vector<std::string> trace_names;
+  bool is_functional = false;     // a warmup phase run on the functional cache model, without timing
+  bool train_prefetchers = false; // whether the prefetchers are trained during a functional phase
 };
 
 struct phase_stats {
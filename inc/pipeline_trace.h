@@ -0,0 +1,52 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PIPELINE_TRACE_H
+#define PIPELINE_TRACE_H
+
+#include <cstdint>
+#include <ostream>
+
+#include "chrono.h"
+#include "instruction.h"
+
+namespace champsim
+{
+/**
+ * Writes the pipeline timeline of retired instructions in gem5's O3PipeView format, which can be viewed with Konata or gem5's o3-pipeview.py.
+ *
+ * Instructions are sampled in windows: the first sample_length instructions of every sample_interval instructions are written.
+ * Times are given in picoseconds, the same unit as gem5 ticks.
+ */
+class pipeline_tracer
+{
+  std::ostream* out;
+  uint64_t sample_interval;
+  uint64_t sample_length;
+
+public:
+  explicit pipeline_tracer(std::ostream& stream, uint64_t interval = 1, uint64_t length = 1);
+
+  [[nodiscard]] bool sampled(uint64_t instr_id) const;
+
+  /**
+   * Write the timeline of an instruction that retires at the given time, if it is sampled.
+   */
+  void retire(const ooo_model_instr& instr, champsim::chrono::clock::time_point retire_time);
+};
+} // namespace champsim
+
+#endif
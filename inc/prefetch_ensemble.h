@@ -0,0 +1,105 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef PREFETCH_ENSEMBLE_H
+#define PREFETCH_ENSEMBLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace champsim
+{
+/**
+ * The width, in bits, of each component's slice of the prefetch metadata when a cache combines several prefetchers.
+ * A lone prefetcher owns the whole 32 bits.
+ */
+constexpr unsigned metadata_slice_width(std::size_t components)
+{
+  return components <= 1 ? 32u : static_cast<unsigned>(32 / components);
+}
+
+/**
+ * The part of the metadata that belongs to the component at the given position
+ */
+constexpr uint32_t get_metadata_slice(uint32_t metadata, std::size_t position, std::size_t components)
+{
+  const auto width = metadata_slice_width(components);
+  if (width >= 32)
+    return metadata;
+  return (metadata >> (width * position)) & ((uint32_t{1} << width) - 1);
+}
+
+/**
+ * Replace the part of the metadata that belongs to the component at the given position. Bits of the value beyond the slice width are discarded.
+ */
+constexpr uint32_t set_metadata_slice(uint32_t metadata, uint32_t value, std::size_t position, std::size_t components)
+{
+  const auto width = metadata_slice_width(components);
+  if (width >= 32)
+    return value;
+  const uint32_t mask = ((uint32_t{1} << width) - 1) << (width * position);
+  return (metadata & ~mask) | ((value << (width * position)) & mask);
+}
+
+/**
+ * Orders the prefetches of the components of an ensemble when they compete for the internal prefetch queue.
+ *
+ * The cache reports each prefetch that a component issues, and whether it was later used or evicted unused.
+ * At the end of each cycle, the candidates are sorted by the rank of the component that produced them, and only as many as fit in the queue are issued.
+ */
+class prefetch_arbiter
+{
+public:
+  enum class policy {
+    PRIORITY,    // components listed earlier always win
+    ROUND_ROBIN, // the winning component rotates each cycle
+    ACCURACY,    // the component whose prefetches have been used most often wins
+    SELECTOR     // a saturating counter per component, trained on useful and useless prefetches, selects the winner
+  };
+
+  constexpr static unsigned selector_max = 15;
+  constexpr static unsigned selector_initial = 8;
+
+private:
+  struct component_state {
+    uint64_t issued = 0;
+    uint64_t useful = 0;
+    unsigned selector = selector_initial;
+  };
+
+  policy arbitration;
+  std::vector<component_state> components;
+  std::size_t round_robin_head = 0;
+
+  [[nodiscard]] double accuracy(std::size_t component) const;
+
+public:
+  prefetch_arbiter(policy arbitration, std::size_t num_components);
+
+  void record_issue(std::size_t component);
+  void record_useful(std::size_t component);
+  void record_useless(std::size_t component);
+
+  /**
+   * The rank of each component in this cycle, where a lower rank wins. Calling this advances the round-robin policy.
+   */
+  [[nodiscard]] std::vector<std::size_t> rank();
+
+  [[nodiscard]] policy get_policy() const { return arbitration; }
+};
+} // namespace champsim
+
+#endif
@@ -0,0 +1,100 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PREFETCH_THROTTLE_H
+#define PREFETCH_THROTTLE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace champsim
+{
+/**
+ * Feedback-directed prefetch throttling (Srinath et al., HPCA 2007), extended with the DRAM bandwidth signal.
+ *
+ * The cache reports prefetch issues, uses, demand misses and evictions. At the end of each interval, measured in evictions, the accuracy, lateness
+ * and pollution of the prefetches are compared against thresholds, and the aggressiveness level moves up or down by one. Each level recommends a
+ * prefetch degree and distance that prefetchers may query. While the DRAM bandwidth bucket is high, the most conservative degree is recommended.
+ */
+class prefetch_throttle
+{
+public:
+  struct level_type {
+    unsigned degree;
+    unsigned distance;
+  };
+
+  // The aggressiveness levels, from very conservative to very aggressive
+  constexpr static std::array<level_type, 5> levels{{{1, 4}, {1, 8}, {2, 16}, {4, 32}, {4, 64}}};
+  constexpr static std::size_t initial_level = 2;
+
+  constexpr static double accuracy_high = 0.75;
+  constexpr static double accuracy_low = 0.40;
+  constexpr static double lateness_threshold = 0.01;
+  constexpr static double pollution_threshold = 0.005;
+  constexpr static uint8_t high_bandwidth_bucket = 12; // of 16, or 75% of peak DRAM bandwidth
+
+  constexpr static uint64_t default_interval = 8192;
+
+private:
+  struct counters {
+    double issued = 0;
+    double useful = 0;
+    double late = 0;
+    double demand_misses = 0;
+    double polluting_misses = 0;
+  };
+
+  counters interval_counts{}; // since the end of the last interval
+  counters history{};         // exponentially averaged over past intervals
+
+  uint64_t interval;
+  uint64_t evictions = 0;
+  std::size_t current_level = initial_level;
+  uint8_t bandwidth_bucket = 0;
+
+  void end_interval();
+
+public:
+  explicit prefetch_throttle(uint64_t interval = default_interval);
+
+  void record_issue();
+  void record_use(bool late);
+  void record_demand_miss(bool caused_by_prefetch);
+  void record_eviction();
+  void record_bandwidth(uint8_t bucket);
+
+  [[nodiscard]] std::size_t level() const;
+  [[nodiscard]] bool bandwidth_limited() const;
+
+  /**
+   * The number of prefetches each prefetcher activation should issue
+   */
+  [[nodiscard]] unsigned degree() const;
+
+  /**
+   * How far ahead of the demand stream, in blocks, prefetchers should run
+   */
+  [[nodiscard]] unsigned distance() const;
+
+  [[nodiscard]] double accuracy() const;
+  [[nodiscard]] double lateness() const;
+  [[nodiscard]] double pollution() const;
+};
+} // namespace champsim
+
+#endif
@@ -2,7 +2,8 @@
 #include <cstdint>
 #include <list>
 #include <optional>
-#include <queue>
+#include <utility>
+#include <vector>
 
 #ifndef REG_ALLOC_H
 #define REG_ALLOC_H
@@ -19,14 +20,37 @@ struct physical_register {
 class RegisterAllocator
 {
 private:
+  using free_word_type = uint64_t;
+  constexpr static std::size_t free_word_bits = std::numeric_limits<free_word_type>::digits;
+
   std::array<PHYSICAL_REGISTER_ID, std::numeric_limits<uint8_t>::max() + 1> frontend_RAT, backend_RAT;
-  std::queue<PHYSICAL_REGISTER_ID> free_registers;
+  std::vector<free_word_type> free_registers; // one bit per physical register, set if the register is free
   std::vector<physical_register> physical_register_file;
 
+  PHYSICAL_REGISTER_ID allocate_register();
+
 public:
   RegisterAllocator(size_t num_physical_registers);
   PHYSICAL_REGISTER_ID rename_dest_register(int16_t reg, champsim::program_ordered<ooo_model_instr>::id_type producer_id);
   PHYSICAL_REGISTER_ID rename_src_register(int16_t reg);
+
+  /**
+   * Rename all source and destination registers of an instruction.
+   */
+  void rename(ooo_model_instr& instr);
+
+  /**
+   * The number of free registers that renaming the instruction may consume.
+   */
+  [[nodiscard]] unsigned long registers_needed(const ooo_model_instr& instr) const;
+
+  /**
+   * Rename a group of instructions in program order, renaming only those that satisfy the predicate.
+   * The group ends early at the first instruction that needs more registers than are free, and an iterator to that instruction is returned.
+   */
+  template <typename It, typename Pred>
+  It rename_group(It begin, It end, Pred should_rename);
+
   void complete_dest_register(PHYSICAL_REGISTER_ID physreg);
   void retire_dest_register(PHYSICAL_REGISTER_ID physreg);
   void free_register(PHYSICAL_REGISTER_ID physreg);
@@ -37,4 +61,17 @@ public:
   void reset_frontend_RAT();
   void print_deadlock();
 };
+
+template <typename It, typename Pred>
+It RegisterAllocator::rename_group(It begin, It end, Pred should_rename)
+{
+  auto free_count = count_free_registers();
+  for (; begin != end && free_count >= registers_needed(*begin); ++begin) {
+    if (should_rename(std::as_const(*begin))) {
+      rename(*begin);
+      free_count = count_free_registers();
+    }
+  }
+  return begin;
+}
 #endif
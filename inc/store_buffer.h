@@ -0,0 +1,89 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef STORE_BUFFER_H
+#define STORE_BUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+#include "channel.h"
+#include "chrono.h"
+
+namespace champsim
+{
+/**
+ * A post-retirement store buffer that coalesces committed stores to the same block before they are written to the first-level data cache.
+ *
+ * Each entry holds one block and a mask of the words that its stores wrote, taking each store to write one word. A store coalesces only into the youngest
+ * entry, and entries leave in the order they were allocated, so that no store becomes visible before an older one. The oldest entry leaves once all its words are written, once the buffer is more than half
+ * full, or once it has waited long enough. An entry whose words are all written is sent as a full-line write, which a cache may fill without reading the
+ * block for ownership.
+ */
+class store_buffer
+{
+public:
+  using request_type = typename champsim::channel::request_type;
+
+  enum class add_result { ADDED, COALESCED, FULL };
+
+  constexpr static std::size_t word_size = 8; // bytes
+  constexpr static long default_max_wait_cycles = 16;
+
+private:
+  struct entry_type {
+    request_type packet;
+    uint64_t written_words;
+    champsim::chrono::clock::time_point time_enqueued;
+  };
+
+  std::size_t capacity;
+  champsim::data::bits offset_bits;
+  champsim::chrono::clock::duration max_wait;
+  std::deque<entry_type> entries{};
+
+  [[nodiscard]] uint64_t full_mask() const;
+  [[nodiscard]] uint64_t word_bit(champsim::address address) const;
+
+public:
+  store_buffer(std::size_t size, champsim::data::bits offset_bits, champsim::chrono::clock::duration max_wait);
+
+  /**
+   * Whether the buffer holds any stores at all. A buffer of size zero is disabled, and the core writes each store to the cache directly.
+   */
+  [[nodiscard]] bool enabled() const;
+
+  add_result add(const request_type& packet, champsim::chrono::clock::time_point now);
+
+  /**
+   * Whether the oldest entry should be written to the cache now
+   */
+  [[nodiscard]] bool ready(champsim::chrono::clock::time_point now) const;
+
+  /**
+   * The write for the oldest entry, marked as a full-line write if all its words were written
+   */
+  [[nodiscard]] request_type front() const;
+  void pop_front();
+
+  [[nodiscard]] bool contains(champsim::address v_address) const;
+  [[nodiscard]] std::size_t size() const;
+};
+} // namespace champsim
+
+#endif
@@ -0,0 +1,88 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STORE_SET_H
+#define STORE_SET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "address.h"
+
+namespace champsim
+{
+/**
+ * A store set memory dependence predictor (Chrysos and Emer, ISCA 1998).
+ *
+ * The Store Set ID Table (SSIT) maps instruction addresses to store sets, and the Last Fetched Store Table (LFST) holds the most recently dispatched
+ * store in each set that has not yet executed. A load that maps to a store set with a pending store is predicted to depend on that store.
+ * Store sets are formed when a load is found to have executed before an older store to the same address.
+ *
+ * A predictor with an empty SSIT or LFST is disabled.
+ */
+class store_set_predictor
+{
+public:
+  using id_type = uint64_t;
+
+private:
+  using ssid_type = std::size_t;
+
+  std::vector<std::optional<ssid_type>> ssit;
+  std::vector<std::optional<id_type>> lfst;
+
+  uint64_t clear_interval;
+  uint64_t accesses_since_clear = 0;
+
+  [[nodiscard]] std::size_t ssit_index(champsim::address ip) const;
+
+public:
+  /**
+   * The number of lookups after which the SSIT is cleared, so that store sets made stale by changes in program behavior are forgotten.
+   */
+  constexpr static uint64_t default_clear_interval = 1000000;
+
+  store_set_predictor(std::size_t ssit_size, std::size_t lfst_size, uint64_t clear_interval = default_clear_interval);
+
+  [[nodiscard]] bool enabled() const;
+
+  /**
+   * Look up the store on which a dispatching load is predicted to depend, if any.
+   */
+  [[nodiscard]] std::optional<id_type> predict_load(champsim::address ip);
+
+  /**
+   * Record a dispatching store as the last fetched store of its set.
+   */
+  void dispatch_store(champsim::address ip, id_type id);
+
+  /**
+   * Remove an executing store from the LFST, so that later loads in its set do not wait for it.
+   */
+  void execute_store(champsim::address ip, id_type id);
+
+  /**
+   * Place a load and a store into the same store set, after the load was found to have executed before the store.
+   */
+  void train_violation(champsim::address load_ip, champsim::address store_ip);
+
+  void clear();
+};
+} // namespace champsim
+
+#endif
@@ -0,0 +1,80 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TAG_STORE_H
+#define TAG_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace champsim
+{
+/**
+ * A structure-of-arrays copy of the tags of a cache, for fast lookup.
+ *
+ * The tags of each set are packed contiguously, next to a bitmask of the valid ways, so that a lookup compares the whole set at once.
+ * Where the processor supports AVX2, four tags are compared per instruction. Otherwise, the lookup falls back to a scalar loop over the packed tags.
+ * The store holds at most 64 ways per set.
+ */
+class tag_store
+{
+public:
+  using tag_type = uint64_t;
+  using mask_type = uint64_t;
+
+  constexpr static std::size_t max_ways = 64;
+
+private:
+  std::size_t num_way;
+  std::size_t stride; // the number of tags per set, padded to a whole number of vectors
+  std::vector<tag_type> tags;
+  std::vector<mask_type> valid;
+  bool use_simd;
+
+  [[nodiscard]] mask_type match_scalar(std::size_t set, tag_type tag) const;
+  [[nodiscard]] mask_type match_simd(std::size_t set, tag_type tag) const;
+
+public:
+  /**
+   * \param allow_simd Whether to use the vector lookup where the processor supports it. The scalar lookup always gives the same results.
+   * \throws std::invalid_argument if there are more than 64 ways.
+   */
+  tag_store(std::size_t sets, std::size_t ways, bool allow_simd = true);
+
+  /**
+   * Whether the vector lookup is available on this processor
+   */
+  [[nodiscard]] static bool simd_available();
+  [[nodiscard]] bool uses_simd() const { return use_simd; }
+
+  /**
+   * The way of the set that holds a valid block with the given tag, if any
+   */
+  [[nodiscard]] std::optional<std::size_t> find(std::size_t set, tag_type tag) const;
+
+  /**
+   * The lowest way of the set that holds no valid block, if any
+   */
+  [[nodiscard]] std::optional<std::size_t> find_invalid(std::size_t set) const;
+
+  void insert(std::size_t set, std::size_t way, tag_type tag);
+  void erase(std::size_t set, std::size_t way);
+};
+} // namespace champsim
+
+#endif
@@ -30,10 +30,12 @@
 namespace champsim
 {
 using msl::bitmask;
+using msl::countr_zero;
 using msl::ipow;
 using msl::is_power_of_2;
 using msl::lg2;
 using msl::next_pow2;
+using msl::popcount;
 using msl::splice_bits;
 } // namespace champsim
 
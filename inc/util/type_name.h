@@ -0,0 +1,49 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UTIL_TYPE_NAME_H
+#define UTIL_TYPE_NAME_H
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <typeinfo>
+
+#if defined(__GNUG__) || defined(__clang__)
+#include <cxxabi.h>
+#endif
+
+namespace champsim
+{
+/*
+ * The readable name of a type, used to label statistics that belong to a module.
+ * Falls back to the implementation-defined name where demangling is not available.
+ */
+template <typename T>
+std::string type_name()
+{
+  const char* mangled = typeid(T).name();
+#if defined(__GNUG__) || defined(__clang__)
+  int status = 0;
+  std::unique_ptr<char, decltype(&std::free)> demangled{abi::__cxa_demangle(mangled, nullptr, nullptr, &status), &std::free};
+  if (status == 0 && demangled != nullptr)
+    return std::string{demangled.get()};
+#endif
+  return std::string{mangled};
+}
+} // namespace champsim
+
+#endif
@@ -0,0 +1,63 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VICTIM_CACHE_H
+#define VICTIM_CACHE_H
+
+#include <cstddef>
+#include <deque>
+#include <optional>
+
+#include "address.h"
+#include "block.h"
+
+namespace champsim
+{
+/**
+ * A small, fully associative buffer of the blocks most recently evicted from a cache (Jouppi, ISCA 1990).
+ *
+ * A block evicted from the cache is kept here, and a miss that finds its block here swaps it back into the cache instead of going to the lower level.
+ * When the buffer is full, the least recently inserted block is displaced, and the cache writes it back if it is dirty.
+ */
+class victim_cache
+{
+  std::size_t capacity;
+  champsim::data::bits offset_bits;
+  std::deque<champsim::cache_block> blocks{}; // the most recently inserted at the back
+
+  [[nodiscard]] auto find(champsim::address address);
+
+public:
+  victim_cache(std::size_t size, champsim::data::bits offset_bits);
+
+  /**
+   * Remove the block with the given address, and return it, if it is here
+   */
+  std::optional<champsim::cache_block> take(champsim::address address);
+
+  /**
+   * The block that the next insertion would displace, if the buffer is full
+   */
+  [[nodiscard]] std::optional<champsim::cache_block> displaced() const;
+
+  void insert(const champsim::cache_block& block);
+
+  [[nodiscard]] bool contains(champsim::address address) const;
+  [[nodiscard]] std::size_t size() const;
+};
+} // namespace champsim
+
+#endif
@@ -46,6 +46,7 @@ public:
 
 private:
   std::deque<champsim::page_number> ppage_free_list;
+  std::size_t reserved_ppages = 0; // pages at the top of physical memory that are never used for translations
   champsim::page_number active_pte_page{};
   champsim::address_slice<champsim::dynamic_extent> next_pte_page;
 
@@ -59,6 +60,12 @@ private:
   void populate_pages();
 
 public:
+  /**
+   * If set, all cores translate through one address space, so that the threads of a multithreaded workload share physical pages.
+   * Otherwise, the cpu index is used as the address space ID.
+   */
+  bool shared_address_space = false;
+
   /**
    * Initialize the virtual memory.
    * The size of the virtual memory space is determined from the size of a page table page and the number of levels in the hierarchy.
@@ -96,6 +103,16 @@ public:
    */
   [[nodiscard]] std::size_t available_ppages() const;
 
+  /**
+   * Remove a contiguous range of physical memory from the pages available to translations.
+   * Structures that the simulator keeps in memory are placed there, so that they do not alias any page.
+   * This must be called before any translation is made.
+   *
+   * :param size: The size of the range. It is rounded up to a whole number of pages.
+   * :returns: The base address of the range.
+   */
+  champsim::address reserve_region(champsim::data::bytes size);
+
   /**
    * Translate the given address from the virtual space to the physical space.
    * If a page translation does not already exist, one will be created and the minor fault penalty will be applied.
@@ -0,0 +1,90 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WAY_PARTITION_H
+#define WAY_PARTITION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace champsim
+{
+/**
+ * A partition of the ways of a shared cache among the cores that use it.
+ *
+ * Each core may only fill the ways in its mask, though it may hit anywhere. The masks are either given statically, or found by utility-based
+ * cache partitioning (Qureshi and Patt, MICRO 2006): a utility monitor per core keeps an LRU stack of tags for a sample of the sets, and counts the hits
+ * at each stack position. At the end of each interval, measured in monitored accesses, the lookahead algorithm allocates the ways to the cores with
+ * the highest marginal utility, each core gets a contiguous range of ways, and the counters are halved.
+ */
+class way_partition
+{
+public:
+  using mask_type = uint64_t;
+
+  constexpr static std::size_t max_ways = 64;
+  constexpr static std::size_t sampled_sets = 32;
+  constexpr static uint64_t default_interval = 1000000;
+
+private:
+  struct monitor {
+    std::vector<std::vector<uint64_t>> stacks; // per sampled set, the most recently used tag first
+    std::vector<uint64_t> hits;                // per stack position
+  };
+
+  std::size_t num_sets;
+  std::size_t num_ways;
+  uint64_t interval;
+  uint64_t accesses = 0;
+  uint64_t repartition_count = 0;
+  bool utility_based;
+
+  std::vector<mask_type> masks;
+  std::vector<monitor> monitors{};
+
+  [[nodiscard]] bool is_sampled(long set) const;
+  void repartition();
+
+public:
+  /**
+   * A static partition, where core i may fill the ways in masks[i]. Cores without a mask may fill any way.
+   */
+  way_partition(std::size_t sets, std::size_t ways, std::vector<mask_type> static_masks);
+
+  /**
+   * A utility-based partition, repartitioned every interval monitored accesses
+   */
+  way_partition(std::size_t sets, std::size_t ways, uint64_t repartition_interval);
+
+  /**
+   * Record a demand access by a core to the utility monitors, repartitioning at the end of an interval.
+   * Static partitions ignore this.
+   */
+  void record_access(uint32_t cpu, long set, uint64_t block);
+
+  [[nodiscard]] mask_type mask(uint32_t cpu) const;
+  [[nodiscard]] bool allows(uint32_t cpu, long way) const { return ((mask(cpu) >> way) & 1) != 0; }
+
+  /**
+   * The number of ways that each core may fill, for the cores that have a mask
+   */
+  [[nodiscard]] std::vector<uint64_t> allocation() const;
+  [[nodiscard]] uint64_t repartitions() const { return repartition_count; }
+};
+} // namespace champsim
+
+#endif
@@ -0,0 +1,60 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WRITE_COMBINING_BUFFER_H
+#define WRITE_COMBINING_BUFFER_H
+
+#include <cstddef>
+#include <deque>
+
+#include "channel.h"
+
+namespace champsim
+{
+/**
+ * A buffer between a cache and the write queue of its lower level, which holds the blocks that the cache writes back.
+ *
+ * A write to a block that is already waiting here is combined with it, and the lower level sees one write instead of two. The buffer is drained,
+ * oldest first, while it is more than half full, and one block at a time whenever the lower level has no writes waiting.
+ */
+class write_combining_buffer
+{
+public:
+  using request_type = typename champsim::channel::request_type;
+
+  enum class add_result { ADDED, COMBINED, FULL };
+
+private:
+  std::size_t capacity;
+  champsim::data::bits offset_bits;
+  std::deque<request_type> entries{};
+
+public:
+  write_combining_buffer(std::size_t size, champsim::data::bits offset_bits);
+
+  add_result add(const request_type& packet);
+
+  /**
+   * Send the writes that should leave the buffer now to the given channel, and return how many were sent
+   */
+  long drain(champsim::channel& lower_level);
+
+  [[nodiscard]] bool contains(champsim::address address) const;
+  [[nodiscard]] std::size_t size() const;
+};
+} // namespace champsim
+
+#endif
@@ -1,6 +1,8 @@
 #include "feature_knowledge.h"
 
+#include <algorithm>
 #include <assert.h>
+#include <memory>
 #include <stdio.h>
 
 #include "util/util.h"
@@ -45,46 +47,46 @@ FeatureKnowledge::FeatureKnowledge(FeatureType feature_type, float alpha, float
   assert(m_num_tilings <= FK_MAX_TILINGS);
   assert(m_num_tilings == 1 || m_enable_tiling_offset); /* enforce the use of tiling offsets in case of multiple tilings */
 
-  /* create Q-table */
-  m_qtable = (float***)calloc(m_num_tilings, sizeof(float**));
+  /* create Q-table, with enough slack to align its start to a cache line */
+  m_row_stride = (m_actions + floats_per_line - 1) / floats_per_line * floats_per_line;
+  assert(m_row_stride <= PYTHIA::max_actions);
+  std::size_t table_size = (std::size_t)m_num_tilings * m_num_tiles * m_row_stride;
+  m_qtable_storage.resize(table_size + floats_per_line - 1);
+  void* table_begin = m_qtable_storage.data();
+  std::size_t space = m_qtable_storage.size() * sizeof(float);
+  m_qtable = static_cast<float*>(std::align(64, table_size * sizeof(float), table_begin, space));
   assert(m_qtable);
-  for (uint32_t tiling = 0; tiling < m_num_tilings; ++tiling) {
-    m_qtable[tiling] = (float**)calloc(m_num_tiles, sizeof(float*));
-    assert(m_qtable[tiling]);
-    for (uint32_t tile = 0; tile < m_num_tiles; ++tile) {
-      m_qtable[tiling][tile] = (float*)calloc(m_actions, sizeof(float));
-      assert(m_qtable[tiling][tile]);
-    }
-  }
 
-  /* init Q-table */
+  /* init Q-table. The padding at the end of each row is zero and never selected. */
   m_init_value = (float)1ul / (1 - gamma);
 
   for (uint32_t tiling = 0; tiling < m_num_tilings; ++tiling) {
     for (uint32_t tile = 0; tile < m_num_tiles; ++tile) {
-      for (uint32_t action = 0; action < m_actions; ++action) {
-        m_qtable[tiling][tile][action] = m_init_value;
-      }
+      float* row = getRow(tiling, tile);
+      std::fill(row, row + m_actions, m_init_value);
     }
   }
 }
 
 FeatureKnowledge::~FeatureKnowledge() {}
 
-float FeatureKnowledge::getQ(uint32_t tiling, uint32_t tile_index, uint32_t action)
+float* FeatureKnowledge::getRow(uint32_t tiling, uint32_t tile_index)
 {
   assert(tiling < m_num_tilings);
   assert(tile_index < m_num_tiles);
+  return m_qtable + ((std::size_t)tiling * m_num_tiles + tile_index) * m_row_stride;
+}
+
+float FeatureKnowledge::getQ(uint32_t tiling, uint32_t tile_index, uint32_t action)
+{
   assert(action < m_actions);
-  return m_qtable[tiling][tile_index][action];
+  return getRow(tiling, tile_index)[action];
 }
 
 void FeatureKnowledge::setQ(uint32_t tiling, uint32_t tile_index, uint32_t action, float value)
 {
-  assert(tiling < m_num_tilings);
-  assert(tile_index < m_num_tiles);
   assert(action < m_actions);
-  m_qtable[tiling][tile_index][action] = value;
+  getRow(tiling, tile_index)[action] = value;
 }
 
 float FeatureKnowledge::retrieveQ(State* state, uint32_t action)
@@ -100,6 +102,19 @@ float FeatureKnowledge::retrieveQ(State* state, uint32_t action)
   return q_value;
 }
 
+void FeatureKnowledge::retrieveQ(State* state, float* q_values)
+{
+  /* Each tile index is hashed once for all actions, and the rows are summed in the same order as retrieveQ(state, action),
+   * so that the results are identical. */
+  std::fill(q_values, q_values + m_row_stride, 0.0f);
+  for (uint32_t tiling = 0; tiling < m_num_tilings; ++tiling) {
+    const float* row = getRow(tiling, get_tile_index(tiling, state));
+    for (uint32_t action = 0; action < m_row_stride; ++action) {
+      q_values[action] += row[action];
+    }
+  }
+}
+
 void FeatureKnowledge::updateQ(State* state1, uint32_t action1, int32_t reward, State* state2, uint32_t action2)
 {
   uint32_t tile_index1 = 0, tile_index2 = 0;
@@ -191,8 +206,11 @@ uint32_t FeatureKnowledge::getMaxAction(State* state)
   float max_q_value = 0.0, q_value = 0.0;
   uint32_t selected_action = 0, init_index = 0;
 
+  float q_values[PYTHIA::max_actions];
+  retrieveQ(state, q_values);
+
   for (uint32_t action = init_index; action < m_actions; ++action) {
-    q_value = retrieveQ(state, action);
+    q_value = q_values[action];
     if (q_value > max_q_value) {
       max_q_value = q_value;
       selected_action = action;
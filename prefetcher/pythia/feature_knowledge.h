@@ -2,6 +2,7 @@
 #define FEATURE_KNOWLEDGE
 
 #include <string>
+#include <vector>
 
 #include "pythia_helper.h"
 
@@ -40,10 +41,18 @@ private:
   uint32_t m_hash_type;
 
   uint32_t m_num_tilings, m_num_tiles;
-  float*** m_qtable;
   bool m_enable_tiling_offset;
 
+  /* Q-table: one contiguous array of [tiling][tile] rows, each holding the Q-values of all actions.
+   * Rows are padded to whole cache lines and the table is cache-line aligned, so that a row is fetched in as few lines as possible
+   * and the per-action loops over a row can be vectorized. */
+  static constexpr uint32_t floats_per_line = 64 / sizeof(float);
+  uint32_t m_row_stride;
+  std::vector<float> m_qtable_storage;
+  float* m_qtable;
+
 private:
+  float* getRow(uint32_t tiling, uint32_t tile_index);
   float getQ(uint32_t tiling, uint32_t tile_index, uint32_t action);
   void setQ(uint32_t tiling, uint32_t tile_index, uint32_t action, float value);
   uint32_t get_tile_index(uint32_t tiling, State* state);
@@ -76,6 +85,8 @@ public:
                    int32_t enable_tiling_offset);
   ~FeatureKnowledge();
   float retrieveQ(State* state, uint32_t action_index);
+  void retrieveQ(State* state, float* q_values); /* Q-values of all actions, summed over the tilings. q_values must hold getRowStride() values */
+  uint32_t getRowStride() const { return m_row_stride; }
   void updateQ(State* state1, uint32_t action1, int32_t reward, State* state2, uint32_t action2);
   static std::string getFeatureString(FeatureType type);
   uint32_t getMaxAction(State* state); /* Called by featurewise engine only to get a consensus from all the features */
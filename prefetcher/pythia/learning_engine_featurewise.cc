@@ -1,5 +1,6 @@
 #include "learning_engine_featurewise.h"
 
+#include <algorithm>
 #include <assert.h>
 #include <iostream>
 #include <numeric>
@@ -109,15 +110,18 @@ uint32_t LearningEngineFeaturewise::getMaxAction(State* state, float& max_q)
   float max_q_value = 0.0, q_value = 0.0;
   uint32_t selected_action = 0, init_index = 0;
 
+  float q_values[PYTHIA::max_actions];
+  consultQ(state, q_values);
+
   bool fallback = do_fallback(state);
 
   if (!fallback) {
-    max_q_value = consultQ(state, 0);
+    max_q_value = q_values[0];
     init_index = 1;
   }
 
   for (uint32_t action = init_index; action < m_actions; ++action) {
-    q_value = consultQ(state, action);
+    q_value = q_values[action];
     if (q_value > max_q_value) {
       max_q_value = q_value;
       selected_action = action;
@@ -131,31 +135,36 @@ uint32_t LearningEngineFeaturewise::getMaxAction(State* state, float& max_q)
   return selected_action;
 }
 
-float LearningEngineFeaturewise::consultQ(State* state, uint32_t action)
+void LearningEngineFeaturewise::consultQ(State* state, float* q_values)
 {
-  assert(action < m_actions);
-  float q_value = 0.0;
-  float max = -1000000000.0;
+  /* Each feature's Q-values are retrieved for all actions at once, and pooled elementwise.
+   * Features are pooled in the same order for every action, so the result matches pooling one action at a time. */
+  float feature_q[PYTHIA::max_actions];
+  float max[PYTHIA::max_actions];
+  std::fill(q_values, q_values + PYTHIA::max_actions, 0.0f);
+  std::fill(std::begin(max), std::end(max), -1000000000.0f);
 
   /* pool Q-value accross all feature tables */
   for (uint32_t index = 0; index < NumFeatureTypes; ++index) {
     if (m_feature_knowledges[index]) {
+      m_feature_knowledges[index]->retrieveQ(state, feature_q);
+      uint32_t stride = m_feature_knowledges[index]->getRowStride();
       if (PYTHIA::le_featurewise_pooling_type == 1) /* sum pooling */
       {
-        q_value += m_feature_knowledges[index]->retrieveQ(state, action);
+        for (uint32_t action = 0; action < stride; ++action)
+          q_values[action] += feature_q[action];
       } else if (PYTHIA::le_featurewise_pooling_type == 2) /* max pooling */
       {
-        float tmp = m_feature_knowledges[index]->retrieveQ(state, action);
-        if (tmp >= max) {
-          max = tmp;
-          q_value = tmp;
+        for (uint32_t action = 0; action < stride; ++action) {
+          bool take = feature_q[action] >= max[action];
+          max[action] = take ? feature_q[action] : max[action];
+          q_values[action] = take ? feature_q[action] : q_values[action];
         }
       } else {
         assert(false);
       }
     }
   }
-  return q_value;
 }
 
 void LearningEngineFeaturewise::dump_stats()
@@ -53,7 +53,7 @@ private:
   void init_knobs();
   void init_stats();
   uint32_t getMaxAction(State* state, float& max_q);
-  float consultQ(State* state, uint32_t action);
+  void consultQ(State* state, float* q_values);
   bool do_fallback(State* state);
 
 public:
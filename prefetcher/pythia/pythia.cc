@@ -15,7 +15,7 @@ void pythia::prefetcher_initialize()
 {
   init_knobs();
 
-  last_evicted_tracker = NULL;
+  last_evicted_tracker.reset();
   brain_featurewise = new LearningEngineFeaturewise(PYTHIA::alpha, PYTHIA::gamma, PYTHIA::epsilon, (uint32_t)Actions.size(), PYTHIA::seed, PYTHIA::policy,
                                                     PYTHIA::learning_type);
 }
@@ -43,19 +43,19 @@ uint32_t pythia::prefetcher_cache_operate(champsim::address addr, champsim::addr
    * state can contain per page local information like delta signature, pc signature etc.
    * it can also contain global signatures like last three branch PCs etc.
    */
-  State* state = new State();
-  state->pc = pc;
-  state->address = address;
-  state->page = page;
-  state->offset = offset;
-  state->delta = !stentry->deltas.empty() ? stentry->deltas.back() : 0;
-  state->local_delta_sig2 = stentry->get_delta_sig2();
-  state->local_pc_sig = stentry->get_pc_sig();
-  state->local_offset_sig = stentry->get_offset_sig();
-  state->is_high_bw = is_high_bw(get_dram_bw());
+  State state{};
+  state.pc = pc;
+  state.address = address;
+  state.page = page;
+  state.offset = offset;
+  state.delta = !stentry->deltas.empty() ? stentry->deltas.back() : 0;
+  state.local_delta_sig2 = stentry->get_delta_sig2();
+  state.local_pc_sig = stentry->get_pc_sig();
+  state.local_offset_sig = stentry->get_offset_sig();
+  state.is_high_bw = is_high_bw(get_dram_bw());
 
   // generate prefetch predictions
-  predict(address, page, offset, state, pref_addr);
+  predict(address, page, offset, &state, pref_addr);
 
   /* issue prefetches */
   for (uint32_t addr_index = 0; addr_index < pref_addr.size(); ++addr_index) {
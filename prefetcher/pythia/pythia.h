@@ -8,19 +8,20 @@
 #ifndef __PYTHIA_H__
 #define __PYTHIA_H__
 
-#include <deque>
+#include <optional>
 
 #include "champsim.h"
 #include "learning_engine_featurewise.h"
 #include "modules.h"
 #include "pythia_helper.h"
+#include "pythia_params.h"
 
 struct pythia : public champsim::modules::prefetcher {
 private:
-  std::deque<Scooby_STEntry*> signature_table;
+  Scooby_SignatureTable signature_table{PYTHIA::st_size};
   LearningEngineFeaturewise* brain_featurewise;
-  std::deque<Scooby_PTEntry*> prefetch_tracker;
-  Scooby_PTEntry* last_evicted_tracker;
+  Scooby_PrefetchTracker prefetch_tracker{PYTHIA::pt_size};
+  std::optional<Scooby_PTEntry> last_evicted_tracker;
 
   /* Action array: basically a set of deltas to evaluate */
   std::vector<int32_t> Actions;
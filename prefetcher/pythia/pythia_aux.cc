@@ -28,27 +28,19 @@ void pythia::update_global_state(uint64_t pc, uint64_t page, uint32_t offset, ui
 Scooby_STEntry* pythia::update_local_state(uint64_t pc, uint64_t page, uint32_t offset, uint64_t address)
 {
   stats.st.lookup++;
-  Scooby_STEntry* stentry = NULL;
-  auto st_index = find_if(signature_table.begin(), signature_table.end(), [page](Scooby_STEntry* _stentry) { return _stentry->page == page; });
-  if (st_index != signature_table.end()) {
+  Scooby_STEntry* stentry = signature_table.touch(page);
+  if (stentry) {
     stats.st.hit++;
-    stentry = (*st_index);
     stentry->update(page, pc, offset, address);
-    signature_table.erase(st_index);
-    signature_table.push_back(stentry);
     return stentry;
   } else {
-    if (signature_table.size() >= PYTHIA::st_size) {
+    if (signature_table.full()) {
       stats.st.evict++;
-      stentry = signature_table.front();
-      signature_table.pop_front();
-      delete stentry;
+      signature_table.evict_lru();
     }
 
     stats.st.insert++;
-    stentry = new Scooby_STEntry(page, pc, offset);
-    signature_table.push_back(stentry);
-    return stentry;
+    return signature_table.insert(Scooby_STEntry(page, pc, offset));
   }
 }
 
@@ -162,29 +154,24 @@ bool pythia::track(uint64_t address, State* state, uint32_t action_index, Scooby
   }
 
   /* new prefetched address that hasn't been seen before */
-  Scooby_PTEntry* ptentry = NULL;
-
   if (prefetch_tracker.size() >= PYTHIA::pt_size) {
     stats.track.evict++;
-    ptentry = prefetch_tracker.front();
-    prefetch_tracker.pop_front();
-    MYLOG("victim_state %x victim_act_idx %u victim_act %d", ptentry->state->value(), ptentry->action_index, Actions[ptentry->action_index]);
-    if (last_evicted_tracker) {
-      MYLOG("last_victim_state %x last_victim_act_idx %u last_victim_act %d", last_evicted_tracker->state->value(), last_evicted_tracker->action_index,
+    Scooby_PTEntry& victim = prefetch_tracker.front();
+    MYLOG("victim_state %x victim_act_idx %u victim_act %d", victim.state.value(), victim.action_index, Actions[victim.action_index]);
+    if (last_evicted_tracker.has_value()) {
+      MYLOG("last_victim_state %x last_victim_act_idx %u last_victim_act %d", last_evicted_tracker->state.value(), last_evicted_tracker->action_index,
             Actions[last_evicted_tracker->action_index]);
       /* train the agent */
-      train(ptentry, last_evicted_tracker);
-      delete last_evicted_tracker->state;
-      delete last_evicted_tracker;
+      train(&victim, &last_evicted_tracker.value());
     }
-    last_evicted_tracker = ptentry;
+    last_evicted_tracker = victim;
+    prefetch_tracker.pop_front();
   }
 
-  ptentry = new Scooby_PTEntry(address, state, action_index);
-  prefetch_tracker.push_back(ptentry);
+  Scooby_PTEntry& ptentry = prefetch_tracker.push_back(Scooby_PTEntry(address, *state, action_index));
   assert(prefetch_tracker.size() <= PYTHIA::pt_size);
 
-  (*tracker) = ptentry;
+  (*tracker) = &ptentry;
   MYLOG("end@%lx", address);
 
   return new_addr;
@@ -200,10 +187,10 @@ uint32_t pythia::get_dyn_pref_degree(float max_to_avg_q_ratio, uint64_t page, in
   uint32_t degree = 1;
   bool high_bw = is_high_bw(get_dram_bw());
 
-  auto st_index = find_if(signature_table.begin(), signature_table.end(), [page](Scooby_STEntry* stentry) { return stentry->page == page; });
-  if (st_index != signature_table.end()) {
+  Scooby_STEntry* stentry = signature_table.find(page);
+  if (stentry) {
     int32_t conf = 0;
-    bool found = (*st_index)->search_action_tracker(action, conf);
+    bool found = stentry->search_action_tracker(action, conf);
     std::vector<int32_t> conf_thresholds, deg_normal;
 
     conf_thresholds = high_bw ? PYTHIA::last_pref_offset_conf_thresholds_hbw : PYTHIA::last_pref_offset_conf_thresholds;
@@ -281,7 +268,7 @@ void pythia::reward(uint64_t address)
     Scooby_PTEntry* ptentry = ptentries[index];
     stats.reward.demand.pt_found_total++;
 
-    MYLOG("PT hit. state %x act_idx %u act %d", ptentry->state->value(), ptentry->action_index, Actions[ptentry->action_index]);
+    MYLOG("PT hit. state %x act_idx %u act %d", ptentry->state.value(), ptentry->action_index, Actions[ptentry->action_index]);
     /* Do not compute reward if already has a reward.
      * This can happen when a prefetch access sees multiple demand reuse */
     if (ptentry->has_reward) {
@@ -308,7 +295,7 @@ void pythia::reward(uint64_t address)
 //----------------------------------------------------//
 void pythia::reward(Scooby_PTEntry* ptentry)
 {
-  MYLOG("reward PT evict %lx state %x act_idx %u act %d", ptentry->address, ptentry->state->value(), ptentry->action_index, Actions[ptentry->action_index]);
+  MYLOG("reward PT evict %lx state %x act_idx %u act %d", ptentry->address, ptentry->state.value(), ptentry->action_index, Actions[ptentry->action_index]);
 
   stats.reward.train.called++;
   assert(!ptentry->has_reward);
@@ -337,7 +324,7 @@ void pythia::reward(Scooby_PTEntry* ptentry)
 //----------------------------------------------------//
 void pythia::assign_reward(Scooby_PTEntry* ptentry, RewardType type)
 {
-  MYLOG("assign_reward PT evict %lx state %x act_idx %u act %d", ptentry->address, ptentry->state->value(), ptentry->action_index,
+  MYLOG("assign_reward PT evict %lx state %x act_idx %u act %d", ptentry->address, ptentry->state.value(), ptentry->action_index,
         Actions[ptentry->action_index]);
   assert(!ptentry->has_reward);
 
@@ -413,8 +400,8 @@ int32_t pythia::compute_reward(Scooby_PTEntry* ptentry, RewardType type)
 //----------------------------------------------------//
 void pythia::train(Scooby_PTEntry* curr_evicted, Scooby_PTEntry* last_evicted)
 {
-  MYLOG("victim %s %u %d last_victim %s %u %d", curr_evicted->state->to_string().c_str(), curr_evicted->action_index, Actions[curr_evicted->action_index],
-        last_evicted->state->to_string().c_str(), last_evicted->action_index, Actions[last_evicted->action_index]);
+  MYLOG("victim %s %u %d last_victim %s %u %d", curr_evicted->state.to_string().c_str(), curr_evicted->action_index, Actions[curr_evicted->action_index],
+        last_evicted->state.to_string().c_str(), last_evicted->action_index, Actions[last_evicted->action_index]);
 
   stats.train.called++;
   if (!last_evicted->has_reward) {
@@ -424,11 +411,11 @@ void pythia::train(Scooby_PTEntry* curr_evicted, Scooby_PTEntry* last_evicted)
   assert(last_evicted->has_reward);
 
   /* train */
-  MYLOG("===SARSA=== S1: %s A1: %u R1: %d S2: %s A2: %u", last_evicted->state->to_string().c_str(), last_evicted->action_index, last_evicted->reward,
-        curr_evicted->state->to_string().c_str(), curr_evicted->action_index);
+  MYLOG("===SARSA=== S1: %s A1: %u R1: %d S2: %s A2: %u", last_evicted->state.to_string().c_str(), last_evicted->action_index, last_evicted->reward,
+        curr_evicted->state.to_string().c_str(), curr_evicted->action_index);
 
   /* RL engine training */
-  brain_featurewise->learn(last_evicted->state, last_evicted->action_index, last_evicted->reward, curr_evicted->state, curr_evicted->action_index,
+  brain_featurewise->learn(&last_evicted->state, last_evicted->action_index, last_evicted->reward, &curr_evicted->state, curr_evicted->action_index,
                            last_evicted->reward_type);
 
   MYLOG("train done");
@@ -460,15 +447,7 @@ void pythia::register_fill(uint64_t address)
 
 std::vector<Scooby_PTEntry*> pythia::search_pt(uint64_t address, bool search_all)
 {
-  std::vector<Scooby_PTEntry*> entries;
-  for (uint32_t index = 0; index < prefetch_tracker.size(); ++index) {
-    if (prefetch_tracker[index]->address == address) {
-      entries.push_back(prefetch_tracker[index]);
-      if (!search_all)
-        break;
-    }
-  }
-  return entries;
+  return prefetch_tracker.search(address, search_all);
 }
 
 int32_t pythia::getAction(uint32_t action_index)
@@ -479,9 +458,9 @@ int32_t pythia::getAction(uint32_t action_index)
 
 void pythia::track_in_st(uint64_t page, uint32_t pred_offset, int32_t pref_offset)
 {
-  auto st_index = find_if(signature_table.begin(), signature_table.end(), [page](Scooby_STEntry* stentry) { return stentry->page == page; });
-  if (st_index != signature_table.end()) {
-    (*st_index)->track_prefetch(pred_offset, pref_offset);
+  Scooby_STEntry* stentry = signature_table.find(page);
+  if (stentry) {
+    stentry->track_prefetch(pred_offset, pref_offset);
   }
 }
 
@@ -9,6 +9,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <iterator>
 #include <sstream>
 #include <string>
 
@@ -142,4 +143,143 @@ bool Scooby_STEntry::search_action_tracker(int32_t action, int32_t& conf)
   } else {
     return false;
   }
-}
\ No newline at end of file
+}
+Scooby_PrefetchTracker::Scooby_PrefetchTracker(uint32_t capacity) : slots(capacity), bucket_head(2 * capacity, npos), bucket_tail(2 * capacity, npos)
+{
+  assert(capacity > 0);
+}
+
+uint32_t Scooby_PrefetchTracker::bucket_of(uint64_t address) const
+{
+  return (uint32_t)(((address * 0x9e3779b97f4a7c15ULL) >> 32) % bucket_head.size());
+}
+
+Scooby_PTEntry& Scooby_PrefetchTracker::front()
+{
+  assert(count > 0);
+  return slots[head].entry;
+}
+
+void Scooby_PrefetchTracker::pop_front()
+{
+  assert(count > 0);
+  Slot& slot = slots[head];
+  uint32_t bucket = bucket_of(slot.entry.address);
+
+  /* the oldest entry is the oldest of its bucket too */
+  assert(bucket_head[bucket] == head);
+  bucket_head[bucket] = slot.next;
+  if (slot.next != npos)
+    slots[slot.next].prev = npos;
+  else
+    bucket_tail[bucket] = npos;
+
+  head = (uint32_t)((head + 1) % slots.size());
+  --count;
+}
+
+Scooby_PTEntry& Scooby_PrefetchTracker::push_back(const Scooby_PTEntry& entry)
+{
+  assert(count < slots.size());
+  uint32_t index = (uint32_t)((head + count) % slots.size());
+  ++count;
+
+  Slot& slot = slots[index];
+  slot.entry = entry;
+
+  /* append to the bucket chain, which keeps it in insertion order */
+  uint32_t bucket = bucket_of(entry.address);
+  slot.prev = bucket_tail[bucket];
+  slot.next = npos;
+  if (bucket_tail[bucket] != npos)
+    slots[bucket_tail[bucket]].next = index;
+  else
+    bucket_head[bucket] = index;
+  bucket_tail[bucket] = index;
+
+  return slot.entry;
+}
+
+std::vector<Scooby_PTEntry*> Scooby_PrefetchTracker::search(uint64_t address, bool search_all)
+{
+  std::vector<Scooby_PTEntry*> entries;
+  for (uint32_t index = bucket_head[bucket_of(address)]; index != npos; index = slots[index].next) {
+    if (slots[index].entry.address == address) {
+      entries.push_back(&slots[index].entry);
+      if (!search_all)
+        break;
+    }
+  }
+  return entries;
+}
+
+Scooby_SignatureTable::Scooby_SignatureTable(uint32_t capacity) : slots(capacity), buckets(2 * capacity, npos)
+{
+  assert(capacity > 0);
+  /* hand out the slots in ascending order */
+  for (uint32_t index = capacity; index > 0; --index)
+    free_slots.push_back(index - 1);
+}
+
+uint32_t Scooby_SignatureTable::bucket_of(uint64_t page) const { return (uint32_t)(((page * 0x9e3779b97f4a7c15ULL) >> 32) % buckets.size()); }
+
+uint32_t Scooby_SignatureTable::find_slot(uint64_t page) const
+{
+  for (uint32_t index = buckets[bucket_of(page)]; index != npos; index = slots[index].next) {
+    if (slots[index].entry->page == page)
+      return index;
+  }
+  return npos;
+}
+
+Scooby_STEntry* Scooby_SignatureTable::find(uint64_t page)
+{
+  uint32_t index = find_slot(page);
+  return index != npos ? &slots[index].entry.value() : nullptr;
+}
+
+Scooby_STEntry* Scooby_SignatureTable::touch(uint64_t page)
+{
+  uint32_t index = find_slot(page);
+  if (index == npos)
+    return nullptr;
+
+  slots[index].last_used = ++access_count;
+  return &slots[index].entry.value();
+}
+
+void Scooby_SignatureTable::evict_lru()
+{
+  auto victim = std::min_element(slots.begin(), slots.end(), [](const Slot& x, const Slot& y) {
+    return x.entry.has_value() && (!y.entry.has_value() || x.last_used < y.last_used);
+  });
+  assert(victim != slots.end() && victim->entry.has_value());
+  uint32_t victim_index = (uint32_t)std::distance(slots.begin(), victim);
+
+  /* unlink from the bucket chain */
+  uint32_t* link = &buckets[bucket_of(victim->entry->page)];
+  while (*link != victim_index)
+    link = &slots[*link].next;
+  *link = victim->next;
+
+  victim->entry.reset();
+  victim->next = npos;
+  free_slots.push_back(victim_index);
+}
+
+Scooby_STEntry* Scooby_SignatureTable::insert(const Scooby_STEntry& entry)
+{
+  assert(!full());
+  uint32_t index = free_slots.back();
+  free_slots.pop_back();
+
+  Slot& slot = slots[index];
+  slot.entry = entry;
+  slot.last_used = ++access_count;
+
+  uint32_t bucket = bucket_of(entry.page);
+  slot.next = buckets[bucket];
+  buckets[bucket] = index;
+
+  return &slot.entry.value();
+}
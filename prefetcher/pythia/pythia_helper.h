@@ -11,6 +11,7 @@
 #include <bitset>
 #include <cstdint>
 #include <deque>
+#include <optional>
 #include <unordered_set>
 #include <vector>
 
@@ -120,7 +121,7 @@ class Scooby_PTEntry
 {
 public:
   uint64_t address;
-  State* state;
+  State state;
   uint32_t action_index;
   /* set when prefetched line is filled into cache
    * check during reward to measure timeliness */
@@ -133,7 +134,7 @@ public:
   bool has_reward;
   std::vector<bool> consensus_vec; // only used in featurewise engine
 
-  Scooby_PTEntry(uint64_t ad, State* st, uint32_t ac) : address(ad), state(st), action_index(ac)
+  Scooby_PTEntry(uint64_t ad, const State& st, uint32_t ac) : address(ad), state(st), action_index(ac)
   {
     is_filled = false;
     pf_cache_hit = false;
@@ -141,9 +142,65 @@ public:
     reward_type = RewardType::none;
     has_reward = false;
   }
+  Scooby_PTEntry() : Scooby_PTEntry(0xdeadbeef, State{}, 0) {}
   ~Scooby_PTEntry() {}
 };
 
+/* Prefetch tracker (PT): a fixed-capacity FIFO of entries, held in a ring of preallocated slots.
+ * Entries are chained into buckets by a hash of their address, in insertion order,
+ * so that a search visits only the entries that might match, and finds the oldest match first. */
+class Scooby_PrefetchTracker
+{
+  static constexpr uint32_t npos = UINT32_MAX;
+
+  struct Slot {
+    Scooby_PTEntry entry;
+    uint32_t prev = npos, next = npos; /* neighbours in the bucket chain */
+  };
+
+  std::vector<Slot> slots;
+  std::vector<uint32_t> bucket_head, bucket_tail;
+  uint32_t head = 0, count = 0;
+
+  uint32_t bucket_of(uint64_t address) const;
+
+public:
+  explicit Scooby_PrefetchTracker(uint32_t capacity);
+  uint32_t size() const { return count; }
+  Scooby_PTEntry& front();
+  void pop_front();
+  Scooby_PTEntry& push_back(const Scooby_PTEntry& entry);
+  std::vector<Scooby_PTEntry*> search(uint64_t address, bool search_all);
+};
+
+/* Signature table (ST): a fixed-capacity table of per-page entries with LRU replacement, indexed by a hash of the page number. */
+class Scooby_SignatureTable
+{
+  static constexpr uint32_t npos = UINT32_MAX;
+
+  struct Slot {
+    std::optional<Scooby_STEntry> entry{};
+    uint64_t last_used = 0;
+    uint32_t next = npos; /* next slot in the bucket chain */
+  };
+
+  std::vector<Slot> slots;
+  std::vector<uint32_t> buckets;
+  std::vector<uint32_t> free_slots;
+  uint64_t access_count = 0;
+
+  uint32_t bucket_of(uint64_t page) const;
+  uint32_t find_slot(uint64_t page) const;
+
+public:
+  explicit Scooby_SignatureTable(uint32_t capacity);
+  bool full() const { return free_slots.empty(); }
+  Scooby_STEntry* find(uint64_t page);  /* does not change the replacement order */
+  Scooby_STEntry* touch(uint64_t page); /* marks the entry as most recently used */
+  void evict_lru();
+  Scooby_STEntry* insert(const Scooby_STEntry& entry);
+};
+
 typedef struct _stats {
   struct {
     uint64_t lookup;
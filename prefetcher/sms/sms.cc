@@ -7,12 +7,7 @@
 
 #include "sms.h"
 
-void sms::prefetcher_initialize()
-{
-  /* init PHT */
-  std::deque<PHTEntry*> d;
-  pht.resize(sms::PHT_SETS, d);
-}
+void sms::prefetcher_initialize() {}
 
 uint32_t sms::prefetcher_cache_operate(champsim::address address, champsim::address ip, uint8_t cache_hit, bool useful_prefetch, access_type type,
                                        uint32_t metadata_in)
@@ -28,22 +23,21 @@ uint32_t sms::prefetcher_cache_operate(champsim::address address, champsim::addr
   // 	<< " offset " << dec << setw(2) << offset
   // 	<< endl;
 
-  auto at_index = search_acc_table(page);
+  auto atentry = acc_table.check_hit(ATEntry{page});
   //   stats.at.lookup++;
-  if (at_index != acc_table.end()) {
+  if (atentry.has_value()) {
     /* accumulation table hit */
     // stats.at.hit++;
-    (*at_index)->pattern[offset] = 1;
-    update_age_acc_table(at_index);
+    atentry->pattern[offset] = 1;
+    acc_table.fill(*atentry);
   } else {
     /* search filter table */
-    auto ft_index = search_filter_table(page);
+    auto ftentry = filter_table.invalidate(FTEntry{page});
     // stats.ft.lookup++;
-    if (ft_index != filter_table.end()) {
+    if (ftentry.has_value()) {
       /* filter table hit */
       //   stats.ft.hit++;
-      insert_acc_table((*ft_index), offset);
-      evict_filter_table(ft_index);
+      insert_acc_table(*ftentry, offset);
     } else {
       /* filter table miss. Beginning of new generation. Issue prefetch */
       insert_filter_table(ip.to<uint64_t>(), page, offset);
@@ -13,13 +13,16 @@
 
 #include "champsim.h"
 #include "modules.h"
+#include "msl/lru_table.h"
 #include "sms_helper.h"
 
 struct sms : public champsim::modules::prefetcher {
 private:
   // config
   constexpr static uint32_t AT_SIZE = 32;
+  constexpr static uint32_t AT_ASSOC = 8;
   constexpr static uint32_t FT_SIZE = 64;
+  constexpr static uint32_t FT_ASSOC = 16;
   constexpr static uint32_t PHT_SIZE = 2048;
   constexpr static uint32_t PHT_ASSOC = 16;
   constexpr static uint32_t PHT_SETS = PHT_SIZE / PHT_ASSOC;
@@ -29,29 +32,15 @@ private:
   constexpr static uint32_t PREF_BUFFER_SIZE = 256;
 
   // internal data structures
-  std::deque<FTEntry*> filter_table;
-  std::deque<ATEntry*> acc_table;
-  std::vector<std::deque<PHTEntry*>> pht;
-  uint32_t pht_sets;
+  champsim::msl::lru_table<FTEntry> filter_table{FT_SIZE / FT_ASSOC, FT_ASSOC};
+  champsim::msl::lru_table<ATEntry> acc_table{AT_SIZE / AT_ASSOC, AT_ASSOC};
+  champsim::msl::lru_table<PHTEntry> pht{PHT_SETS, PHT_ASSOC};
   std::deque<uint64_t> pref_buffer;
 
   // private functions
-  std::deque<FTEntry*>::iterator search_filter_table(uint64_t page);
-  std::deque<FTEntry*>::iterator search_victim_filter_table();
-  void evict_filter_table(std::deque<FTEntry*>::iterator victim);
   void insert_filter_table(uint64_t pc, uint64_t page, uint32_t offset);
-
-  std::deque<ATEntry*>::iterator search_acc_table(uint64_t page);
-  std::deque<ATEntry*>::iterator search_victim_acc_table();
-  void evict_acc_table(std::deque<ATEntry*>::iterator victim);
-  void update_age_acc_table(std::deque<ATEntry*>::iterator current);
-  void insert_acc_table(FTEntry* ftentry, uint32_t offset);
-
-  std::deque<PHTEntry*>::iterator search_pht(uint64_t signature, uint32_t& set);
-  std::deque<PHTEntry*>::iterator search_victim_pht(int32_t set);
-  void evcit_pht(int32_t set, std::deque<PHTEntry*>::iterator victim);
-  void update_age_pht(int32_t set, std::deque<PHTEntry*>::iterator current);
-  void insert_pht_table(ATEntry* atentry);
+  void insert_acc_table(const FTEntry& ftentry, uint32_t offset);
+  void insert_pht_table(const ATEntry& atentry);
 
   uint64_t create_signature(uint64_t pc, uint32_t offset);
   std::size_t generate_prefetch(uint64_t pc, uint64_t address, uint64_t page, uint32_t offset, std::vector<uint64_t>& pref_addr);
@@ -13,6 +13,7 @@
 
 #include "bitmap.h"
 
+/* Entries are stored by value in champsim::msl::lru_table, which finds the set with index() and matches entries with tag() */
 class FTEntry
 {
 public:
@@ -28,7 +29,11 @@ public:
     trigger_offset = 0;
   }
   FTEntry() { reset(); }
+  explicit FTEntry(uint64_t _page, uint64_t _pc = 0xdeadbeef, uint32_t _trigger_offset = 0) : page(_page), pc(_pc), trigger_offset(_trigger_offset) {}
   ~FTEntry() {}
+
+  uint64_t index() const { return page; }
+  uint64_t tag() const { return page; }
 };
 
 class ATEntry
@@ -38,7 +43,6 @@ public:
   uint64_t pc;
   uint32_t trigger_offset;
   Bitmap pattern;
-  uint32_t age;
 
 public:
   void reset()
@@ -46,10 +50,13 @@ public:
     page = pc = 0xdeadbeef;
     trigger_offset = 0;
     pattern.reset();
-    age = 0;
   }
   ATEntry() { reset(); }
+  explicit ATEntry(uint64_t _page) : ATEntry() { page = _page; }
   ~ATEntry() {}
+
+  uint64_t index() const { return page; }
+  uint64_t tag() const { return page; }
 };
 
 class PHTEntry
@@ -57,17 +64,19 @@ class PHTEntry
 public:
   uint64_t signature;
   Bitmap pattern;
-  uint32_t age;
 
 public:
   void reset()
   {
     signature = 0xdeadbeef;
     pattern.reset();
-    age = 0;
   }
   PHTEntry() { reset(); }
+  explicit PHTEntry(uint64_t _signature, Bitmap _pattern = {}) : signature(_signature), pattern(_pattern) {}
   ~PHTEntry() {}
+
+  uint64_t index() const { return signature; }
+  uint64_t tag() const { return signature; }
 };
 
 #endif /* __SMS_HELPER_H__ */
@@ -0,0 +1,43 @@
+#include "triage.h"
+
+#include <algorithm>
+
+#include "cache.h"
+
+uint32_t triage::prefetcher_cache_operate(champsim::address addr, champsim::address ip, uint8_t cache_hit, bool useful_prefetch, access_type type,
+                                          uint32_t metadata_in)
+{
+  // Train only on the misses of loads, including the misses that a prefetch has covered
+  if (!intern_->has_metadata_store() || type == access_type::PREFETCH || type == access_type::WRITE || (cache_hit && !useful_prefetch))
+    return metadata_in;
+
+  champsim::block_number block{addr};
+  unsigned confidence = 0;
+
+  if (auto found = training.check_hit({ip, block, 0}); found.has_value()) {
+    confidence = found->confidence;
+    if (found->last_block != block) {
+      const auto key = found->last_block.to<uint64_t>();
+      const auto recorded = intern_->metadata_read(key);
+      if (recorded.has_value() && *recorded == block.to<uint64_t>())
+        confidence = std::min(confidence + 1, MAX_CONFIDENCE);
+      else if (confidence > 0)
+        --confidence;
+      intern_->metadata_write(key, block.to<uint64_t>());
+    }
+  }
+
+  training.fill({ip, block, confidence});
+
+  if (confidence >= CONFIDENCE_THRESHOLD) {
+    auto next = block.to<uint64_t>();
+    for (unsigned i = 0; i < recommended_degree(PREFETCH_DEGREE); ++i) {
+      const auto successor = intern_->metadata_read(next);
+      if (!successor.has_value() || !prefetch_line(champsim::address{champsim::block_number{*successor}}, true, metadata_in))
+        break;
+      next = *successor;
+    }
+  }
+
+  return metadata_in;
+}
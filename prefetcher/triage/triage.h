@@ -0,0 +1,49 @@
+#ifndef PREFETCHER_TRIAGE_H
+#define PREFETCHER_TRIAGE_H
+
+#include <cstdint>
+
+#include "address.h"
+#include "champsim.h"
+#include "modules.h"
+#include "msl/lru_table.h"
+
+/*
+ * A temporal prefetcher in the manner of Triage, with the pattern confidence of Triangel.
+ *
+ * Each IP's miss stream is recorded as pairwise correlations, from each block to the block that followed it, in the metadata store of the cache.
+ * When the correlations of an IP have recently repeated, the prefetcher follows the chain of successors from the current block.
+ * The prefetcher does nothing in a cache without a metadata store.
+ */
+struct triage : public champsim::modules::prefetcher {
+  struct tracker_entry {
+    champsim::address ip{};
+    champsim::block_number last_block{}; // the last block that this IP trained on
+    unsigned confidence = 0;             // how often the recorded successors of this IP have repeated
+
+    auto index() const
+    {
+      using namespace champsim::data::data_literals;
+      return ip.slice_upper<2_b>();
+    }
+    auto tag() const
+    {
+      using namespace champsim::data::data_literals;
+      return ip.slice_upper<2_b>();
+    }
+  };
+
+  constexpr static std::size_t TRACKER_SETS = 256;
+  constexpr static std::size_t TRACKER_WAYS = 4;
+  constexpr static unsigned MAX_CONFIDENCE = 7;
+  constexpr static unsigned CONFIDENCE_THRESHOLD = 4;
+  constexpr static unsigned PREFETCH_DEGREE = 2;
+
+  champsim::msl::lru_table<tracker_entry> training{TRACKER_SETS, TRACKER_WAYS};
+
+  using prefetcher::prefetcher;
+  uint32_t prefetcher_cache_operate(champsim::address addr, champsim::address ip, uint8_t cache_hit, bool useful_prefetch, access_type type,
+                                    uint32_t metadata_in);
+};
+
+#endif
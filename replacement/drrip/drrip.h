@@ -7,13 +7,12 @@
 #include "cache.h"
 #include "modules.h"
 #include "msl/fwcounter.h"
+#include "msl/packed_rrpv.h"
 
 struct drrip : public champsim::modules::replacement {
-private:
-  unsigned& get_rrpv(long set, long way);
-
 public:
-  static constexpr unsigned maxRRPV = 3;
+  using rrpv_table = champsim::msl::packed_rrpv<2>;
+  static constexpr unsigned maxRRPV = rrpv_table::max_rrpv;
   static constexpr unsigned BRRIP_MAX = 32;
   static constexpr unsigned PSEL_WIDTH = 10;
 
@@ -25,13 +24,13 @@ public:
 
   unsigned brrip_counter;
   std::vector<champsim::msl::fwcounter<PSEL_WIDTH>> PSEL;
-  std::vector<unsigned> rrpv;
+  rrpv_table rrpv;
 
   drrip(CACHE* cache);
 
   // void initialize_replacement()
   long find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, const champsim::cache_block* current_set, champsim::address ip,
-                   champsim::address full_addr, access_type type);
+                   champsim::address full_addr, access_type type, way_mask allowed_ways = all_ways);
   void replacement_cache_fill(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip, champsim::address victim_addr,
                               access_type type);
   void update_replacement_state(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip, champsim::address victim_addr,
@@ -0,0 +1,178 @@
+#include "hawkeye.h"
+
+#include <algorithm>
+#include <cassert>
+#include <fmt/core.h>
+
+#include "champsim.h"
+
+namespace
+{
+// The sampler keeps a partial tag of each block, as in the hardware
+constexpr uint64_t SAMPLER_TAG_BITS = 16;
+} // namespace
+
+hawkeye::optgen::optgen(std::size_t history, unsigned capacity_) : liveness(history, 0), capacity(capacity_) {}
+
+uint64_t hawkeye::optgen::access()
+{
+  liveness.at(now % std::size(liveness)) = 0;
+  return now++;
+}
+
+bool hawkeye::optgen::should_cache(uint64_t last_use)
+{
+  const auto current = now - 1;
+  if (current - last_use >= std::size(liveness))
+    return false;
+
+  for (auto q = last_use; q < current; ++q) {
+    if (liveness.at(q % std::size(liveness)) >= capacity)
+      return false;
+  }
+  for (auto q = last_use; q < current; ++q)
+    ++liveness.at(q % std::size(liveness));
+  return true;
+}
+
+hawkeye::hawkeye(CACHE* cache) : hawkeye(cache, cache->NUM_SET, cache->NUM_WAY) {}
+
+hawkeye::hawkeye(CACHE* cache, long sets, long ways)
+    : replacement(cache), NUM_SET(sets), NUM_WAY(ways), rrpv(sets, ways), line_signature(static_cast<std::size_t>(sets * ways)),
+      line_prefetch(static_cast<std::size_t>(sets * ways)), line_friendly(static_cast<std::size_t>(sets * ways))
+{
+  // Begin weakly cache-friendly
+  for (auto& table : predictor)
+    table.resize(PREDICTOR_SIZE, champsim::msl::fwcounter<PREDICTOR_BITS>{1 << (PREDICTOR_BITS - 1)});
+}
+
+std::size_t hawkeye::signature(champsim::address ip)
+{
+  auto val = ip.to<uint64_t>();
+  return static_cast<std::size_t>((val ^ (val >> 11) ^ (val >> 22)) % PREDICTOR_SIZE);
+}
+
+// Caches too small for set sampling are sampled entirely
+bool hawkeye::is_sampled(long set) const { return NUM_SET < 8 || get_set_sample_category(set) == 0; }
+
+bool hawkeye::predict(champsim::address ip, bool prefetch) const
+{
+  const auto& counter = predictor.at(prefetch).at(signature(ip));
+  return counter.value() > (counter.maximum / 2);
+}
+
+void hawkeye::train(long set, champsim::address full_addr, champsim::address ip, bool prefetch)
+{
+  auto& sampler = samplers.try_emplace(set, sampled_set{optgen{static_cast<std::size_t>(OPTGEN_HISTORY * NUM_WAY), static_cast<unsigned>(NUM_WAY)}})
+                      .first->second;
+  const auto now = sampler.occupancy.access();
+
+  // Lines that were not reused within the history would not have been kept by OPT
+  while (!std::empty(sampler.order) && now - sampler.order.front().second >= sampler.occupancy.history()) {
+    auto [block, last_use] = sampler.order.front();
+    sampler.order.pop_front();
+    if (auto found = sampler.entries.find(block); found != std::end(sampler.entries) && found->second.last_use == last_use) {
+      predictor.at(found->second.prefetch).at(found->second.signature) -= 1;
+      sampler.entries.erase(found);
+    }
+  }
+
+  const auto block = champsim::block_number{full_addr}.to<uint64_t>();
+  if (auto found = sampler.entries.find(block); found != std::end(sampler.entries)) {
+    // An interval that ends in a prefetch need not be cached, since the prefetch brings the line back
+    const bool opt_hit = !prefetch && sampler.occupancy.should_cache(found->second.last_use);
+    auto& counter = predictor.at(found->second.prefetch).at(found->second.signature);
+    if (opt_hit)
+      counter += 1;
+    else
+      counter -= 1;
+  }
+
+  sampler.entries.insert_or_assign(block, sampler_entry{now, signature(ip), prefetch});
+  sampler.order.emplace_back(block, now);
+}
+
+long hawkeye::find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, const champsim::cache_block* current_set, champsim::address ip,
+                          champsim::address full_addr, access_type type, way_mask allowed_ways)
+{
+  // Cache-averse lines are evicted first. If there are none, the oldest cache-friendly line is evicted, and its PC is detrained.
+  auto way = rrpv.max_way(set, allowed_ways);
+  const auto idx = line_index(set, way);
+  if (rrpv.get(set, way) < maxRRPV && line_friendly.at(idx)) {
+    predictor.at(line_prefetch.at(idx)).at(line_signature.at(idx)) -= 1;
+    ++detrains;
+  }
+  return way;
+}
+
+void hawkeye::replacement_cache_fill(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
+                                     champsim::address victim_addr, access_type type)
+{
+  if (way == NUM_WAY)
+    return;
+
+  const auto idx = line_index(set, way);
+
+  // Writebacks are not predicted, and are inserted as cache-averse
+  if (access_type{type} == access_type::WRITE) {
+    rrpv.set(set, way, maxRRPV);
+    line_friendly.at(idx) = false;
+    return;
+  }
+
+  const bool prefetch = (access_type{type} == access_type::PREFETCH);
+  const bool friendly = predict(ip, prefetch);
+  if (friendly) {
+    rrpv.increment_below(set, maxRRPV - 1);
+    rrpv.set(set, way, 0);
+    ++friendly_insertions;
+  } else {
+    rrpv.set(set, way, maxRRPV);
+    ++averse_insertions;
+  }
+
+  line_signature.at(idx) = signature(ip);
+  line_prefetch.at(idx) = prefetch;
+  line_friendly.at(idx) = friendly;
+}
+
+void hawkeye::update_replacement_state(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
+                                       champsim::address victim_addr, access_type type, uint8_t hit)
+{
+  // Writebacks neither train nor promote
+  if (access_type{type} == access_type::WRITE)
+    return;
+
+  const bool prefetch = (access_type{type} == access_type::PREFETCH);
+  if (is_sampled(set))
+    train(set, full_addr, ip, prefetch);
+
+  if (hit && way < NUM_WAY) {
+    const auto idx = line_index(set, way);
+    const bool friendly = predict(ip, prefetch);
+    rrpv.set(set, way, friendly ? 0 : maxRRPV);
+    line_signature.at(idx) = signature(ip);
+    line_prefetch.at(idx) = prefetch;
+    line_friendly.at(idx) = friendly;
+  }
+}
+
+uint64_t hawkeye::storage_bits() const
+{
+  const auto lines = static_cast<uint64_t>(NUM_SET * NUM_WAY);
+  const auto sampled_sets = static_cast<uint64_t>(NUM_SET < 8 ? NUM_SET : get_num_sampled_sets());
+  const auto history = static_cast<uint64_t>(OPTGEN_HISTORY * NUM_WAY);
+  const auto signature_bits = static_cast<uint64_t>(champsim::lg2(PREDICTOR_SIZE));
+
+  const auto line_bits = lines * RRPV_BITS + lines * (signature_bits + 2);
+  const auto predictor_bits = uint64_t{2} * PREDICTOR_SIZE * PREDICTOR_BITS;
+  const auto sampler_bits = sampled_sets * history * (SAMPLER_TAG_BITS + champsim::lg2(history) + signature_bits + 1);
+  const auto optgen_bits = sampled_sets * history * (champsim::lg2(static_cast<uint64_t>(NUM_WAY)) + 1);
+  return line_bits + predictor_bits + sampler_bits + optgen_bits;
+}
+
+void hawkeye::replacement_final_stats()
+{
+  fmt::print("{} Hawkeye storage: {:.1f} KiB friendly insertions: {} averse insertions: {} detrains: {}\n", intern_->NAME,
+             static_cast<double>(storage_bits()) / 8192.0, friendly_insertions, averse_insertions, detrains);
+}
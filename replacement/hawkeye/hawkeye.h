@@ -0,0 +1,116 @@
+#ifndef REPLACEMENT_HAWKEYE_H
+#define REPLACEMENT_HAWKEYE_H
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#include "cache.h"
+#include "modules.h"
+#include "msl/fwcounter.h"
+#include "msl/packed_rrpv.h"
+
+/*
+ * Hawkeye (Jain and Lin, ISCA 2016).
+ *
+ * OPTgen reconstructs Belady's decisions on a sample of the sets, and trains a predictor indexed by the PC of the access that began each reuse interval.
+ * Lines brought in by cache-friendly PCs are inserted with a near re-reference, and lines brought in by cache-averse PCs are the first to be evicted.
+ *
+ * Training is prefetch-aware, as in the version of Hawkeye in CRC2: demands and prefetches train separate predictors, and an interval that ends in a
+ * prefetch is not cached by OPT, since the prefetch would bring the line back anyway.
+ */
+class hawkeye : public champsim::modules::replacement
+{
+public:
+  static constexpr unsigned RRPV_BITS = 3;
+  using rrpv_table = champsim::msl::packed_rrpv<RRPV_BITS>;
+  static constexpr unsigned maxRRPV = rrpv_table::max_rrpv;
+
+  static constexpr std::size_t PREDICTOR_SIZE = 2048;
+  static constexpr unsigned PREDICTOR_BITS = 3;
+  static constexpr long OPTGEN_HISTORY = 8; // the history of each sampled set covers this many times its associativity
+
+  /**
+   * The occupancy of one sampled set under Belady's MIN, over a sliding window of accesses to the set
+   */
+  class optgen
+  {
+    std::vector<unsigned> liveness;
+    unsigned capacity;
+    uint64_t now = 0;
+
+  public:
+    optgen(std::size_t history, unsigned capacity_);
+
+    /**
+     * Start the next time quantum, returning its timestamp
+     */
+    uint64_t access();
+
+    /**
+     * Decide whether OPT would have kept a line from its last use until the current access, and if so, occupy the cache for that interval
+     */
+    bool should_cache(uint64_t last_use);
+
+    [[nodiscard]] std::size_t history() const { return std::size(liveness); }
+  };
+
+private:
+  struct sampler_entry {
+    uint64_t last_use;
+    std::size_t signature;
+    bool prefetch;
+  };
+
+  struct sampled_set {
+    optgen occupancy;
+    std::unordered_map<uint64_t, sampler_entry> entries{};
+    std::deque<std::pair<uint64_t, uint64_t>> order{}; // (block, last use), to retire entries that leave the history
+  };
+
+  long NUM_SET, NUM_WAY;
+
+  rrpv_table rrpv;
+  std::vector<std::size_t> line_signature;
+  std::vector<bool> line_prefetch;
+  std::vector<bool> line_friendly;
+
+  // Indexed by whether the access was a prefetch
+  std::array<std::vector<champsim::msl::fwcounter<PREDICTOR_BITS>>, 2> predictor;
+  std::unordered_map<long, sampled_set> samplers{};
+
+  uint64_t friendly_insertions = 0;
+  uint64_t averse_insertions = 0;
+  uint64_t detrains = 0;
+
+  [[nodiscard]] static std::size_t signature(champsim::address ip);
+  [[nodiscard]] bool is_sampled(long set) const;
+  [[nodiscard]] std::size_t line_index(long set, long way) const { return static_cast<std::size_t>(set * NUM_WAY + way); }
+  void train(long set, champsim::address full_addr, champsim::address ip, bool prefetch);
+
+public:
+  explicit hawkeye(CACHE* cache);
+  hawkeye(CACHE* cache, long sets, long ways);
+
+  long find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, const champsim::cache_block* current_set, champsim::address ip,
+                   champsim::address full_addr, access_type type, way_mask allowed_ways = all_ways);
+  void replacement_cache_fill(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip, champsim::address victim_addr,
+                              access_type type);
+  void update_replacement_state(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip, champsim::address victim_addr,
+                                access_type type, uint8_t hit);
+  void replacement_final_stats();
+
+  /**
+   * Whether lines accessed by this PC are predicted to be cache-friendly
+   */
+  [[nodiscard]] bool predict(champsim::address ip, bool prefetch) const;
+
+  /**
+   * The storage of the modeled hardware, in bits
+   */
+  [[nodiscard]] uint64_t storage_bits() const;
+};
+
+#endif
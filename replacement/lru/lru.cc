@@ -8,13 +8,17 @@ lru::lru(CACHE* cache) : lru(cache, cache->NUM_SET, cache->NUM_WAY) {}
 lru::lru(CACHE* cache, long sets, long ways) : replacement(cache), NUM_WAY(ways), last_used_cycles(static_cast<std::size_t>(sets * ways), 0) {}
 
 long lru::find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, const champsim::cache_block* current_set, champsim::address ip,
-                      champsim::address full_addr, access_type type)
+                      champsim::address full_addr, access_type type, way_mask allowed_ways)
 {
   auto begin = std::next(std::begin(last_used_cycles), set * NUM_WAY);
   auto end = std::next(begin, NUM_WAY);
 
-  // Find the way whose last use cycle is most distant
-  auto victim = std::min_element(begin, end);
+  // Find the allowed way whose last use cycle is most distant
+  auto victim = end;
+  for (auto it = begin; it != end; ++it) {
+    if (allows(allowed_ways, std::distance(begin, it)) && (victim == end || *it < *victim))
+      victim = it;
+  }
   assert(begin <= victim);
   assert(victim < end);
   return std::distance(begin, victim);
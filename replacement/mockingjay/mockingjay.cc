@@ -0,0 +1,166 @@
+#include "mockingjay.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <fmt/core.h>
+
+#include "champsim.h"
+
+namespace
+{
+// The sampler keeps a partial tag of each block, as in the hardware
+constexpr uint64_t SAMPLER_TAG_BITS = 16;
+} // namespace
+
+mockingjay::mockingjay(CACHE* cache) : mockingjay(cache, cache->NUM_SET, cache->NUM_WAY) {}
+
+mockingjay::mockingjay(CACHE* cache, long sets, long ways)
+    : replacement(cache), NUM_SET(sets), NUM_WAY(ways), max_rd(HISTORY_FACTOR * ways), granularity(std::max<long>(max_rd / (INF_ETR + 1), 1)),
+      etr(static_cast<std::size_t>(sets * ways), INF_ETR), set_clock(static_cast<std::size_t>(sets)), rdp(RDP_SIZE, -1)
+{
+}
+
+std::size_t mockingjay::signature(champsim::address ip, bool prefetch, uint32_t cpu)
+{
+  auto val = ip.to<uint64_t>();
+  auto hash = (val ^ (val >> 11) ^ (val >> 22)) + cpu;
+  return static_cast<std::size_t>(((hash << 1) | (prefetch ? 1 : 0)) % RDP_SIZE);
+}
+
+// Caches too small for set sampling are sampled entirely
+bool mockingjay::is_sampled(long set) const { return NUM_SET < 8 || get_set_sample_category(set) == 0; }
+
+int mockingjay::predict(champsim::address ip, bool prefetch, uint32_t cpu) const
+{
+  auto rd = rdp.at(signature(ip, prefetch, cpu));
+  if (rd < 0)
+    return INF_ETR - 1; // an untrained signature is expected to be reused late, but not never
+  if (rd >= max_rd)
+    return INF_ETR;
+  return static_cast<int>(std::min<long>(rd / granularity, INF_ETR));
+}
+
+void mockingjay::train_rdp(std::size_t sig, long observed)
+{
+  auto& rd = rdp.at(sig);
+  if (rd < 0) {
+    rd = observed;
+    return;
+  }
+
+  // Move toward the observed distance by a fraction of the difference, and at least by one
+  auto diff = observed - rd;
+  auto step = diff / (1 << RDP_LEARNING_SHIFT);
+  if (step == 0 && diff != 0)
+    step = diff > 0 ? 1 : -1;
+  rd = std::clamp<long>(rd + step, 0, max_rd);
+}
+
+void mockingjay::train(long set, champsim::address full_addr, std::size_t sig)
+{
+  auto& sampler = samplers[set];
+  const auto now = ++sampler.now;
+
+  // Lines that pass the longest reuse distance are trained as never reused
+  while (!std::empty(sampler.order) && now - sampler.order.front().second > static_cast<uint64_t>(max_rd)) {
+    auto [block, last_use] = sampler.order.front();
+    sampler.order.pop_front();
+    if (auto found = sampler.entries.find(block); found != std::end(sampler.entries) && found->second.last_use == last_use) {
+      train_rdp(found->second.signature, max_rd);
+      sampler.entries.erase(found);
+    }
+  }
+
+  const auto block = champsim::block_number{full_addr}.to<uint64_t>();
+  if (auto found = sampler.entries.find(block); found != std::end(sampler.entries))
+    train_rdp(found->second.signature, static_cast<long>(now - found->second.last_use));
+
+  sampler.entries.insert_or_assign(block, sampler_entry{now, sig});
+  sampler.order.emplace_back(block, now);
+}
+
+void mockingjay::age(long set)
+{
+  auto& clock = set_clock.at(static_cast<std::size_t>(set));
+  if (++clock < granularity)
+    return;
+
+  clock = 0;
+  auto begin = std::next(std::begin(etr), set * NUM_WAY);
+  std::transform(begin, std::next(begin, NUM_WAY), begin, [](auto x) { return std::max(x - 1, -INF_ETR); });
+}
+
+long mockingjay::find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, const champsim::cache_block* current_set, champsim::address ip,
+                             champsim::address full_addr, access_type type, way_mask allowed_ways)
+{
+  // The line furthest from its reuse, counting overdue lines as far; ties go to the overdue line
+  auto begin = std::next(std::begin(etr), set * NUM_WAY);
+  auto end = std::next(begin, NUM_WAY);
+  auto nearer = [](auto x, auto y) { return std::abs(x) < std::abs(y) || (std::abs(x) == std::abs(y) && x > y); };
+  auto victim = end;
+  for (auto it = begin; it != end; ++it) {
+    if (allows(allowed_ways, std::distance(begin, it)) && (victim == end || nearer(*victim, *it)))
+      victim = it;
+  }
+
+  assert(begin <= victim);
+  assert(victim < end);
+
+  // An incoming line that would be reused after every resident line bypasses the cache. Writebacks may not bypass.
+  if (access_type{type} != access_type::WRITE && predict(ip, access_type{type} == access_type::PREFETCH, triggering_cpu) > std::abs(*victim)) {
+    ++bypasses;
+    return NUM_WAY;
+  }
+
+  return std::distance(begin, victim);
+}
+
+void mockingjay::replacement_cache_fill(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
+                                        champsim::address victim_addr, access_type type)
+{
+  if (way == NUM_WAY)
+    return;
+
+  // Writebacks are not predicted, and are expected not to be reused
+  if (access_type{type} == access_type::WRITE)
+    etr.at(line_index(set, way)) = INF_ETR;
+  else
+    etr.at(line_index(set, way)) = predict(ip, access_type{type} == access_type::PREFETCH, triggering_cpu);
+}
+
+void mockingjay::update_replacement_state(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
+                                          champsim::address victim_addr, access_type type, uint8_t hit)
+{
+  // Writebacks neither train nor promote
+  if (access_type{type} == access_type::WRITE)
+    return;
+
+  const bool prefetch = (access_type{type} == access_type::PREFETCH);
+  if (is_sampled(set))
+    train(set, full_addr, signature(ip, prefetch, triggering_cpu));
+
+  age(set);
+
+  if (hit && way < NUM_WAY)
+    etr.at(line_index(set, way)) = predict(ip, prefetch, triggering_cpu);
+}
+
+uint64_t mockingjay::storage_bits() const
+{
+  const auto lines = static_cast<uint64_t>(NUM_SET * NUM_WAY);
+  const auto sampled_sets = static_cast<uint64_t>(NUM_SET < 8 ? NUM_SET : get_num_sampled_sets());
+  const auto rd_bits = static_cast<uint64_t>(champsim::lg2(static_cast<uint64_t>(max_rd)) + 1);
+  const auto signature_bits = static_cast<uint64_t>(champsim::lg2(RDP_SIZE));
+
+  const auto line_bits = lines * (champsim::lg2(static_cast<uint64_t>(INF_ETR) + 1) + 1);
+  const auto clock_bits = static_cast<uint64_t>(NUM_SET) * (champsim::lg2(static_cast<uint64_t>(granularity)) + 1);
+  const auto rdp_bits = RDP_SIZE * rd_bits;
+  const auto sampler_bits = sampled_sets * static_cast<uint64_t>(max_rd) * (SAMPLER_TAG_BITS + rd_bits + signature_bits);
+  return line_bits + clock_bits + rdp_bits + sampler_bits;
+}
+
+void mockingjay::replacement_final_stats()
+{
+  fmt::print("{} Mockingjay storage: {:.1f} KiB bypasses: {}\n", intern_->NAME, static_cast<double>(storage_bits()) / 8192.0, bypasses);
+}
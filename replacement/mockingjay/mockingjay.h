@@ -0,0 +1,82 @@
+#ifndef REPLACEMENT_MOCKINGJAY_H
+#define REPLACEMENT_MOCKINGJAY_H
+
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#include "cache.h"
+#include "modules.h"
+
+/*
+ * Mockingjay (Shah, Jain and Lin, HPCA 2022).
+ *
+ * A reuse distance predictor (RDP), trained on a sample of the sets, predicts how many accesses to its set will pass before a line is used again.
+ * Each line keeps an estimated time remaining (ETR) until its reuse, which counts down as its set is accessed. The line whose ETR is furthest from zero,
+ * either far in the future or long overdue, is evicted, and an incoming line that would be reused later than every resident line bypasses the cache.
+ *
+ * Prefetches and demands are predicted separately, since a prefetched line is reused at a different distance than a demanded one.
+ */
+class mockingjay : public champsim::modules::replacement
+{
+public:
+  static constexpr std::size_t RDP_SIZE = 2048;
+  static constexpr long HISTORY_FACTOR = 8; // the longest predicted reuse distance, as a multiple of the associativity
+  static constexpr int INF_ETR = 15;        // ETRs are stored in 5 bits, with a sign
+  static constexpr int RDP_LEARNING_SHIFT = 3;
+
+private:
+  struct sampler_entry {
+    uint64_t last_use;
+    std::size_t signature;
+  };
+
+  struct sampled_set {
+    uint64_t now = 0;
+    std::unordered_map<uint64_t, sampler_entry> entries{};
+    std::deque<std::pair<uint64_t, uint64_t>> order{}; // (block, last use), to retire entries that pass the longest reuse distance
+  };
+
+  long NUM_SET, NUM_WAY;
+  long max_rd;      // the longest reuse distance, in accesses to the set, which stands for no reuse
+  long granularity; // the number of accesses to a set between decrements of its ETRs
+
+  std::vector<int> etr;
+  std::vector<long> set_clock;
+  std::vector<long> rdp; // negative for signatures that have not been trained
+  std::unordered_map<long, sampled_set> samplers{};
+
+  uint64_t bypasses = 0;
+
+  [[nodiscard]] static std::size_t signature(champsim::address ip, bool prefetch, uint32_t cpu);
+  [[nodiscard]] bool is_sampled(long set) const;
+  [[nodiscard]] std::size_t line_index(long set, long way) const { return static_cast<std::size_t>(set * NUM_WAY + way); }
+  void train(long set, champsim::address full_addr, std::size_t sig);
+  void train_rdp(std::size_t sig, long observed);
+  void age(long set);
+
+public:
+  explicit mockingjay(CACHE* cache);
+  mockingjay(CACHE* cache, long sets, long ways);
+
+  long find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, const champsim::cache_block* current_set, champsim::address ip,
+                   champsim::address full_addr, access_type type, way_mask allowed_ways = all_ways);
+  void replacement_cache_fill(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip, champsim::address victim_addr,
+                              access_type type);
+  void update_replacement_state(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip, champsim::address victim_addr,
+                                access_type type, uint8_t hit);
+  void replacement_final_stats();
+
+  /**
+   * The ETR that a line accessed by this PC would be given
+   */
+  [[nodiscard]] int predict(champsim::address ip, bool prefetch, uint32_t cpu) const;
+
+  /**
+   * The storage of the modeled hardware, in bits
+   */
+  [[nodiscard]] uint64_t storage_bits() const;
+};
+
+#endif
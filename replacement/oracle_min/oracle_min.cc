@@ -0,0 +1,80 @@
+#include "oracle_min.h"
+
+#include <algorithm>
+#include <cassert>
+#include <fmt/core.h>
+
+oracle_min::oracle_min(CACHE* cache) : oracle_min(cache, champsim::next_use_index::default_path(cache->NAME)) {}
+
+oracle_min::oracle_min(CACHE* cache, const std::string& index_path)
+    : replacement(cache), NUM_SET(cache->NUM_SET), NUM_WAY(cache->NUM_WAY), index(index_path), set_position(static_cast<std::size_t>(NUM_SET)),
+      line_next_use(static_cast<std::size_t>(NUM_SET * NUM_WAY), champsim::next_use_index::never)
+{
+}
+
+uint64_t oracle_min::next_use(long set, long way) const { return line_next_use.at(line_index(set, way)); }
+
+long oracle_min::find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, const champsim::cache_block* current_set, champsim::address ip,
+                             champsim::address full_addr, access_type type, way_mask allowed_ways)
+{
+  const auto now = set_position.at(static_cast<std::size_t>(set));
+  auto begin = std::next(std::begin(line_next_use), set * NUM_WAY);
+  auto end = std::next(begin, NUM_WAY);
+
+  // A line whose recorded use was never made is looked up again from here
+  for (auto [it, way] = std::pair{begin, current_set}; it != end; ++it, ++way) {
+    if (*it < now)
+      *it = index.next_use(champsim::block_number{intern_->virtual_prefetch ? way->v_address : way->address}.to<uint64_t>(), now);
+  }
+
+  auto victim = end;
+  for (auto it = begin; it != end; ++it) {
+    if (allows(allowed_ways, std::distance(begin, it)) && (victim == end || *victim < *it))
+      victim = it;
+  }
+
+  assert(begin <= victim);
+  assert(victim < end);
+
+  // Writebacks may not bypass
+  if (access_type{type} != access_type::WRITE && index.next_use(champsim::block_number{full_addr}.to<uint64_t>(), now) >= *victim) {
+    ++bypasses;
+    return NUM_WAY;
+  }
+
+  return std::distance(begin, victim);
+}
+
+void oracle_min::replacement_cache_fill(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
+                                        champsim::address victim_addr, access_type type)
+{
+  if (way == NUM_WAY)
+    return;
+
+  line_next_use.at(line_index(set, way)) = index.next_use(champsim::block_number{full_addr}.to<uint64_t>(), set_position.at(static_cast<std::size_t>(set)));
+}
+
+void oracle_min::update_replacement_state(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
+                                          champsim::address victim_addr, access_type type, uint8_t hit)
+{
+  if (!champsim::next_use_index::is_demand(type))
+    return;
+
+  const auto position = set_position.at(static_cast<std::size_t>(set))++;
+  const auto block = champsim::block_number{full_addr}.to<uint64_t>();
+
+  ++lookups;
+  auto next = index.next_use(block, position);
+  if (next == position)
+    next = index.next_use(block, position + 1);
+  else
+    ++unmatched;
+
+  if (hit && way < NUM_WAY)
+    line_next_use.at(line_index(set, way)) = next;
+}
+
+void oracle_min::replacement_final_stats()
+{
+  fmt::print("{} MIN lookups: {} unmatched: {} bypasses: {}\n", intern_->NAME, lookups, unmatched, bypasses);
+}
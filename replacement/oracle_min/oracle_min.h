@@ -0,0 +1,54 @@
+#ifndef REPLACEMENT_ORACLE_MIN_H
+#define REPLACEMENT_ORACLE_MIN_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "cache.h"
+#include "modules.h"
+#include "next_use_index.h"
+
+/*
+ * Belady's MIN, as an upper bound for realizable policies.
+ *
+ * The demand stream of the cache is recorded by an earlier simulation (see champsim::next_use_index). Each line remembers the position of its next
+ * demand access in its set, and the line used furthest in the future is evicted. An incoming line that is used after every resident line bypasses.
+ *
+ * The replay is exact only while the second simulation makes the same demand accesses as the first. Since the policy changes the timing, prefetches
+ * and writebacks may differ, and a line whose next use has passed unmatched is looked up again. The accesses that do not match the recording are
+ * counted, to show how far the replay has drifted.
+ */
+class oracle_min : public champsim::modules::replacement
+{
+  long NUM_SET, NUM_WAY;
+  champsim::next_use_index index;
+
+  std::vector<uint64_t> set_position; // the number of demand accesses to each set so far
+  std::vector<uint64_t> line_next_use;
+
+  uint64_t lookups = 0;
+  uint64_t unmatched = 0;
+  uint64_t bypasses = 0;
+
+  [[nodiscard]] std::size_t line_index(long set, long way) const { return static_cast<std::size_t>(set * NUM_WAY + way); }
+
+public:
+  explicit oracle_min(CACHE* cache);
+  oracle_min(CACHE* cache, const std::string& index_path);
+
+  long find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, const champsim::cache_block* current_set, champsim::address ip,
+                   champsim::address full_addr, access_type type, way_mask allowed_ways = all_ways);
+  void replacement_cache_fill(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip, champsim::address victim_addr,
+                              access_type type);
+  void update_replacement_state(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip, champsim::address victim_addr,
+                                access_type type, uint8_t hit);
+  void replacement_final_stats();
+
+  /**
+   * The position of the next demand access to the line, or champsim::next_use_index::never
+   */
+  [[nodiscard]] uint64_t next_use(long set, long way) const;
+};
+
+#endif
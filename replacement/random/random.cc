@@ -4,8 +4,12 @@ random::random(CACHE* cache) : random(cache, cache->NUM_WAY) {}
 
 random::random(CACHE* cache, long ways) : replacement(cache), dist(0, ways - 1) {}
 
-long random::find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, const CACHE::BLOCK* current_set, uint64_t ip, uint64_t full_addr,
-                         access_type type)
+long random::find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, const CACHE::BLOCK* current_set, champsim::address ip,
+                         champsim::address full_addr, access_type type, way_mask allowed_ways)
 {
-  return dist(rng);
+  // Draw again until the way is allowed. The cache allows at least one way.
+  auto way = dist(rng);
+  while (!allows(allowed_ways, way))
+    way = dist(rng);
+  return way;
 }
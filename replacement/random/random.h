@@ -14,7 +14,8 @@ struct random : public champsim::modules::replacement {
   random(CACHE* cache, long ways);
 
   // void initialize_replacement();
-  long find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, const CACHE::BLOCK* current_set, uint64_t ip, uint64_t full_addr, access_type type);
+  long find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, const CACHE::BLOCK* current_set, champsim::address ip, champsim::address full_addr,
+                   access_type type, way_mask allowed_ways = all_ways);
   // void update_replacement_state(uint32_t triggering_cpu, long set, long way, uint64_t full_addr, uint64_t ip, uint64_t victim_addr, access_type type, uint8_t
   // hit);
   //  void replacement_final_stats()
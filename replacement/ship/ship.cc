@@ -9,29 +9,17 @@
 // initialize replacement state
 ship::ship(CACHE* cache)
     : replacement(cache), NUM_SET(cache->NUM_SET), NUM_WAY(cache->NUM_WAY), sampler(get_num_sampled_sets() * NUM_CPUS * static_cast<std::size_t>(NUM_WAY)),
-      rrpv_values(static_cast<std::size_t>(NUM_SET * NUM_WAY), maxRRPV)
+      sampler_tags(std::size(sampler), invalid_tag), rrpv_values(NUM_SET, NUM_WAY)
 {
   std::generate_n(std::back_inserter(SHCT), NUM_CPUS, []() -> typename decltype(SHCT)::value_type { return {}; });
 }
 
-int& ship::get_rrpv(long set, long way) { return rrpv_values.at(static_cast<std::size_t>(set * NUM_WAY + way)); }
-
 // find replacement victim
 long ship::find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, const champsim::cache_block* current_set, champsim::address ip,
-                       champsim::address full_addr, access_type type)
+                       champsim::address full_addr, access_type type, way_mask allowed_ways)
 {
-  // look for the maxRRPV line
-  auto begin = std::next(std::begin(rrpv_values), set * NUM_WAY);
-  auto end = std::next(begin, NUM_WAY);
-
-  auto victim = std::max_element(begin, end);
-  if (auto rrpv_update = maxRRPV - *victim; rrpv_update != 0)
-    for (auto it = begin; it != end; ++it)
-      *it += rrpv_update;
-
-  assert(begin <= victim);
-  assert(victim < end);
-  return std::distance(begin, victim);
+  // look for the maxRRPV line, aging the set until there is one
+  return rrpv_values.victim(set, allowed_ways);
 }
 
 // called on every cache hit and cache fill
@@ -43,20 +31,24 @@ void ship::update_replacement_state(uint32_t triggering_cpu, long set, long way,
   // update sampler
   if (is_sampled(set)) {
     auto s_idx = set / get_set_sample_rate();
-    auto s_set_begin = std::next(std::begin(sampler), s_idx * NUM_WAY + get_num_sampled_sets() * NUM_WAY * triggering_cpu);
+    auto s_offset = s_idx * NUM_WAY + get_num_sampled_sets() * NUM_WAY * triggering_cpu;
+    auto s_set_begin = std::next(std::begin(sampler), s_offset);
     auto s_set_end = std::next(s_set_begin, NUM_WAY);
+    auto s_tags_begin = std::next(std::begin(sampler_tags), s_offset);
+    auto s_tags_end = std::next(s_tags_begin, NUM_WAY);
 
     // check hit
-    auto match = std::find_if(s_set_begin, s_set_end, [addr = full_addr, shamt = champsim::data::bits{champsim::lg2(get_num_sampled_sets()) + champsim::lg2(NUM_WAY)}](auto x) {
-      return x.valid && x.address.slice_upper(shamt) == addr.slice_upper(shamt);
-    });
+    auto shamt = champsim::data::bits{champsim::lg2(get_num_sampled_sets()) + champsim::lg2(NUM_WAY)};
+    auto tag = full_addr.slice_upper(shamt).to<uint64_t>();
+    auto tag_match = std::find(s_tags_begin, s_tags_end, tag);
+    auto match = std::next(s_set_begin, std::distance(s_tags_begin, tag_match));
     if (match != s_set_end) {
       auto SHCT_idx = match->ip.slice_lower<32_b>().to<std::size_t>() % SHCT_PRIME;
       SHCT[triggering_cpu][SHCT_idx] -= 1;
 
       match->used = true;
     } else {
-      match = std::min_element(s_set_begin, s_set_end, [](auto x, auto y) { return x.last_used < y.last_used; });
+      match = std::min_element(s_set_begin, s_set_end, [](const auto& x, const auto& y) { return x.last_used < y.last_used; });
 
       if (!match->used) {
         auto SHCT_idx = match->ip.slice_lower<32_b>().to<std::size_t>() % SHCT_PRIME;
@@ -67,6 +59,7 @@ void ship::update_replacement_state(uint32_t triggering_cpu, long set, long way,
       match->address = full_addr;
       match->ip = ip;
       match->used = false;
+      *std::next(s_tags_begin, std::distance(s_set_begin, match)) = tag;
     }
 
     // update LRU state
@@ -74,14 +67,14 @@ void ship::update_replacement_state(uint32_t triggering_cpu, long set, long way,
   }
 
   if(hit)
-    get_rrpv(set, way) = 0;
+    rrpv_values.set(set, way, 0);
 }
 
 void ship::replacement_cache_fill(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip, champsim::address victim_addr, access_type type)
 {
   // handle writeback access
   if (access_type{type} == access_type::WRITE) {
-    get_rrpv(set, way) = maxRRPV - 1;
+    rrpv_values.set(set, way, maxRRPV - 1);
     return;
   }
 
@@ -89,7 +82,7 @@ void ship::replacement_cache_fill(uint32_t triggering_cpu, long set, long way, c
   // SHIP prediction
   auto SHCT_idx = ip.slice_lower<32_b>().to<std::size_t>() % SHCT_PRIME;
 
-  get_rrpv(set, way) = maxRRPV - 1;
+  rrpv_values.set(set, way, maxRRPV - 1);
   if (SHCT[triggering_cpu][SHCT_idx].is_max())
-    get_rrpv(set, way) = maxRRPV;
+    rrpv_values.set(set, way, maxRRPV);
 }
@@ -2,19 +2,19 @@
 #define REPLACEMENT_SHIP_H
 
 #include <array>
+#include <limits>
 #include <vector>
 
 #include "cache.h"
 #include "modules.h"
 #include "msl/bits.h"
 #include "msl/fwcounter.h"
+#include "msl/packed_rrpv.h"
 
 struct ship : public champsim::modules::replacement {
-private:
-  int& get_rrpv(long set, long way);
-
 public:
-  static constexpr int maxRRPV = 3;
+  using rrpv_table = champsim::msl::packed_rrpv<2>;
+  static constexpr unsigned maxRRPV = rrpv_table::max_rrpv;
   static constexpr std::size_t SHCT_SIZE = 16384;
   static constexpr unsigned SHCT_PRIME = 16381;
   static constexpr unsigned SHCT_MAX = 7;
@@ -33,9 +33,11 @@ public:
   long NUM_SET, NUM_WAY;
   uint64_t access_count = 0;
 
-  // sampler
+  // sampler, with the tags of its entries kept apart so that a sampled set is searched in one pass
+  static constexpr uint64_t invalid_tag = std::numeric_limits<uint64_t>::max();
   std::vector<SAMPLER_class> sampler;
-  std::vector<int> rrpv_values;
+  std::vector<uint64_t> sampler_tags;
+  rrpv_table rrpv_values;
 
   // prediction table structure
   std::vector<std::array<champsim::msl::fwcounter<champsim::msl::lg2(SHCT_MAX + 1)>, SHCT_SIZE>> SHCT;
@@ -43,7 +45,7 @@ public:
   explicit ship(CACHE* cache);
 
   long find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, const champsim::cache_block* current_set, champsim::address ip,
-                   champsim::address full_addr, access_type type);
+                   champsim::address full_addr, access_type type, way_mask allowed_ways = all_ways);
   void replacement_cache_fill(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip, champsim::address victim_addr,
                               access_type type);
   void update_replacement_state(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip, champsim::address victim_addr,
@@ -8,39 +8,27 @@
 
 srrip::srrip(CACHE* cache) : srrip(cache, cache->NUM_SET, cache->NUM_WAY) {}
 
-srrip::srrip(CACHE* cache, long sets_, long ways_) : replacement(cache)
-{
-  std::generate_n(std::back_inserter(sets), sets_, [ways = ways_] { return srrip_set_helper{ways}; });
-}
+srrip::srrip(CACHE* cache, long sets_, long ways_) : replacement(cache), rrpv(sets_, ways_) {}
 
 // find replacement victim
 long srrip::find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, const champsim::cache_block* current_set, champsim::address ip,
-                        champsim::address full_addr, access_type type)
+                        champsim::address full_addr, access_type type, way_mask allowed_ways)
 {
-  return sets.at(static_cast<std::size_t>(set)).victim();
+  return rrpv.victim(set, allowed_ways);
 }
 
 // called on every cache hit and cache fill
 void srrip::update_replacement_state(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
                                      champsim::address victim_addr, access_type type, uint8_t hit)
 {
-  sets.at(static_cast<std::size_t>(set)).update(way, hit);
+  rrpv.set(set, way, hit ? 0 : (maxRRPV - 1));
 }
 
-srrip_set_helper::srrip_set_helper(long ways) : rrpv_values(static_cast<std::size_t>(ways), maxRRPV) {}
-
-auto srrip_set_helper::get_rrpv(long way) -> rrpv_type& { return rrpv_values.at(static_cast<std::size_t>(way)); }
+srrip_set_helper::srrip_set_helper(long ways) : rrpv_values(1, ways) {}
 
-long srrip_set_helper::victim()
-{
-  // Find the maximum RRPV
-  auto victim = std::max_element(std::begin(rrpv_values), std::end(rrpv_values));
-
-  // If the maximum element has RRPV less than the maximum, increment everything to the maximum
-  std::transform(std::cbegin(rrpv_values), std::cend(rrpv_values), std::begin(rrpv_values), [diff = maxRRPV - *victim](auto x) { return x + diff; });
+auto srrip_set_helper::get_rrpv(long way) const -> rrpv_type { return rrpv_values.get(0, way); }
 
-  // Return the way index
-  return std::distance(std::begin(rrpv_values), victim);
-}
+// Find the first way with the maximum RRPV, aging the set until it is the maximum
+long srrip_set_helper::victim() { return rrpv_values.victim(0); }
 
-void srrip_set_helper::update(long way, bool hit) { get_rrpv(way) = hit ? 0 : (maxRRPV - 1); }
+void srrip_set_helper::update(long way, bool hit) { rrpv_values.set(0, way, hit ? 0 : (maxRRPV - 1)); }
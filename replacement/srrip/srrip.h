@@ -2,17 +2,18 @@
 #define REPLACEMENT_SRRIP_H
 
 #include <cstdint>
-#include <vector>
 
 #include "cache.h"
 #include "modules.h"
+#include "msl/packed_rrpv.h"
 
 struct srrip_set_helper {
-  using rrpv_type = int;
-  static constexpr rrpv_type maxRRPV = 3;
+  using rrpv_table = champsim::msl::packed_rrpv<2>;
+  using rrpv_type = rrpv_table::value_type;
+  static constexpr rrpv_type maxRRPV = rrpv_table::max_rrpv;
 
-  std::vector<rrpv_type> rrpv_values;
-  rrpv_type& get_rrpv(long way);
+  rrpv_table rrpv_values;
+  [[nodiscard]] rrpv_type get_rrpv(long way) const;
 
   explicit srrip_set_helper(long ways);
 
@@ -21,15 +22,17 @@ struct srrip_set_helper {
 };
 
 struct srrip : public champsim::modules::replacement {
+  using rrpv_table = srrip_set_helper::rrpv_table;
+  static constexpr auto maxRRPV = srrip_set_helper::maxRRPV;
 
-  std::vector<srrip_set_helper> sets;
+  rrpv_table rrpv;
 
   explicit srrip(CACHE* cache);
   srrip(CACHE* cache, long sets_, long ways_);
 
   // void initialize_replacement() {}
   long find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, const champsim::cache_block* current_set, champsim::address ip,
-                   champsim::address full_addr, access_type type);
+                   champsim::address full_addr, access_type type, way_mask allowed_ways = all_ways);
   void update_replacement_state(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip, champsim::address victim_addr,
                                 access_type type, uint8_t hit);
 
@@ -27,6 +27,7 @@
 #include "champsim.h"
 #include "chrono.h"
 #include "deadlock.h"
+#include "dpc_api.h"
 #include "instruction.h"
 #include "util/algorithm.h"
 #include "util/bits.h"
@@ -47,6 +48,31 @@ CACHE::CACHE(CACHE&& other)
 
       pref_module_pimpl(std::move(other.pref_module_pimpl)), repl_module_pimpl(std::move(other.repl_module_pimpl))
 {
+  evicted_unused_prefetch = std::move(other.evicted_unused_prefetch);
+  prefetch_filter = std::move(other.prefetch_filter);
+  evicted_by_prefetch = std::move(other.evicted_by_prefetch);
+  pf_throttle = std::move(other.pf_throttle);
+  pf_components = other.pf_components;
+  pf_activation_issued = std::move(other.pf_activation_issued);
+  useful_pf_source = other.useful_pf_source;
+  pf_metadata_sliced = other.pf_metadata_sliced;
+  pf_candidates = std::move(other.pf_candidates);
+  pf_arbiter = std::move(other.pf_arbiter);
+  pf_metadata_store = std::move(other.pf_metadata_store);
+  packed_tags = std::move(other.packed_tags);
+  inclusion = other.inclusion;
+  directory = std::move(other.directory);
+  directory_requesters = std::move(other.directory_requesters);
+  partition = std::move(other.partition);
+  metadata_region = other.metadata_region;
+  pending_metadata_accesses = other.pending_metadata_accesses;
+  inflight_metadata_reads = std::move(other.inflight_metadata_reads);
+  victims = std::move(other.victims);
+  write_combiner = std::move(other.write_combiner);
+  compression = std::move(other.compression);
+  data_segments_per_set = other.data_segments_per_set;
+  oracle_recorder = std::move(other.oracle_recorder);
+
   pref_module_pimpl->bind(this);
   repl_module_pimpl->bind(this);
 }
@@ -83,6 +109,30 @@ auto CACHE::operator=(CACHE&& other) -> CACHE&
 
   this->sim_stats = std::move(other.sim_stats);
   this->roi_stats = std::move(other.roi_stats);
+  this->evicted_unused_prefetch = std::move(other.evicted_unused_prefetch);
+  this->prefetch_filter = std::move(other.prefetch_filter);
+  this->evicted_by_prefetch = std::move(other.evicted_by_prefetch);
+  this->pf_throttle = std::move(other.pf_throttle);
+  this->pf_components = other.pf_components;
+  this->pf_activation_issued = std::move(other.pf_activation_issued);
+  this->useful_pf_source = other.useful_pf_source;
+  this->pf_metadata_sliced = other.pf_metadata_sliced;
+  this->pf_candidates = std::move(other.pf_candidates);
+  this->pf_arbiter = std::move(other.pf_arbiter);
+  this->pf_metadata_store = std::move(other.pf_metadata_store);
+  this->packed_tags = std::move(other.packed_tags);
+  this->inclusion = other.inclusion;
+  this->directory = std::move(other.directory);
+  this->directory_requesters = std::move(other.directory_requesters);
+  this->partition = std::move(other.partition);
+  this->metadata_region = other.metadata_region;
+  this->pending_metadata_accesses = other.pending_metadata_accesses;
+  this->inflight_metadata_reads = std::move(other.inflight_metadata_reads);
+  this->victims = std::move(other.victims);
+  this->write_combiner = std::move(other.write_combiner);
+  this->compression = std::move(other.compression);
+  this->data_segments_per_set = other.data_segments_per_set;
+  this->oracle_recorder = std::move(other.oracle_recorder);
 
   this->pref_module_pimpl = std::move(other.pref_module_pimpl);
   this->repl_module_pimpl = std::move(other.repl_module_pimpl);
@@ -104,14 +154,15 @@ CACHE::~CACHE()
 CACHE::tag_lookup_type::tag_lookup_type(const request_type& req, bool local_pref, bool skip)
     : address(req.address), v_address(req.v_address), data(req.data), ip(req.ip), instr_id(req.instr_id), pf_metadata(req.pf_metadata), cpu(req.cpu),
       type(req.type), prefetch_from_this(local_pref), skip_fill(skip), is_translated(req.is_translated), is_instr(req.is_instr),
-      instr_depend_on_me(req.instr_depend_on_me)
+      clean_victim(req.clean_victim), full_line(req.full_line), instr_depend_on_me(req.instr_depend_on_me)
 {
 }
 
 CACHE::mshr_type::mshr_type(const tag_lookup_type& req, champsim::chrono::clock::time_point _time_enqueued)
-    : address(req.address), v_address(req.v_address), ip(req.ip), instr_id(req.instr_id), cpu(req.cpu), type(req.type),
-      prefetch_from_this(req.prefetch_from_this), is_instr(req.is_instr), time_enqueued(_time_enqueued), instr_depend_on_me(req.instr_depend_on_me),
-      to_return(req.to_return)
+    : address(req.address), v_address(req.v_address), ip(req.ip), instr_id(req.instr_id), pf_source(req.pf_source), cpu(req.cpu), type(req.type),
+      prefetch_from_this(req.prefetch_from_this), is_instr(req.is_instr), page_walked(req.page_walked), clean_victim(req.clean_victim),
+      time_enqueued(_time_enqueued),
+      instr_depend_on_me(req.instr_depend_on_me), to_return(req.to_return)
 {
 }
 
@@ -133,6 +184,7 @@ CACHE::mshr_type CACHE::mshr_type::merge(mshr_type predecessor, mshr_type succes
   retval.instr_depend_on_me = merged_instr;
   retval.to_return = merged_return;
   retval.data_promise = predecessor.data_promise;
+  retval.page_walked = predecessor.page_walked || successor.page_walked;
 
   if constexpr (champsim::debug_print) {
     if (successor.type == access_type::PREFETCH) {
@@ -154,11 +206,13 @@ auto CACHE::fill_block(mshr_type mshr, uint32_t metadata) -> BLOCK
   CACHE::BLOCK to_fill;
   to_fill.valid = true;
   to_fill.prefetch = mshr.prefetch_from_this;
-  to_fill.dirty = (mshr.type == access_type::WRITE);
+  to_fill.dirty = (mshr.type == access_type::WRITE) && !mshr.clean_victim;
+  to_fill.owned = (mshr.type == access_type::RFO) || (mshr.type == access_type::WRITE);
   to_fill.address = mshr.address;
   to_fill.v_address = mshr.v_address;
   to_fill.data = mshr.data_promise->data;
   to_fill.pf_metadata = metadata;
+  to_fill.pf_source = mshr.pf_source;
 
   return to_fill;
 }
@@ -189,15 +243,22 @@ bool CACHE::handle_fill(const mshr_type& fill_mshr)
 
   // find victim
   auto [set_begin, set_end] = get_set_span(fill_mshr.address);
-  auto way = std::find_if_not(set_begin, set_end, [](auto x) { return x.valid; });
-  if (way == set_end) {
+
+  // An exclusive cache passes blocks up without keeping them. It keeps only its own prefetches and the blocks evicted above.
+  const bool bypass_exclusive =
+      (inclusion == champsim::inclusion_policy::EXCLUSIVE) && fill_mshr.type != access_type::WRITE && !std::empty(fill_mshr.to_return);
+
+  const auto allowed_ways = fill_ways(fill_mshr.cpu);
+  auto way = bypass_exclusive ? set_end : find_invalid_block(set_begin, set_end, allowed_ways);
+  if (way == set_end && !bypass_exclusive) {
     way = std::next(set_begin, impl_find_victim(fill_mshr.cpu, fill_mshr.instr_id, get_set_index(fill_mshr.address), &*set_begin, fill_mshr.ip,
-                                                fill_mshr.address, fill_mshr.type));
+                                                fill_mshr.address, fill_mshr.type, allowed_ways));
   }
   assert(set_begin <= way);
   assert(way <= set_end);
   assert(way != set_end || fill_mshr.type != access_type::WRITE); // Writes may not bypass
   const auto way_idx = std::distance(set_begin, way);             // cast protected by earlier assertion
+  assert(way == set_end || champsim::modules::replacement::allows(allowed_ways, way_idx));
 
   if constexpr (champsim::debug_print) {
     fmt::print("[{}] {} instr_id: {} address: {} v_address: {} set: {} way: {} type: {} prefetch_metadata: {} cycle_enqueued: {} cycle: {}\n", NAME, __func__,
@@ -206,24 +267,40 @@ bool CACHE::handle_fill(const mshr_type& fill_mshr)
                (fill_mshr.time_enqueued.time_since_epoch()) / clock_period, (current_time.time_since_epoch()) / clock_period);
   }
 
-  if (way != set_end && way->valid && way->dirty) {
-    request_type writeback_packet;
-
-    writeback_packet.cpu = fill_mshr.cpu;
-    writeback_packet.address = way->address;
-    writeback_packet.data = way->data;
-    writeback_packet.instr_id = fill_mshr.instr_id;
-    writeback_packet.ip = champsim::address{};
-    writeback_packet.type = access_type::WRITE;
-    writeback_packet.pf_metadata = way->pf_metadata;
-    writeback_packet.response_requested = false;
+  const auto fill_segments = compression.has_value() ? compression->segments(fill_mshr.address) : uint32_t{0};
+  if (compression.has_value() && way != set_end) {
+    // The victim's tag may not free enough of the data array for the incoming block, so the oldest blocks of the set leave as well
+    for (auto extra : compression_victims(set_begin, set_end, way, fill_segments, fill_mshr.cpu, fill_mshr.instr_id, fill_mshr.ip, fill_mshr.address)) {
+      if ((extra->dirty || lower_level->lower_is_exclusive) && !issue_writeback(*extra, fill_mshr.cpu, fill_mshr.instr_id))
+        return false;
+      if (extra->prefetch) {
+        ++sim_stats.pf_useless;
+        if (extra->pf_source < std::size(sim_stats.pf_sources))
+          ++sim_stats.pf_sources[extra->pf_source].useless;
+      }
+      if (inclusion == champsim::inclusion_policy::INCLUSIVE)
+        send_back_invalidation(extra->address);
+      invalidate_block(extra);
+      ++sim_stats.compression_evictions;
+    }
+  }
 
+  if (way != set_end && way->valid && victims.has_value()) {
+    // The victim cache takes the evicted block, and the block that it displaces is written back instead
+    auto displaced = victims->displaced();
+    if (displaced.has_value() && (displaced->dirty || lower_level->lower_is_exclusive)) {
+      if (!issue_writeback(*displaced, fill_mshr.cpu, fill_mshr.instr_id))
+        return false;
+      ++sim_stats.victim_cache_writebacks;
+    }
+    victims->insert(*way);
+  } else if (way != set_end && way->valid && (way->dirty || lower_level->lower_is_exclusive)) {
     if constexpr (champsim::debug_print) {
-      fmt::print("[{}] {} evict address: {} v_address: {} prefetch_metadata: {}\n", NAME, __func__, writeback_packet.address, writeback_packet.v_address,
+      fmt::print("[{}] {} evict address: {} v_address: {} prefetch_metadata: {}\n", NAME, __func__, way->address, way->v_address,
                  fill_mshr.data_promise->pf_metadata);
     }
 
-    auto success = lower_level->add_wq(writeback_packet);
+    auto success = issue_writeback(*way, fill_mshr.cpu, fill_mshr.instr_id);
     if (!success) {
       return false;
     }
@@ -232,11 +309,33 @@ bool CACHE::handle_fill(const mshr_type& fill_mshr)
   champsim::address evicting_address{};
   if (way != set_end && way->valid) {
     evicting_address = module_address(*way);
+    prefetch_filter_remove(virtual_prefetch ? way->v_address : way->address);
   }
 
   if (way != set_end) {
     if (way->valid && way->prefetch) {
       ++sim_stats.pf_useless;
+      if (way->pf_source < std::size(sim_stats.pf_sources))
+        ++sim_stats.pf_sources[way->pf_source].useless;
+      if (pf_arbiter.has_value())
+        pf_arbiter->record_useless(way->pf_source);
+      evicted_unused_prefetch.at(static_cast<std::size_t>(get_set_index(fill_mshr.address))) = way->address;
+    }
+
+    if (way->valid && fill_mshr.type == access_type::PREFETCH) {
+      evicted_by_prefetch.at(static_cast<std::size_t>(get_set_index(fill_mshr.address))) = way->address;
+    }
+
+    if (way->valid && pf_throttle.has_value()) {
+      pf_throttle->record_eviction();
+    }
+
+    if (way->valid && inclusion == champsim::inclusion_policy::INCLUSIVE) {
+      send_back_invalidation(way->address);
+    }
+
+    if (fill_mshr.type == access_type::WRITE && inclusion == champsim::inclusion_policy::EXCLUSIVE) {
+      ++sim_stats.victim_fills;
     }
 
     if (fill_mshr.type == access_type::PREFETCH) {
@@ -246,14 +345,27 @@ bool CACHE::handle_fill(const mshr_type& fill_mshr)
 
   uint32_t metadata_thru = fill_mshr.data_promise->pf_metadata;
   if (!module_is_instr(fill_mshr)) { // limiting only for data line fills
+    reset_prefetch_budget();
+    pf_metadata_sliced = fill_mshr.prefetch_from_this;
     metadata_thru = impl_prefetcher_cache_fill(module_address(fill_mshr), get_set_index(fill_mshr.address), way_idx, (fill_mshr.type == access_type::PREFETCH),
                                                evicting_address, fill_mshr.data_promise->pf_metadata);
   }
-  impl_replacement_cache_fill(fill_mshr.cpu, get_set_index(fill_mshr.address), way_idx, module_address(fill_mshr), fill_mshr.ip, evicting_address,
-                              fill_mshr.type);
+  if (!bypass_exclusive) { // the replacement policy did not choose to bypass, so it is not told of the fill
+    impl_replacement_cache_fill(fill_mshr.cpu, get_set_index(fill_mshr.address), way_idx, module_address(fill_mshr), fill_mshr.ip, evicting_address,
+                                fill_mshr.type);
+  }
 
   if (way != set_end) {
     *way = fill_block(fill_mshr, metadata_thru);
+    way->fill_time = current_time;
+    way->cpu = fill_mshr.cpu;
+    way->segments = fill_segments;
+    if (compression.has_value()) {
+      ++sim_stats.compressed_fills;
+      sim_stats.compressed_fill_bytes += compression->compressed_size(fill_mshr.address);
+    }
+    update_packed_tag(way);
+    prefetch_filter_insert(virtual_prefetch ? fill_mshr.v_address : fill_mshr.address, true);
   }
 
   // COLLECT STATS
@@ -262,6 +374,8 @@ bool CACHE::handle_fill(const mshr_type& fill_mshr)
   sim_stats.mshr_return.increment(std::pair{fill_mshr.type, fill_mshr.cpu});
 
   response_type response{fill_mshr.address, fill_mshr.v_address, fill_mshr.data_promise->data, metadata_thru, fill_mshr.instr_depend_on_me};
+  response.miss_depth = static_cast<uint8_t>(std::min(fill_mshr.data_promise->miss_depth + 1, int{std::numeric_limits<uint8_t>::max()}));
+  response.page_walked = fill_mshr.page_walked || fill_mshr.data_promise->page_walked;
   for (auto* ret : fill_mshr.to_return) {
     ret->push_back(response);
   }
@@ -275,9 +389,13 @@ bool CACHE::try_hit(const tag_lookup_type& handle_pkt)
 
   // access cache
   auto [set_begin, set_end] = get_set_span(handle_pkt.address);
-  auto way = std::find_if(set_begin, set_end, [matcher = matches_address(handle_pkt.address)](const auto& x) { return x.valid && matcher(x); });
+  auto way = find_valid_block(set_begin, set_end, handle_pkt.address);
+  if (way == set_end && victims.has_value())
+    way = swap_from_victim_cache(set_begin, set_end, handle_pkt);
   const auto hit = (way != set_end);
   const auto useful_prefetch = (hit && way->prefetch && !handle_pkt.prefetch_from_this);
+  if (useful_prefetch)
+    useful_pf_source = way->pf_source;
 
   if (hit && !warmup && trace_file) {
     fprintf(trace_file, "%ld,%lx,%lx,%s,HIT\n", 
@@ -296,34 +414,181 @@ bool CACHE::try_hit(const tag_lookup_type& handle_pkt)
 
   auto metadata_thru = handle_pkt.pf_metadata;
   if (should_activate_prefetcher(handle_pkt) && !module_is_instr(handle_pkt)) { // limiting only to data line hits
+    reset_prefetch_budget();
+    pf_metadata_sliced = handle_pkt.prefetch_from_this;
     metadata_thru = impl_prefetcher_cache_operate(module_address(handle_pkt), handle_pkt.ip, hit, useful_prefetch, handle_pkt.type, metadata_thru);
   }
 
-  // update replacement policy
-  const auto way_idx = std::distance(set_begin, way);
-  impl_update_replacement_state(handle_pkt.cpu, get_set_index(handle_pkt.address), way_idx, module_address(handle_pkt), handle_pkt.ip, {}, handle_pkt.type,
-                                hit);
-
   if (hit) {
+    // update replacement policy. A miss updates it once its tag check is final.
+    impl_update_replacement_state(handle_pkt.cpu, get_set_index(handle_pkt.address), std::distance(set_begin, way), module_address(handle_pkt), handle_pkt.ip,
+                                  {}, handle_pkt.type, true);
+
     sim_stats.hits.increment(std::pair{handle_pkt.type, handle_pkt.cpu});
 
     response_type response{handle_pkt.address, handle_pkt.v_address, way->data, metadata_thru, handle_pkt.instr_depend_on_me};
+    response.page_walked = handle_pkt.page_walked;
     for (auto* ret : handle_pkt.to_return) {
       ret->push_back(response);
     }
 
-    way->dirty |= (handle_pkt.type == access_type::WRITE);
+    way->dirty |= (handle_pkt.type == access_type::WRITE) && !handle_pkt.clean_victim;
+
+    // A store to a block held shared must take ownership from the directory below. The store does not wait for it.
+    const bool is_store = (handle_pkt.type == access_type::RFO) || (handle_pkt.type == access_type::WRITE && !handle_pkt.clean_victim);
+    if (is_store && !way->owned)
+      way->owned = issue_upgrade(*way, handle_pkt.cpu);
 
     // update prefetch stats and reset prefetch bit
     if (useful_prefetch) {
-      ++sim_stats.pf_useful;
+      record_prefetch_use(way->pf_source, false);
+      const auto fill_to_use = static_cast<uint64_t>((current_time - way->fill_time) / clock_period);
+      sim_stats.pf_fill_to_use.increment(fill_to_use == 0 ? 0 : champsim::lg2(fill_to_use) + 1);
       way->prefetch = false;
     }
+
+    // An exclusive cache gives up a block that moves up. Dirty data is written back first, and if it cannot be, the block stays.
+    const bool moves_up = (inclusion == champsim::inclusion_policy::EXCLUSIVE) && handle_pkt.type != access_type::WRITE && !std::empty(handle_pkt.to_return);
+    if (moves_up && (!way->dirty || issue_writeback(*way, handle_pkt.cpu, handle_pkt.instr_id))) {
+      invalidate_block(way);
+    }
+
+    finish_tag_check(handle_pkt, true);
   }
 
   return hit;
 }
 
+auto CACHE::functional_access(const request_type& req, bool train_prefetcher) -> functional_result
+{
+  cpu = req.cpu;
+  const tag_lookup_type handle_pkt{req, false, false};
+
+  auto [set_begin, set_end] = get_set_span(handle_pkt.address);
+  auto way = find_valid_block(set_begin, set_end, handle_pkt.address);
+  functional_result result{way != set_end, {}};
+
+  if (train_prefetcher && should_activate_prefetcher(handle_pkt) && !module_is_instr(handle_pkt)) {
+    reset_prefetch_budget();
+    pf_metadata_sliced = false;
+    impl_prefetcher_cache_operate(module_address(handle_pkt), handle_pkt.ip, result.hit, result.hit && way->prefetch, handle_pkt.type,
+                                  handle_pkt.pf_metadata);
+  }
+
+  if (partition.has_value() && handle_pkt.type != access_type::WRITE)
+    partition->record_access(handle_pkt.cpu, get_set_index(handle_pkt.address), champsim::block_number{handle_pkt.address}.to<uint64_t>());
+
+  impl_update_replacement_state(handle_pkt.cpu, get_set_index(handle_pkt.address), std::distance(set_begin, way), module_address(handle_pkt), handle_pkt.ip,
+                                {}, handle_pkt.type, result.hit);
+
+  if (result.hit) {
+    way->dirty |= (handle_pkt.type == access_type::WRITE) && !handle_pkt.clean_victim;
+    way->prefetch = false;
+
+    // An exclusive cache gives up a block that moves up
+    if (inclusion == champsim::inclusion_policy::EXCLUSIVE && handle_pkt.type != access_type::WRITE) {
+      if (way->dirty)
+        result.evicted.push_back(*way);
+      invalidate_block(way);
+    }
+  } else if (handle_pkt.type != access_type::WRITE || write_allocate) {
+    auto evicted = functional_fill(handle_pkt, train_prefetcher);
+    result.evicted.insert(std::end(result.evicted), std::begin(evicted), std::end(evicted));
+  }
+
+  // Prefetches are filled here at once. They do not reach the lower levels.
+  while (!std::empty(internal_PQ)) {
+    auto pf_packet = internal_PQ.front();
+    internal_PQ.pop_front();
+    auto [pf_begin, pf_end] = get_set_span(pf_packet.address);
+    if (pf_packet.is_translated && find_valid_block(pf_begin, pf_end, pf_packet.address) == pf_end) {
+      auto evicted = functional_fill(pf_packet, train_prefetcher);
+      result.evicted.insert(std::end(result.evicted), std::begin(evicted), std::end(evicted));
+    }
+  }
+
+  return result;
+}
+
+auto CACHE::functional_fill(const tag_lookup_type& pkt, bool train_prefetcher) -> std::vector<BLOCK>
+{
+  const auto set = get_set_index(pkt.address);
+  auto [set_begin, set_end] = get_set_span(pkt.address);
+
+  // An exclusive cache passes blocks up without keeping them
+  const bool bypass_exclusive = (inclusion == champsim::inclusion_policy::EXCLUSIVE) && pkt.type != access_type::WRITE && !pkt.prefetch_from_this;
+  if (bypass_exclusive || pkt.skip_fill)
+    return {};
+
+  const auto allowed_ways = fill_ways(pkt.cpu);
+  auto way = find_invalid_block(set_begin, set_end, allowed_ways);
+  if (way == set_end)
+    way = std::next(set_begin, impl_find_victim(pkt.cpu, pkt.instr_id, set, &*set_begin, pkt.ip, pkt.address, pkt.type, allowed_ways));
+  const auto way_idx = std::distance(set_begin, way);
+
+  std::vector<BLOCK> evicted{};
+  const auto fill_segments = compression.has_value() ? compression->segments(pkt.address) : uint32_t{0};
+  if (compression.has_value() && way != set_end) {
+    for (auto extra : compression_victims(set_begin, set_end, way, fill_segments, pkt.cpu, pkt.instr_id, pkt.ip, pkt.address)) {
+      evicted.push_back(*extra);
+      invalidate_block(extra);
+    }
+  }
+
+  champsim::address evicting_address{};
+  if (way != set_end && way->valid) {
+    evicted.push_back(*way);
+    evicting_address = module_address(*way);
+    prefetch_filter_remove(virtual_prefetch ? way->v_address : way->address);
+  }
+
+  uint32_t metadata_thru = pkt.pf_metadata;
+  if (train_prefetcher && !module_is_instr(pkt)) {
+    reset_prefetch_budget();
+    pf_metadata_sliced = false;
+    metadata_thru = impl_prefetcher_cache_fill(module_address(pkt), set, way_idx, (pkt.type == access_type::PREFETCH), evicting_address, pkt.pf_metadata);
+  }
+  impl_replacement_cache_fill(pkt.cpu, set, way_idx, module_address(pkt), pkt.ip, evicting_address, pkt.type);
+
+  if (way != set_end) {
+    way->valid = true;
+    way->prefetch = pkt.prefetch_from_this;
+    way->dirty = (pkt.type == access_type::WRITE) && !pkt.clean_victim;
+    way->address = pkt.address;
+    way->v_address = pkt.v_address;
+    way->data = pkt.data;
+    way->pf_metadata = metadata_thru;
+    way->pf_source = pkt.pf_source;
+    way->cpu = pkt.cpu;
+    way->fill_time = current_time;
+    way->segments = fill_segments;
+    update_packed_tag(way);
+    prefetch_filter_insert(virtual_prefetch ? pkt.v_address : pkt.address, true);
+  }
+
+  return evicted;
+}
+
+void CACHE::record_prefetch_use(uint32_t pf_source, bool late)
+{
+  ++sim_stats.pf_useful;
+  if (late)
+    ++sim_stats.pf_late;
+  else
+    ++sim_stats.pf_timely;
+
+  if (pf_source < std::size(sim_stats.pf_sources)) {
+    ++sim_stats.pf_sources[pf_source].useful;
+    if (late)
+      ++sim_stats.pf_sources[pf_source].late;
+  }
+
+  if (pf_throttle.has_value())
+    pf_throttle->record_use(late);
+  if (pf_arbiter.has_value())
+    pf_arbiter->record_useful(pf_source);
+}
+
 auto CACHE::mshr_and_forward_packet(const tag_lookup_type& handle_pkt) -> std::pair<mshr_type, request_type>
 {
   mshr_type to_allocate{handle_pkt, current_time};
@@ -390,10 +655,9 @@ bool CACHE::handle_miss(const tag_lookup_type& handle_pkt)
   if (mshr_entry != MSHR.end()) // miss already inflight
   {
     if (mshr_entry->type == access_type::PREFETCH && handle_pkt.type != access_type::PREFETCH) {
-      // Mark the prefetch as useful
-      if (mshr_entry->prefetch_from_this) {
-        ++sim_stats.pf_useful;
-      }
+      // Mark the prefetch as useful, but late
+      if (mshr_entry->prefetch_from_this)
+        record_prefetch_use(mshr_entry->pf_source, true);
     }
 
     // COLLECT STATS
@@ -416,9 +680,65 @@ bool CACHE::handle_miss(const tag_lookup_type& handle_pkt)
     if (mshr_pkt.second.response_requested) {
       MSHR.emplace_back(std::move(mshr_pkt.first));
     }
+
+    // A demand for a block that was prefetched, but evicted before it was used
+    auto& evicted_prefetch = evicted_unused_prefetch.at(static_cast<std::size_t>(get_set_index(handle_pkt.address)));
+    if (handle_pkt.type != access_type::PREFETCH && evicted_prefetch.has_value()
+        && evicted_prefetch->slice_upper(OFFSET_BITS) == handle_pkt.address.slice_upper(OFFSET_BITS)) {
+      ++sim_stats.pf_early;
+      evicted_prefetch.reset();
+    }
+
+    // A demand for a block that was evicted to make room for a prefetch
+    if (handle_pkt.type != access_type::PREFETCH) {
+      auto& evicted_block = evicted_by_prefetch.at(static_cast<std::size_t>(get_set_index(handle_pkt.address)));
+      const bool polluting = evicted_block.has_value() && evicted_block->slice_upper(OFFSET_BITS) == handle_pkt.address.slice_upper(OFFSET_BITS);
+      if (polluting) {
+        ++sim_stats.pf_polluting_misses;
+        evicted_block.reset();
+      }
+      if (pf_throttle.has_value())
+        pf_throttle->record_demand_miss(polluting);
+    }
   }
 
+  // The prefetched block is now on its way to this cache, so later prefetches for it are duplicates
+  if (handle_pkt.prefetch_from_this && !handle_pkt.skip_fill)
+    prefetch_filter_insert(virtual_prefetch ? handle_pkt.v_address : handle_pkt.address, false);
+
   sim_stats.misses.increment(std::pair{handle_pkt.type, handle_pkt.cpu});
+  finish_tag_check(handle_pkt, false);
+
+  return true;
+}
+
+bool CACHE::handle_write_around(const tag_lookup_type& handle_pkt)
+{
+  if constexpr (champsim::debug_print) {
+    fmt::print("[{}] {} instr_id: {} address: {} v_address: {} type: {} cycle: {}\n", NAME, __func__, handle_pkt.instr_id, handle_pkt.address,
+               handle_pkt.v_address, access_type_names.at(champsim::to_underlying(handle_pkt.type)), current_time.time_since_epoch() / clock_period);
+  }
+
+  request_type fwd_pkt;
+  fwd_pkt.asid[0] = handle_pkt.asid[0];
+  fwd_pkt.asid[1] = handle_pkt.asid[1];
+  fwd_pkt.type = access_type::WRITE;
+  fwd_pkt.cpu = handle_pkt.cpu;
+  fwd_pkt.address = handle_pkt.address;
+  fwd_pkt.v_address = handle_pkt.v_address;
+  fwd_pkt.data = handle_pkt.data;
+  fwd_pkt.instr_id = handle_pkt.instr_id;
+  fwd_pkt.ip = handle_pkt.ip;
+  fwd_pkt.clean_victim = handle_pkt.clean_victim;
+  fwd_pkt.full_line = handle_pkt.full_line;
+  fwd_pkt.response_requested = false;
+
+  if (!lower_level->add_wq(fwd_pkt))
+    return false;
+
+  ++sim_stats.writes_not_allocated;
+  sim_stats.misses.increment(std::pair{handle_pkt.type, handle_pkt.cpu});
+  finish_tag_check(handle_pkt, false);
 
   return true;
 }
@@ -436,6 +756,7 @@ bool CACHE::handle_write(const tag_lookup_type& handle_pkt)
   inflight_writes.push_back(to_allocate);
 
   sim_stats.misses.increment(std::pair{handle_pkt.type, handle_pkt.cpu});
+  finish_tag_check(handle_pkt, false);
 
   return true;
 }
@@ -451,6 +772,7 @@ auto CACHE::initiate_tag_check(champsim::channel* ul)
       if (entry.response_requested) {
         retval.to_return = {&ul->returned};
       }
+      retval.source_channel = ul;
     } else {
       (void)ul; // supress warning about ul being unused
     }
@@ -468,6 +790,9 @@ long CACHE::operate()
 {
   long progress{0};
 
+  // Prefetches that are not triggered by an access, such as those from cycle_operate(), are clamped per cycle
+  reset_prefetch_budget();
+
   auto is_ready = [time = current_time](const auto& entry) {
     return entry.event_cycle <= time;
   };
@@ -484,6 +809,25 @@ long CACHE::operate()
   progress += std::distance(std::cbegin(lower_level->returned), std::cend(lower_level->returned));
   lower_level->returned.clear();
 
+  // Send the writebacks that are ready to leave the write-combining buffer
+  if (write_combiner.has_value())
+    progress += write_combiner->drain(*lower_level);
+
+  // Apply back-invalidations from an inclusive lower level
+  std::for_each(std::cbegin(lower_level->invalidations), std::cend(lower_level->invalidations),
+                [this](const auto& addr) { this->apply_back_invalidation(addr); });
+  progress += std::distance(std::cbegin(lower_level->invalidations), std::cend(lower_level->invalidations));
+  lower_level->invalidations.clear();
+
+  // Tell the levels above whether a directory below tracks the ownership of their blocks
+  for (auto* ul : upper_levels)
+    ul->lower_tracks_ownership = directory.has_value() || lower_level->lower_tracks_ownership;
+
+  // Apply coherence downgrades from a lower level with a directory
+  std::for_each(std::cbegin(lower_level->downgrades), std::cend(lower_level->downgrades), [this](const auto& addr) { this->apply_downgrade(addr); });
+  progress += std::distance(std::cbegin(lower_level->downgrades), std::cend(lower_level->downgrades));
+  lower_level->downgrades.clear();
+
   // Finish translations
   if (lower_translate != nullptr) {
     std::for_each(std::cbegin(lower_translate->returned), std::cend(lower_translate->returned), [this](const auto& pkt) { this->finish_translation(pkt); });
@@ -505,6 +849,14 @@ long CACHE::operate()
   const champsim::bandwidth::maximum_type bandwidth_from_tag_checks{champsim::to_underlying(MAX_TAG) * (long)(HIT_LATENCY / clock_period)
                                                                     - (long)std::size(inflight_tag_check)};
   champsim::bandwidth initiate_tag_bw{std::clamp(bandwidth_from_tag_checks, champsim::bandwidth::maximum_type{0}, MAX_TAG)};
+
+  // Metadata accesses share the tag array with demands, and take precedence over them
+  auto metadata_bandwidth_consumed = std::min(pending_metadata_accesses, initiate_tag_bw.amount_remaining());
+  initiate_tag_bw.consume(metadata_bandwidth_consumed);
+  pending_metadata_accesses -= metadata_bandwidth_consumed;
+  if (lower_level != nullptr)
+    issue_metadata_reads();
+
   auto can_translate = [avail = (std::size(translation_stash) < static_cast<std::size_t>(MSHR_SIZE))](const auto& entry) {
     return avail || entry.is_translated;
   };
@@ -551,9 +903,17 @@ long CACHE::operate()
 
   // Perform tag checks
   auto do_handle_miss = [this](const auto& pkt) {
+    if (pkt.type == access_type::WRITE && !this->write_allocate) {
+      return this->handle_write_around(pkt); // Send writes on to the lower level without allocating
+    }
     if (pkt.type == access_type::WRITE && !this->match_offset_bits) {
       return this->handle_write(pkt); // Treat writes (that is, writebacks) like fills
     }
+    if (pkt.type == access_type::WRITE && pkt.full_line && this->full_line_write_elision
+        && std::none_of(std::begin(this->MSHR), std::end(this->MSHR), this->matches_address(pkt.address))) {
+      ++this->sim_stats.rfo_elided;
+      return this->handle_write(pkt); // A store that writes the whole block need not read it for ownership
+    }
     return this->handle_miss(pkt); // Treat writes (that is, stores) like reads
   };
   champsim::bandwidth tag_check_bw{MAX_TAG};
@@ -566,6 +926,7 @@ long CACHE::operate()
   inflight_tag_check.erase(tag_check_ready_begin, finish_tag_check_end);
 
   impl_prefetcher_cycle_operate();
+  arbitrate_prefetches();
 
   if constexpr (champsim::debug_print) {
     fmt::print("[{}] {} cycle completed: {} tags checked: {} remaining: {} stash consumed: {} remaining: {} channel consumed: {} pq consumed {} unused consume "
@@ -613,22 +974,363 @@ uint64_t CACHE::get_way(uint64_t address, uint64_t /*unused set index*/) const
 }
 // LCOV_EXCL_STOP
 
+auto CACHE::find_valid_block(set_type::iterator set_begin, set_type::iterator set_end, champsim::address address) -> set_type::iterator
+{
+  if (packed_tags.has_value()) {
+    auto way = packed_tags->find(static_cast<std::size_t>(get_set_index(address)), address.slice_upper(OFFSET_BITS).to<uint64_t>());
+    return way.has_value() ? std::next(set_begin, static_cast<set_type::difference_type>(*way)) : set_end;
+  }
+  return std::find_if(set_begin, set_end, [matcher = matches_address(address)](const auto& x) { return x.valid && matcher(x); });
+}
+
+auto CACHE::find_invalid_block(set_type::iterator set_begin, set_type::iterator set_end, uint64_t allowed_ways) -> set_type::iterator
+{
+  if (packed_tags.has_value() && allowed_ways == champsim::modules::replacement::all_ways) {
+    const auto set_idx = std::distance(std::begin(block), set_begin) / NUM_WAY;
+    auto way = packed_tags->find_invalid(static_cast<std::size_t>(set_idx));
+    return way.has_value() ? std::next(set_begin, static_cast<set_type::difference_type>(*way)) : set_end;
+  }
+  for (auto way = set_begin; way != set_end; ++way) {
+    if (!way->valid && champsim::modules::replacement::allows(allowed_ways, std::distance(set_begin, way)))
+      return way;
+  }
+  return set_end;
+}
+
+uint64_t CACHE::fill_ways(uint32_t triggering_cpu) const
+{
+  return partition.has_value() ? partition->mask(triggering_cpu) : champsim::modules::replacement::all_ways;
+}
+
+void CACHE::finish_tag_check(const tag_lookup_type& handle_pkt, bool hit)
+{
+  if (!hit) {
+    impl_update_replacement_state(handle_pkt.cpu, get_set_index(handle_pkt.address), NUM_WAY, module_address(handle_pkt), handle_pkt.ip, {}, handle_pkt.type,
+                                  false);
+  }
+
+  if (oracle_recorder && champsim::next_use_index::is_demand(handle_pkt.type))
+    oracle_recorder->record(get_set_index(handle_pkt.address), champsim::block_number{module_address(handle_pkt)}.to<uint64_t>());
+
+  if (partition.has_value() && handle_pkt.type != access_type::WRITE && !handle_pkt.prefetch_from_this)
+    partition->record_access(handle_pkt.cpu, get_set_index(handle_pkt.address), champsim::block_number{handle_pkt.address}.to<uint64_t>());
+
+  directory_access(handle_pkt);
+}
+
+void CACHE::update_packed_tag(set_type::const_iterator way)
+{
+  if (!packed_tags.has_value())
+    return;
+
+  const auto idx = static_cast<std::size_t>(std::distance(std::cbegin(block), way));
+  if (way->valid)
+    packed_tags->insert(idx / NUM_WAY, idx % NUM_WAY, way->address.slice_upper(OFFSET_BITS).to<uint64_t>());
+  else
+    packed_tags->erase(idx / NUM_WAY, idx % NUM_WAY);
+}
+
+bool CACHE::issue_writeback(const BLOCK& victim, uint32_t triggering_cpu, uint64_t instr_id)
+{
+  request_type writeback_packet;
+
+  writeback_packet.cpu = triggering_cpu;
+  writeback_packet.address = victim.address;
+  writeback_packet.data = victim.data;
+  writeback_packet.instr_id = instr_id;
+  writeback_packet.ip = champsim::address{};
+  writeback_packet.type = access_type::WRITE;
+  writeback_packet.pf_metadata = victim.pf_metadata;
+  writeback_packet.response_requested = false;
+  writeback_packet.clean_victim = !victim.dirty;
+
+  if (!write_combiner.has_value())
+    return lower_level->add_wq(writeback_packet);
+
+  auto result = write_combiner->add(writeback_packet);
+  if (result == champsim::write_combining_buffer::add_result::COMBINED)
+    ++sim_stats.wcb_combined;
+  if (result != champsim::write_combining_buffer::add_result::FULL)
+    ++sim_stats.wcb_writes;
+  return result != champsim::write_combining_buffer::add_result::FULL;
+}
+
+bool CACHE::issue_upgrade(const BLOCK& shared_block, uint32_t triggering_cpu)
+{
+  if (!lower_level->lower_tracks_ownership)
+    return true;
+
+  request_type upgrade_packet;
+  upgrade_packet.cpu = triggering_cpu;
+  upgrade_packet.address = shared_block.address;
+  upgrade_packet.v_address = shared_block.v_address;
+  upgrade_packet.type = access_type::RFO;
+  upgrade_packet.is_translated = true;
+  upgrade_packet.response_requested = false;
+
+  if (!lower_level->add_rq(upgrade_packet))
+    return false; // The next store to the block tries again
+
+  ++sim_stats.coherence_upgrades;
+  return true;
+}
+
+auto CACHE::swap_from_victim_cache(set_type::iterator set_begin, set_type::iterator set_end, const tag_lookup_type& handle_pkt) -> set_type::iterator
+{
+  auto found = victims->take(handle_pkt.address);
+  if (!found.has_value())
+    return set_end;
+
+  // The block returns to the set, and the block it replaces takes its place in the victim cache.
+  // The replacement policy may not bypass here, so it is asked as if for a writeback.
+  const auto allowed_ways = fill_ways(handle_pkt.cpu);
+  auto way = find_invalid_block(set_begin, set_end, allowed_ways);
+  if (way == set_end) {
+    way = std::next(set_begin, impl_find_victim(handle_pkt.cpu, handle_pkt.instr_id, get_set_index(handle_pkt.address), &*set_begin, handle_pkt.ip,
+                                                handle_pkt.address, access_type::WRITE, allowed_ways));
+  }
+  assert(way != set_end);
+
+  champsim::address evicting_address{};
+  if (way->valid) {
+    evicting_address = module_address(*way);
+    prefetch_filter_remove(virtual_prefetch ? way->v_address : way->address);
+    victims->insert(*way);
+  }
+
+  impl_replacement_cache_fill(handle_pkt.cpu, get_set_index(handle_pkt.address), std::distance(set_begin, way), module_address(*found), handle_pkt.ip,
+                              evicting_address, handle_pkt.type);
+  *way = *found;
+  update_packed_tag(way);
+  prefetch_filter_insert(virtual_prefetch ? way->v_address : way->address, true);
+
+  ++sim_stats.victim_cache_hits;
+  return way;
+}
+
+auto CACHE::compression_victims(set_type::iterator set_begin, set_type::iterator set_end, set_type::iterator way, uint32_t segments,
+                                uint32_t triggering_cpu, uint64_t instr_id, champsim::address ip, champsim::address full_addr)
+    -> std::vector<set_type::iterator>
+{
+  // The constructor limits a compressed cache to as many tag ways as the mask holds
+  uint64_t resident = 0;
+  uint32_t used = 0;
+  for (auto it = set_begin; it != set_end; ++it) {
+    if (it->valid && it != way) {
+      resident |= uint64_t{1} << std::distance(set_begin, it);
+      used += it->segments;
+    }
+  }
+
+  // Each further victim is chosen by the replacement policy among the blocks that remain, as if for a writeback, so that it may not bypass.
+  // The blocks in the ways the core may fill go first, and the other cores' blocks only if those do not free enough of the data array.
+  const auto allowed_ways = fill_ways(triggering_cpu);
+  std::vector<set_type::iterator> retval{};
+  while (used + segments > data_segments_per_set) {
+    const auto candidates = (resident & allowed_ways) != 0 ? (resident & allowed_ways) : resident;
+    assert(candidates != 0);
+    auto victim = impl_find_victim(triggering_cpu, instr_id, get_set_index(full_addr), &*set_begin, ip, full_addr, access_type::WRITE, candidates);
+    assert(((candidates >> victim) & 1) != 0);
+
+    resident &= ~(uint64_t{1} << victim);
+    used -= std::next(set_begin, victim)->segments;
+    retval.push_back(std::next(set_begin, victim));
+  }
+  return retval;
+}
+
+void CACHE::invalidate_block(set_type::iterator way)
+{
+  way->valid = false;
+  update_packed_tag(way);
+  prefetch_filter_remove(virtual_prefetch ? way->v_address : way->address);
+}
+
+void CACHE::send_back_invalidation(champsim::address address)
+{
+  for (auto* ul : upper_levels) {
+    if (ul->upper_holds_copies)
+      ul->invalidations.push_back(address);
+  }
+  ++sim_stats.back_invalidations;
+}
+
+void CACHE::apply_back_invalidation(champsim::address address)
+{
+  auto [set_begin, set_end] = get_set_span(address);
+  auto way = find_valid_block(set_begin, set_end, address);
+  if (way != set_end) {
+    // The lower level has already given up the block, so dirty data is sent on a best-effort basis
+    if (way->dirty)
+      issue_writeback(*way, cpu, 0);
+    invalidate_block(way);
+    ++sim_stats.back_invalidated;
+  } else if (auto victim = victims.has_value() ? victims->take(address) : std::nullopt; victim.has_value()) {
+    if (victim->dirty)
+      issue_writeback(*victim, cpu, 0);
+    ++sim_stats.back_invalidated;
+  }
+
+  // The levels above may hold the block even if this level does not
+  for (auto* ul : upper_levels) {
+    if (ul->upper_holds_copies)
+      ul->invalidations.push_back(address);
+  }
+}
+
+void CACHE::apply_downgrade(champsim::address address)
+{
+  auto [set_begin, set_end] = get_set_span(address);
+  auto way = find_valid_block(set_begin, set_end, address);
+  if (way != set_end) {
+    way->owned = false;
+    if (way->dirty && issue_writeback(*way, cpu, 0))
+      way->dirty = false;
+  }
+
+  for (auto* ul : upper_levels) {
+    if (ul->upper_holds_copies)
+      ul->downgrades.push_back(address);
+  }
+}
+
+void CACHE::directory_access(const tag_lookup_type& handle_pkt)
+{
+  if (!directory.has_value() || handle_pkt.source_channel == nullptr)
+    return;
+
+  auto requester_it = std::find(std::begin(directory_requesters), std::end(directory_requesters), handle_pkt.source_channel);
+  assert(requester_it != std::end(directory_requesters));
+  const auto requester = static_cast<std::size_t>(std::distance(std::begin(directory_requesters), requester_it));
+  const auto block_num = champsim::block_number{handle_pkt.address}.to<uint64_t>();
+
+  if (handle_pkt.type == access_type::WRITE) {
+    directory->writeback(block_num, requester);
+    return;
+  }
+
+  // Only requests that leave a copy above are tracked. An upgrade asks for no data, but keeps the copy that is already there.
+  if (std::empty(handle_pkt.to_return) && handle_pkt.type != access_type::RFO)
+    return;
+
+  auto result = directory->access(block_num, requester, handle_pkt.type == access_type::RFO);
+  if (result.coherence_miss)
+    ++sim_stats.coherence_misses;
+
+  auto send = [this](champsim::coherence_directory::mask_type requesters, champsim::address addr, auto queue) {
+    for (std::size_t i = 0; i < std::size(directory_requesters); ++i) {
+      if (((requesters >> i) & 1) != 0 && directory_requesters[i]->upper_holds_copies)
+        (directory_requesters[i]->*queue).push_back(addr);
+    }
+    return champsim::popcount(requesters);
+  };
+
+  const champsim::address block_address{champsim::block_number{handle_pkt.address}};
+  sim_stats.coherence_invalidations += static_cast<uint64_t>(send(result.invalidate, block_address, &channel_type::invalidations));
+  sim_stats.coherence_downgrades += static_cast<uint64_t>(send(result.downgrade, block_address, &channel_type::downgrades));
+  if (result.evicted_block.has_value()) {
+    ++sim_stats.directory_evictions;
+    const champsim::address evicted_address{champsim::block_number{*result.evicted_block}};
+    sim_stats.coherence_invalidations += static_cast<uint64_t>(send(result.evicted_sharers, evicted_address, &channel_type::invalidations));
+  }
+}
+
+long CACHE::lookup_way(champsim::address address)
+{
+  auto [begin, end] = get_set_span(address);
+  return std::distance(begin, find_valid_block(begin, end, address));
+}
+
 long CACHE::invalidate_entry(champsim::address inval_addr)
 {
+  if (victims.has_value())
+    victims->take(inval_addr);
+
   auto [begin, end] = get_set_span(inval_addr);
-  auto inv_way = std::find_if(begin, end, matches_address(inval_addr));
+  auto inv_way = find_valid_block(begin, end, inval_addr);
 
   if (inv_way != end) {
-    inv_way->valid = false;
+    invalidate_block(inv_way);
   }
 
   return std::distance(begin, inv_way);
 }
 
+uint64_t CACHE::prefetch_filter_key(champsim::address addr) const { return addr.slice_upper(OFFSET_BITS).to<uint64_t>(); }
+
+void CACHE::prefetch_filter_insert(champsim::address addr, bool resident)
+{
+  if (prefetch_filter.has_value())
+    prefetch_filter->fill({prefetch_filter_key(addr), resident});
+}
+
+void CACHE::prefetch_filter_remove(champsim::address addr)
+{
+  if (prefetch_filter.has_value())
+    prefetch_filter->invalidate({prefetch_filter_key(addr), false});
+}
+
 bool CACHE::prefetch_line(champsim::address pf_addr, bool fill_this_level, uint32_t prefetch_metadata)
 {
   ++sim_stats.pf_requested;
 
+  if (pf_throttle.has_value()) {
+    pf_throttle->record_bandwidth(get_dram_bw());
+    if (pf_activation_issued.at(active_pf_source) >= pf_throttle->degree()) {
+      ++sim_stats.pf_throttled;
+      return false;
+    }
+  }
+
+  // The issuing module owns only its slice of the metadata that travels with the prefetch
+  const auto metadata = champsim::set_metadata_slice(0, prefetch_metadata, active_pf_source, pf_components);
+
+  bool accepted = false;
+  if (pf_arbiter.has_value()) {
+    // The filter and the queue's occupancy are checked now. Only the order in which the candidates take the free queue entries waits for the end of the cycle.
+    if (prefetch_filtered(pf_addr)) {
+      accepted = true;
+    } else {
+      // Each module may offer up to a full queue of candidates
+      const auto offered =
+          std::count_if(std::cbegin(pf_candidates), std::cend(pf_candidates), [source = active_pf_source](const auto& x) { return x.source == source; });
+      accepted = std::size(internal_PQ) < PQ_SIZE && static_cast<std::size_t>(offered) < PQ_SIZE;
+      if (accepted)
+        pf_candidates.push_back({pf_addr, fill_this_level, metadata, active_pf_source});
+    }
+  } else {
+    accepted = issue_prefetch(pf_addr, fill_this_level, metadata, active_pf_source);
+  }
+
+  if (accepted)
+    ++pf_activation_issued.at(active_pf_source);
+  return accepted;
+}
+
+bool CACHE::prefetch_filtered(champsim::address pf_addr)
+{
+  if (!prefetch_filter.has_value())
+    return false;
+
+  auto found = prefetch_filter->check_hit({prefetch_filter_key(pf_addr), false});
+  if (!found.has_value())
+    return false;
+
+  if (found->resident)
+    ++sim_stats.pf_filtered_resident;
+  else
+    ++sim_stats.pf_filtered_duplicate;
+  return true;
+}
+
+void CACHE::reset_prefetch_budget() { std::fill(std::begin(pf_activation_issued), std::end(pf_activation_issued), 0); }
+
+bool CACHE::issue_prefetch(champsim::address pf_addr, bool fill_this_level, uint32_t prefetch_metadata, uint32_t source)
+{
+  // A prefetch for a block that was recently prefetched, or that is in the cache, is dropped. The block is already on its way, so this counts as success.
+  if (prefetch_filtered(pf_addr))
+    return true;
+
   if (std::size(internal_PQ) >= PQ_SIZE) {
     return false;
   }
@@ -642,11 +1344,135 @@ bool CACHE::prefetch_line(champsim::address pf_addr, bool fill_this_level, uint3
   pf_packet.is_translated = !virtual_prefetch;
 
   internal_PQ.emplace_back(pf_packet, true, !fill_this_level);
+  internal_PQ.back().pf_source = source;
   ++sim_stats.pf_issued;
+  if (pf_throttle.has_value())
+    pf_throttle->record_issue();
+  if (pf_arbiter.has_value())
+    pf_arbiter->record_issue(source);
+  if (source < std::size(sim_stats.pf_sources))
+    ++sim_stats.pf_sources[source].issued;
+
+  return true;
+}
+
+bool CACHE::has_metadata_store() const { return pf_metadata_store.has_value(); }
+
+std::optional<uint64_t> CACHE::metadata_read(uint64_t key)
+{
+  if (!pf_metadata_store.has_value())
+    return std::nullopt;
+
+  auto result = pf_metadata_store->read(key);
+  ++sim_stats.metadata_reads;
+  if (result.onchip_hit)
+    ++sim_stats.metadata_read_hits;
+  charge_metadata_access(key, result);
+
+  // Metadata that is still on its way from memory cannot yet be used to prefetch
+  auto is_key = [key](const auto& entry) { return entry.key == key; };
+  if (std::any_of(std::cbegin(inflight_metadata_reads), std::cend(inflight_metadata_reads), is_key))
+    return std::nullopt;
+  return result.value;
+}
+
+void CACHE::metadata_write(uint64_t key, uint64_t value)
+{
+  if (!pf_metadata_store.has_value())
+    return;
 
+  auto result = pf_metadata_store->write(key, value);
+  ++sim_stats.metadata_writes;
+  charge_metadata_access(key, result);
+}
+
+champsim::address CACHE::metadata_address(uint64_t key) const
+{
+  assert(metadata_region.has_value());
+  return metadata_region.value() + champsim::data::bytes{static_cast<long long>(key % metadata_region_entries) * metadata_entry_size.count()};
+}
+
+void CACHE::charge_metadata_access(uint64_t key, const champsim::metadata_store::access_result& result)
+{
+  ++pending_metadata_accesses;
+  if (result.evicted)
+    ++sim_stats.metadata_evictions;
+
+  if (lower_level == nullptr)
+    return;
+
+  // Off-chip metadata lives in a reserved region of physical memory. Reads hold back the value until the response returns, but writebacks are not waited on.
+  if (result.offchip_read) {
+    auto is_key = [key](const auto& entry) { return entry.key == key; };
+    if (std::none_of(std::cbegin(inflight_metadata_reads), std::cend(inflight_metadata_reads), is_key))
+      inflight_metadata_reads.push_back({metadata_address(key), key});
+    issue_metadata_reads();
+  }
+
+  if (result.offchip_write) {
+    request_type packet;
+    packet.cpu = cpu;
+    packet.address = metadata_address(key);
+    packet.v_address = packet.address;
+    packet.is_translated = true;
+    packet.response_requested = false;
+    packet.type = access_type::WRITE;
+    if (lower_level->add_wq(packet))
+      ++sim_stats.metadata_offchip_writes;
+  }
+}
+
+void CACHE::issue_metadata_reads()
+{
+  for (auto& entry : inflight_metadata_reads) {
+    if (entry.issued)
+      continue;
+
+    request_type packet;
+    packet.cpu = cpu;
+    packet.address = entry.address;
+    packet.v_address = packet.address;
+    packet.is_translated = true;
+    packet.response_requested = true;
+    packet.type = access_type::LOAD;
+    if (!lower_level->add_rq(packet))
+      return; // Try again next cycle
+
+    entry.issued = true;
+    ++sim_stats.metadata_offchip_reads;
+  }
+}
+
+bool CACHE::finish_metadata_read(const response_type& packet)
+{
+  auto is_response = [block = champsim::block_number{packet.address}](const auto& entry) {
+    return entry.issued && champsim::block_number{entry.address} == block;
+  };
+  auto first_returned = std::remove_if(std::begin(inflight_metadata_reads), std::end(inflight_metadata_reads), is_response);
+  if (first_returned == std::end(inflight_metadata_reads))
+    return false;
+
+  inflight_metadata_reads.erase(first_returned, std::end(inflight_metadata_reads));
   return true;
 }
 
+void CACHE::arbitrate_prefetches()
+{
+  if (!pf_arbiter.has_value() || std::empty(pf_candidates))
+    return;
+
+  // The candidates of the highest-ranked module are issued first, in the order that module issued them
+  auto ranks = pf_arbiter->rank();
+  auto rank_of = [&ranks](const prefetch_candidate& x) { return x.source < std::size(ranks) ? ranks[x.source] : std::size(ranks); };
+  std::stable_sort(std::begin(pf_candidates), std::end(pf_candidates), [rank_of](const auto& x, const auto& y) { return rank_of(x) < rank_of(y); });
+
+  for (const auto& candidate : pf_candidates) {
+    if (!issue_prefetch(candidate.address, candidate.fill_this_level, candidate.metadata, candidate.source))
+      ++sim_stats.pf_arbitration_dropped;
+  }
+  pf_candidates.clear();
+}
+
 // LCOV_EXCL_START exclude deprecated function
 bool CACHE::prefetch_line(uint64_t pf_addr, bool fill_this_level, uint32_t prefetch_metadata)
 {
@@ -661,6 +1487,10 @@ bool CACHE::prefetch_line(uint64_t /*deprecated*/, uint64_t /*deprecated*/, uint
 
 void CACHE::finish_packet(const response_type& packet)
 {
+  // Responses to metadata reads have no MSHR
+  if (finish_metadata_read(packet))
+    return;
+
   // check MSHR information
   auto mshr_entry = std::find_if(std::begin(MSHR), std::end(MSHR), matches_address(packet.address));
   auto first_unreturned = std::find_if(MSHR.begin(), MSHR.end(), [](auto x) { return x.data_promise.has_unknown_readiness(); });
@@ -672,7 +1502,7 @@ void CACHE::finish_packet(const response_type& packet)
   }
 
   // MSHR holds the most updated information about this request
-  mshr_type::returned_value finished_value{packet.data, packet.pf_metadata};
+  mshr_type::returned_value finished_value{packet.data, packet.pf_metadata, packet.miss_depth, packet.page_walked};
   mshr_entry->data_promise = champsim::waitable{finished_value, current_time + (warmup ? champsim::chrono::clock::duration{} : FILL_LATENCY)};
   if constexpr (champsim::debug_print) {
     fmt::print("[{}_MSHR] finish_packet instr_id: {} address: {} data: {} type: {} current: {}\n", this->NAME, mshr_entry->instr_id, mshr_entry->address,
@@ -689,10 +1519,11 @@ void CACHE::finish_translation(const response_type& packet)
   auto matches_vpage = [page_num = champsim::page_number{packet.v_address}](const auto& entry) {
     return (champsim::page_number{entry.v_address} == page_num) && !entry.is_translated;
   };
-  auto mark_translated = [p_page = champsim::page_number{packet.data}, this](auto& entry) {
+  auto mark_translated = [p_page = champsim::page_number{packet.data}, walked = packet.page_walked, this](auto& entry) {
     [[maybe_unused]] auto old_address = entry.address;
     entry.address = champsim::address{champsim::splice(p_page, champsim::page_offset{entry.v_address})}; // translated address
     entry.is_translated = true;                                                                          // This entry is now translated
+    entry.page_walked = walked;
 
     if constexpr (champsim::debug_print) {
       fmt::print("[{}_TRANSLATE] finish_translation old: {} paddr: {} vaddr: {} type: {} cycle: {}\n", this->NAME, old_address, entry.address, entry.v_address,
@@ -871,9 +1702,9 @@ void CACHE::impl_prefetcher_branch_operate(champsim::address ip, uint8_t branch_
 void CACHE::impl_initialize_replacement() const { repl_module_pimpl->impl_initialize_replacement(); }
 
 long CACHE::impl_find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, const BLOCK* current_set, champsim::address ip, champsim::address full_addr,
-                             access_type type) const
+                             access_type type, uint64_t allowed_ways) const
 {
-  return repl_module_pimpl->impl_find_victim(triggering_cpu, instr_id, set, current_set, ip, full_addr, type);
+  return repl_module_pimpl->impl_find_victim(triggering_cpu, instr_id, set, current_set, ip, full_addr, type, allowed_ways);
 }
 
 void CACHE::impl_update_replacement_state(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
@@ -895,6 +1726,11 @@ void CACHE::initialize()
   impl_prefetcher_initialize();
   impl_initialize_replacement();
 
+  if (lower_level != nullptr)
+    lower_level->upper_holds_copies = true;
+  for (auto* ul : upper_levels)
+    ul->lower_is_exclusive = (inclusion == champsim::inclusion_policy::EXCLUSIVE);
+
   const char* trace_env = std::getenv("CHAMPSIM_TRACE");
   bool should_trace = false;
 
@@ -923,6 +1759,11 @@ void CACHE::initialize()
         fmt::print("Error: Failed to open trace file pipeline: {}\n", filename);
     }
   }
+
+  // Record the demand stream for an oracle replacement policy to replay in a later simulation
+  const char* oracle_env = std::getenv("CHAMPSIM_ORACLE_RECORD");
+  if (oracle_env != nullptr && (std::string_view{oracle_env} == "ALL" || this->NAME.find(oracle_env) != std::string::npos))
+    oracle_recorder = std::make_unique<champsim::next_use_index::recorder>(champsim::next_use_index::default_path(NAME), NUM_SET);
 }
 
 void CACHE::begin_phase()
@@ -933,6 +1774,11 @@ void CACHE::begin_phase()
   new_roi_stats.name = NAME;
   new_sim_stats.name = NAME;
 
+  for (const auto& source_name : pref_module_pimpl->impl_prefetcher_names()) {
+    new_roi_stats.pf_sources.push_back({source_name});
+    new_sim_stats.pf_sources.push_back({source_name});
+  }
+
   roi_stats = new_roi_stats;
   sim_stats = new_sim_stats;
 
@@ -957,8 +1803,64 @@ void CACHE::end_phase(unsigned finished_cpu)
   roi_stats.pf_requested = sim_stats.pf_requested;
   roi_stats.pf_issued = sim_stats.pf_issued;
   roi_stats.pf_useful = sim_stats.pf_useful;
+  roi_stats.pf_timely = sim_stats.pf_timely;
+  roi_stats.pf_late = sim_stats.pf_late;
+  roi_stats.pf_early = sim_stats.pf_early;
   roi_stats.pf_useless = sim_stats.pf_useless;
   roi_stats.pf_fill = sim_stats.pf_fill;
+  roi_stats.pf_filtered_duplicate = sim_stats.pf_filtered_duplicate;
+  roi_stats.pf_filtered_resident = sim_stats.pf_filtered_resident;
+  roi_stats.pf_throttled = sim_stats.pf_throttled;
+  roi_stats.pf_polluting_misses = sim_stats.pf_polluting_misses;
+  roi_stats.pf_arbitration_dropped = sim_stats.pf_arbitration_dropped;
+  roi_stats.back_invalidations = sim_stats.back_invalidations;
+  roi_stats.back_invalidated = sim_stats.back_invalidated;
+  roi_stats.victim_fills = sim_stats.victim_fills;
+  roi_stats.coherence_misses = sim_stats.coherence_misses;
+  roi_stats.coherence_invalidations = sim_stats.coherence_invalidations;
+  roi_stats.coherence_downgrades = sim_stats.coherence_downgrades;
+  roi_stats.directory_evictions = sim_stats.directory_evictions;
+  roi_stats.coherence_upgrades = sim_stats.coherence_upgrades;
+  roi_stats.victim_cache_hits = sim_stats.victim_cache_hits;
+  roi_stats.victim_cache_writebacks = sim_stats.victim_cache_writebacks;
+  roi_stats.wcb_writes = sim_stats.wcb_writes;
+  roi_stats.wcb_combined = sim_stats.wcb_combined;
+  roi_stats.compressed_fills = sim_stats.compressed_fills;
+  roi_stats.compressed_fill_bytes = sim_stats.compressed_fill_bytes;
+  roi_stats.compression_evictions = sim_stats.compression_evictions;
+  roi_stats.rfo_elided = sim_stats.rfo_elided;
+  roi_stats.writes_not_allocated = sim_stats.writes_not_allocated;
+
+  // Occupancy and partitions are snapshots at the end of the phase
+  sim_stats.occupancy.clear();
+  for (const auto& blk : block) {
+    if (!blk.valid)
+      continue;
+    if (std::size(sim_stats.occupancy) <= blk.cpu)
+      sim_stats.occupancy.resize(blk.cpu + 1);
+    ++sim_stats.occupancy[blk.cpu];
+  }
+  if (partition.has_value()) {
+    sim_stats.partition_ways = partition->allocation();
+    sim_stats.repartitions = partition->repartitions();
+  }
+  if (compression.has_value()) {
+    sim_stats.resident_blocks = static_cast<uint64_t>(std::count_if(std::begin(block), std::end(block), [](const auto& blk) { return blk.valid; }));
+    sim_stats.capacity_blocks = uint64_t{NUM_SET} * (data_segments_per_set / compression->block_segments());
+  }
+  roi_stats.occupancy = sim_stats.occupancy;
+  roi_stats.resident_blocks = sim_stats.resident_blocks;
+  roi_stats.capacity_blocks = sim_stats.capacity_blocks;
+  roi_stats.partition_ways = sim_stats.partition_ways;
+  roi_stats.repartitions = sim_stats.repartitions;
+  roi_stats.metadata_reads = sim_stats.metadata_reads;
+  roi_stats.metadata_read_hits = sim_stats.metadata_read_hits;
+  roi_stats.metadata_writes = sim_stats.metadata_writes;
+  roi_stats.metadata_evictions = sim_stats.metadata_evictions;
+  roi_stats.metadata_offchip_reads = sim_stats.metadata_offchip_reads;
+  roi_stats.metadata_offchip_writes = sim_stats.metadata_offchip_writes;
+  roi_stats.pf_fill_to_use = sim_stats.pf_fill_to_use;
+  roi_stats.pf_sources = sim_stats.pf_sources;
 
   for (auto* ul : upper_levels) {
     ul->roi_stats.RQ_ACCESS = ul->sim_stats.RQ_ACCESS;
@@ -1,13 +1,60 @@
 #include "cache_stats.h"
 
+#include <algorithm>
+
 cache_stats operator-(cache_stats lhs, cache_stats rhs)
 {
   cache_stats result;
   result.pf_requested = lhs.pf_requested - rhs.pf_requested;
   result.pf_issued = lhs.pf_issued - rhs.pf_issued;
   result.pf_useful = lhs.pf_useful - rhs.pf_useful;
+  result.pf_timely = lhs.pf_timely - rhs.pf_timely;
+  result.pf_late = lhs.pf_late - rhs.pf_late;
+  result.pf_early = lhs.pf_early - rhs.pf_early;
   result.pf_useless = lhs.pf_useless - rhs.pf_useless;
   result.pf_fill = lhs.pf_fill - rhs.pf_fill;
+  result.pf_filtered_duplicate = lhs.pf_filtered_duplicate - rhs.pf_filtered_duplicate;
+  result.pf_filtered_resident = lhs.pf_filtered_resident - rhs.pf_filtered_resident;
+  result.pf_throttled = lhs.pf_throttled - rhs.pf_throttled;
+  result.pf_polluting_misses = lhs.pf_polluting_misses - rhs.pf_polluting_misses;
+  result.pf_arbitration_dropped = lhs.pf_arbitration_dropped - rhs.pf_arbitration_dropped;
+  result.back_invalidations = lhs.back_invalidations - rhs.back_invalidations;
+  result.back_invalidated = lhs.back_invalidated - rhs.back_invalidated;
+  result.victim_fills = lhs.victim_fills - rhs.victim_fills;
+  result.coherence_misses = lhs.coherence_misses - rhs.coherence_misses;
+  result.coherence_invalidations = lhs.coherence_invalidations - rhs.coherence_invalidations;
+  result.coherence_downgrades = lhs.coherence_downgrades - rhs.coherence_downgrades;
+  result.directory_evictions = lhs.directory_evictions - rhs.directory_evictions;
+  result.coherence_upgrades = lhs.coherence_upgrades - rhs.coherence_upgrades;
+  result.victim_cache_hits = lhs.victim_cache_hits - rhs.victim_cache_hits;
+  result.victim_cache_writebacks = lhs.victim_cache_writebacks - rhs.victim_cache_writebacks;
+  result.wcb_writes = lhs.wcb_writes - rhs.wcb_writes;
+  result.wcb_combined = lhs.wcb_combined - rhs.wcb_combined;
+  result.compressed_fills = lhs.compressed_fills - rhs.compressed_fills;
+  result.compressed_fill_bytes = lhs.compressed_fill_bytes - rhs.compressed_fill_bytes;
+  result.compression_evictions = lhs.compression_evictions - rhs.compression_evictions;
+  result.rfo_elided = lhs.rfo_elided - rhs.rfo_elided;
+  result.writes_not_allocated = lhs.writes_not_allocated - rhs.writes_not_allocated;
+  result.resident_blocks = lhs.resident_blocks;
+  result.capacity_blocks = lhs.capacity_blocks;
+  result.occupancy = lhs.occupancy;
+  result.partition_ways = lhs.partition_ways;
+  result.repartitions = lhs.repartitions - rhs.repartitions;
+  result.metadata_reads = lhs.metadata_reads - rhs.metadata_reads;
+  result.metadata_read_hits = lhs.metadata_read_hits - rhs.metadata_read_hits;
+  result.metadata_writes = lhs.metadata_writes - rhs.metadata_writes;
+  result.metadata_evictions = lhs.metadata_evictions - rhs.metadata_evictions;
+  result.metadata_offchip_reads = lhs.metadata_offchip_reads - rhs.metadata_offchip_reads;
+  result.metadata_offchip_writes = lhs.metadata_offchip_writes - rhs.metadata_offchip_writes;
+  result.pf_fill_to_use = lhs.pf_fill_to_use - rhs.pf_fill_to_use;
+
+  result.pf_sources = lhs.pf_sources;
+  for (std::size_t i = 0; i < std::min(std::size(lhs.pf_sources), std::size(rhs.pf_sources)); ++i) {
+    result.pf_sources[i].issued -= rhs.pf_sources[i].issued;
+    result.pf_sources[i].useful -= rhs.pf_sources[i].useful;
+    result.pf_sources[i].late -= rhs.pf_sources[i].late;
+    result.pf_sources[i].useless -= rhs.pf_sources[i].useless;
+  }
 
   result.hits = lhs.hits - rhs.hits;
   result.misses = lhs.misses - rhs.misses;
@@ -24,6 +24,7 @@
 #include <fmt/core.h>
 
 #include "environment.h"
+#include "functional_warmup.h"
 #include "ooo_cpu.h"
 #include "operable.h"
 #include "phase_info.h"
@@ -64,10 +65,36 @@ long do_cycle(environment& env, std::vector<tracereader>& traces, std::vector<st
   return progress;
 }
 
+phase_stats collect_stats(const phase_info& phase, environment& env)
+{
+  phase_stats stats;
+  stats.name = phase.name;
+
+  for (std::size_t i = 0; i < std::size(phase.trace_index); ++i) {
+    stats.trace_names.push_back(phase.trace_names.at(phase.trace_index.at(i)));
+  }
+
+  auto cpus = env.cpu_view();
+  std::transform(std::begin(cpus), std::end(cpus), std::back_inserter(stats.sim_cpu_stats), [](const O3_CPU& cpu) { return cpu.sim_stats; });
+  std::transform(std::begin(cpus), std::end(cpus), std::back_inserter(stats.roi_cpu_stats), [](const O3_CPU& cpu) { return cpu.roi_stats; });
+
+  auto caches = env.cache_view();
+  std::transform(std::begin(caches), std::end(caches), std::back_inserter(stats.sim_cache_stats), [](const CACHE& cache) { return cache.sim_stats; });
+  std::transform(std::begin(caches), std::end(caches), std::back_inserter(stats.roi_cache_stats), [](const CACHE& cache) { return cache.roi_stats; });
+
+  auto dram = env.dram_view();
+  std::transform(std::begin(dram.channels), std::end(dram.channels), std::back_inserter(stats.sim_dram_stats),
+                 [](const DRAM_CHANNEL& chan) { return chan.sim_stats; });
+  std::transform(std::begin(dram.channels), std::end(dram.channels), std::back_inserter(stats.roi_dram_stats),
+                 [](const DRAM_CHANNEL& chan) { return chan.roi_stats; });
+
+  return stats;
+}
+
 phase_stats do_phase(const phase_info& phase, environment& env, std::vector<tracereader>& traces, champsim::chrono::clock& global_clock)
 {
   auto operables = env.operable_view();
-  auto [phase_name, is_warmup, length, trace_index, trace_names] = phase;
+  auto [phase_name, is_warmup, length, trace_index, trace_names, is_functional, train_prefetchers] = phase;
 
   // Initialize phase
   for (champsim::operable& op : operables) {
@@ -171,28 +198,35 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
                cpu.sim_instr(), cpu.sim_cycle(), std::ceil(cpu.sim_instr()) / std::ceil(cpu.sim_cycle()), elapsed_time());
   }
 
-  phase_stats stats;
-  stats.name = phase.name;
+  return collect_stats(phase, env);
+}
 
-  for (std::size_t i = 0; i < std::size(trace_index); ++i) {
-    stats.trace_names.push_back(trace_names.at(trace_index.at(i)));
+phase_stats do_functional_phase(const phase_info& phase, environment& env, std::vector<tracereader>& traces)
+{
+  auto operables = env.operable_view();
+  for (champsim::operable& op : operables) {
+    op.warmup = phase.is_warmup;
+    op.halt = false;
+    op.begin_phase();
   }
 
+  // The cores take turns, one instruction at a time, so that they share the lower levels as they would in the detailed model
+  functional_warmup model{env, phase.train_prefetchers};
   auto cpus = env.cpu_view();
-  std::transform(std::begin(cpus), std::end(cpus), std::back_inserter(stats.sim_cpu_stats), [](const O3_CPU& cpu) { return cpu.sim_stats; });
-  std::transform(std::begin(cpus), std::end(cpus), std::back_inserter(stats.roi_cpu_stats), [](const O3_CPU& cpu) { return cpu.roi_stats; });
-
-  auto caches = env.cache_view();
-  std::transform(std::begin(caches), std::end(caches), std::back_inserter(stats.sim_cache_stats), [](const CACHE& cache) { return cache.sim_stats; });
-  std::transform(std::begin(caches), std::end(caches), std::back_inserter(stats.roi_cache_stats), [](const CACHE& cache) { return cache.roi_stats; });
+  long long instrs{0};
+  for (; instrs < phase.length && std::none_of(std::begin(traces), std::end(traces), [](const auto& tr) { return tr.eof(); }); ++instrs) {
+    for (O3_CPU& cpu : cpus)
+      model.operate(cpu.cpu, traces.at(phase.trace_index.at(cpu.cpu))());
+  }
 
-  auto dram = env.dram_view();
-  std::transform(std::begin(dram.channels), std::end(dram.channels), std::back_inserter(stats.sim_dram_stats),
-                 [](const DRAM_CHANNEL& chan) { return chan.sim_stats; });
-  std::transform(std::begin(dram.channels), std::end(dram.channels), std::back_inserter(stats.roi_dram_stats),
-                 [](const DRAM_CHANNEL& chan) { return chan.roi_stats; });
+  for (O3_CPU& cpu : cpus) {
+    for (champsim::operable& op : operables)
+      op.end_phase(cpu.cpu);
+    fmt::print("{} complete CPU {} instructions: {} functional cache accesses: {} (Simulation time: {:%H hr %M min %S sec})\n", phase.name, cpu.cpu, instrs,
+               model.accesses(), elapsed_time());
+  }
 
-  return stats;
+  return collect_stats(phase, env);
 }
 
 // simulation entry point
@@ -205,7 +239,7 @@ std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases,
   champsim::chrono::clock global_clock;
   std::vector<phase_stats> results;
   for (auto phase : phases) {
-    auto stats = do_phase(phase, env, traces, global_clock);
+    auto stats = phase.is_functional ? do_functional_phase(phase, env, traces) : do_phase(phase, env, traces, global_clock);
     if (!phase.is_warmup) {
       results.push_back(stats);
     }
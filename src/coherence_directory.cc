@@ -0,0 +1,49 @@
+#include "coherence_directory.h"
+
+champsim::coherence_directory::coherence_directory(std::size_t sets, std::size_t ways) : entries(sets, ways) {}
+
+auto champsim::coherence_directory::access(uint64_t block, std::size_t requester, bool exclusive) -> action
+{
+  action result{};
+  const mask_type requester_bit = mask_type{1} << requester;
+
+  entry_type entry{block};
+  if (auto found = entries.check_hit(entry); found.has_value()) {
+    entry = *found;
+  }
+
+  result.coherence_miss = (entry.lost & requester_bit) != 0;
+  entry.lost &= ~requester_bit;
+
+  if (exclusive) {
+    // Read for ownership: every other copy is invalidated (M)
+    result.invalidate = entry.sharers & ~requester_bit;
+    entry.lost |= result.invalidate;
+    entry.sharers = requester_bit;
+    entry.owner = requester;
+  } else {
+    // Read: an exclusive copy elsewhere is downgraded (S), and a copy that no one else holds is exclusive (E)
+    if (entry.owner.has_value() && *entry.owner != requester) {
+      result.downgrade = mask_type{1} << *entry.owner;
+      entry.owner.reset();
+    }
+    entry.sharers |= requester_bit;
+    if (entry.sharers == requester_bit)
+      entry.owner = requester;
+  }
+
+  if (auto victim = entries.fill(entry); victim.has_value()) {
+    result.evicted_block = victim->block;
+    result.evicted_sharers = victim->sharers;
+  }
+
+  return result;
+}
+
+void champsim::coherence_directory::writeback(uint64_t block, std::size_t requester)
+{
+  if (auto found = entries.check_hit({block}); found.has_value() && found->owner == requester) {
+    found->owner.reset();
+    entries.fill(*found);
+  }
+}
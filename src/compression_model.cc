@@ -0,0 +1,106 @@
+#include "compression_model.h"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+#include "util/to_underlying.h"
+
+namespace
+{
+uint64_t mix(uint64_t key)
+{
+  // The finalizer of splitmix64, so that neighboring blocks fall into unrelated size classes
+  key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9;
+  key = (key ^ (key >> 27)) * 0x94d049bb133111eb;
+  return key ^ (key >> 31);
+}
+} // namespace
+
+auto champsim::compression_model::bdi_classes() -> std::vector<size_class>
+{
+  return {{1, 10}, {8, 5}, {16, 10}, {20, 5}, {24, 10}, {34, 5}, {36, 5}, {40, 10}, {64, 40}};
+}
+
+auto champsim::compression_model::fpc_classes() -> std::vector<size_class>
+{
+  return {{8, 10}, {16, 10}, {24, 10}, {32, 15}, {40, 10}, {48, 10}, {56, 5}, {64, 30}};
+}
+
+auto champsim::compression_model::uncompressed_classes() -> std::vector<size_class> { return {{std::numeric_limits<uint32_t>::max(), 1}}; }
+
+champsim::compression_model::compression_model(std::vector<size_class> classes_, champsim::data::bits offset) : classes(std::move(classes_)), offset_bits(offset)
+{
+  total_weight = std::accumulate(std::begin(classes), std::end(classes), uint32_t{0}, [](auto acc, const auto& cls) { return acc + cls.weight; });
+  if (total_weight == 0)
+    throw std::invalid_argument{"A compression model must have at least one size class of nonzero weight"};
+  for (auto& cls : classes)
+    cls.bytes = std::clamp(cls.bytes, uint32_t{1}, block_size());
+}
+
+namespace
+{
+std::vector<champsim::compression_model::size_class> classes_named(const std::string& model_name)
+{
+  if (model_name == "bdi")
+    return champsim::compression_model::bdi_classes();
+  if (model_name == "fpc")
+    return champsim::compression_model::fpc_classes();
+  if (std::empty(model_name) || model_name == "none")
+    return champsim::compression_model::uncompressed_classes();
+  throw std::invalid_argument{"Unknown compression model " + model_name};
+}
+} // namespace
+
+champsim::compression_model::compression_model(const std::string& model_name, const std::string& size_file, champsim::data::bits offset)
+    : compression_model(classes_named(model_name), offset)
+{
+  if (!std::empty(size_file)) {
+    std::ifstream stream{size_file};
+    if (!stream.good())
+      throw std::invalid_argument{"Could not open compressed size file " + size_file};
+    read_sizes(stream);
+  }
+}
+
+void champsim::compression_model::read_sizes(std::istream& stream)
+{
+  std::string line;
+  while (std::getline(stream, line)) {
+    if (std::empty(line) || line.front() == '#')
+      continue;
+    std::istringstream fields{line};
+    uint64_t address{};
+    uint32_t bytes{};
+    if (!(fields >> std::hex >> address >> std::dec >> bytes))
+      throw std::invalid_argument{"Malformed compressed size: " + line};
+    file_sizes[champsim::address{address}.slice_upper(offset_bits).to<uint64_t>()] = std::clamp(bytes, uint32_t{1}, block_size());
+  }
+}
+
+uint32_t champsim::compression_model::compressed_size(champsim::address address) const
+{
+  const auto block_number = address.slice_upper(offset_bits).to<uint64_t>();
+  if (auto found = file_sizes.find(block_number); found != std::end(file_sizes))
+    return found->second;
+
+  auto draw = mix(block_number) % total_weight;
+  for (const auto& cls : classes) {
+    if (draw < cls.weight)
+      return cls.bytes;
+    draw -= cls.weight;
+  }
+  return block_size();
+}
+
+uint32_t champsim::compression_model::segments(champsim::address address) const
+{
+  return (compressed_size(address) + segment_size - 1) / segment_size;
+}
+
+uint32_t champsim::compression_model::block_segments() const { return (block_size() + segment_size - 1) / segment_size; }
+
+uint32_t champsim::compression_model::block_size() const { return uint32_t{1} << champsim::to_underlying(offset_bits); }
@@ -7,9 +7,18 @@ cpu_stats operator-(cpu_stats lhs, cpu_stats rhs)
   lhs.end_instrs -= rhs.end_instrs;
   lhs.end_cycles -= rhs.end_cycles;
   lhs.total_rob_occupancy_at_branch_mispredict -= rhs.total_rob_occupancy_at_branch_mispredict;
+  lhs.memory_dependences_predicted -= rhs.memory_dependences_predicted;
+  lhs.memory_dependences_false -= rhs.memory_dependences_false;
+  lhs.memory_order_violations -= rhs.memory_order_violations;
+  lhs.stores_coalesced -= rhs.stores_coalesced;
+  lhs.full_line_stores -= rhs.full_line_stores;
 
   lhs.total_branch_types -= rhs.total_branch_types;
   lhs.branch_type_misses -= rhs.branch_type_misses;
+  lhs.retire_stall_cycles -= rhs.retire_stall_cycles;
+  lhs.btb_lookups -= rhs.btb_lookups;
+  lhs.btb_bubble_cycles -= rhs.btb_bubble_cycles;
+  lhs.btb_level_hits -= rhs.btb_level_hits;
 
   return lhs;
 }
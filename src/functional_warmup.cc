@@ -0,0 +1,139 @@
+#include "functional_warmup.h"
+
+#include "vmem.h"
+
+champsim::functional_warmup::functional_warmup(environment& env, bool train) : train_prefetchers(train)
+{
+  for (CACHE& cache : env.cache_view()) {
+    for (auto* ul : cache.upper_levels)
+      serving[ul] = &cache;
+  }
+
+  for (CACHE& cache : env.cache_view()) {
+    if (auto* lower = below(cache.lower_level); lower != nullptr)
+      above[lower].push_back(&cache);
+  }
+
+  for (O3_CPU& cpu : env.cpu_view()) {
+    if (std::size(cores) <= cpu.cpu)
+      cores.resize(cpu.cpu + 1);
+    cores.at(cpu.cpu).l1i = below(cpu.L1I_bus.lower_channel());
+    cores.at(cpu.cpu).l1d = below(cpu.L1D_bus.lower_channel());
+  }
+
+  if (auto ptws = env.ptw_view(); !std::empty(ptws))
+    vmem = ptws.front().get().vmem;
+}
+
+CACHE* champsim::functional_warmup::below(const champsim::channel* chan) const
+{
+  auto found = serving.find(chan);
+  return found == std::end(serving) ? nullptr : found->second;
+}
+
+champsim::address champsim::functional_warmup::translate(const CACHE& cache, uint32_t cpu, champsim::address v_address)
+{
+  if (vmem == nullptr)
+    return v_address;
+
+  auto [ppage, penalty] = vmem->va_to_pa(cpu, champsim::page_number{v_address});
+
+  // The TLBs hold the physical page as their data, as the page table walker returns it
+  if (auto* tlb = below(cache.lower_translate); tlb != nullptr) {
+    request_type req;
+    req.address = v_address;
+    req.v_address = v_address;
+    req.data = champsim::address{ppage};
+    req.type = access_type::LOAD;
+    req.cpu = cpu;
+    access(tlb, req);
+  }
+
+  return champsim::address{champsim::splice(ppage, champsim::page_offset{v_address})};
+}
+
+void champsim::functional_warmup::access(CACHE* cache, request_type req)
+{
+  for (; cache != nullptr; cache = below(cache->lower_level)) {
+    ++access_count;
+    auto result = cache->functional_access(req, train_prefetchers);
+
+    for (const auto& victim : result.evicted) {
+      if (cache->inclusion == champsim::inclusion_policy::INCLUSIVE)
+        invalidate_above(*cache, victim.address);
+
+      if (victim.dirty || cache->lower_level->lower_is_exclusive) {
+        request_type writeback;
+        writeback.address = victim.address;
+        writeback.v_address = victim.v_address;
+        writeback.data = victim.data;
+        writeback.type = access_type::WRITE;
+        writeback.cpu = victim.cpu;
+        writeback.clean_victim = !victim.dirty;
+        access(below(cache->lower_level), writeback);
+      }
+    }
+
+    // A writeback that misses is filled where it misses, and a store that misses reads the block for ownership, unless the cache does not allocate on writes
+    if (result.hit)
+      return;
+    if (req.type == access_type::WRITE && !cache->write_allocate)
+      continue;
+    if (req.type == access_type::WRITE && (!cache->match_offset_bits || (req.full_line && cache->full_line_write_elision)))
+      return;
+    if (req.type == access_type::WRITE)
+      req.type = access_type::RFO;
+  }
+}
+
+void champsim::functional_warmup::invalidate_above(const CACHE& cache, champsim::address address)
+{
+  if (auto found = above.find(&cache); found != std::end(above)) {
+    for (auto* upper : found->second) {
+      upper->invalidate_entry(address);
+      invalidate_above(*upper, address);
+    }
+  }
+}
+
+void champsim::functional_warmup::operate(uint32_t cpu, const ooo_model_instr& instr)
+{
+  auto& core = cores.at(cpu);
+
+  if (core.l1i != nullptr && core.last_fetch != champsim::block_number{instr.ip}) {
+    core.last_fetch = champsim::block_number{instr.ip};
+
+    request_type fetch;
+    fetch.v_address = instr.ip;
+    fetch.address = translate(*core.l1i, cpu, instr.ip);
+    fetch.ip = instr.ip;
+    fetch.type = access_type::LOAD;
+    fetch.cpu = cpu;
+    fetch.is_instr = true;
+    fetch.asid[0] = instr.asid[0];
+    fetch.asid[1] = instr.asid[1];
+    access(core.l1i, fetch);
+  }
+
+  if (core.l1d == nullptr)
+    return;
+
+  auto data_access = [&](champsim::address v_address, access_type type) {
+    request_type req;
+    req.v_address = v_address;
+    req.address = translate(*core.l1d, cpu, v_address);
+    req.ip = instr.ip;
+    req.type = type;
+    req.cpu = cpu;
+    req.asid[0] = instr.asid[0];
+    req.asid[1] = instr.asid[1];
+    access(core.l1d, req);
+  };
+
+  for (auto v_address : instr.source_memory)
+    data_access(v_address, access_type::LOAD);
+  for (auto v_address : instr.destination_memory)
+    data_access(v_address, access_type::WRITE);
+}
+
+uint64_t champsim::functional_warmup::accesses() const { return access_count; }
@@ -15,6 +15,7 @@
  */
 
 #include <algorithm>
+#include <string>
 #include <utility>
 #include <nlohmann/json.hpp>
 
@@ -33,10 +34,27 @@ void to_json(nlohmann::json& j, const O3_CPU::stats_type& stats)
     mpki.emplace(branch_type_names.at(champsim::to_underlying(type)), stats.branch_type_misses.value_or(type, 0));
   }
 
+  std::map<std::string, long> stalls{};
+  for (std::size_t idx = 0; idx < std::size(stall_type_names); ++idx) {
+    stalls.emplace(stall_type_names.at(idx), stats.retire_stall_cycles.value_or(static_cast<stall_type>(idx), 0));
+  }
+
+  std::map<std::string, long> btb_hits{};
+  for (auto level : stats.btb_level_hits.get_keys()) {
+    btb_hits.emplace("L" + std::to_string(level), stats.btb_level_hits.value_or(level, 0));
+  }
+
   j = nlohmann::json{{"instructions", stats.instrs()},
                      {"cycles", stats.cycles()},
                      {"Avg ROB occupancy at mispredict", std::ceil(stats.total_rob_occupancy_at_branch_mispredict) / std::ceil(total_mispredictions)},
-                     {"mispredict", mpki}};
+                     {"mispredict", mpki},
+                     {"memory dependence",
+                      {{"predicted", stats.memory_dependences_predicted},
+                       {"false", stats.memory_dependences_false},
+                       {"violations", stats.memory_order_violations}}},
+                     {"store buffer", {{"coalesced", stats.stores_coalesced}, {"full lines", stats.full_line_stores}}},
+                     {"retire stall cycles", stalls},
+                     {"btb", {{"lookups", stats.btb_lookups}, {"bubble cycles", stats.btb_bubble_cycles}, {"level hits", btb_hits}}}};
 }
 
 void to_json(nlohmann::json& j, const CACHE::stats_type& stats)
@@ -51,6 +69,48 @@ void to_json(nlohmann::json& j, const CACHE::stats_type& stats)
   statsmap.emplace("prefetch issued", stats.pf_issued);
   statsmap.emplace("useful prefetch", stats.pf_useful);
   statsmap.emplace("useless prefetch", stats.pf_useless);
+  statsmap.emplace("timely prefetch", stats.pf_timely);
+  statsmap.emplace("late prefetch", stats.pf_late);
+  statsmap.emplace("early prefetch", stats.pf_early);
+  statsmap.emplace("filtered prefetch", nlohmann::json{{"duplicate", stats.pf_filtered_duplicate}, {"resident", stats.pf_filtered_resident}});
+  statsmap.emplace("throttled prefetch", stats.pf_throttled);
+  statsmap.emplace("polluting misses", stats.pf_polluting_misses);
+  statsmap.emplace("arbitration dropped prefetch", stats.pf_arbitration_dropped);
+  statsmap.emplace("back invalidations", stats.back_invalidations);
+  statsmap.emplace("back invalidated", stats.back_invalidated);
+  statsmap.emplace("victim fills", stats.victim_fills);
+  statsmap.emplace("coherence", nlohmann::json{{"misses", stats.coherence_misses},
+                                               {"invalidations", stats.coherence_invalidations},
+                                               {"downgrades", stats.coherence_downgrades},
+                                               {"directory evictions", stats.directory_evictions},
+                                               {"upgrades", stats.coherence_upgrades}});
+  statsmap.emplace("victim cache", nlohmann::json{{"hits", stats.victim_cache_hits}, {"writebacks", stats.victim_cache_writebacks}});
+  statsmap.emplace("write combining", nlohmann::json{{"writes", stats.wcb_writes}, {"combined", stats.wcb_combined}});
+  statsmap.emplace("compression", nlohmann::json{{"fills", stats.compressed_fills},
+                                                 {"fill bytes", stats.compressed_fill_bytes},
+                                                 {"evictions", stats.compression_evictions},
+                                                 {"resident blocks", stats.resident_blocks},
+                                                 {"capacity blocks", stats.capacity_blocks}});
+  statsmap.emplace("write policy", nlohmann::json{{"rfo elided", stats.rfo_elided}, {"not allocated", stats.writes_not_allocated}});
+  statsmap.emplace("partition", nlohmann::json{{"occupancy", stats.occupancy}, {"ways", stats.partition_ways}, {"repartitions", stats.repartitions}});
+  statsmap.emplace("metadata", nlohmann::json{{"reads", stats.metadata_reads},
+                                              {"read hits", stats.metadata_read_hits},
+                                              {"writes", stats.metadata_writes},
+                                              {"evictions", stats.metadata_evictions},
+                                              {"offchip reads", stats.metadata_offchip_reads},
+                                              {"offchip writes", stats.metadata_offchip_writes}});
+
+  std::map<std::string, long> fill_to_use{};
+  for (auto bucket : stats.pf_fill_to_use.get_keys()) {
+    fill_to_use.emplace("<" + std::to_string(uint64_t{1} << bucket), stats.pf_fill_to_use.value_or(bucket, 0));
+  }
+  statsmap.emplace("prefetch fill to use cycles", fill_to_use);
+
+  std::map<std::string, nlohmann::json> sources{};
+  for (const auto& source : stats.pf_sources) {
+    sources.emplace(source.name, nlohmann::json{{"issued", source.issued}, {"useful", source.useful}, {"late", source.late}, {"useless", source.useless}});
+  }
+  statsmap.emplace("prefetchers", sources);
 
   uint64_t total_downstream_demands = stats.mshr_return.total();
   for (std::size_t cpu = 0; cpu < NUM_CPUS; ++cpu)
@@ -52,6 +52,7 @@ const unsigned PAGE_SIZE = configured_environment::page_size;
 const unsigned LOG2_BLOCK_SIZE = champsim::lg2(BLOCK_SIZE);
 const unsigned LOG2_PAGE_SIZE = champsim::lg2(PAGE_SIZE);
 
+#ifndef CHAMPSIM_TEST_BUILD
 // Singleton environment pointer
 static configured_environment* g_env;
 
@@ -70,6 +71,12 @@ long long get_retired_insts(uint8_t cpu_id)
   O3_CPU& cpu = g_env->cpu_view().at(cpu_id);
   return cpu.num_retired;
 }
+#else
+// The test build has no configured environment; report an idle system
+uint8_t get_dram_bw() { return 0; }
+
+long long get_retired_insts(uint8_t /*cpu_id*/) { return 0; }
+#endif
 
 #ifndef CHAMPSIM_TEST_BUILD
 int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
@@ -80,11 +87,16 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
 
   bool knob_cloudsuite{false};
   long long warmup_instructions = 0;
+  bool functional_warmup{false};
+  bool functional_warmup_prefetch{false};
   long long simulation_instructions = std::numeric_limits<long long>::max();
   std::string json_file_name;
   std::vector<std::string> trace_names;
   bool hide_heartbeat{false};
   long long heartbeat_interval = 500000;
+  std::string pipeline_trace_name;
+  uint64_t pipeline_trace_interval = 1;
+  uint64_t pipeline_trace_length = 1;
 
   app.add_flag("-c,--cloudsuite", knob_cloudsuite, "Read all traces using the cloudsuite format");
   app.add_flag("--hide-heartbeat", hide_heartbeat, "Hide the heartbeat output");
@@ -92,6 +104,8 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
   auto* warmup_instr_option = app.add_option("-w,--warmup-instructions", warmup_instructions, "The number of instructions in the warmup phase");
   auto* deprec_warmup_instr_option =
       app.add_option("--warmup_instructions", warmup_instructions, "[deprecated] use --warmup-instructions instead")->excludes(warmup_instr_option);
+  auto* functional_warmup_option = app.add_flag("--functional-warmup", functional_warmup, "Warm up the caches on a functional model, without timing");
+  app.add_flag("--functional-warmup-prefetch", functional_warmup_prefetch, "Train the prefetchers during functional warmup")->needs(functional_warmup_option);
   auto* sim_instr_option = app.add_option("-i,--simulation-instructions", simulation_instructions,
                                           "The number of instructions in the detailed phase. If not specified, run to the end of the trace.");
   auto* deprec_sim_instr_option =
@@ -100,6 +114,14 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
   auto* json_option =
       app.add_option("--json", json_file_name, "The name of the file to receive JSON output. If no name is specified, stdout will be used")->expected(0, 1);
 
+  auto* pipeline_trace_option = app.add_option("--pipeline-trace", pipeline_trace_name,
+                                               "The name of the file to receive an O3PipeView pipeline trace. With multiple cores, the core index is appended");
+  app.add_option("--pipeline-trace-interval", pipeline_trace_interval, "Sample the pipeline trace once in this many instructions")
+      ->check(CLI::PositiveNumber)
+      ->needs(pipeline_trace_option);
+  app.add_option("--pipeline-trace-length", pipeline_trace_length, "The number of consecutive instructions in each pipeline trace sample")
+      ->needs(pipeline_trace_option);
+
   app.add_option("traces", trace_names, "The paths to the traces")->required()->expected(NUM_CPUS)->check(CLI::ExistingFile);
 
   CLI11_PARSE(app, argc, argv);
@@ -111,6 +133,15 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
     cpu.heartbeat_interval = heartbeat_interval;
   }
 
+  std::vector<std::ofstream> pipeline_trace_files{};
+  if (pipeline_trace_option->count() > 0) {
+    pipeline_trace_files.reserve(NUM_CPUS); // the cores hold references to these streams
+    for (O3_CPU& cpu : gen_environment.cpu_view()) {
+      auto& trace_file = pipeline_trace_files.emplace_back(NUM_CPUS > 1 ? fmt::format("{}.{}", pipeline_trace_name, cpu.cpu) : pipeline_trace_name);
+      cpu.pipeline_trace.emplace(trace_file, pipeline_trace_interval, pipeline_trace_length);
+    }
+  }
+
   const bool warmup_given = (warmup_instr_option->count() > 0) || (deprec_warmup_instr_option->count() > 0);
   const bool simulation_given = (sim_instr_option->count() > 0) || (deprec_sim_instr_option->count() > 0);
 
@@ -140,6 +171,8 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
   for (auto& p : phases) {
     std::iota(std::begin(p.trace_index), std::end(p.trace_index), 0);
   }
+  phases.at(0).is_functional = functional_warmup;
+  phases.at(0).train_prefetchers = functional_warmup_prefetch;
 
   fmt::print("\n*** ChampSim Multicore Out-of-Order Simulator ***\nWarmup Instructions: {}\nSimulation Instructions: {}\nNumber of CPUs: {}\nPage size: {}\n",
              phases.at(0).length, phases.at(1).length, std::size(gen_environment.cpu_view()), PAGE_SIZE);
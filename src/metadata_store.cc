@@ -0,0 +1,46 @@
+#include "metadata_store.h"
+
+champsim::metadata_store::metadata_store(std::size_t sets, std::size_t ways, std::size_t entries_per_block, bool offchip_)
+    : num_entries(sets * ways * entries_per_block), table(sets, ways * entries_per_block), offchip(offchip_)
+{
+}
+
+bool champsim::metadata_store::install(uint64_t key, uint64_t value)
+{
+  auto victim = table.fill({key, value});
+  if (victim.has_value() && offchip)
+    offchip_entries.insert_or_assign(victim->key, victim->value);
+  return victim.has_value();
+}
+
+auto champsim::metadata_store::read(uint64_t key) -> access_result
+{
+  access_result result{};
+  if (auto found = table.check_hit({key, 0}); found.has_value()) {
+    result.value = found->value;
+    result.onchip_hit = true;
+    return result;
+  }
+
+  // An entry that misses on chip must be looked for in memory, whether or not it is there
+  if (offchip) {
+    result.offchip_read = true;
+    if (auto found = offchip_entries.find(key); found != std::end(offchip_entries)) {
+      result.value = found->second;
+      offchip_entries.erase(found);
+      result.evicted = install(key, *result.value);
+      result.offchip_write = result.evicted;
+    }
+  }
+
+  return result;
+}
+
+auto champsim::metadata_store::write(uint64_t key, uint64_t value) -> access_result
+{
+  access_result result{};
+  result.onchip_hit = table.check_hit({key, 0}).has_value();
+  result.evicted = install(key, value);
+  result.offchip_write = result.evicted && offchip;
+  return result;
+}
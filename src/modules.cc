@@ -17,18 +17,31 @@
 #include "modules.h"
 
 #include "cache.h"
+#include "ooo_cpu.h"
 
 bool champsim::modules::prefetcher::prefetch_line(champsim::address pf_addr, bool fill_this_level, uint32_t prefetch_metadata) const
 {
   return intern_->prefetch_line(pf_addr, fill_this_level, prefetch_metadata);
 }
 
+unsigned champsim::modules::prefetcher::recommended_degree(unsigned default_degree) const
+{
+  return intern_->pf_throttle.has_value() ? intern_->pf_throttle->degree() : default_degree;
+}
+
+unsigned champsim::modules::prefetcher::recommended_distance(unsigned default_distance) const
+{
+  return intern_->pf_throttle.has_value() ? intern_->pf_throttle->distance() : default_distance;
+}
+
 // LCOV_EXCL_START Exclude deprecated function
 bool champsim::modules::prefetcher::prefetch_line(uint64_t pf_addr, bool fill_this_level, uint32_t prefetch_metadata) const
 {
   return prefetch_line(champsim::address{pf_addr}, fill_this_level, prefetch_metadata);
 }
 // LCOV_EXCL_STOP
+std::vector<champsim::btb_level_config> champsim::modules::btb::configured_levels() const { return intern_->BTB_LEVELS; }
+
 long champsim::modules::replacement::get_set_sample_rate() const
 {
   long set_sample_rate = 32; // 1 in 32
@@ -0,0 +1,166 @@
+#include "next_use_index.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <fmt/core.h>
+#include <fstream>
+#include <numeric>
+#include <queue>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <tuple>
+#include <unistd.h>
+
+namespace
+{
+constexpr uint64_t index_magic = 0x5844494e494d5343; // "CSMINIDX", little-endian
+
+struct header_type {
+  uint64_t magic;
+  uint64_t count;
+};
+
+bool by_block_then_position(const champsim::next_use_index::record_type& lhs, const champsim::next_use_index::record_type& rhs)
+{
+  return std::tie(lhs.block, lhs.position) < std::tie(rhs.block, rhs.position);
+}
+} // namespace
+
+champsim::next_use_index::recorder::recorder(std::string index_path, long sets, std::size_t records_per_run)
+    : path(std::move(index_path)), runs_path(path + ".runs"), runs(runs_path, std::ios::binary | std::ios::trunc),
+      run_capacity(std::max<std::size_t>(records_per_run, 1)), set_position(static_cast<std::size_t>(sets))
+{
+  pending.reserve(run_capacity);
+}
+
+void champsim::next_use_index::recorder::record(long set, uint64_t block)
+{
+  auto& position = set_position.at(static_cast<std::size_t>(set));
+  pending.push_back({block, position});
+  ++position;
+
+  if (std::size(pending) == run_capacity)
+    spill();
+}
+
+void champsim::next_use_index::recorder::spill()
+{
+  std::sort(std::begin(pending), std::end(pending), by_block_then_position);
+  runs.write(reinterpret_cast<const char*>(std::data(pending)), static_cast<std::streamsize>(std::size(pending) * sizeof(record_type)));
+  run_sizes.push_back(std::size(pending));
+  pending.clear();
+}
+
+void champsim::next_use_index::recorder::merge()
+{
+  std::ofstream out{path, std::ios::binary | std::ios::trunc};
+  header_type header{index_magic, std::accumulate(std::begin(run_sizes), std::end(run_sizes), uint64_t{0})};
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  // Each run is read through its own stream, and the smallest of their next records is written out until all are exhausted
+  using head_type = std::pair<record_type, std::size_t>;
+  auto later = [](const head_type& lhs, const head_type& rhs) { return by_block_then_position(rhs.first, lhs.first); };
+  std::priority_queue<head_type, std::vector<head_type>, decltype(later)> heads{later};
+  std::vector<std::ifstream> readers{};
+  std::vector<uint64_t> remaining = run_sizes;
+  auto pull = [&](std::size_t run) {
+    record_type next{};
+    if (remaining.at(run) > 0 && readers.at(run).read(reinterpret_cast<char*>(&next), sizeof(next))) {
+      --remaining.at(run);
+      heads.push({next, run});
+    }
+  };
+
+  uint64_t offset = 0;
+  for (std::size_t run = 0; run < std::size(run_sizes); ++run) {
+    readers.emplace_back(runs_path, std::ios::binary);
+    readers.back().seekg(static_cast<std::streamoff>(offset * sizeof(record_type)));
+    offset += run_sizes.at(run);
+    pull(run);
+  }
+
+  while (!std::empty(heads)) {
+    auto [next, run] = heads.top();
+    heads.pop();
+    out.write(reinterpret_cast<const char*>(&next), sizeof(next));
+    pull(run);
+  }
+
+  if (!out || std::any_of(std::begin(remaining), std::end(remaining), [](auto x) { return x != 0; }))
+    fmt::print("Error: Failed to write next-use index: {}\n", path);
+}
+
+champsim::next_use_index::recorder::~recorder()
+{
+  if (!std::empty(pending))
+    spill();
+  runs.close();
+  if (!runs)
+    fmt::print("Error: Failed to write next-use runs: {}\n", runs_path);
+
+  merge();
+  std::remove(runs_path.c_str());
+}
+
+champsim::next_use_index::next_use_index(const std::string& index_path)
+{
+  auto fd = ::open(index_path.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw std::runtime_error{"Could not open next-use index " + index_path};
+
+  struct stat file_stat {
+  };
+  if (::fstat(fd, &file_stat) != 0 || static_cast<std::size_t>(file_stat.st_size) < sizeof(header_type)) {
+    ::close(fd);
+    throw std::runtime_error{"Next-use index " + index_path + " is truncated"};
+  }
+
+  mapping_size = static_cast<std::size_t>(file_stat.st_size);
+  mapping = ::mmap(nullptr, mapping_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    mapping = nullptr;
+    throw std::runtime_error{"Could not map next-use index " + index_path};
+  }
+
+  auto header = static_cast<const header_type*>(mapping);
+  if (header->magic != index_magic || mapping_size != sizeof(header_type) + header->count * sizeof(record_type)) {
+    ::munmap(mapping, mapping_size);
+    mapping = nullptr;
+    throw std::runtime_error{"Next-use index " + index_path + " is malformed"};
+  }
+
+  first = reinterpret_cast<const record_type*>(header + 1);
+  count = header->count;
+}
+
+champsim::next_use_index::~next_use_index()
+{
+  if (mapping != nullptr)
+    ::munmap(mapping, mapping_size);
+}
+
+bool champsim::next_use_index::is_demand(access_type type)
+{
+  return type == access_type::LOAD || type == access_type::RFO || type == access_type::TRANSLATION;
+}
+
+std::string champsim::next_use_index::default_path(std::string_view cache_name)
+{
+  const char* dir_env = std::getenv("CHAMPSIM_TRACE_DIR");
+  const char* id_env = std::getenv("CHAMPSIM_TRACE_ID");
+  return fmt::format("{}/{}_{}.min", (dir_env != nullptr) ? dir_env : ".", (id_env != nullptr) ? id_env : "unknown", cache_name);
+}
+
+uint64_t champsim::next_use_index::next_use(uint64_t block, uint64_t from) const
+{
+  auto found = std::lower_bound(first, first + count, record_type{block, from}, by_block_then_position);
+  if (found == first + count || found->block != block)
+    return never;
+  return found->position;
+}
+
+std::size_t champsim::next_use_index::size() const { return count; }
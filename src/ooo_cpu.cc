@@ -28,27 +28,14 @@
 #include "champsim.h"
 #include "deadlock.h"
 #include "instruction.h"
+#include "ooo_cpu_pipeline.h"
 #include "util/span.h"
 
 std::chrono::seconds elapsed_time();
 
 long O3_CPU::operate()
 {
-  long progress{0};
-  progress += retire_rob();                    // retire
-  progress += complete_inflight_instruction(); // finalize execution
-  progress += execute_instruction();           // execute instructions
-  progress += schedule_instruction();          // schedule instructions
-  progress += handle_memory_return();          // finalize memory transactions
-  progress += operate_lsq();                   // execute memory transactions
-
-  progress += dispatch_instruction(); // dispatch
-  progress += decode_instruction();   // decode
-  progress += promote_to_decode();
-
-  progress += fetch_instruction(); // fetch
-  progress += check_dib();
-  initialize_instruction();
+  long progress = operate_pipeline();
 
   // heartbeat
   if (show_heartbeat && (num_retired >= (last_heartbeat_instr + heartbeat_interval))) {
@@ -69,6 +56,8 @@ long O3_CPU::operate()
   return progress;
 }
 
+long O3_CPU::operate_pipeline() { return operate_pipeline(*this); }
+
 void O3_CPU::initialize()
 {
   // BRANCH PREDICTOR & BTB
@@ -103,25 +92,6 @@ void O3_CPU::end_phase(unsigned finished_cpu)
   }
 }
 
-void O3_CPU::initialize_instruction()
-{
-  champsim::bandwidth instrs_to_read_this_cycle{
-      std::min(FETCH_WIDTH, champsim::bandwidth::maximum_type{static_cast<long>(IFETCH_BUFFER_SIZE - std::size(IFETCH_BUFFER))})};
-
-  bool stop_fetch = false;
-  while (current_time >= fetch_resume_time && instrs_to_read_this_cycle.has_remaining() && !stop_fetch && !std::empty(input_queue)) {
-    instrs_to_read_this_cycle.consume();
-
-    stop_fetch = do_init_instruction(input_queue.front());
-
-    // Add to IFETCH_BUFFER
-    IFETCH_BUFFER.push_back(input_queue.front());
-    input_queue.pop_front();
-
-    IFETCH_BUFFER.back().ready_time = current_time;
-  }
-}
-
 namespace
 {
 void do_stack_pointer_folding(ooo_model_instr& arch_instr)
@@ -151,8 +121,10 @@ bool O3_CPU::do_predict_branch(ooo_model_instr& arch_instr)
 
   // handle branch prediction for all instructions as at this point we do not know if the instruction is a branch
   sim_stats.total_branch_types.increment(arch_instr.branch);
-  auto [predicted_branch_target, always_taken] = impl_btb_prediction(arch_instr.ip, arch_instr.branch);
-  arch_instr.branch_prediction = impl_predict_branch(arch_instr.ip, predicted_branch_target, always_taken, arch_instr.branch) || always_taken;
+  auto btb_result = impl_btb_prediction(arch_instr.ip, arch_instr.branch);
+  auto predicted_branch_target = btb_result.target;
+  arch_instr.branch_prediction =
+      impl_predict_branch(arch_instr.ip, predicted_branch_target, btb_result.always_taken, arch_instr.branch) || btb_result.always_taken;
   if (!arch_instr.branch_prediction) {
     predicted_branch_target = champsim::address{};
   }
@@ -165,6 +137,11 @@ bool O3_CPU::do_predict_branch(ooo_model_instr& arch_instr)
     // call code prefetcher every time the branch predictor is used
     l1i->impl_prefetcher_branch_operate(arch_instr.ip, arch_instr.branch, predicted_branch_target);
 
+    ++sim_stats.btb_lookups;
+    if (btb_result.level.has_value()) {
+      sim_stats.btb_level_hits.increment(*btb_result.level);
+    }
+
     if (predicted_branch_target != arch_instr.branch_target
         || (((arch_instr.branch == BRANCH_CONDITIONAL) || (arch_instr.branch == BRANCH_OTHER))
             && arch_instr.branch_taken != arch_instr.branch_prediction)) { // conditional branches are re-evaluated at decode when the target is computed
@@ -177,6 +154,12 @@ bool O3_CPU::do_predict_branch(ooo_model_instr& arch_instr)
       }
     } else {
       stop_fetch = arch_instr.branch_taken; // if correctly predicted taken, then we can't fetch anymore instructions this cycle
+
+      // a target from a slower BTB level leaves fetch idle for some cycles after the taken branch
+      if (arch_instr.branch_taken && btb_result.bubbles > 0 && !warmup) {
+        btb_bubble_end_time = current_time + (btb_result.bubbles + 1) * clock_period;
+        sim_stats.btb_bubble_cycles += btb_result.bubbles;
+      }
     }
 
     impl_update_btb(arch_instr.ip, arch_instr.branch_target, arch_instr.branch_taken, arch_instr.branch);
@@ -198,15 +181,6 @@ bool O3_CPU::do_init_instruction(ooo_model_instr& arch_instr)
   return do_predict_branch(arch_instr);
 }
 
-long O3_CPU::check_dib()
-{
-  // scan through IFETCH_BUFFER to find instructions that hit in the decoded instruction buffer
-  auto begin = std::find_if(std::begin(IFETCH_BUFFER), std::end(IFETCH_BUFFER), [](const ooo_model_instr& x) { return !x.dib_checked; });
-  auto [window_begin, window_end] = champsim::get_span(begin, std::end(IFETCH_BUFFER), champsim::bandwidth{FETCH_WIDTH});
-  std::for_each(window_begin, window_end, [this](auto& ifetch_entry) { this->do_check_dib(ifetch_entry); });
-  return std::distance(window_begin, window_end);
-}
-
 void O3_CPU::do_check_dib(ooo_model_instr& instr)
 {
   // Check DIB to see if we recently fetched this line
@@ -230,40 +204,6 @@ void O3_CPU::do_check_dib(ooo_model_instr& instr)
   }
 }
 
-long O3_CPU::fetch_instruction()
-{
-  long progress{0};
-
-  // Fetch a single cache line
-  auto fetch_ready = [](const ooo_model_instr& x) {
-    return x.dib_checked && !x.fetch_issued;
-  };
-
-  // Find the chunk of instructions in the block
-  auto no_match_ip = [](const auto& lhs, const auto& rhs) {
-    return champsim::block_number{lhs.ip} != champsim::block_number{rhs.ip};
-  };
-
-  auto l1i_req_begin = std::find_if(std::begin(IFETCH_BUFFER), std::end(IFETCH_BUFFER), fetch_ready);
-  for (champsim::bandwidth l1i_bw{L1I_BANDWIDTH}; l1i_bw.has_remaining() && l1i_req_begin != std::end(IFETCH_BUFFER); l1i_bw.consume()) {
-    auto l1i_req_end = std::adjacent_find(l1i_req_begin, std::end(IFETCH_BUFFER), no_match_ip);
-    if (l1i_req_end != std::end(IFETCH_BUFFER)) {
-      l1i_req_end = std::next(l1i_req_end); // adjacent_find returns the first of the non-equal elements
-    }
-
-    // Issue to L1I
-    auto success = do_fetch_instruction(l1i_req_begin, l1i_req_end);
-    if (success) {
-      std::for_each(l1i_req_begin, l1i_req_end, [](auto& x) { x.fetch_issued = true; });
-      ++progress;
-    }
-
-    l1i_req_begin = std::find_if(l1i_req_end, std::end(IFETCH_BUFFER), fetch_ready);
-  }
-
-  return progress;
-}
-
 bool O3_CPU::do_fetch_instruction(std::deque<ooo_model_instr>::iterator begin, std::deque<ooo_model_instr>::iterator end)
 {
   CacheBus::request_type fetch_packet;
@@ -282,209 +222,13 @@ bool O3_CPU::do_fetch_instruction(std::deque<ooo_model_instr>::iterator begin, s
   return L1I_bus.issue_read(fetch_packet);
 }
 
-long O3_CPU::promote_to_decode()
-{
-  auto is_decoded = [](const ooo_model_instr& x) {
-    return x.decoded;
-  };
-
-  auto fetch_complete_and_ready = [time = current_time](const auto& x) {
-    return x.fetch_completed && x.ready_time <= time;
-  };
-
-  champsim::bandwidth available_fetch_bandwidth{
-      std::min(FETCH_WIDTH, std::min(champsim::bandwidth::maximum_type{static_cast<long>(DIB_HIT_BUFFER_SIZE - std::size(DIB_HIT_BUFFER))},
-                                     champsim::bandwidth::maximum_type{static_cast<long>(DECODE_BUFFER_SIZE - std::size(DECODE_BUFFER))}))};
-
-  auto fetched_check_end = std::find_if(std::begin(IFETCH_BUFFER), std::end(IFETCH_BUFFER), [](const ooo_model_instr& x) { return !x.fetch_completed; });
-  // find the first not fetch completed
-  auto [window_begin, window_end] = champsim::get_span_p(std::begin(IFETCH_BUFFER), fetched_check_end, available_fetch_bandwidth, fetch_complete_and_ready);
-  auto decoded_window_end = std::stable_partition(window_begin, window_end, is_decoded); // reorder instructions
-  auto mark_for_decode = [time = current_time, lat = DECODE_LATENCY, warmup = warmup](auto& x) {
-    return x.ready_time = time + (warmup ? champsim::chrono::clock::duration{} : lat);
-  };
-  // to DIB_HIT_BUFFER
-  auto mark_for_dib = [time = current_time, lat = DIB_HIT_LATENCY, warmup = warmup](auto& x) {
-    return x.ready_time = time + lat;
-  };
-
-  std::for_each(window_begin, decoded_window_end, mark_for_dib); // assume DECODE_LATENCY = DIB_HIT_LATENCY
-  std::move(window_begin, decoded_window_end, std::back_inserter(DIB_HIT_BUFFER));
-  // to DECODE_BUFFER
-
-  std::for_each(decoded_window_end, window_end, mark_for_decode);
-  std::move(decoded_window_end, window_end, std::back_inserter(DECODE_BUFFER));
-
-  long progress{std::distance(window_begin, window_end)};
-  IFETCH_BUFFER.erase(window_begin, window_end);
-  return progress;
-}
-long O3_CPU::decode_instruction()
-{
-  auto is_ready = [time = current_time](const auto& x) {
-    return x.ready_time <= time;
-  };
-
-  auto dib_hit_buffer_begin = std::begin(DIB_HIT_BUFFER);
-  auto dib_hit_buffer_end = dib_hit_buffer_begin;
-  auto decode_buffer_begin = std::begin(DECODE_BUFFER);
-  auto decode_buffer_end = decode_buffer_begin;
-
-  champsim::bandwidth available_decode_bandwidth{DECODE_WIDTH};
-
-  // bw move instructions to dispatch_buffer
-  champsim::bandwidth available_dib_inorder_bandwidth{
-      std::min(DIB_INORDER_WIDTH, champsim::bandwidth::maximum_type{static_cast<long>(DISPATCH_BUFFER_SIZE - std::size(DISPATCH_BUFFER))})};
-
-  // conditions choose how many instructions sent to dispatch_buffer
-  while (dib_hit_buffer_end != std::end(DIB_HIT_BUFFER) && decode_buffer_end != std::end(DECODE_BUFFER) && available_dib_inorder_bandwidth.has_remaining()
-         && available_decode_bandwidth.has_remaining() && is_ready(std::min(*dib_hit_buffer_end, *decode_buffer_end, ooo_model_instr::program_order))) {
-    if (ooo_model_instr::program_order(*dib_hit_buffer_end, *decode_buffer_end)) {
-      dib_hit_buffer_end++;
-      available_dib_inorder_bandwidth.consume();
-    } else {
-      decode_buffer_end++;
-      available_dib_inorder_bandwidth.consume();
-      available_decode_bandwidth.consume();
-    }
-  }
-  while (dib_hit_buffer_end != std::end(DIB_HIT_BUFFER) && available_dib_inorder_bandwidth.has_remaining() && is_ready(*dib_hit_buffer_end)
-         && (decode_buffer_end == std::end(DECODE_BUFFER) || ooo_model_instr::program_order(*dib_hit_buffer_end, *decode_buffer_end))) {
-    dib_hit_buffer_end++;
-    available_dib_inorder_bandwidth.consume();
-  }
-  while (decode_buffer_end != std::end(DECODE_BUFFER) && available_dib_inorder_bandwidth.has_remaining() && available_decode_bandwidth.has_remaining()
-         && is_ready(*decode_buffer_end)
-         && (dib_hit_buffer_end == std::end(DIB_HIT_BUFFER) || ooo_model_instr::program_order(*decode_buffer_end, *dib_hit_buffer_end))) {
-    decode_buffer_end++;
-    available_dib_inorder_bandwidth.consume();
-    available_decode_bandwidth.consume();
-  }
-
-  // decode instructions have not decoded, merge instructions with dib_hit_buffer then send to dispatch_buffer
-  auto do_decode = [&, this](auto& db_entry) {
-    this->do_dib_update(db_entry);
-
-    // Resume fetch
-    if (db_entry.branch_mispredicted) {
-      // These branches detect the misprediction at decode
-      if ((db_entry.branch == BRANCH_DIRECT_JUMP) || (db_entry.branch == BRANCH_DIRECT_CALL)
-          || (((db_entry.branch == BRANCH_CONDITIONAL) || (db_entry.branch == BRANCH_OTHER)) && db_entry.branch_taken == db_entry.branch_prediction)) {
-        // clear the branch_mispredicted bit so we don't attempt to resume fetch again at execute
-        db_entry.branch_mispredicted = 0;
-        // pay misprediction penalty
-        this->fetch_resume_time = this->current_time + BRANCH_MISPREDICT_PENALTY;
-      }
-    }
-    // Add to dispatch
-    db_entry.ready_time = this->current_time + (this->warmup ? champsim::chrono::clock::duration{} : this->DISPATCH_LATENCY);
-
-    if constexpr (champsim::debug_print) {
-      fmt::print("[DECODE] do_decode instr_id: {} time: {}\n", db_entry.instr_id, this->current_time.time_since_epoch() / this->clock_period);
-    }
-  };
-
-  auto do_dib_hit = [&, this](auto& dib_entry) {
-    dib_entry.ready_time = this->current_time + (this->warmup ? champsim::chrono::clock::duration{} : this->DISPATCH_LATENCY);
-  };
-
-  std::for_each(decode_buffer_begin, decode_buffer_end, do_decode);
-  std::for_each(dib_hit_buffer_begin, dib_hit_buffer_end, do_dib_hit);
-
-  long progress{std::distance(dib_hit_buffer_begin, dib_hit_buffer_end) + std::distance(decode_buffer_begin, decode_buffer_end)};
-
-  std::merge(dib_hit_buffer_begin, dib_hit_buffer_end, decode_buffer_begin, decode_buffer_end, std::back_inserter(DISPATCH_BUFFER),
-             ooo_model_instr::program_order);
-  DECODE_BUFFER.erase(decode_buffer_begin, decode_buffer_end);
-  DIB_HIT_BUFFER.erase(dib_hit_buffer_begin, dib_hit_buffer_end);
-
-  return progress;
-}
-
 void O3_CPU::do_dib_update(const ooo_model_instr& instr) { DIB.fill(instr.ip); }
 
-long O3_CPU::dispatch_instruction()
-{
-  champsim::bandwidth available_dispatch_bandwidth{DISPATCH_WIDTH};
-
-  // dispatch DISPATCH_WIDTH instructions into the ROB
-  while (available_dispatch_bandwidth.has_remaining() && !std::empty(DISPATCH_BUFFER) && DISPATCH_BUFFER.front().ready_time <= current_time
-         && std::size(ROB) != ROB_SIZE
-         && ((std::size_t)std::count_if(std::begin(LQ), std::end(LQ), [](const auto& lq_entry) { return !lq_entry.has_value(); })
-             >= std::size(DISPATCH_BUFFER.front().source_memory))
-         && ((std::size(DISPATCH_BUFFER.front().destination_memory) + std::size(SQ)) <= SQ_SIZE)) {
-    ROB.push_back(std::move(DISPATCH_BUFFER.front()));
-    DISPATCH_BUFFER.pop_front();
-    do_memory_scheduling(ROB.back());
-
-    available_dispatch_bandwidth.consume();
-    ROB.back().ready_time = current_time + (warmup ? champsim::chrono::clock::duration{} : SCHEDULING_LATENCY);
-  }
-
-  return available_dispatch_bandwidth.amount_consumed();
-}
-
-long O3_CPU::schedule_instruction()
-{
-  champsim::bandwidth search_bw{SCHEDULER_SIZE};
-  int progress{0};
-  for (auto rob_it = std::begin(ROB); rob_it != std::end(ROB) && search_bw.has_remaining(); ++rob_it) {
-    // if there aren't enough physical registers available for the next instruction, stop scheduling
-    unsigned long sources_to_allocate = std::count_if(rob_it->source_registers.begin(), rob_it->source_registers.end(),
-                                                      [&alloc = std::as_const(reg_allocator)](auto srcreg) { return !alloc.isAllocated(srcreg); });
-    if (reg_allocator.count_free_registers() < (sources_to_allocate + rob_it->destination_registers.size())) {
-      break;
-    }
-    if (!rob_it->scheduled && rob_it->ready_time <= current_time) {
-      do_scheduling(*rob_it);
-      ++progress;
-    }
-
-    if (!rob_it->executed) {
-      search_bw.consume();
-    }
-  }
-
-  return progress;
-}
-
-void O3_CPU::do_scheduling(ooo_model_instr& instr)
-{
-  // Mark register dependencies
-  for (auto& src_reg : instr.source_registers) {
-    // rename source register
-    src_reg = reg_allocator.rename_src_register(src_reg);
-  }
-
-  for (auto& dreg : instr.destination_registers) {
-    // rename destination register
-    dreg = reg_allocator.rename_dest_register(dreg, instr.instr_id);
-  }
-
-  instr.scheduled = true;
-}
-
-long O3_CPU::execute_instruction()
-{
-  champsim::bandwidth exec_bw{EXEC_WIDTH};
-  for (auto rob_it = std::begin(ROB); rob_it != std::end(ROB) && exec_bw.has_remaining(); ++rob_it) {
-    if (rob_it->scheduled && !rob_it->executed && rob_it->ready_time <= current_time) {
-      bool ready = std::all_of(std::begin(rob_it->source_registers), std::end(rob_it->source_registers),
-                               [&alloc = std::as_const(reg_allocator)](auto srcreg) { return alloc.isValid(srcreg); });
-      if (ready) {
-        do_execution(*rob_it);
-        exec_bw.consume();
-      }
-    }
-  }
-
-  return exec_bw.amount_consumed();
-}
-
 void O3_CPU::do_execution(ooo_model_instr& instr)
 {
   instr.executed = true;
   instr.ready_time = current_time + (warmup ? champsim::chrono::clock::duration{} : EXEC_LATENCY);
+  instr.timing.issue = current_time;
 
   // Mark LQ entries as ready to translate
   for (auto& lq_entry : LQ) {
@@ -513,6 +257,14 @@ void O3_CPU::do_memory_scheduling(ooo_model_instr& instr)
     assert(q_entry != std::end(LQ));
     q_entry->emplace(smem, instr.instr_id, instr.ip, instr.asid); // add it to the load queue
 
+    // Find the store, if any, that this load is predicted to wait on
+    auto predicted_id = mem_dep_predictor.predict_load(instr.ip);
+    auto predicted_it = std::end(SQ);
+    if (predicted_id.has_value()) {
+      predicted_it = std::find_if(std::begin(SQ), std::end(SQ),
+                                  [id = *predicted_id](const auto& sq_entry) { return sq_entry.instr_id == id && !sq_entry.fetch_issued; });
+    }
+
     // Check for forwarding
     auto sq_it = std::max_element(std::begin(SQ), std::end(SQ), [smem](const auto& lhs, const auto& rhs) {
       return lhs.virtual_address != smem || (rhs.virtual_address == smem && LSQ_ENTRY::program_order(lhs, rhs));
@@ -521,14 +273,35 @@ void O3_CPU::do_memory_scheduling(ooo_model_instr& instr)
       if (sq_it->fetch_issued) { // Store already executed
         (*q_entry)->finish(instr);
         q_entry->reset();
-      } else {
+      } else if (!mem_dep_predictor.enabled() || predicted_it != std::end(SQ)) {
         assert(sq_it->instr_id < instr.instr_id);      // The found SQ entry is a prior store
         sq_it->lq_depend_on_me.emplace_back(*q_entry); // Forward the load when the store finishes
         (*q_entry)->producer_id = sq_it->instr_id;     // The load waits on the store to finish
 
+        if (mem_dep_predictor.enabled()) {
+          ++sim_stats.memory_dependences_predicted;
+        }
+
         if constexpr (champsim::debug_print) {
           fmt::print("[DISPATCH] {} instr_id: {} waits on: {}\n", __func__, instr.instr_id, sq_it->instr_id);
         }
+      } else {
+        // The load is not predicted to depend on the store, so it may issue and complete before the store executes
+        (*q_entry)->bypassed_store_id = sq_it->instr_id;
+        sq_it->bypassing_loads.push_back(instr.instr_id);
+
+        if constexpr (champsim::debug_print) {
+          fmt::print("[DISPATCH] {} instr_id: {} bypasses: {}\n", __func__, instr.instr_id, sq_it->instr_id);
+        }
+      }
+    } else if (predicted_it != std::end(SQ)) {
+      // The load waits on a store to a different address. It is released, but not forwarded, when the store executes.
+      predicted_it->lq_depend_on_me.emplace_back(*q_entry);
+      (*q_entry)->producer_id = predicted_it->instr_id;
+      ++sim_stats.memory_dependences_false;
+
+      if constexpr (champsim::debug_print) {
+        fmt::print("[DISPATCH] {} instr_id: {} falsely waits on: {}\n", __func__, instr.instr_id, predicted_it->instr_id);
       }
     }
   }
@@ -536,6 +309,7 @@ void O3_CPU::do_memory_scheduling(ooo_model_instr& instr)
   // store
   for (auto& dmem : instr.destination_memory) {
     SQ.emplace_back(dmem, instr.instr_id, instr.ip, instr.asid); // add it to the store queue
+    mem_dep_predictor.dispatch_store(instr.ip, instr.instr_id);
   }
 
   if constexpr (champsim::debug_print) {
@@ -544,45 +318,6 @@ void O3_CPU::do_memory_scheduling(ooo_model_instr& instr)
   }
 }
 
-long O3_CPU::operate_lsq()
-{
-  champsim::bandwidth store_bw{SQ_WIDTH};
-
-  const auto complete_id = std::empty(ROB) ? std::numeric_limits<uint64_t>::max() : ROB.front().instr_id;
-  auto do_complete = [time = current_time, finished = LSQ_ENTRY::precedes(complete_id), this](const auto& x) {
-    return finished(x) && x.ready_time <= time && this->do_complete_store(x);
-  };
-
-  auto unfetched_begin = std::partition_point(std::begin(SQ), std::end(SQ), [](const auto& x) { return x.fetch_issued; });
-  auto [fetch_begin, fetch_end] =
-      champsim::get_span_p(unfetched_begin, std::end(SQ), store_bw, [time = current_time](const auto& x) { return !x.fetch_issued && x.ready_time <= time; });
-  store_bw.consume(std::distance(fetch_begin, fetch_end));
-  std::for_each(fetch_begin, fetch_end, [time = current_time, this](auto& sq_entry) {
-    this->do_finish_store(sq_entry);
-    sq_entry.fetch_issued = true;
-    sq_entry.ready_time = time;
-  });
-
-  auto [complete_begin, complete_end] = champsim::get_span_p(std::cbegin(SQ), std::cend(SQ), store_bw, do_complete);
-  store_bw.consume(std::distance(complete_begin, complete_end));
-  SQ.erase(complete_begin, complete_end);
-
-  champsim::bandwidth load_bw{LQ_WIDTH};
-
-  for (auto& lq_entry : LQ) {
-    if (load_bw.has_remaining() && lq_entry.has_value() && lq_entry->producer_id == std::numeric_limits<uint64_t>::max() && !lq_entry->fetch_issued
-        && lq_entry->ready_time < current_time) {
-      auto success = execute_load(*lq_entry);
-      if (success) {
-        load_bw.consume();
-        lq_entry->fetch_issued = true;
-      }
-    }
-  }
-
-  return store_bw.amount_consumed() + load_bw.amount_consumed();
-}
-
 void O3_CPU::do_finish_store(const LSQ_ENTRY& sq_entry)
 {
   if constexpr (champsim::debug_print) {
@@ -590,14 +325,53 @@ void O3_CPU::do_finish_store(const LSQ_ENTRY& sq_entry)
   }
 
   sq_entry.finish(std::begin(ROB), std::end(ROB));
+  mem_dep_predictor.execute_store(sq_entry.ip, sq_entry.instr_id);
 
   // Release dependent loads
   for (std::optional<LSQ_ENTRY>& dependent : sq_entry.lq_depend_on_me) {
     assert(dependent.has_value()); // LQ entry is still allocated
     assert(dependent->producer_id == sq_entry.instr_id);
 
-    dependent->finish(std::begin(ROB), std::end(ROB));
-    dependent.reset();
+    if (dependent->virtual_address == sq_entry.virtual_address) {
+      dependent->finish(std::begin(ROB), std::end(ROB));
+      dependent.reset();
+    } else {
+      dependent->producer_id = std::numeric_limits<uint64_t>::max(); // The dependence was falsely predicted
+    }
+  }
+
+  // Check loads that bypassed this store
+  for (auto load_id : sq_entry.bypassing_loads) {
+    auto lq_entry = std::find_if(std::begin(LQ), std::end(LQ), [load_id, store_id = sq_entry.instr_id](const auto& x) {
+      return x.has_value() && x->instr_id == load_id && x->bypassed_store_id == store_id;
+    });
+
+    if (lq_entry != std::end(LQ) && !(*lq_entry)->fetch_issued) {
+      // The store executed first after all, so the load is forwarded from it
+      (*lq_entry)->finish(std::begin(ROB), std::end(ROB));
+      lq_entry->reset();
+      continue;
+    }
+
+    // The load issued before the store executed, and must be replayed
+    auto rob_entry = std::partition_point(std::begin(ROB), std::end(ROB), ooo_model_instr::precedes(load_id));
+    assert(rob_entry != std::end(ROB)); // the load cannot retire ahead of the older store
+    mem_dep_predictor.train_violation(rob_entry->ip, sq_entry.ip);
+    ++sim_stats.memory_order_violations;
+
+    if (lq_entry != std::end(LQ)) {
+      // The load's read is still in flight. It takes the store's data instead.
+      (*lq_entry)->finish(*rob_entry);
+      lq_entry->reset();
+    }
+
+    // The load completes again after the replay. Younger instructions that have already consumed its value are not replayed.
+    rob_entry->completed = false;
+    rob_entry->ready_time = std::max(rob_entry->ready_time, current_time + (warmup ? champsim::chrono::clock::duration{} : MEMORY_VIOLATION_PENALTY));
+
+    if constexpr (champsim::debug_print) {
+      fmt::print("[SQ] {} instr_id: {} violated by load instr_id: {}\n", __func__, sq_entry.instr_id, load_id);
+    }
   }
 }
 
@@ -612,7 +386,28 @@ bool O3_CPU::do_complete_store(const LSQ_ENTRY& sq_entry)
     fmt::print("[SQ] {} instr_id: {} vaddr: {}\n", __func__, data_packet.instr_id, data_packet.v_address);
   }
 
-  return L1D_bus.issue_write(data_packet);
+  if (!store_buf.enabled())
+    return L1D_bus.issue_write(data_packet);
+
+  auto result = store_buf.add(data_packet, current_time);
+  if (result == champsim::store_buffer::add_result::COALESCED)
+    ++sim_stats.stores_coalesced;
+  return result != champsim::store_buffer::add_result::FULL;
+}
+
+long O3_CPU::drain_store_buffer()
+{
+  long progress{0};
+  while (store_buf.ready(current_time)) {
+    auto data_packet = store_buf.front();
+    if (!L1D_bus.issue_write(data_packet))
+      break;
+    if (data_packet.full_line)
+      ++sim_stats.full_line_stores;
+    store_buf.pop_front();
+    ++progress;
+  }
+  return progress;
 }
 
 bool O3_CPU::execute_load(const LSQ_ENTRY& lq_entry)
@@ -637,96 +432,43 @@ void O3_CPU::do_complete_execution(ooo_model_instr& instr)
   }
 
   instr.completed = true;
+  instr.timing.complete = current_time;
 
   if (instr.branch_mispredicted) {
     fetch_resume_time = current_time + BRANCH_MISPREDICT_PENALTY;
   }
 }
 
-long O3_CPU::complete_inflight_instruction()
+void O3_CPU::do_stall_accounting()
 {
-  // update ROB entries with completed executions
-  champsim::bandwidth complete_bw{EXEC_WIDTH};
-  for (auto rob_it = std::begin(ROB); rob_it != std::end(ROB) && complete_bw.has_remaining(); ++rob_it) {
-    if (rob_it->executed && !rob_it->completed && (rob_it->ready_time <= current_time) && rob_it->completed_mem_ops == rob_it->num_mem_ops()) {
-      do_complete_execution(*rob_it);
-      complete_bw.consume();
-    }
+  if (std::empty(ROB)) {
+    sim_stats.retire_stall_cycles.increment(current_time < fetch_resume_time ? stall_type::BAD_SPECULATION : stall_type::FRONTEND);
+    return;
   }
 
-  return complete_bw.amount_consumed();
-}
-
-long O3_CPU::handle_memory_return()
-{
-  long progress{0};
-
-  for (champsim::bandwidth fetch_bw{FETCH_WIDTH}, l1i_bw{L1I_BANDWIDTH};
-       fetch_bw.has_remaining() && l1i_bw.has_remaining() && !L1I_bus.lower_level->returned.empty(); l1i_bw.consume()) {
-    auto& l1i_entry = L1I_bus.lower_level->returned.front();
-
-    while (fetch_bw.has_remaining() && !l1i_entry.instr_depend_on_me.empty()) {
-      auto fetched = std::find_if(std::begin(IFETCH_BUFFER), std::end(IFETCH_BUFFER), ooo_model_instr::matches_id(l1i_entry.instr_depend_on_me.front()));
-      if (fetched != std::end(IFETCH_BUFFER) && champsim::block_number{fetched->ip} == champsim::block_number{l1i_entry.v_address} && fetched->fetch_issued) {
-        fetched->fetch_completed = true;
-        fetch_bw.consume();
-        ++progress;
-
-        if constexpr (champsim::debug_print) {
-          fmt::print("[IFETCH] {} instr_id: {} fetch completed\n", __func__, fetched->instr_id);
-        }
-      }
-
-      l1i_entry.instr_depend_on_me.erase(std::begin(l1i_entry.instr_depend_on_me));
-    }
-
-    // remove this entry if we have serviced all of its instructions
-    if (l1i_entry.instr_depend_on_me.empty()) {
-      L1I_bus.lower_level->returned.pop_front();
-      ++progress;
-    }
-  }
-
-  auto l1d_it = std::begin(L1D_bus.lower_level->returned);
-  for (champsim::bandwidth l1d_bw{L1D_BANDWIDTH}; l1d_bw.has_remaining() && l1d_it != std::end(L1D_bus.lower_level->returned); l1d_bw.consume(), ++l1d_it) {
-    for (auto& lq_entry : LQ) {
-      if (lq_entry.has_value() && lq_entry->fetch_issued && champsim::block_number{lq_entry->virtual_address} == champsim::block_number{l1d_it->v_address}) {
-        lq_entry->finish(std::begin(ROB), std::end(ROB));
-        lq_entry.reset();
-        ++progress;
-      }
-    }
-    ++progress;
+  auto& head = ROB.front();
+  if (head.executed && !std::empty(head.source_memory) && head.completed_mem_ops < head.num_mem_ops()) {
+    // Where the load will be serviced is not known until it returns, so these cycles are attributed when the instruction retires
+    ++head.memory_stall_cycles;
+  } else {
+    sim_stats.retire_stall_cycles.increment(stall_type::CORE);
   }
-  L1D_bus.lower_level->returned.erase(std::begin(L1D_bus.lower_level->returned), l1d_it);
-
-  return progress;
 }
 
-long O3_CPU::retire_rob()
+void O3_CPU::do_retire_accounting(const ooo_model_instr& instr)
 {
-  auto [retire_begin, retire_end] =
-      champsim::get_span_p(std::cbegin(ROB), std::cend(ROB), champsim::bandwidth{RETIRE_WIDTH}, [](const auto& x) { return x.completed; });
-  assert(std::distance(retire_begin, retire_end) >= 0); // end succeeds begin
-  if constexpr (champsim::debug_print) {
-    std::for_each(retire_begin, retire_end, [cycle = current_time.time_since_epoch() / clock_period](const auto& x) {
-      fmt::print("[ROB] retire_rob instr_id: {} is retired cycle: {}\n", x.instr_id, cycle);
-    });
-  }
-
-  // commit register writes to backend RAT
-  // and recycle the old physical registers
-  for (auto rob_it = retire_begin; rob_it != retire_end; ++rob_it) {
-    for (auto dreg : rob_it->destination_registers) {
-      reg_allocator.retire_dest_register(dreg);
+  if (instr.memory_stall_cycles > 0) {
+    auto type = stall_type::TRANSLATION;
+    if (!instr.mem_page_walked) {
+      constexpr std::array levels{stall_type::L1, stall_type::L2, stall_type::L3, stall_type::DRAM};
+      type = levels.at(std::min<std::size_t>(instr.mem_miss_depth, std::size(levels) - 1));
     }
+    sim_stats.retire_stall_cycles.set(type, sim_stats.retire_stall_cycles.value_or(type, 0) + instr.memory_stall_cycles);
   }
 
-  auto retire_count = std::distance(retire_begin, retire_end);
-  num_retired += retire_count;
-  ROB.erase(retire_begin, retire_end);
-
-  return retire_count;
+  if (pipeline_trace.has_value() && !warmup) {
+    pipeline_trace->retire(instr, current_time);
+  }
 }
 
 void O3_CPU::impl_initialize_branch_predictor() const { branch_module_pimpl->impl_initialize_branch_predictor(); }
@@ -748,7 +490,7 @@ void O3_CPU::impl_update_btb(champsim::address ip, champsim::address predicted_t
   btb_module_pimpl->impl_update_btb(ip, predicted_target, taken, branch_type);
 }
 
-std::pair<champsim::address, bool> O3_CPU::impl_btb_prediction(champsim::address ip, uint8_t branch_type) const
+champsim::modules::btb::prediction O3_CPU::impl_btb_prediction(champsim::address ip, uint8_t branch_type) const
 {
   return btb_module_pimpl->impl_btb_prediction(ip, branch_type);
 }
@@ -820,6 +562,9 @@ void LSQ_ENTRY::finish(ooo_model_instr& rob_entry) const
   ++rob_entry.completed_mem_ops;
   assert(rob_entry.completed_mem_ops <= rob_entry.num_mem_ops());
 
+  rob_entry.mem_miss_depth = std::max(rob_entry.mem_miss_depth, miss_depth);
+  rob_entry.mem_page_walked = rob_entry.mem_page_walked || page_walked;
+
   if constexpr (champsim::debug_print) {
     fmt::print("[LSQ] {} instr_id: {} full_address: {} remain_mem_ops: {}\n", __func__, instr_id, virtual_address,
                rob_entry.num_mem_ops() - rob_entry.completed_mem_ops);
@@ -0,0 +1,49 @@
+#include "pipeline_trace.h"
+
+#include <cassert>
+#include <string_view>
+#include <fmt/ostream.h>
+
+namespace
+{
+auto ticks(champsim::chrono::clock::time_point time) { return time.time_since_epoch().count(); }
+
+std::string_view mnemonic(const ooo_model_instr& instr)
+{
+  using namespace std::literals::string_view_literals;
+  if (instr.is_branch) {
+    return "branch"sv;
+  }
+  if (!std::empty(instr.source_memory)) {
+    return std::empty(instr.destination_memory) ? "load"sv : "load-store"sv;
+  }
+  if (!std::empty(instr.destination_memory)) {
+    return "store"sv;
+  }
+  return "op"sv;
+}
+} // namespace
+
+champsim::pipeline_tracer::pipeline_tracer(std::ostream& stream, uint64_t interval, uint64_t length)
+    : out(&stream), sample_interval(interval), sample_length(length)
+{
+  assert(sample_interval > 0);
+}
+
+bool champsim::pipeline_tracer::sampled(uint64_t instr_id) const { return (instr_id % sample_interval) < sample_length; }
+
+void champsim::pipeline_tracer::retire(const ooo_model_instr& instr, champsim::chrono::clock::time_point retire_time)
+{
+  if (!sampled(instr.instr_id)) {
+    return;
+  }
+
+  // ChampSim does not track stores past retirement, so the store completion time is never given
+  fmt::print(*out, "O3PipeView:fetch:{}:{:#010x}:0:{}:{}\n", ticks(instr.timing.fetch), instr.ip.to<uint64_t>(), instr.instr_id, mnemonic(instr));
+  fmt::print(*out, "O3PipeView:decode:{}\n", ticks(instr.timing.decode));
+  fmt::print(*out, "O3PipeView:rename:{}\n", ticks(instr.timing.rename));
+  fmt::print(*out, "O3PipeView:dispatch:{}\n", ticks(instr.timing.dispatch));
+  fmt::print(*out, "O3PipeView:issue:{}\n", ticks(instr.timing.issue));
+  fmt::print(*out, "O3PipeView:complete:{}\n", ticks(instr.timing.complete));
+  fmt::print(*out, "O3PipeView:retire:{}:store:0\n", ticks(retire_time));
+}
@@ -23,6 +23,7 @@
 #include <fmt/chrono.h>
 #include <fmt/core.h>
 #include <fmt/ostream.h>
+#include <fmt/ranges.h>
 
 #include "stats_printer.h"
 
@@ -56,12 +57,42 @@ std::vector<std::string> champsim::plain_printer::format(O3_CPU::stats_type stat
                               ::print_ratio(std::kilo::num * total_mispredictions, stats.instrs()),
                               ::print_ratio(stats.total_rob_occupancy_at_branch_mispredict, total_mispredictions)));
 
+  // Memory dependence prediction is optional, so only report it if it was active
+  if (stats.memory_dependences_predicted > 0 || stats.memory_dependences_false > 0 || stats.memory_order_violations > 0) {
+    lines.push_back(fmt::format("{} Memory dependences predicted: {} false: {} Memory order violations: {} PKI: {}", stats.name,
+                                stats.memory_dependences_predicted, stats.memory_dependences_false, stats.memory_order_violations,
+                                ::print_ratio(std::kilo::num * stats.memory_order_violations, stats.instrs())));
+  }
+
+  // The store buffer is optional, so only report it if it was active
+  if (stats.stores_coalesced > 0 || stats.full_line_stores > 0) {
+    lines.push_back(fmt::format("{} Stores coalesced: {} Full-line stores: {}", stats.name, stats.stores_coalesced, stats.full_line_stores));
+  }
+
+  // Only hierarchical BTBs report the level that provided each target
+  if (stats.btb_level_hits.total() > 0) {
+    lines.push_back(fmt::format("{} BTB lookups: {} Bubble cycles: {}", stats.name, stats.btb_lookups, stats.btb_bubble_cycles));
+    for (auto level : stats.btb_level_hits.get_keys()) {
+      lines.push_back(fmt::format("L{} BTB hit rate: {}%", level, ::print_ratio(100 * stats.btb_level_hits.value_or(level, 0), stats.btb_lookups)));
+    }
+  }
+
   lines.emplace_back("Branch type MPKI");
   for (auto idx : types) {
     lines.push_back(fmt::format("{}: {}", branch_type_names.at(champsim::to_underlying(idx)),
                                 ::print_ratio(std::kilo::num * stats.branch_type_misses.value_or(idx, 0), stats.instrs())));
   }
 
+  // Cores that never ran have no stalls to report
+  if (stats.retire_stall_cycles.total() > 0) {
+    lines.push_back(fmt::format("{} Retire stall cycles: {} ({}% of cycles)", stats.name, stats.retire_stall_cycles.total(),
+                                ::print_ratio(100 * stats.retire_stall_cycles.total(), stats.cycles())));
+    for (std::size_t idx = 0; idx < std::size(stall_type_names); ++idx) {
+      auto count = stats.retire_stall_cycles.value_or(static_cast<stall_type>(idx), 0);
+      lines.push_back(fmt::format("{}: {} ({}%)", stall_type_names.at(idx), count, ::print_ratio(100 * count, stats.cycles())));
+    }
+  }
+
   return lines;
 }
 
@@ -119,6 +150,85 @@ std::vector<std::string> champsim::plain_printer::format(CACHE::stats_type stats
     lines.push_back(fmt::format("cpu{}->{} PREFETCH REQUESTED: {:10} ISSUED: {:10} USEFUL: {:10} USELESS: {:10}", cpu, stats.name, stats.pf_requested,
                                 stats.pf_issued, stats.pf_useful, stats.pf_useless));
 
+    if (stats.pf_timely > 0 || stats.pf_late > 0 || stats.pf_early > 0) {
+      lines.push_back(fmt::format("cpu{}->{} PREFETCH TIMELY: {:10} LATE: {:10} EARLY: {:10}", cpu, stats.name, stats.pf_timely, stats.pf_late, stats.pf_early));
+    }
+
+    if (stats.pf_fill_to_use.total() > 0) {
+      std::vector<std::string> buckets{};
+      for (auto bucket : stats.pf_fill_to_use.get_keys()) {
+        buckets.push_back(fmt::format("<{}: {}", uint64_t{1} << bucket, stats.pf_fill_to_use.value_or(bucket, 0)));
+      }
+      lines.push_back(fmt::format("cpu{}->{} PREFETCH FILL TO USE CYCLES {}", cpu, stats.name, fmt::join(buckets, " ")));
+    }
+
+    if (stats.pf_filtered_duplicate > 0 || stats.pf_filtered_resident > 0) {
+      lines.push_back(fmt::format("cpu{}->{} PREFETCH FILTERED DUPLICATE: {:10} RESIDENT: {:10}", cpu, stats.name, stats.pf_filtered_duplicate,
+                                  stats.pf_filtered_resident));
+    }
+
+    if (stats.pf_throttled > 0 || stats.pf_polluting_misses > 0) {
+      lines.push_back(fmt::format("cpu{}->{} PREFETCH THROTTLED: {:10} POLLUTING MISSES: {:10}", cpu, stats.name, stats.pf_throttled, stats.pf_polluting_misses));
+    }
+
+    if (stats.pf_arbitration_dropped > 0) {
+      lines.push_back(fmt::format("cpu{}->{} PREFETCH ARBITRATION DROPPED: {:10}", cpu, stats.name, stats.pf_arbitration_dropped));
+    }
+
+    if (stats.back_invalidations > 0 || stats.back_invalidated > 0 || stats.victim_fills > 0) {
+      lines.push_back(fmt::format("cpu{}->{} BACK INVALIDATIONS SENT: {:10} RECEIVED: {:10} VICTIM FILLS: {:10}", cpu, stats.name, stats.back_invalidations,
+                                  stats.back_invalidated, stats.victim_fills));
+    }
+
+    if (stats.coherence_misses > 0 || stats.coherence_invalidations > 0 || stats.coherence_downgrades > 0) {
+      lines.push_back(fmt::format("cpu{}->{} COHERENCE MISSES: {:10} INVALIDATIONS: {:10} DOWNGRADES: {:10} DIRECTORY EVICTIONS: {:10}", cpu, stats.name,
+                                  stats.coherence_misses, stats.coherence_invalidations, stats.coherence_downgrades, stats.directory_evictions));
+    }
+
+    if (stats.coherence_upgrades > 0) {
+      lines.push_back(fmt::format("cpu{}->{} COHERENCE UPGRADES: {:10}", cpu, stats.name, stats.coherence_upgrades));
+    }
+
+    if (std::size(stats.occupancy) > 1 || !std::empty(stats.partition_ways)) {
+      const auto occupancy = cpu < std::size(stats.occupancy) ? stats.occupancy[cpu] : 0;
+      const auto ways = cpu < std::size(stats.partition_ways) ? fmt::format("{:10}", stats.partition_ways[cpu]) : fmt::format("{:>10}", "ALL");
+      lines.push_back(fmt::format("cpu{}->{} OCCUPANCY: {:10} PARTITION WAYS: {} REPARTITIONS: {:10}", cpu, stats.name, occupancy, ways, stats.repartitions));
+    }
+
+    if (stats.victim_cache_hits > 0 || stats.victim_cache_writebacks > 0 || stats.wcb_writes > 0) {
+      lines.push_back(fmt::format("cpu{}->{} VICTIM CACHE HITS: {:10} WRITEBACKS: {:10} WRITE COMBINING WRITES: {:10} COMBINED: {:10}", cpu, stats.name,
+                                  stats.victim_cache_hits, stats.victim_cache_writebacks, stats.wcb_writes, stats.wcb_combined));
+    }
+
+    if (stats.rfo_elided > 0 || stats.writes_not_allocated > 0) {
+      lines.push_back(fmt::format("cpu{}->{} WRITES RFO ELIDED: {:10} NOT ALLOCATED: {:10}", cpu, stats.name, stats.rfo_elided, stats.writes_not_allocated));
+    }
+
+    if (stats.capacity_blocks > 0) {
+      const auto effective_capacity = static_cast<double>(stats.resident_blocks) / static_cast<double>(stats.capacity_blocks);
+      lines.push_back(fmt::format("cpu{}->{} COMPRESSED FILLS: {:10} BYTES: {:10} EXTRA EVICTIONS: {:10} RESIDENT BLOCKS: {:10} EFFECTIVE CAPACITY: {:.4g}", cpu,
+                                  stats.name, stats.compressed_fills, stats.compressed_fill_bytes, stats.compression_evictions, stats.resident_blocks,
+                                  effective_capacity));
+    }
+
+    if (stats.metadata_reads > 0 || stats.metadata_writes > 0) {
+      lines.push_back(fmt::format("cpu{}->{} METADATA READS: {:10} HITS: {:10} WRITES: {:10} EVICTIONS: {:10}", cpu, stats.name, stats.metadata_reads,
+                                  stats.metadata_read_hits, stats.metadata_writes, stats.metadata_evictions));
+    }
+
+    if (stats.metadata_offchip_reads > 0 || stats.metadata_offchip_writes > 0) {
+      lines.push_back(fmt::format("cpu{}->{} METADATA OFFCHIP READS: {:10} WRITES: {:10}", cpu, stats.name, stats.metadata_offchip_reads,
+                                  stats.metadata_offchip_writes));
+    }
+
+    // Attribute prefetches to each module only when several are combined
+    if (std::size(stats.pf_sources) > 1) {
+      for (const auto& source : stats.pf_sources) {
+        lines.push_back(fmt::format("cpu{}->{} PREFETCHER {} ISSUED: {:10} USEFUL: {:10} LATE: {:10} USELESS: {:10}", cpu, stats.name, source.name,
+                                    source.issued, source.useful, source.late, source.useless));
+      }
+    }
+
     uint64_t total_downstream_demands = total_mshr_return - stats.mshr_return.value_or(std::pair{access_type::PREFETCH, cpu}, mshr_return_value_type{});
     lines.push_back(
         fmt::format("cpu{}->{} AVERAGE MISS LATENCY: {} cycles", cpu, stats.name, ::print_ratio(stats.total_miss_latency_cycles, total_downstream_demands)));
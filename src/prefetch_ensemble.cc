@@ -0,0 +1,56 @@
+#include "prefetch_ensemble.h"
+
+#include <algorithm>
+#include <numeric>
+
+champsim::prefetch_arbiter::prefetch_arbiter(policy arbitration_, std::size_t num_components) : arbitration(arbitration_), components(num_components) {}
+
+void champsim::prefetch_arbiter::record_issue(std::size_t component)
+{
+  if (component < std::size(components))
+    ++components[component].issued;
+}
+
+void champsim::prefetch_arbiter::record_useful(std::size_t component)
+{
+  if (component < std::size(components)) {
+    ++components[component].useful;
+    components[component].selector = std::min(components[component].selector + 1, selector_max);
+  }
+}
+
+void champsim::prefetch_arbiter::record_useless(std::size_t component)
+{
+  if (component < std::size(components) && components[component].selector > 0)
+    --components[component].selector;
+}
+
+double champsim::prefetch_arbiter::accuracy(std::size_t component) const
+{
+  // Components that have not issued anything yet are assumed to be as good as a coin flip
+  const auto& state = components.at(component);
+  return (static_cast<double>(state.useful) + 1) / (static_cast<double>(state.issued) + 2);
+}
+
+std::vector<std::size_t> champsim::prefetch_arbiter::rank()
+{
+  const auto num_components = std::size(components);
+  std::vector<std::size_t> order(num_components);
+  std::iota(std::begin(order), std::end(order), std::size_t{0});
+
+  if (arbitration == policy::ROUND_ROBIN) {
+    std::rotate(std::begin(order), std::next(std::begin(order), static_cast<long>(round_robin_head)), std::end(order));
+    if (num_components > 0)
+      round_robin_head = (round_robin_head + 1) % num_components;
+  } else if (arbitration == policy::ACCURACY) {
+    std::stable_sort(std::begin(order), std::end(order), [this](auto x, auto y) { return accuracy(x) > accuracy(y); });
+  } else if (arbitration == policy::SELECTOR) {
+    std::stable_sort(std::begin(order), std::end(order), [this](auto x, auto y) { return components[x].selector > components[y].selector; });
+  }
+
+  // Invert the order, so that the result is indexed by component
+  std::vector<std::size_t> ranks(num_components);
+  for (std::size_t i = 0; i < num_components; ++i)
+    ranks[order[i]] = i;
+  return ranks;
+}
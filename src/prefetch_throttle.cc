@@ -0,0 +1,83 @@
+#include "prefetch_throttle.h"
+
+#include <algorithm>
+
+champsim::prefetch_throttle::prefetch_throttle(uint64_t interval_) : interval(std::max(interval_, uint64_t{1})) {}
+
+void champsim::prefetch_throttle::record_issue() { ++interval_counts.issued; }
+
+void champsim::prefetch_throttle::record_use(bool late)
+{
+  ++interval_counts.useful;
+  if (late)
+    ++interval_counts.late;
+}
+
+void champsim::prefetch_throttle::record_demand_miss(bool caused_by_prefetch)
+{
+  ++interval_counts.demand_misses;
+  if (caused_by_prefetch)
+    ++interval_counts.polluting_misses;
+}
+
+void champsim::prefetch_throttle::record_eviction()
+{
+  if (++evictions >= interval) {
+    end_interval();
+    evictions = 0;
+  }
+}
+
+void champsim::prefetch_throttle::record_bandwidth(uint8_t bucket) { bandwidth_bucket = bucket; }
+
+void champsim::prefetch_throttle::end_interval()
+{
+  auto average = [](double past, double now) {
+    return (past + now) / 2;
+  };
+  history.issued = average(history.issued, interval_counts.issued);
+  history.useful = average(history.useful, interval_counts.useful);
+  history.late = average(history.late, interval_counts.late);
+  history.demand_misses = average(history.demand_misses, interval_counts.demand_misses);
+  history.polluting_misses = average(history.polluting_misses, interval_counts.polluting_misses);
+  interval_counts = {};
+
+  const bool late = lateness() > lateness_threshold;
+  const bool polluting = pollution() > pollution_threshold;
+
+  // Table 2 of the FDP paper: accurate prefetchers that are late run further ahead,
+  // inaccurate or polluting prefetchers are reined in, and everything else stays where it is.
+  int change = 0;
+  if (accuracy() >= accuracy_high) {
+    change = late ? 1 : 0;
+  } else if (accuracy() >= accuracy_low) {
+    if (polluting)
+      change = -1;
+    else if (late)
+      change = 1;
+  } else if (late || polluting) {
+    change = -1;
+  }
+
+  if (bandwidth_limited())
+    change = std::min(change, -1);
+
+  if (change > 0 && current_level + 1 < std::size(levels))
+    ++current_level;
+  if (change < 0 && current_level > 0)
+    --current_level;
+}
+
+std::size_t champsim::prefetch_throttle::level() const { return current_level; }
+
+bool champsim::prefetch_throttle::bandwidth_limited() const { return bandwidth_bucket >= high_bandwidth_bucket; }
+
+unsigned champsim::prefetch_throttle::degree() const { return bandwidth_limited() ? levels.front().degree : levels.at(current_level).degree; }
+
+unsigned champsim::prefetch_throttle::distance() const { return levels.at(current_level).distance; }
+
+double champsim::prefetch_throttle::accuracy() const { return history.issued > 0 ? history.useful / history.issued : 0; }
+
+double champsim::prefetch_throttle::lateness() const { return history.useful > 0 ? history.late / history.useful : 0; }
+
+double champsim::prefetch_throttle::pollution() const { return history.demand_misses > 0 ? history.polluting_misses / history.demand_misses : 0; }
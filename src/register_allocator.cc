@@ -1,12 +1,17 @@
 #include "register_allocator.h"
 
+#include <algorithm>
 #include <cassert>
+#include <numeric>
+
+#include "util/bits.h"
 
 RegisterAllocator::RegisterAllocator(size_t num_physical_registers)
+    : free_registers((num_physical_registers + free_word_bits - 1) / free_word_bits, ~free_word_type{0})
 {
   assert(num_physical_registers <= std::numeric_limits<PHYSICAL_REGISTER_ID>::max());
-  for (size_t i = 0; i < num_physical_registers; ++i) {
-    free_registers.push(static_cast<PHYSICAL_REGISTER_ID>(i));
+  if (num_physical_registers % free_word_bits != 0) {
+    free_registers.back() = champsim::bitmask(champsim::data::bits{num_physical_registers % free_word_bits});
   }
   physical_register_file = std::vector<physical_register>(num_physical_registers, {0, 0, false, false});
   frontend_RAT.fill(-1); // default value for no mapping
@@ -15,10 +20,7 @@ RegisterAllocator::RegisterAllocator(size_t num_physical_registers)
 
 PHYSICAL_REGISTER_ID RegisterAllocator::rename_dest_register(int16_t reg, champsim::program_ordered<ooo_model_instr>::id_type producer_id)
 {
-  assert(!free_registers.empty());
-
-  PHYSICAL_REGISTER_ID phys_reg = free_registers.front();
-  free_registers.pop();
+  PHYSICAL_REGISTER_ID phys_reg = allocate_register();
   frontend_RAT[reg] = phys_reg;
   physical_register_file.at(phys_reg) = {(uint16_t)reg, producer_id, false, true}; // arch_reg_index, valid, busy
 
@@ -32,8 +34,7 @@ PHYSICAL_REGISTER_ID RegisterAllocator::rename_src_register(int16_t reg)
   if (phys < 0) {
     // allocate the register if it hasn't yet been mapped
     // (common due to the traces being slices in the middle of a program)
-    phys = free_registers.front();
-    free_registers.pop();
+    phys = allocate_register();
     frontend_RAT[reg] = phys;
     backend_RAT[reg] = phys;                                          // we assume this register's last write has been committed
     physical_register_file.at(phys) = {(uint16_t)reg, 0, true, true}; // arch_reg_index, producing_inst_id, valid, busy
@@ -42,6 +43,35 @@ PHYSICAL_REGISTER_ID RegisterAllocator::rename_src_register(int16_t reg)
   return phys;
 }
 
+PHYSICAL_REGISTER_ID RegisterAllocator::allocate_register()
+{
+  // Allocate the lowest-numbered free register
+  auto word = std::find_if(std::begin(free_registers), std::end(free_registers), [](auto x) { return x != 0; });
+  assert(word != std::end(free_registers));
+
+  auto bit = champsim::countr_zero(*word);
+  *word &= *word - 1; // clear the lowest set bit
+  return static_cast<PHYSICAL_REGISTER_ID>(std::distance(std::begin(free_registers), word) * static_cast<long>(free_word_bits) + bit);
+}
+
+void RegisterAllocator::rename(ooo_model_instr& instr)
+{
+  for (auto& src_reg : instr.source_registers) {
+    src_reg = rename_src_register(src_reg);
+  }
+
+  for (auto& dreg : instr.destination_registers) {
+    dreg = rename_dest_register(dreg, instr.instr_id);
+  }
+}
+
+unsigned long RegisterAllocator::registers_needed(const ooo_model_instr& instr) const
+{
+  auto sources_to_allocate =
+      std::count_if(std::begin(instr.source_registers), std::end(instr.source_registers), [this](auto srcreg) { return !isAllocated(srcreg); });
+  return static_cast<unsigned long>(sources_to_allocate) + std::size(instr.destination_registers);
+}
+
 void RegisterAllocator::complete_dest_register(PHYSICAL_REGISTER_ID physreg)
 {
   // mark the physical register as valid
@@ -66,14 +96,18 @@ void RegisterAllocator::retire_dest_register(PHYSICAL_REGISTER_ID physreg)
 void RegisterAllocator::free_register(PHYSICAL_REGISTER_ID physreg)
 {
   physical_register_file.at(physreg) = {255, 0, false, false}; // arch_reg_index, producing_inst_id, valid, busy
-  free_registers.push(physreg);
+  free_registers.at(static_cast<std::size_t>(physreg) / free_word_bits) |= free_word_type{1} << (static_cast<std::size_t>(physreg) % free_word_bits);
 }
 
 bool RegisterAllocator::isValid(PHYSICAL_REGISTER_ID physreg) const { return physical_register_file.at(physreg).valid; }
 
 bool RegisterAllocator::isAllocated(PHYSICAL_REGISTER_ID archreg) const { return frontend_RAT[archreg] != -1; }
 
-unsigned long RegisterAllocator::count_free_registers() const { return std::size(free_registers); }
+unsigned long RegisterAllocator::count_free_registers() const
+{
+  return std::accumulate(std::begin(free_registers), std::end(free_registers), 0ul,
+                         [](auto acc, auto word) { return acc + static_cast<unsigned long>(champsim::popcount(word)); });
+}
 
 int RegisterAllocator::count_reg_dependencies(const ooo_model_instr& instr) const
 {
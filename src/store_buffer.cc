@@ -0,0 +1,65 @@
+#include "store_buffer.h"
+
+#include <algorithm>
+
+#include "util/to_underlying.h"
+
+champsim::store_buffer::store_buffer(std::size_t size, champsim::data::bits offset, champsim::chrono::clock::duration wait)
+    : capacity(size), offset_bits(offset), max_wait(wait)
+{
+}
+
+uint64_t champsim::store_buffer::full_mask() const
+{
+  const auto words = std::max<std::size_t>((std::size_t{1} << champsim::to_underlying(offset_bits)) / word_size, 1);
+  return words >= 64 ? ~uint64_t{0} : ((uint64_t{1} << words) - 1);
+}
+
+uint64_t champsim::store_buffer::word_bit(champsim::address address) const
+{
+  const auto offset = address.slice_lower(offset_bits).to<uint64_t>();
+  return (uint64_t{1} << ((offset / word_size) % 64)) & full_mask();
+}
+
+bool champsim::store_buffer::enabled() const { return capacity > 0; }
+
+auto champsim::store_buffer::add(const request_type& packet, champsim::chrono::clock::time_point now) -> add_result
+{
+  // Only the youngest entry may take more stores, so that no store passes an older one to a different block
+  if (!std::empty(entries) && entries.back().packet.v_address.slice_upper(offset_bits) == packet.v_address.slice_upper(offset_bits)) {
+    entries.back().written_words |= word_bit(packet.v_address);
+    return add_result::COALESCED;
+  }
+
+  if (std::size(entries) >= capacity)
+    return add_result::FULL;
+
+  entries.push_back({packet, word_bit(packet.v_address), now});
+  return add_result::ADDED;
+}
+
+bool champsim::store_buffer::ready(champsim::chrono::clock::time_point now) const
+{
+  if (std::empty(entries))
+    return false;
+  const auto& oldest = entries.front();
+  return oldest.written_words == full_mask() || 2 * std::size(entries) > capacity || oldest.time_enqueued + max_wait <= now;
+}
+
+auto champsim::store_buffer::front() const -> request_type
+{
+  auto retval = entries.front().packet;
+  retval.full_line = (entries.front().written_words == full_mask());
+  return retval;
+}
+
+void champsim::store_buffer::pop_front() { entries.pop_front(); }
+
+bool champsim::store_buffer::contains(champsim::address v_address) const
+{
+  return std::any_of(std::begin(entries), std::end(entries), [match = v_address.slice_upper(offset_bits), shamt = offset_bits](const auto& entry) {
+    return entry.packet.v_address.slice_upper(shamt) == match;
+  });
+}
+
+std::size_t champsim::store_buffer::size() const { return std::size(entries); }
@@ -0,0 +1,80 @@
+#include "store_set.h"
+
+#include <algorithm>
+
+champsim::store_set_predictor::store_set_predictor(std::size_t ssit_size, std::size_t lfst_size, uint64_t clear_interval_)
+    : ssit(ssit_size), lfst(lfst_size), clear_interval(clear_interval_)
+{
+}
+
+bool champsim::store_set_predictor::enabled() const { return !std::empty(ssit) && !std::empty(lfst); }
+
+std::size_t champsim::store_set_predictor::ssit_index(champsim::address ip) const { return ip.to<std::size_t>() % std::size(ssit); }
+
+auto champsim::store_set_predictor::predict_load(champsim::address ip) -> std::optional<id_type>
+{
+  if (!enabled()) {
+    return std::nullopt;
+  }
+
+  if (++accesses_since_clear >= clear_interval) {
+    clear();
+  }
+
+  auto ssid = ssit.at(ssit_index(ip));
+  if (!ssid.has_value()) {
+    return std::nullopt;
+  }
+  return lfst.at(*ssid);
+}
+
+void champsim::store_set_predictor::dispatch_store(champsim::address ip, id_type id)
+{
+  if (!enabled()) {
+    return;
+  }
+
+  if (auto ssid = ssit.at(ssit_index(ip)); ssid.has_value()) {
+    lfst.at(*ssid) = id;
+  }
+}
+
+void champsim::store_set_predictor::execute_store(champsim::address ip, id_type id)
+{
+  if (!enabled()) {
+    return;
+  }
+
+  if (auto ssid = ssit.at(ssit_index(ip)); ssid.has_value() && lfst.at(*ssid) == id) {
+    lfst.at(*ssid).reset();
+  }
+}
+
+void champsim::store_set_predictor::train_violation(champsim::address load_ip, champsim::address store_ip)
+{
+  if (!enabled()) {
+    return;
+  }
+
+  auto& load_ssid = ssit.at(ssit_index(load_ip));
+  auto& store_ssid = ssit.at(ssit_index(store_ip));
+
+  if (!load_ssid.has_value() && !store_ssid.has_value()) {
+    // Allocate a new store set, named after the store
+    load_ssid = store_ssid = ssit_index(store_ip) % std::size(lfst);
+  } else if (!load_ssid.has_value()) {
+    load_ssid = store_ssid;
+  } else if (!store_ssid.has_value()) {
+    store_ssid = load_ssid;
+  } else {
+    // Both belong to sets already. The smaller set ID wins, so that sets converge.
+    load_ssid = store_ssid = std::min(*load_ssid, *store_ssid);
+  }
+}
+
+void champsim::store_set_predictor::clear()
+{
+  std::fill(std::begin(ssit), std::end(ssit), std::nullopt);
+  std::fill(std::begin(lfst), std::end(lfst), std::nullopt);
+  accesses_since_clear = 0;
+}
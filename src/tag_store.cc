@@ -0,0 +1,88 @@
+#include "tag_store.h"
+
+#include <stdexcept>
+
+#include "util/bits.h"
+
+#if defined(__x86_64__) && (defined(__GNUG__) || defined(__clang__))
+#define CHAMPSIM_TAG_STORE_AVX2
+#include <immintrin.h>
+#endif
+
+namespace
+{
+constexpr std::size_t tags_per_vector = 4; // 64-bit tags in a 256-bit register
+
+champsim::tag_store::mask_type all_ways(std::size_t ways)
+{
+  return ways >= champsim::tag_store::max_ways ? ~champsim::tag_store::mask_type{0} : ((champsim::tag_store::mask_type{1} << ways) - 1);
+}
+} // namespace
+
+champsim::tag_store::tag_store(std::size_t sets, std::size_t ways, bool allow_simd)
+    : num_way(ways), stride(((ways + tags_per_vector - 1) / tags_per_vector) * tags_per_vector), tags(sets * stride), valid(sets),
+      use_simd(allow_simd && simd_available())
+{
+  if (ways > max_ways)
+    throw std::invalid_argument{"The packed tag store holds at most 64 ways"};
+}
+
+bool champsim::tag_store::simd_available()
+{
+#ifdef CHAMPSIM_TAG_STORE_AVX2
+  static const bool available = __builtin_cpu_supports("avx2");
+  return available;
+#else
+  return false;
+#endif
+}
+
+auto champsim::tag_store::match_scalar(std::size_t set, tag_type tag) const -> mask_type
+{
+  mask_type result = 0;
+  const auto* set_tags = tags.data() + set * stride;
+  for (std::size_t way = 0; way < num_way; ++way)
+    result |= mask_type{set_tags[way] == tag} << way;
+  return result;
+}
+
+#ifdef CHAMPSIM_TAG_STORE_AVX2
+__attribute__((target("avx2"))) auto champsim::tag_store::match_simd(std::size_t set, tag_type tag) const -> mask_type
+{
+  mask_type result = 0;
+  const auto* set_tags = tags.data() + set * stride;
+  const auto needle = _mm256_set1_epi64x(static_cast<long long>(tag));
+  for (std::size_t way = 0; way < stride; way += tags_per_vector) {
+    const auto haystack = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(set_tags + way));
+    const auto matches = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(haystack, needle)));
+    result |= static_cast<mask_type>(static_cast<unsigned>(matches)) << way;
+  }
+  return result;
+}
+#else
+auto champsim::tag_store::match_simd(std::size_t set, tag_type tag) const -> mask_type { return match_scalar(set, tag); }
+#endif
+
+auto champsim::tag_store::find(std::size_t set, tag_type tag) const -> std::optional<std::size_t>
+{
+  const auto matches = (use_simd ? match_simd(set, tag) : match_scalar(set, tag)) & valid[set];
+  if (matches == 0)
+    return std::nullopt;
+  return static_cast<std::size_t>(champsim::countr_zero(matches));
+}
+
+auto champsim::tag_store::find_invalid(std::size_t set) const -> std::optional<std::size_t>
+{
+  const auto invalid = ~valid[set] & all_ways(num_way);
+  if (invalid == 0)
+    return std::nullopt;
+  return static_cast<std::size_t>(champsim::countr_zero(invalid));
+}
+
+void champsim::tag_store::insert(std::size_t set, std::size_t way, tag_type tag)
+{
+  tags[set * stride + way] = tag;
+  valid[set] |= mask_type{1} << way;
+}
+
+void champsim::tag_store::erase(std::size_t set, std::size_t way) { valid[set] &= ~(mask_type{1} << way); }
@@ -0,0 +1,48 @@
+#include "victim_cache.h"
+
+#include <algorithm>
+
+champsim::victim_cache::victim_cache(std::size_t size, champsim::data::bits offset) : capacity(size), offset_bits(offset) {}
+
+auto champsim::victim_cache::find(champsim::address address)
+{
+  return std::find_if(std::begin(blocks), std::end(blocks), [match = address.slice_upper(offset_bits), shamt = offset_bits](const auto& entry) {
+    return entry.address.slice_upper(shamt) == match;
+  });
+}
+
+std::optional<champsim::cache_block> champsim::victim_cache::take(champsim::address address)
+{
+  auto found = find(address);
+  if (found == std::end(blocks))
+    return std::nullopt;
+
+  auto block = *found;
+  blocks.erase(found);
+  return block;
+}
+
+std::optional<champsim::cache_block> champsim::victim_cache::displaced() const
+{
+  if (std::size(blocks) < capacity || std::empty(blocks))
+    return std::nullopt;
+  return blocks.front();
+}
+
+void champsim::victim_cache::insert(const champsim::cache_block& block)
+{
+  if (capacity == 0)
+    return;
+  if (std::size(blocks) >= capacity)
+    blocks.pop_front();
+  blocks.push_back(block);
+}
+
+bool champsim::victim_cache::contains(champsim::address address) const
+{
+  return std::any_of(std::begin(blocks), std::end(blocks), [match = address.slice_upper(offset_bits), shamt = offset_bits](const auto& entry) {
+    return entry.address.slice_upper(shamt) == match;
+  });
+}
+
+std::size_t champsim::victim_cache::size() const { return std::size(blocks); }
@@ -57,8 +57,9 @@ VirtualMemory::VirtualMemory(champsim::data::bytes page_table_page_size, std::si
 void VirtualMemory::populate_pages()
 {
   assert(dram.size() > 1_MiB);
-  ppage_free_list.resize(((dram.size() - 1_MiB) / PAGE_SIZE).count());
-  assert(ppage_free_list.size() != 0);
+  const auto total_ppages = static_cast<std::size_t>(((dram.size() - 1_MiB) / PAGE_SIZE).count());
+  assert(total_ppages > reserved_ppages);
+  ppage_free_list.resize(total_ppages - reserved_ppages);
   champsim::page_number base_address =
       champsim::page_number{champsim::lowest_address_for_size(std::max<champsim::data::mebibytes>(champsim::data::bytes{PAGE_SIZE}, 1_MiB))};
   for (auto it = ppage_free_list.begin(); it != ppage_free_list.end(); it++) {
@@ -104,9 +105,23 @@ void VirtualMemory::ppage_pop()
 
 std::size_t VirtualMemory::available_ppages() const { return (ppage_free_list.size()); }
 
+champsim::address VirtualMemory::reserve_region(champsim::data::bytes size)
+{
+  assert(std::empty(vpage_to_ppage_map) && std::empty(page_table));
+  const auto pages = static_cast<std::size_t>((size.count() + PAGE_SIZE - 1) / PAGE_SIZE);
+  reserved_ppages += pages;
+  populate_pages();
+  shuffle_pages();
+
+  // Translations use the pages below the reservations, so this one begins just past them
+  champsim::page_number base_address =
+      champsim::page_number{champsim::lowest_address_for_size(std::max<champsim::data::mebibytes>(champsim::data::bytes{PAGE_SIZE}, 1_MiB))};
+  return champsim::address{base_address + static_cast<champsim::page_number::difference_type>(available_ppages())};
+}
+
 std::pair<champsim::page_number, champsim::chrono::clock::duration> VirtualMemory::va_to_pa(uint32_t cpu_num, champsim::page_number vaddr)
 {
-  auto [ppage, fault] = vpage_to_ppage_map.try_emplace({cpu_num, champsim::page_number{vaddr}}, ppage_front());
+  auto [ppage, fault] = vpage_to_ppage_map.try_emplace({shared_address_space ? 0 : cpu_num, champsim::page_number{vaddr}}, ppage_front());
 
   // this vpage doesn't yet have a ppage mapping
   if (fault) {
@@ -125,8 +140,8 @@ std::pair<champsim::page_number, champsim::chrono::clock::duration> VirtualMemor
 std::pair<champsim::address, champsim::chrono::clock::duration> VirtualMemory::get_pte_pa(uint32_t cpu_num, champsim::page_number vaddr, std::size_t level)
 {
   champsim::dynamic_extent pte_table_entry_extent{champsim::address::bits, shamt(level + 1)};
-  auto [ppage, fault] =
-      page_table.try_emplace({cpu_num, level, champsim::address_slice{pte_table_entry_extent, vaddr}}, champsim::splice(active_pte_page, next_pte_page));
+  auto [ppage, fault] = page_table.try_emplace({shared_address_space ? 0 : cpu_num, level, champsim::address_slice{pte_table_entry_extent, vaddr}},
+                                                champsim::splice(active_pte_page, next_pte_page));
 
   // this PTE doesn't yet have a mapping
   if (fault) {
@@ -0,0 +1,131 @@
+#include "way_partition.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+#include "util/bits.h"
+
+namespace
+{
+auto all_ways(std::size_t ways) { return champsim::way_partition::mask_type{champsim::bitmask(champsim::data::bits{ways})}; }
+} // namespace
+
+champsim::way_partition::way_partition(std::size_t sets, std::size_t ways, std::vector<mask_type> static_masks)
+    : num_sets(sets), num_ways(ways), interval(0), utility_based(false), masks(std::move(static_masks))
+{
+  if (num_ways > max_ways)
+    throw std::invalid_argument{"Way partitions are limited to 64 ways"};
+  for (auto m : masks) {
+    if ((m & all_ways(num_ways)) == 0)
+      throw std::invalid_argument{"Every way partition mask must include at least one way of the cache"};
+  }
+}
+
+champsim::way_partition::way_partition(std::size_t sets, std::size_t ways, uint64_t repartition_interval)
+    : num_sets(sets), num_ways(ways), interval(repartition_interval), utility_based(true), masks()
+{
+  if (num_ways > max_ways)
+    throw std::invalid_argument{"Way partitions are limited to 64 ways"};
+}
+
+bool champsim::way_partition::is_sampled(long set) const
+{
+  const auto stride = std::max<std::size_t>(num_sets / sampled_sets, 1);
+  return static_cast<std::size_t>(set) % stride == 0;
+}
+
+void champsim::way_partition::record_access(uint32_t cpu, long set, uint64_t block)
+{
+  if (!utility_based)
+    return;
+
+  if (is_sampled(set)) {
+    if (std::size(monitors) <= cpu)
+      monitors.resize(cpu + 1, {std::vector<std::vector<uint64_t>>(std::min(num_sets, sampled_sets)), std::vector<uint64_t>(num_ways)});
+
+    auto& mon = monitors.at(cpu);
+    const auto stride = std::max<std::size_t>(num_sets / sampled_sets, 1);
+    auto& stack = mon.stacks.at(static_cast<std::size_t>(set) / stride);
+
+    auto found = std::find(std::begin(stack), std::end(stack), block);
+    if (found != std::end(stack)) {
+      mon.hits.at(static_cast<std::size_t>(std::distance(std::begin(stack), found)))++;
+      stack.erase(found);
+    } else if (std::size(stack) == num_ways) {
+      stack.pop_back();
+    }
+    stack.insert(std::begin(stack), block);
+  }
+
+  if (++accesses >= interval) {
+    repartition();
+    accesses = 0;
+  }
+}
+
+void champsim::way_partition::repartition()
+{
+  const auto cpus = std::size(monitors);
+  ++repartition_count;
+
+  // Every core keeps at least one way, so a partition is only possible with more ways than cores
+  if (cpus == 0 || cpus > num_ways) {
+    masks.clear();
+    return;
+  }
+
+  // The hits that a core would have with the given number of ways
+  auto utility = [this](std::size_t cpu, std::size_t ways) {
+    const auto& hits = monitors.at(cpu).hits;
+    return std::accumulate(std::begin(hits), std::next(std::begin(hits), static_cast<long>(ways)), uint64_t{});
+  };
+
+  // The lookahead algorithm
+  std::vector<std::size_t> alloc(cpus, 1);
+  auto balance = num_ways - cpus;
+  while (balance > 0) {
+    double best_mu = -1;
+    std::size_t best_cpu = 0;
+    std::size_t best_ways = 1;
+    for (std::size_t cpu = 0; cpu < cpus; ++cpu) {
+      for (std::size_t extra = 1; extra <= balance; ++extra) {
+        const auto gain = utility(cpu, alloc[cpu] + extra) - utility(cpu, alloc[cpu]);
+        const auto mu = static_cast<double>(gain) / static_cast<double>(extra);
+        if (mu > best_mu) {
+          best_mu = mu;
+          best_cpu = cpu;
+          best_ways = extra;
+        }
+      }
+    }
+    alloc[best_cpu] += best_ways;
+    balance -= best_ways;
+  }
+
+  masks.resize(cpus);
+  std::size_t first_way = 0;
+  for (std::size_t cpu = 0; cpu < cpus; ++cpu) {
+    masks[cpu] = all_ways(alloc[cpu]) << first_way;
+    first_way += alloc[cpu];
+  }
+
+  for (auto& mon : monitors) {
+    for (auto& h : mon.hits)
+      h /= 2;
+  }
+}
+
+auto champsim::way_partition::mask(uint32_t cpu) const -> mask_type
+{
+  if (cpu < std::size(masks))
+    return masks[cpu];
+  return all_ways(num_ways);
+}
+
+std::vector<uint64_t> champsim::way_partition::allocation() const
+{
+  std::vector<uint64_t> retval{};
+  std::transform(std::begin(masks), std::end(masks), std::back_inserter(retval), [](auto m) { return static_cast<uint64_t>(champsim::popcount(m)); });
+  return retval;
+}
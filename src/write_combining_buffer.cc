@@ -0,0 +1,42 @@
+#include "write_combining_buffer.h"
+
+#include <algorithm>
+
+champsim::write_combining_buffer::write_combining_buffer(std::size_t size, champsim::data::bits offset) : capacity(size), offset_bits(offset) {}
+
+auto champsim::write_combining_buffer::add(const request_type& packet) -> add_result
+{
+  auto found = std::find_if(std::begin(entries), std::end(entries), [match = packet.address.slice_upper(offset_bits), shamt = offset_bits](const auto& entry) {
+    return entry.address.slice_upper(shamt) == match;
+  });
+
+  if (found != std::end(entries)) {
+    found->clean_victim = found->clean_victim && packet.clean_victim;
+    return add_result::COMBINED;
+  }
+
+  if (std::size(entries) >= capacity)
+    return add_result::FULL;
+
+  entries.push_back(packet);
+  return add_result::ADDED;
+}
+
+long champsim::write_combining_buffer::drain(champsim::channel& lower_level)
+{
+  long sent{0};
+  while (!std::empty(entries) && (2 * std::size(entries) > capacity || lower_level.wq_occupancy() == 0) && lower_level.add_wq(entries.front())) {
+    entries.pop_front();
+    ++sent;
+  }
+  return sent;
+}
+
+bool champsim::write_combining_buffer::contains(champsim::address address) const
+{
+  return std::any_of(std::begin(entries), std::end(entries), [match = address.slice_upper(offset_bits), shamt = offset_bits](const auto& entry) {
+    return entry.address.slice_upper(shamt) == match;
+  });
+}
+
+std::size_t champsim::write_combining_buffer::size() const { return std::size(entries); }
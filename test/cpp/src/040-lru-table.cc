@@ -290,3 +290,35 @@ TEMPLATE_TEST_CASE("A lru_table returns the evicted block on invalidation", "",
     }
   }
 }
+
+TEMPLATE_TEST_CASE("A lru_table returns the displaced block on fill", "",
+                   (champsim::lru_table<::strong_type<unsigned int>, ::strong_type_getter, ::strong_type_getter>), champsim::lru_table<::type_with_getters>)
+{
+  GIVEN("A lru_table with one element")
+  {
+    constexpr unsigned int data = 0xcafebabe;
+    TestType uut{1, 2};
+    auto first_result = uut.fill({data});
+
+    THEN("Filling an empty way displaces nothing") { REQUIRE_FALSE(first_result.has_value()); }
+
+    WHEN("We refill the same element")
+    {
+      auto result = uut.fill({data});
+
+      THEN("Nothing is displaced") { REQUIRE_FALSE(result.has_value()); }
+    }
+
+    WHEN("We fill enough elements to overflow the set")
+    {
+      uut.fill({data + 1});
+      auto result = uut.fill({data + 2});
+
+      THEN("The returned value is the least-recently-used block")
+      {
+        REQUIRE(result.has_value());
+        REQUIRE(result.value().value == data);
+      }
+    }
+  }
+}
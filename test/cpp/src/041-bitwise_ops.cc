@@ -33,6 +33,21 @@ TEST_CASE("bitmask correctly produces lower-order bits")
   REQUIRE(std::bitset<64>{champsim::bitmask(champsim::data::bits{i})}.count() == i);
 }
 
+TEST_CASE("popcount counts the set bits")
+{
+  auto i = GENERATE(range(0u, 64u));
+  REQUIRE(champsim::popcount(champsim::bitmask(champsim::data::bits{i})) == static_cast<int>(i));
+  REQUIRE(champsim::popcount(1ull << i) == 1);
+}
+
+TEST_CASE("countr_zero finds the lowest set bit")
+{
+  auto i = GENERATE(range(0u, 64u));
+  REQUIRE(champsim::countr_zero(1ull << i) == static_cast<int>(i));
+  REQUIRE(champsim::countr_zero(~0ull << i) == static_cast<int>(i));
+  REQUIRE(champsim::countr_zero(0ull) == 64);
+}
+
 TEMPLATE_TEST_CASE("is_power_of_2 correctly identifies powers", "", char, unsigned char, short, unsigned short, int, unsigned int, long, unsigned long)
 {
   auto shamt = GENERATE(range(2, std::numeric_limits<TestType>::digits - 1));
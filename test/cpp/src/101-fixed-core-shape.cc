@@ -0,0 +1,119 @@
+#include <catch.hpp>
+
+#include "bandwidth.h"
+#include "champsim.h"
+#include "fixed_core.h"
+#include "instr.h"
+#include "mocks.hpp"
+#include "ooo_cpu.h"
+#include "operable.h"
+
+namespace
+{
+constexpr auto test_shape = champsim::core_builder{}
+                                .ifetch_buffer_size(16)
+                                .decode_buffer_size(16)
+                                .dispatch_buffer_size(16)
+                                .register_file_size(128)
+                                .rob_size(16)
+                                .decode_latency(2)
+                                .dispatch_latency(1)
+                                .schedule_latency(1)
+                                .execute_latency(3)
+                                .execute_width(champsim::bandwidth::maximum_type{2})
+                                .decode_width(champsim::bandwidth::maximum_type{2})
+                                .dispatch_width(champsim::bandwidth::maximum_type{2})
+                                .fetch_width(champsim::bandwidth::maximum_type{2})
+                                .retire_width(champsim::bandwidth::maximum_type{2});
+
+constexpr auto no_dib_shape = champsim::core_builder{test_shape}.dib_way(0);
+
+template <typename CPU>
+long cycles_to_retire(CPU& uut, do_nothing_MRC& mock_L1I, do_nothing_MRC& mock_L1D, std::size_t num_instrs)
+{
+  // Instructions issued in the same cycle must be distinguishable by their IDs
+  for (std::size_t i = 0; i < num_instrs; ++i) {
+    uut.IFETCH_BUFFER.push_back(champsim::test::instruction_with_ip(1));
+    uut.IFETCH_BUFFER.back().instr_id = static_cast<uint64_t>(uut.num_retired) + i;
+  }
+
+  const auto target = uut.num_retired + static_cast<long long>(num_instrs);
+  long cycles = 0;
+  for (; uut.num_retired < target && cycles < 1000; ++cycles) {
+    for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+      op->_operate();
+  }
+  return cycles;
+}
+} // namespace
+
+SCENARIO("A core with a compile-time shape takes the same time as a runtime-sized core")
+{
+  GIVEN("A runtime-sized core and a fixed core built from the same builder")
+  {
+    const auto num_instrs = GENERATE(1u, 2u, 5u, 12u);
+    do_nothing_MRC dyn_L1I, dyn_L1D, fixed_L1I, fixed_L1D;
+
+    O3_CPU dynamic_uut{champsim::core_builder{test_shape}.fetch_queues(&dyn_L1I.queues).data_queues(&dyn_L1D.queues)};
+    champsim::fixed_core<test_shape> fixed_uut{champsim::core_builder{test_shape}.fetch_queues(&fixed_L1I.queues).data_queues(&fixed_L1D.queues)};
+    dynamic_uut.warmup = false;
+    fixed_uut.warmup = false;
+
+    WHEN("The same instructions are added to both cores")
+    {
+      auto dynamic_cycles = cycles_to_retire(dynamic_uut, dyn_L1I, dyn_L1D, num_instrs);
+      auto fixed_cycles = cycles_to_retire(fixed_uut, fixed_L1I, fixed_L1D, num_instrs);
+
+      THEN("All instructions retire in both cores")
+      {
+        REQUIRE(dynamic_uut.num_retired == static_cast<long long>(num_instrs));
+        REQUIRE(fixed_uut.num_retired == static_cast<long long>(num_instrs));
+      }
+
+      THEN("The cores take the same number of cycles") { REQUIRE(fixed_cycles == dynamic_cycles); }
+    }
+  }
+}
+
+SCENARIO("The shape of a fixed core is a constant expression")
+{
+  using shape = champsim::fixed_core<test_shape>::shape_type;
+  STATIC_REQUIRE(shape::ROB_SIZE == 16);
+  STATIC_REQUIRE(shape::FETCH_WIDTH == champsim::bandwidth::maximum_type{2});
+  STATIC_REQUIRE(shape::DECODE_LATENCY == 2 * test_shape.m_clock_period);
+  STATIC_REQUIRE(shape::DIB_ENABLED);
+  STATIC_REQUIRE_FALSE(champsim::fixed_core<no_dib_shape>::shape_type::DIB_ENABLED);
+}
+
+SCENARIO("A fixed core without DIB ways never consults the DIB")
+{
+  GIVEN("A fixed core whose DIB has ways")
+  {
+    do_nothing_MRC mock_L1I, mock_L1D;
+    champsim::fixed_core<test_shape> uut{champsim::core_builder{test_shape}.fetch_queues(&mock_L1I.queues).data_queues(&mock_L1D.queues)};
+    uut.warmup = false;
+
+    WHEN("The same instruction is fetched twice")
+    {
+      cycles_to_retire(uut, mock_L1I, mock_L1D, 1);
+      cycles_to_retire(uut, mock_L1I, mock_L1D, 1);
+
+      THEN("The second instruction hits in the DIB") { REQUIRE(std::size(mock_L1I.addresses) == 1); }
+    }
+  }
+
+  GIVEN("A fixed core whose DIB has no ways")
+  {
+    do_nothing_MRC mock_L1I, mock_L1D;
+    champsim::fixed_core<no_dib_shape> uut{champsim::core_builder{no_dib_shape}.fetch_queues(&mock_L1I.queues).data_queues(&mock_L1D.queues)};
+    uut.warmup = false;
+
+    WHEN("The same instruction is fetched twice")
+    {
+      cycles_to_retire(uut, mock_L1I, mock_L1D, 1);
+      cycles_to_retire(uut, mock_L1I, mock_L1D, 1);
+
+      THEN("Every instruction was fetched from the L1I") { REQUIRE(std::size(mock_L1I.addresses) == 2); }
+    }
+  }
+}
@@ -0,0 +1,163 @@
+#include <catch.hpp>
+
+#include "../../../btb/multi_level_btb/multi_level_btb.h"
+#include "cache.h"
+#include "instr.h"
+#include "instruction.h"
+#include "mocks.hpp"
+#include "ooo_cpu.h"
+
+namespace
+{
+/*
+ * A BTB that always predicts the correct target from its last level, after a fixed number of bubble cycles
+ */
+template <long Bubbles>
+struct fixed_latency_btb : champsim::modules::btb {
+  using btb::btb;
+
+  champsim::address next_target{};
+
+  prediction btb_prediction(champsim::address) { return {next_target, true, Bubbles, 2}; }
+  void update_btb(champsim::address, champsim::address branch_target, bool, uint8_t) { next_target = branch_target; }
+};
+
+template <long Bubbles>
+std::pair<long, O3_CPU::stats_type> cycles_to_fetch_after_taken_branch()
+{
+  do_nothing_MRC mock_L1I, mock_L1D;
+  CACHE l1i{champsim::cache_builder{}.name("L1I")}; // receives the branch operations for its prefetcher
+  O3_CPU uut{champsim::core_builder{}
+                 .fetch_queues(&mock_L1I.queues)
+                 .data_queues(&mock_L1D.queues)
+                 .l1i(&l1i)
+                 .fetch_width(champsim::bandwidth::maximum_type{2})
+                 .ifetch_buffer_size(2)
+                 .btb<fixed_latency_btb<Bubbles>>()};
+  uut.warmup = false;
+
+  auto branch = champsim::test::branch_instruction_with_ip(0x1000);
+  branch.branch_target = champsim::address{0x2000};
+  branch.instr_id = 1;
+  auto target = champsim::test::instruction_with_ip(0x2000);
+  target.instr_id = 2;
+
+  // Train the BTB so that the branch target is predicted correctly
+  uut.impl_update_btb(branch.ip, branch.branch_target, true, branch.branch);
+
+  uut.input_queue.push_back(branch);
+  uut.input_queue.push_back(target);
+
+  long cycles = 0;
+  for (; cycles < 100 && !std::empty(uut.input_queue); ++cycles) {
+    for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+      op->_operate();
+  }
+
+  return {cycles, uut.sim_stats};
+}
+} // namespace
+
+TEST_CASE("The multi_level_btb does not predict unknown branches")
+{
+  multi_level_btb uut;
+  auto result = uut.btb_prediction(champsim::address{0x110000});
+
+  CHECK(result.target == champsim::address{});
+  CHECK_FALSE(result.level.has_value());
+}
+
+TEST_CASE("The multi_level_btb reports the level that provided the target")
+{
+  multi_level_btb uut;
+  const champsim::address test_ip{0x110000};
+  const champsim::address fake_target{0x66b5f0};
+  uut.update_btb(test_ip, fake_target, true, BRANCH_DIRECT_JUMP);
+
+  auto first = uut.btb_prediction(test_ip);
+  CHECK(first.target == fake_target);
+  CHECK(first.always_taken);
+  CHECK(first.level == std::optional<std::size_t>{0});
+  CHECK(first.bubbles == multi_level_btb::default_level_configs.at(0).latency);
+
+  // Displace the branch from the L0 BTB, without displacing it from the L1 BTB
+  for (uint64_t i = 1; i <= multi_level_btb::default_level_configs.at(0).ways; ++i)
+    uut.update_btb(test_ip + static_cast<long>(4 * i), fake_target, true, BRANCH_DIRECT_JUMP);
+
+  auto second = uut.btb_prediction(test_ip);
+  CHECK(second.target == fake_target);
+  CHECK(second.level == std::optional<std::size_t>{1});
+  CHECK(second.bubbles == multi_level_btb::default_level_configs.at(1).latency);
+
+  // The hit promoted the branch back into the L0 BTB
+  auto third = uut.btb_prediction(test_ip);
+  CHECK(third.level == std::optional<std::size_t>{0});
+}
+
+TEST_CASE("The multi_level_btb takes its levels from the core configuration")
+{
+  do_nothing_MRC mock_L1I, mock_L1D;
+  O3_CPU cpu{champsim::core_builder{}.fetch_queues(&mock_L1I.queues).data_queues(&mock_L1D.queues).btb_level(1, 2, 0).btb_level(4, 2, 5)};
+  REQUIRE(std::size(cpu.BTB_LEVELS) == 2);
+
+  multi_level_btb uut{&cpu};
+  const champsim::address test_ip{0x110000};
+  const champsim::address fake_target{0x66b5f0};
+  uut.update_btb(test_ip, fake_target, true, BRANCH_DIRECT_JUMP);
+
+  // Displace the branch from the two-entry L0 BTB
+  for (uint64_t i = 1; i <= 2; ++i)
+    uut.update_btb(test_ip + static_cast<long>(4 * i), fake_target, true, BRANCH_DIRECT_JUMP);
+
+  auto result = uut.btb_prediction(test_ip);
+  CHECK(result.target == fake_target);
+  CHECK(result.level == std::optional<std::size_t>{1});
+  CHECK(result.bubbles == 5);
+}
+
+TEST_CASE("The multi_level_btb predicts indirect targets that are correlated with history")
+{
+  multi_level_btb uut;
+  const champsim::address cond_ip{0x400000};
+  const champsim::address indirect_ip{0x400100};
+  const std::array<champsim::address, 2> targets{{champsim::address{0x500000}, champsim::address{0x600000}}};
+
+  // The indirect branch's target follows the direction of the preceding conditional branch
+  long correct = 0;
+  for (int i = 0; i < 200; ++i) {
+    bool taken = (i % 2 == 0);
+    uut.update_btb(cond_ip, champsim::address{0x400040}, taken, BRANCH_CONDITIONAL);
+
+    auto actual = targets.at(taken ? 0 : 1);
+    if (i >= 100 && uut.btb_prediction(indirect_ip).target == actual)
+      ++correct;
+    uut.update_btb(indirect_ip, actual, true, BRANCH_INDIRECT);
+  }
+
+  CHECK(correct == 100);
+}
+
+TEST_CASE("The multi_level_btb predicts returns from its return address stack")
+{
+  multi_level_btb uut;
+  const champsim::address call_ip{0x400000};
+  const champsim::address return_ip{0x500000};
+
+  uut.update_btb(call_ip, champsim::address{0x500000}, true, BRANCH_DIRECT_CALL);
+  uut.update_btb(return_ip, call_ip + 4, true, BRANCH_RETURN);
+
+  uut.update_btb(call_ip, champsim::address{0x500000}, true, BRANCH_DIRECT_CALL);
+  CHECK(uut.btb_prediction(return_ip).target == call_ip + 4);
+}
+
+TEST_CASE("BTB bubbles delay fetch after a correctly predicted taken branch")
+{
+  auto [base_cycles, base_stats] = cycles_to_fetch_after_taken_branch<0>();
+  auto [slow_cycles, slow_stats] = cycles_to_fetch_after_taken_branch<3>();
+
+  CHECK(slow_cycles == base_cycles + 3);
+  CHECK(base_stats.btb_bubble_cycles == 0);
+  CHECK(slow_stats.btb_bubble_cycles == 3);
+  CHECK(slow_stats.btb_lookups == 1);
+  CHECK(slow_stats.btb_level_hits.value_or(2, 0) == 1);
+}
@@ -0,0 +1,138 @@
+#include <catch.hpp>
+#include <deque>
+
+#include "instr.h"
+#include "register_allocator.h"
+
+namespace
+{
+std::deque<ooo_model_instr> dependent_chain(std::size_t length)
+{
+  std::deque<ooo_model_instr> instrs{};
+  for (std::size_t i = 0; i < length; ++i) {
+    auto instr = champsim::test::instruction_with_ip(i);
+    instr.instr_id = i;
+    instr.source_registers.push_back(static_cast<PHYSICAL_REGISTER_ID>(i % 16));
+    instr.destination_registers.push_back(static_cast<PHYSICAL_REGISTER_ID>((i + 1) % 16));
+    instrs.push_back(instr);
+  }
+  return instrs;
+}
+} // namespace
+
+SCENARIO("The register allocator tracks free registers across word boundaries")
+{
+  auto num_regs = GENERATE(as<std::size_t>{}, 1, 63, 64, 65, 128, 200);
+
+  GIVEN("An empty register file with " + std::to_string(num_regs) + " registers")
+  {
+    RegisterAllocator ra{num_regs};
+
+    THEN("All registers are free") { REQUIRE(ra.count_free_registers() == num_regs); }
+
+    WHEN("Every register is allocated")
+    {
+      std::vector<PHYSICAL_REGISTER_ID> allocated{};
+      for (std::size_t i = 0; i < num_regs; ++i)
+        allocated.push_back(ra.rename_dest_register(static_cast<int16_t>(i % 256), i));
+
+      THEN("No registers are free") { REQUIRE(ra.count_free_registers() == 0); }
+
+      THEN("Every register was allocated once")
+      {
+        std::sort(std::begin(allocated), std::end(allocated));
+        REQUIRE(std::adjacent_find(std::begin(allocated), std::end(allocated)) == std::end(allocated));
+        REQUIRE(allocated.front() == 0);
+        REQUIRE(allocated.back() == static_cast<PHYSICAL_REGISTER_ID>(num_regs - 1));
+      }
+
+      AND_WHEN("The last register is freed")
+      {
+        ra.free_register(static_cast<PHYSICAL_REGISTER_ID>(num_regs - 1));
+
+        THEN("It is allocated next") { REQUIRE(ra.rename_dest_register(0, 0) == static_cast<PHYSICAL_REGISTER_ID>(num_regs - 1)); }
+      }
+    }
+  }
+}
+
+SCENARIO("A group of instructions is renamed at once")
+{
+  GIVEN("A chain of dependent instructions")
+  {
+    auto instrs = dependent_chain(8);
+
+    WHEN("The whole group is renamed")
+    {
+      RegisterAllocator ra{128};
+      auto renamed_end = ra.rename_group(std::begin(instrs), std::end(instrs), [](const auto&) { return true; });
+
+      THEN("Every instruction is renamed") { REQUIRE(renamed_end == std::end(instrs)); }
+
+      THEN("Each instruction reads the register written by its predecessor")
+      {
+        for (std::size_t i = 1; i < std::size(instrs); ++i)
+          REQUIRE(instrs.at(i).source_registers.front() == instrs.at(i - 1).destination_registers.front());
+      }
+
+      THEN("The renaming is the same as renaming each instruction in turn")
+      {
+        RegisterAllocator serial_ra{128};
+        auto serial_instrs = dependent_chain(8);
+        for (auto& instr : serial_instrs)
+          serial_ra.rename(instr);
+
+        for (std::size_t i = 0; i < std::size(instrs); ++i) {
+          REQUIRE(instrs.at(i).source_registers == serial_instrs.at(i).source_registers);
+          REQUIRE(instrs.at(i).destination_registers == serial_instrs.at(i).destination_registers);
+        }
+      }
+    }
+
+    WHEN("The register file cannot hold the whole group")
+    {
+      RegisterAllocator ra{4};
+      auto renamed_end = ra.rename_group(std::begin(instrs), std::end(instrs), [](const auto&) { return true; });
+
+      THEN("Renaming stops at the first instruction that does not fit")
+      {
+        // The first instruction allocates its source and destination, and each later one allocates only its destination
+        REQUIRE(std::distance(std::begin(instrs), renamed_end) == 3);
+        REQUIRE(ra.count_free_registers() == 0);
+      }
+    }
+
+    WHEN("Only some instructions satisfy the predicate")
+    {
+      RegisterAllocator ra{128};
+      auto renamed_end = ra.rename_group(std::begin(instrs), std::end(instrs), [](const auto& x) { return x.instr_id % 2 == 0; });
+
+      THEN("The others are not renamed")
+      {
+        REQUIRE(renamed_end == std::end(instrs));
+        // Since the instructions between them were not renamed, each renamed instruction allocates both its source and its destination
+        REQUIRE(ra.count_free_registers() == 128 - 8);
+      }
+    }
+  }
+}
+
+TEST_CASE("Register allocator benchmarks")
+{
+  constexpr std::size_t group_size = 128;
+
+  BENCHMARK_ADVANCED("RegisterAllocator::rename_group()")(Catch::Benchmark::Chronometer meter)
+  {
+    std::vector<RegisterAllocator> allocators(static_cast<std::size_t>(meter.runs()), RegisterAllocator{512});
+    std::vector<std::deque<ooo_model_instr>> groups(static_cast<std::size_t>(meter.runs()), dependent_chain(group_size));
+    meter.measure([&](int i) {
+      return allocators.at(i).rename_group(std::begin(groups.at(i)), std::end(groups.at(i)), [](const auto&) { return true; }) == std::end(groups.at(i));
+    });
+  };
+
+  BENCHMARK_ADVANCED("RegisterAllocator::count_free_registers()")(Catch::Benchmark::Chronometer meter)
+  {
+    RegisterAllocator ra{512};
+    meter.measure([&] { return ra.count_free_registers(); });
+  };
+}
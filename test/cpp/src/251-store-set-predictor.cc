@@ -0,0 +1,135 @@
+#include <catch.hpp>
+
+#include "store_set.h"
+
+SCENARIO("A disabled store set predictor never predicts a dependence")
+{
+  GIVEN("A predictor with no SSIT entries")
+  {
+    champsim::store_set_predictor uut{0, 8};
+
+    WHEN("A load and a store are trained together")
+    {
+      uut.train_violation(champsim::address{0x100}, champsim::address{0x200});
+      uut.dispatch_store(champsim::address{0x200}, 1);
+
+      THEN("The load is not predicted to depend on the store")
+      {
+        REQUIRE_FALSE(uut.enabled());
+        REQUIRE_FALSE(uut.predict_load(champsim::address{0x100}).has_value());
+      }
+    }
+  }
+}
+
+SCENARIO("The store set predictor learns from violations")
+{
+  GIVEN("An untrained predictor")
+  {
+    champsim::store_set_predictor uut{16, 8};
+    const champsim::address load_ip{0x100};
+    const champsim::address store_ip{0x201};
+
+    WHEN("A store is dispatched")
+    {
+      uut.dispatch_store(store_ip, 1);
+
+      THEN("A load is not predicted to depend on it") { REQUIRE_FALSE(uut.predict_load(load_ip).has_value()); }
+    }
+
+    AND_GIVEN("A violation between the load and the store")
+    {
+      uut.train_violation(load_ip, store_ip);
+
+      WHEN("The store is dispatched")
+      {
+        uut.dispatch_store(store_ip, 5);
+
+        THEN("The load is predicted to depend on it") { REQUIRE(uut.predict_load(load_ip) == std::optional<uint64_t>{5}); }
+
+        AND_WHEN("The store executes")
+        {
+          uut.execute_store(store_ip, 5);
+
+          THEN("The load is no longer predicted to wait") { REQUIRE_FALSE(uut.predict_load(load_ip).has_value()); }
+        }
+
+        AND_WHEN("A younger store in the same set is dispatched")
+        {
+          uut.dispatch_store(store_ip, 7);
+
+          THEN("The load is predicted to depend on the younger store") { REQUIRE(uut.predict_load(load_ip) == std::optional<uint64_t>{7}); }
+
+          AND_WHEN("The older store executes")
+          {
+            uut.execute_store(store_ip, 5);
+
+            THEN("The load still waits on the younger store") { REQUIRE(uut.predict_load(load_ip) == std::optional<uint64_t>{7}); }
+          }
+        }
+
+        AND_WHEN("The predictor is cleared")
+        {
+          uut.clear();
+
+          THEN("The load is not predicted to depend on the store") { REQUIRE_FALSE(uut.predict_load(load_ip).has_value()); }
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("Store sets merge when their members violate")
+{
+  GIVEN("Two loads that each violated with a different store")
+  {
+    champsim::store_set_predictor uut{16, 16};
+    const champsim::address load_a{0x100}, store_a{0x103};
+    const champsim::address load_b{0x105}, store_b{0x10a};
+    uut.train_violation(load_a, store_a);
+    uut.train_violation(load_b, store_b);
+
+    WHEN("The first load violates with the second store")
+    {
+      uut.train_violation(load_a, store_b);
+
+      AND_WHEN("The second store is dispatched")
+      {
+        uut.dispatch_store(store_b, 9);
+
+        THEN("The first load is predicted to depend on it") { REQUIRE(uut.predict_load(load_a) == std::optional<uint64_t>{9}); }
+
+        AND_WHEN("The first store is dispatched")
+        {
+          uut.dispatch_store(store_a, 11);
+
+          THEN("The first load is predicted to depend on the youngest store in the merged set")
+          {
+            REQUIRE(uut.predict_load(load_a) == std::optional<uint64_t>{11});
+          }
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("The store set predictor is cleared periodically")
+{
+  GIVEN("A trained predictor with a short clearing interval")
+  {
+    champsim::store_set_predictor uut{16, 8, 4};
+    const champsim::address load_ip{0x100};
+    const champsim::address store_ip{0x201};
+    uut.train_violation(load_ip, store_ip);
+    uut.dispatch_store(store_ip, 5);
+
+    WHEN("The load is looked up until the interval passes")
+    {
+      std::optional<uint64_t> last_prediction{};
+      for (int i = 0; i < 4; ++i)
+        last_prediction = uut.predict_load(load_ip);
+
+      THEN("The store sets are forgotten") { REQUIRE_FALSE(last_prediction.has_value()); }
+    }
+  }
+}
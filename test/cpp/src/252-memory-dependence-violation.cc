@@ -0,0 +1,186 @@
+#include <catch.hpp>
+
+#include "instr.h"
+#include "mocks.hpp"
+#include "ooo_cpu.h"
+
+namespace
+{
+/*
+ * A store whose address depends on a slow load, followed by a load from the same address.
+ * The younger load is ready to issue long before the store executes.
+ */
+std::vector<ooo_model_instr> store_load_pair(uint64_t first_id, champsim::address addr)
+{
+  auto producer = champsim::test::instruction_with_ip_and_source_memory(champsim::address{0x1000}, champsim::address{0xdead0000});
+  producer.destination_registers.push_back(1);
+  producer.instr_id = first_id;
+
+  auto store = champsim::test::instruction_with_ip(0x1004);
+  store.source_registers.push_back(1);
+  store.destination_memory.push_back(addr);
+  store.instr_id = first_id + 1;
+
+  auto load = champsim::test::instruction_with_ip_and_source_memory(champsim::address{0x1008}, addr);
+  load.instr_id = first_id + 2;
+
+  return {producer, store, load};
+}
+
+void run_until_retired(O3_CPU& uut, do_nothing_MRC& mock_L1I, do_nothing_MRC& mock_L1D, long long target)
+{
+  for (int i = 0; i < 10000 && uut.num_retired < target; ++i) {
+    for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+      op->_operate();
+  }
+}
+} // namespace
+
+SCENARIO("A core without a memory dependence predictor never issues a load ahead of a store to the same address")
+{
+  GIVEN("A core with no store sets")
+  {
+    const champsim::address addr{0xcafe0000};
+    do_nothing_MRC mock_L1I, mock_L1D{50};
+    O3_CPU uut{champsim::core_builder{}
+                   .fetch_queues(&mock_L1I.queues)
+                   .data_queues(&mock_L1D.queues)
+                   .dispatch_width(champsim::bandwidth::maximum_type{3})
+                   .schedule_width(champsim::bandwidth::maximum_type{3})
+                   .execute_width(champsim::bandwidth::maximum_type{3})
+                   .retire_width(champsim::bandwidth::maximum_type{3})
+                   .register_file_size(128)
+                   .rob_size(8)
+                   .lq_size(4)
+                   .sq_size(4)};
+    uut.warmup = false;
+
+    WHEN("A load follows a slow store to the same address")
+    {
+      auto instrs = store_load_pair(1, addr);
+      for (auto& instr : instrs) {
+        instr.ready_time = champsim::chrono::clock::time_point{};
+        uut.DISPATCH_BUFFER.push_back(instr);
+      }
+      run_until_retired(uut, mock_L1I, mock_L1D, 3);
+
+      THEN("All instructions retire") { REQUIRE(uut.num_retired == 3); }
+
+      THEN("The load is forwarded from the store")
+      {
+        REQUIRE(std::count(std::begin(mock_L1D.addresses), std::end(mock_L1D.addresses), addr) == 1); // only the store's write
+        REQUIRE(uut.sim_stats.memory_order_violations == 0);
+      }
+    }
+  }
+}
+
+SCENARIO("A store set predictor learns to hold loads behind stores they have violated")
+{
+  GIVEN("A core with store sets")
+  {
+    const champsim::address addr{0xcafe0000};
+    do_nothing_MRC mock_L1I, mock_L1D{50};
+    O3_CPU uut{champsim::core_builder{}
+                   .fetch_queues(&mock_L1I.queues)
+                   .data_queues(&mock_L1D.queues)
+                   .dispatch_width(champsim::bandwidth::maximum_type{3})
+                   .schedule_width(champsim::bandwidth::maximum_type{3})
+                   .execute_width(champsim::bandwidth::maximum_type{3})
+                   .retire_width(champsim::bandwidth::maximum_type{3})
+                   .register_file_size(128)
+                   .rob_size(8)
+                   .lq_size(4)
+                   .sq_size(4)
+                   .ssit_size(16)
+                   .lfst_size(8)
+                   .memory_violation_penalty(20)};
+    uut.warmup = false;
+
+    WHEN("A load follows a slow store to the same address for the first time")
+    {
+      auto instrs = store_load_pair(1, addr);
+      for (auto& instr : instrs) {
+        instr.ready_time = champsim::chrono::clock::time_point{};
+        uut.DISPATCH_BUFFER.push_back(instr);
+      }
+      run_until_retired(uut, mock_L1I, mock_L1D, 3);
+
+      THEN("All instructions retire") { REQUIRE(uut.num_retired == 3); }
+
+      THEN("The load issues ahead of the store and is replayed")
+      {
+        REQUIRE(std::count(std::begin(mock_L1D.addresses), std::end(mock_L1D.addresses), addr) == 2); // the load's read and the store's write
+        REQUIRE(uut.sim_stats.memory_order_violations == 1);
+      }
+
+      AND_WHEN("The same instructions are seen again")
+      {
+        auto second_instrs = store_load_pair(4, addr);
+        for (auto& instr : second_instrs) {
+          instr.ready_time = uut.current_time;
+          uut.DISPATCH_BUFFER.push_back(instr);
+        }
+        run_until_retired(uut, mock_L1I, mock_L1D, 6);
+
+        THEN("All instructions retire") { REQUIRE(uut.num_retired == 6); }
+
+        THEN("The load waits for the store and is forwarded")
+        {
+          REQUIRE(std::count(std::begin(mock_L1D.addresses), std::end(mock_L1D.addresses), addr) == 3); // one more write, but no read
+          REQUIRE(uut.sim_stats.memory_order_violations == 1);
+          REQUIRE(uut.sim_stats.memory_dependences_predicted == 1);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("A load issued ahead of a store to the same address completes after the replay penalty")
+{
+  auto penalty = GENERATE(0u, 40u);
+
+  GIVEN("A core with store sets")
+  {
+    const champsim::address addr{0xcafe0000};
+    do_nothing_MRC mock_L1I, mock_L1D{50};
+    O3_CPU uut{champsim::core_builder{}
+                   .fetch_queues(&mock_L1I.queues)
+                   .data_queues(&mock_L1D.queues)
+                   .dispatch_width(champsim::bandwidth::maximum_type{3})
+                   .schedule_width(champsim::bandwidth::maximum_type{3})
+                   .execute_width(champsim::bandwidth::maximum_type{3})
+                   .retire_width(champsim::bandwidth::maximum_type{3})
+                   .register_file_size(128)
+                   .rob_size(8)
+                   .lq_size(4)
+                   .sq_size(4)
+                   .ssit_size(16)
+                   .lfst_size(8)
+                   .memory_violation_penalty(penalty)};
+    uut.warmup = false;
+
+    WHEN("A load violates a store")
+    {
+      auto instrs = store_load_pair(1, addr);
+      for (auto& instr : instrs) {
+        instr.ready_time = champsim::chrono::clock::time_point{};
+        uut.DISPATCH_BUFFER.push_back(instr);
+      }
+
+      auto start_time = uut.current_time;
+      run_until_retired(uut, mock_L1I, mock_L1D, 3);
+      auto elapsed_cycles = (uut.current_time - start_time) / uut.clock_period;
+
+      THEN("The penalty is added to the time to retire")
+      {
+        REQUIRE(uut.sim_stats.memory_order_violations == 1);
+        if (penalty > 0) {
+          REQUIRE(elapsed_cycles > 50 + penalty);
+        } else {
+          REQUIRE(elapsed_cycles < 50 + 40);
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,124 @@
+#include <catch.hpp>
+
+#include "instr.h"
+#include "mocks.hpp"
+#include "ooo_cpu.h"
+#include "store_buffer.h"
+
+namespace
+{
+champsim::channel::request_type store(champsim::address addr)
+{
+  champsim::channel::request_type pkt;
+  pkt.v_address = addr;
+  pkt.type = access_type::WRITE;
+  return pkt;
+}
+
+/*
+ * A run of stores, one to each word of a block, with no dependences between them
+ */
+std::vector<ooo_model_instr> streaming_stores(uint64_t first_id, champsim::address base)
+{
+  std::vector<ooo_model_instr> retval{};
+  for (uint64_t i = 0; i < BLOCK_SIZE / champsim::store_buffer::word_size; ++i) {
+    auto instr = champsim::test::instruction_with_ip(0x1000 + 4 * i);
+    instr.destination_memory.push_back(champsim::address{base.to<uint64_t>() + i * champsim::store_buffer::word_size});
+    instr.instr_id = first_id + i;
+    instr.ready_time = champsim::chrono::clock::time_point{};
+    retval.push_back(instr);
+  }
+  return retval;
+}
+} // namespace
+
+SCENARIO("The store buffer coalesces consecutive stores to the same block")
+{
+  GIVEN("A store buffer of four blocks")
+  {
+    const auto now = champsim::chrono::clock::time_point{};
+    champsim::store_buffer uut{4, champsim::data::bits{LOG2_BLOCK_SIZE}, champsim::chrono::clock::duration{16}};
+
+    WHEN("Two stores to the same block are added")
+    {
+      auto first = uut.add(store(champsim::address{0xdeadbe00}), now);
+      auto second = uut.add(store(champsim::address{0xdeadbe08}), now);
+
+      THEN("The second is coalesced into the entry of the first, which waits for more")
+      {
+        CHECK(first == champsim::store_buffer::add_result::ADDED);
+        CHECK(second == champsim::store_buffer::add_result::COALESCED);
+        CHECK(uut.size() == 1);
+        CHECK_FALSE(uut.ready(now));
+        CHECK_FALSE(uut.front().full_line);
+      }
+
+      THEN("The entry leaves once it has waited long enough") { CHECK(uut.ready(now + champsim::chrono::clock::duration{16})); }
+
+      AND_WHEN("A store to another block comes between them and a third store to the first block")
+      {
+        uut.add(store(champsim::address{0xcafeba00}), now);
+        auto third = uut.add(store(champsim::address{0xdeadbe10}), now);
+
+        THEN("The third store is not coalesced past the younger entry") { CHECK(third == champsim::store_buffer::add_result::ADDED); }
+      }
+    }
+
+    WHEN("Every word of a block is written")
+    {
+      for (uint64_t offset = 0; offset < BLOCK_SIZE; offset += champsim::store_buffer::word_size)
+        uut.add(store(champsim::address{0xdeadbe00 + offset}), now);
+
+      THEN("The entry leaves at once, as a full-line write")
+      {
+        CHECK(uut.ready(now));
+        CHECK(uut.front().full_line);
+      }
+    }
+  }
+}
+
+SCENARIO("A core with a store buffer writes a streaming block to the L1D once")
+{
+  GIVEN("A core with a store buffer")
+  {
+    const champsim::address base{0xcafe0000};
+    do_nothing_MRC mock_L1I;
+    champsim::channel l1d_queues{};
+    O3_CPU uut{champsim::core_builder{}
+                   .fetch_queues(&mock_L1I.queues)
+                   .data_queues(&l1d_queues)
+                   .dispatch_width(champsim::bandwidth::maximum_type{4})
+                   .schedule_width(champsim::bandwidth::maximum_type{4})
+                   .execute_width(champsim::bandwidth::maximum_type{4})
+                   .retire_width(champsim::bandwidth::maximum_type{4})
+                   .sq_width(champsim::bandwidth::maximum_type{2})
+                   .register_file_size(128)
+                   .rob_size(16)
+                   .lq_size(4)
+                   .sq_size(16)
+                   .store_buffer_size(4)};
+    uut.warmup = false;
+
+    WHEN("The core stores to every word of a block")
+    {
+      auto instrs = streaming_stores(1, base);
+      const auto count = static_cast<long long>(std::size(instrs));
+      for (auto& instr : instrs)
+        uut.DISPATCH_BUFFER.push_back(instr);
+      for (int i = 0; i < 1000 && (uut.num_retired < count || !std::empty(uut.SQ)); ++i) {
+        for (auto op : std::array<champsim::operable*, 2>{{&uut, &mock_L1I}})
+          op->_operate();
+      }
+
+      THEN("The stores reach the L1D as one full-line write")
+      {
+        REQUIRE(uut.num_retired == count);
+        REQUIRE(std::size(l1d_queues.WQ) == 1);
+        CHECK(l1d_queues.WQ.front().full_line);
+        CHECK(uut.sim_stats.stores_coalesced == std::size(instrs) - 1);
+        CHECK(uut.sim_stats.full_line_stores == 1);
+      }
+    }
+  }
+}
@@ -0,0 +1,107 @@
+#include <catch.hpp>
+#include <sstream>
+
+#include "instr.h"
+#include "mocks.hpp"
+#include "ooo_cpu.h"
+
+namespace
+{
+void run_until_retired(O3_CPU& uut, do_nothing_MRC& mock_L1I, do_nothing_MRC& mock_L1D, long long target)
+{
+  for (int i = 0; i < 10000 && uut.num_retired < target; ++i) {
+    for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+      op->_operate();
+  }
+}
+} // namespace
+
+SCENARIO("A core with nothing to do is stalled on the front end")
+{
+  GIVEN("An empty core")
+  {
+    do_nothing_MRC mock_L1I, mock_L1D;
+    O3_CPU uut{champsim::core_builder{}.fetch_queues(&mock_L1I.queues).data_queues(&mock_L1D.queues)};
+    uut.warmup = false;
+
+    WHEN("The core operates for some cycles")
+    {
+      constexpr long cycles = 10;
+      for (long i = 0; i < cycles; ++i)
+        uut._operate();
+
+      THEN("Every cycle is a front end stall")
+      {
+        REQUIRE(uut.sim_stats.retire_stall_cycles.value_or(stall_type::FRONTEND, 0) == cycles);
+        REQUIRE(uut.sim_stats.retire_stall_cycles.total() == cycles);
+      }
+    }
+  }
+}
+
+SCENARIO("Cycles spent waiting on a load at the head of the ROB are attributed to memory")
+{
+  GIVEN("A core with a slow data cache")
+  {
+    constexpr int latency = 50;
+    do_nothing_MRC mock_L1I, mock_L1D{latency};
+    O3_CPU uut{champsim::core_builder{}.fetch_queues(&mock_L1I.queues).data_queues(&mock_L1D.queues).register_file_size(128).rob_size(8).lq_size(4)};
+    uut.warmup = false;
+
+    WHEN("A load is the only instruction")
+    {
+      auto load = champsim::test::instruction_with_ip_and_source_memory(champsim::address{0x1000}, champsim::address{0xdead0000});
+      load.instr_id = 1;
+      uut.DISPATCH_BUFFER.push_back(load);
+      run_until_retired(uut, mock_L1I, mock_L1D, 1);
+
+      THEN("The instruction retires") { REQUIRE(uut.num_retired == 1); }
+
+      THEN("The wait for the load is attributed to the first level")
+      {
+        // The mock data cache does not report missing, so its responses appear to hit
+        REQUIRE(uut.sim_stats.retire_stall_cycles.value_or(stall_type::L1, 0) >= latency);
+        REQUIRE(uut.sim_stats.retire_stall_cycles.value_or(stall_type::DRAM, 0) == 0);
+      }
+
+      THEN("Time before the load issues is attributed to the core") { REQUIRE(uut.sim_stats.retire_stall_cycles.value_or(stall_type::CORE, 0) > 0); }
+    }
+  }
+}
+
+SCENARIO("The pipeline trace records sampled instructions in O3PipeView format")
+{
+  auto [interval, expected_lines] = GENERATE(table<uint64_t, std::size_t>({{1, 4 * 7}, {2, 2 * 7}}));
+
+  GIVEN("A core with a pipeline trace")
+  {
+    do_nothing_MRC mock_L1I, mock_L1D;
+    O3_CPU uut{champsim::core_builder{}.fetch_queues(&mock_L1I.queues).data_queues(&mock_L1D.queues).register_file_size(128).rob_size(16)};
+    uut.warmup = false;
+
+    std::ostringstream trace{};
+    uut.pipeline_trace.emplace(trace, interval, 1);
+
+    WHEN("Instructions pass through the pipeline")
+    {
+      for (uint64_t id = 0; id < 4; ++id) {
+        auto instr = champsim::test::instruction_with_ip(0x1000 + 4 * id);
+        instr.instr_id = id;
+        uut.IFETCH_BUFFER.push_back(instr);
+      }
+      run_until_retired(uut, mock_L1I, mock_L1D, 4);
+
+      THEN("Each sampled instruction is written")
+      {
+        std::vector<std::string> lines{};
+        std::istringstream reader{trace.str()};
+        for (std::string line; std::getline(reader, line);)
+          lines.push_back(line);
+
+        REQUIRE(std::size(lines) == expected_lines);
+        REQUIRE(lines.front().rfind("O3PipeView:fetch:", 0) == 0);
+        REQUIRE(lines.back().rfind("O3PipeView:retire:", 0) == 0);
+      }
+    }
+  }
+}
@@ -0,0 +1,179 @@
+#include <catch.hpp>
+
+#include "cache.h"
+#include "coherence_directory.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+
+namespace
+{
+void run(long cycles, const std::array<champsim::operable*, 6>& elements)
+{
+  for (long i = 0; i < cycles; ++i)
+    for (auto elem : elements)
+      elem->_operate();
+}
+
+champsim::channel::request_type request(champsim::address addr, access_type type, uint32_t cpu, uint64_t instr_id)
+{
+  champsim::channel::request_type pkt;
+  pkt.address = addr;
+  pkt.v_address = addr;
+  pkt.type = type;
+  pkt.instr_id = instr_id;
+  pkt.cpu = cpu;
+  return pkt;
+}
+} // namespace
+
+SCENARIO("The coherence directory tracks the sharers and owner of a block")
+{
+  GIVEN("An empty directory")
+  {
+    champsim::coherence_directory uut{1, 2};
+
+    WHEN("A block is read by one requester")
+    {
+      auto result = uut.access(0x100, 0, false);
+
+      THEN("Nothing is invalidated or downgraded")
+      {
+        CHECK(result.invalidate == 0);
+        CHECK(result.downgrade == 0);
+        CHECK_FALSE(result.coherence_miss);
+      }
+
+      AND_WHEN("Another requester reads the block")
+      {
+        auto second = uut.access(0x100, 1, false);
+
+        THEN("The exclusive owner is downgraded") { CHECK(second.downgrade == 0b01); }
+      }
+
+      AND_WHEN("Another requester writes the block, and then the first reads it again")
+      {
+        auto second = uut.access(0x100, 1, true);
+        auto third = uut.access(0x100, 0, false);
+
+        THEN("The first requester is invalidated, and its next read is a coherence miss")
+        {
+          CHECK(second.invalidate == 0b01);
+          CHECK(third.coherence_miss);
+          CHECK(third.downgrade == 0b10);
+        }
+      }
+    }
+
+    WHEN("More blocks are tracked than the directory holds")
+    {
+      uut.access(0x100, 0, false);
+      uut.access(0x101, 1, false);
+      auto result = uut.access(0x102, 0, false);
+
+      THEN("The sharers of the replaced entry are reported")
+      {
+        REQUIRE(result.evicted_block.has_value());
+        CHECK(result.evicted_block.value() == 0x100);
+        CHECK(result.evicted_sharers == 0b01);
+      }
+    }
+  }
+}
+
+SCENARIO("A shared cache with a directory keeps the private caches above it coherent")
+{
+  GIVEN("Two private caches above a shared cache with a directory")
+  {
+    do_nothing_MRC mock_ll;
+    champsim::channel middle0{};
+    champsim::channel middle1{};
+    to_rq_MRP mock_ul0;
+    to_rq_MRP mock_ul1;
+    CACHE core0{champsim::cache_builder{champsim::defaults::default_l1d}.name("409-core0").upper_levels({&mock_ul0.queues}).lower_level(&middle0)};
+    CACHE core1{champsim::cache_builder{champsim::defaults::default_l1d}.name("409-core1").upper_levels({&mock_ul1.queues}).lower_level(&middle1)};
+    CACHE shared{champsim::cache_builder{champsim::defaults::default_llc}
+                     .name("409-shared")
+                     .directory_sets(64)
+                     .upper_levels({&middle0, &middle1})
+                     .lower_level(&mock_ll.queues)};
+
+    std::array<champsim::operable*, 6> elements{{&core0, &core1, &shared, &mock_ll, &mock_ul0, &mock_ul1}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    const champsim::address addr_a{0xdeadbe40};
+    const champsim::address addr_b{0xcafebac0};
+
+    WHEN("One core reads a block, and then the other writes it")
+    {
+      REQUIRE(mock_ul0.issue(request(addr_a, access_type::LOAD, 0, 1)));
+      run(100, elements);
+      REQUIRE(mock_ul1.issue(request(addr_a, access_type::RFO, 1, 2)));
+      run(100, elements);
+
+      THEN("The reader's copy is invalidated")
+      {
+        CHECK(shared.sim_stats.coherence_invalidations == 1);
+        CHECK(core0.sim_stats.back_invalidated == 1);
+        CHECK(core0.lookup_way(addr_a) == core0.NUM_WAY);
+        CHECK(core1.lookup_way(addr_a) < core1.NUM_WAY);
+      }
+
+      AND_WHEN("The first core reads the block again")
+      {
+        REQUIRE(mock_ul0.issue(request(addr_a, access_type::LOAD, 0, 3)));
+        run(100, elements);
+
+        THEN("The miss is counted as a coherence miss, and the writer is downgraded")
+        {
+          CHECK(shared.sim_stats.coherence_misses == 1);
+          CHECK(shared.sim_stats.coherence_downgrades == 1);
+        }
+      }
+    }
+
+    WHEN("Both cores read a block, and then one of them stores to it")
+    {
+      REQUIRE(mock_ul0.issue(request(addr_a, access_type::LOAD, 0, 1)));
+      REQUIRE(mock_ul1.issue(request(addr_a, access_type::LOAD, 1, 2)));
+      run(100, elements);
+      REQUIRE(mock_ul0.issue(request(addr_a, access_type::RFO, 0, 3)));
+      run(100, elements);
+
+      THEN("The store hits, and its upgrade invalidates the other copy")
+      {
+        CHECK(core0.sim_stats.coherence_upgrades == 1);
+        CHECK(shared.sim_stats.coherence_invalidations == 1);
+        CHECK(core0.lookup_way(addr_a) < core0.NUM_WAY);
+        CHECK(core1.lookup_way(addr_a) == core1.NUM_WAY);
+      }
+
+      AND_WHEN("The core stores to the block again")
+      {
+        REQUIRE(mock_ul0.issue(request(addr_a, access_type::RFO, 0, 4)));
+        run(100, elements);
+
+        THEN("The block is already owned, so no upgrade is sent") { CHECK(core0.sim_stats.coherence_upgrades == 1); }
+      }
+    }
+
+    WHEN("One core writes a block, and then the other reads it")
+    {
+      REQUIRE(mock_ul0.issue(request(addr_b, access_type::RFO, 0, 1)));
+      run(100, elements);
+      REQUIRE(mock_ul1.issue(request(addr_b, access_type::LOAD, 1, 2)));
+      run(100, elements);
+
+      THEN("The writer is downgraded, and both cores keep a copy")
+      {
+        CHECK(shared.sim_stats.coherence_downgrades == 1);
+        CHECK(shared.sim_stats.coherence_invalidations == 0);
+        CHECK(core0.lookup_way(addr_b) < core0.NUM_WAY);
+        CHECK(core1.lookup_way(addr_b) < core1.NUM_WAY);
+      }
+    }
+  }
+}
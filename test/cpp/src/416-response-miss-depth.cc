@@ -0,0 +1,61 @@
+#include <catch.hpp>
+
+#include "cache.h"
+#include "channel.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+
+SCENARIO("A response records how many caches missed before it was serviced")
+{
+  GIVEN("A two-level cache hierarchy")
+  {
+    do_nothing_MRC mock_ll{5};
+    champsim::channel upper_channel{};
+    champsim::channel middle_channel{};
+    CACHE lower{champsim::cache_builder{champsim::defaults::default_l2c}.name("416-lower").upper_levels({&middle_channel}).lower_level(&mock_ll.queues)};
+    CACHE upper{champsim::cache_builder{champsim::defaults::default_l1d}.name("416-upper").upper_levels({&upper_channel}).lower_level(&middle_channel)};
+
+    std::array<champsim::operable*, 3> elements{{&upper, &lower, &mock_ll}};
+
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    auto issue_and_wait = [&](champsim::address addr) {
+      champsim::channel::request_type test;
+      test.address = addr;
+      test.v_address = addr;
+      test.cpu = 0;
+      test.type = access_type::LOAD;
+      REQUIRE(upper_channel.add_rq(test));
+
+      for (int i = 0; i < 200 && std::empty(upper_channel.returned); ++i) {
+        for (auto elem : elements)
+          elem->_operate();
+      }
+
+      REQUIRE(std::size(upper_channel.returned) == 1);
+      auto response = upper_channel.returned.front();
+      upper_channel.returned.clear();
+      return response;
+    };
+
+    WHEN("A packet misses both caches")
+    {
+      auto response = issue_and_wait(champsim::address{0xdeadbeef});
+
+      THEN("The response missed two caches") { REQUIRE(response.miss_depth == 2); }
+
+      THEN("The response did not require a page walk") { REQUIRE_FALSE(response.page_walked); }
+
+      AND_WHEN("The same packet is issued again")
+      {
+        auto second_response = issue_and_wait(champsim::address{0xdeadbeef});
+
+        THEN("The response hit in the first cache") { REQUIRE(second_response.miss_depth == 0); }
+      }
+    }
+  }
+}
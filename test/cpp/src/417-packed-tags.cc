@@ -0,0 +1,127 @@
+#include <catch.hpp>
+#include <vector>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+#include "tag_store.h"
+
+SCENARIO("The packed tag store finds valid tags")
+{
+  auto allow_simd = GENERATE(true, false);
+  auto ways = GENERATE(as<std::size_t>{}, 1, 4, 11, 16, 64);
+  GIVEN("An empty tag store with " + std::to_string(ways) + " ways")
+  {
+    champsim::tag_store uut{4, ways, allow_simd};
+
+    THEN("Nothing is found, and every way is invalid")
+    {
+      CHECK_FALSE(uut.find(1, 0).has_value());
+      CHECK(uut.find_invalid(1) == std::optional<std::size_t>{0});
+    }
+
+    WHEN("Every way of a set is filled")
+    {
+      for (std::size_t way = 0; way < ways; ++way)
+        uut.insert(1, way, 0x100 + way);
+
+      THEN("Each tag is found in its way")
+      {
+        for (std::size_t way = 0; way < ways; ++way)
+          CHECK(uut.find(1, 0x100 + way) == std::optional<std::size_t>{way});
+      }
+
+      THEN("No way is invalid") { CHECK_FALSE(uut.find_invalid(1).has_value()); }
+      THEN("The other sets are unaffected") { CHECK_FALSE(uut.find(2, 0x100).has_value()); }
+
+      AND_WHEN("The last way is erased")
+      {
+        uut.erase(1, ways - 1);
+
+        THEN("Its tag is no longer found, and it is the invalid way")
+        {
+          CHECK_FALSE(uut.find(1, 0x100 + ways - 1).has_value());
+          CHECK(uut.find_invalid(1) == std::optional<std::size_t>{ways - 1});
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("The packed tag store rejects sets with more than 64 ways")
+{
+  CHECK_THROWS_AS(champsim::tag_store(1, 65), std::invalid_argument);
+}
+
+SCENARIO("A cache with packed tags behaves the same as a cache without them")
+{
+  auto packed = GENERATE(true, false);
+  GIVEN("A small cache " + std::string{packed ? "with" : "without"} + " packed tags")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    auto builder = champsim::cache_builder{champsim::defaults::default_l2c}
+                       .name("417-uut")
+                       .sets(4)
+                       .ways(8)
+                       .upper_levels({&mock_ul.queues})
+                       .lower_level(&mock_ll.queues);
+    if (packed)
+      builder.set_packed_tags();
+    CACHE uut{builder};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("A stream of loads that overflows the cache is sent")
+    {
+      uint64_t lcg = 1;
+      for (uint64_t id = 1; id <= 200; ++id) {
+        lcg = lcg * 6364136223846793005ULL + 1442695040888963407ULL;
+        to_rq_MRP::request_type pkt;
+        pkt.address = champsim::address{champsim::block_number{(lcg >> 33) % 64}};
+        pkt.v_address = pkt.address;
+        pkt.instr_id = id;
+        pkt.cpu = 0;
+        REQUIRE(mock_ul.issue(pkt));
+        for (int i = 0; i < 20; ++i)
+          for (auto elem : elements)
+            elem->_operate();
+      }
+
+      THEN("The hits and misses match those of the unpacked lookup")
+      {
+        // Recorded from the cache without packed tags
+        CHECK(uut.sim_stats.hits.total() == 92);
+        CHECK(uut.sim_stats.misses.total() == 108);
+      }
+
+      THEN("Each block is found in the same way as by a search of the set")
+      {
+        for (uint64_t blk = 0; blk < 64; ++blk) {
+          champsim::address addr{champsim::block_number{blk}};
+          auto set_begin = std::next(std::cbegin(uut.block), static_cast<long>((blk % uut.NUM_SET) * uut.NUM_WAY));
+          auto set_end = std::next(set_begin, uut.NUM_WAY);
+          auto found = std::find_if(set_begin, set_end, [addr](const auto& x) { return x.valid && x.address == addr; });
+          CHECK(uut.lookup_way(addr) == std::distance(set_begin, found));
+        }
+      }
+
+      AND_WHEN("A resident block is invalidated")
+      {
+        champsim::address addr{};
+        for (uint64_t blk = 1; blk < 64 && addr == champsim::address{}; ++blk) {
+          if (uut.lookup_way(champsim::address{champsim::block_number{blk}}) < uut.NUM_WAY)
+            addr = champsim::address{champsim::block_number{blk}};
+        }
+        uut.invalidate_entry(addr);
+
+        THEN("It is no longer found") { CHECK(uut.lookup_way(addr) == uut.NUM_WAY); }
+      }
+    }
+  }
+}
@@ -0,0 +1,55 @@
+#include <catch.hpp>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+
+/*
+ * The cost of a tag lookup in a full last-level cache, with and without packed tags. The reciprocal of the mean is the cache's
+ * throughput in lookups per second.
+ */
+TEST_CASE("tag lookup throughput")
+{
+  auto packed = GENERATE(false, true);
+  do_nothing_MRC mock_ll;
+  to_wq_MRP mock_ul;
+  auto builder =
+      champsim::cache_builder{champsim::defaults::default_llc}.name("418-uut").sets(256).upper_levels({&mock_ul.queues}).lower_level(&mock_ll.queues);
+  if (packed)
+    builder.set_packed_tags();
+  CACHE uut{builder};
+
+  std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+  for (auto elem : elements) {
+    elem->initialize();
+    elem->warmup = false;
+    elem->begin_phase();
+  }
+
+  // Fill every way with writes, which allocate without a read from the lower level
+  const uint64_t blocks = uint64_t{uut.NUM_SET} * uut.NUM_WAY;
+  for (uint64_t blk = 0; blk < blocks;) {
+    to_wq_MRP::request_type pkt;
+    pkt.address = champsim::address{champsim::block_number{blk}};
+    pkt.type = access_type::WRITE;
+    pkt.cpu = 0;
+    if (mock_ul.issue(pkt))
+      ++blk;
+    for (auto elem : elements)
+      elem->_operate();
+  }
+
+  // Half of the lookups hit, at every position in the set
+  std::vector<champsim::address> lookups{};
+  uint64_t lcg = 1;
+  for (uint64_t i = 0; i < 16384; ++i) {
+    lcg = lcg * 6364136223846793005ULL + 1442695040888963407ULL;
+    lookups.emplace_back(champsim::block_number{(lcg >> 33) % (2 * blocks)});
+  }
+
+  BENCHMARK_ADVANCED(packed ? "lookups with packed tags" : "lookups in the blocks")(Catch::Benchmark::Chronometer meter)
+  {
+    meter.measure([&](int i) { return uut.lookup_way(lookups.at(static_cast<std::size_t>(i) % std::size(lookups))); });
+  };
+  SUCCEED();
+}
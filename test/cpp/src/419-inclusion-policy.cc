@@ -0,0 +1,166 @@
+#include <catch.hpp>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+
+namespace
+{
+void run(long cycles, const std::array<champsim::operable*, 4>& elements)
+{
+  for (long i = 0; i < cycles; ++i)
+    for (auto elem : elements)
+      elem->_operate();
+}
+
+champsim::channel::request_type load(champsim::address addr, uint64_t instr_id)
+{
+  champsim::channel::request_type pkt;
+  pkt.address = addr;
+  pkt.v_address = addr;
+  pkt.type = access_type::LOAD;
+  pkt.instr_id = instr_id;
+  pkt.cpu = 0;
+  return pkt;
+}
+} // namespace
+
+SCENARIO("An inclusive cache invalidates the blocks it evicts from the caches above")
+{
+  auto policy = GENERATE(champsim::inclusion_policy::INCLUSIVE, champsim::inclusion_policy::NINE);
+  const bool inclusive = (policy == champsim::inclusion_policy::INCLUSIVE);
+  GIVEN("A two-way upper cache above " + std::string{inclusive ? "an inclusive" : "a non-inclusive"} + " one-way lower cache")
+  {
+    do_nothing_MRC mock_ll;
+    champsim::channel middle{};
+    to_rq_MRP mock_ul;
+    CACHE upper{champsim::cache_builder{champsim::defaults::default_l1d}
+                    .name("419-upper")
+                    .sets(1)
+                    .ways(2)
+                    .upper_levels({&mock_ul.queues})
+                    .lower_level(&middle)};
+    CACHE lower{champsim::cache_builder{champsim::defaults::default_l2c}
+                    .name("419-lower")
+                    .sets(1)
+                    .ways(1)
+                    .inclusion(policy)
+                    .upper_levels({&middle})
+                    .lower_level(&mock_ll.queues)};
+
+    std::array<champsim::operable*, 4> elements{{&upper, &lower, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    const champsim::address addr_a{0xdeadbe40};
+    const champsim::address addr_b{0xcafebac0};
+
+    WHEN("Two blocks are loaded, so that the lower cache evicts the first")
+    {
+      REQUIRE(mock_ul.issue(load(addr_a, 1)));
+      run(50, elements);
+      REQUIRE(mock_ul.issue(load(addr_b, 2)));
+      run(50, elements);
+
+      THEN("Both blocks reach the upper cache") { CHECK(std::size(mock_ul.packets) == 2); }
+
+      if (inclusive) {
+        THEN("The first block is invalidated in the upper cache")
+        {
+          CHECK(lower.sim_stats.back_invalidations == 1);
+          CHECK(upper.sim_stats.back_invalidated == 1);
+          CHECK(upper.lookup_way(addr_a) == upper.NUM_WAY);
+          CHECK(upper.lookup_way(addr_b) < upper.NUM_WAY);
+        }
+      } else {
+        THEN("The upper cache keeps the first block")
+        {
+          CHECK(lower.sim_stats.back_invalidations == 0);
+          CHECK(upper.sim_stats.back_invalidated == 0);
+          CHECK(upper.lookup_way(addr_a) < upper.NUM_WAY);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("An exclusive cache holds only the blocks evicted from the caches above")
+{
+  GIVEN("A one-way upper cache above an exclusive four-way lower cache")
+  {
+    do_nothing_MRC mock_ll;
+    champsim::channel middle{};
+    to_rq_MRP mock_ul;
+    CACHE upper{champsim::cache_builder{champsim::defaults::default_l1d}
+                    .name("419-upper")
+                    .sets(1)
+                    .ways(1)
+                    .upper_levels({&mock_ul.queues})
+                    .lower_level(&middle)};
+    CACHE lower{champsim::cache_builder{champsim::defaults::default_l2c}
+                    .name("419-lower")
+                    .sets(1)
+                    .ways(4)
+                    .inclusion(champsim::inclusion_policy::EXCLUSIVE)
+                    .upper_levels({&middle})
+                    .lower_level(&mock_ll.queues)};
+
+    std::array<champsim::operable*, 4> elements{{&upper, &lower, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    const champsim::address addr_a{0xdeadbe40};
+    const champsim::address addr_b{0xcafebac0};
+
+    WHEN("A block is loaded")
+    {
+      REQUIRE(mock_ul.issue(load(addr_a, 1)));
+      run(50, elements);
+
+      THEN("It is filled above, but not in the exclusive cache")
+      {
+        CHECK(upper.lookup_way(addr_a) < upper.NUM_WAY);
+        CHECK(lower.lookup_way(addr_a) == lower.NUM_WAY);
+      }
+
+      AND_WHEN("Another block evicts it from the upper cache")
+      {
+        REQUIRE(mock_ul.issue(load(addr_b, 2)));
+        run(50, elements);
+
+        THEN("The evicted block is filled into the exclusive cache, clean")
+        {
+          CHECK(lower.sim_stats.victim_fills == 1);
+          CHECK(lower.lookup_way(addr_a) < lower.NUM_WAY);
+          CHECK(upper.lookup_way(addr_a) == upper.NUM_WAY);
+        }
+
+        AND_WHEN("The evicted block is loaded again")
+        {
+          const auto misses_before = std::size(mock_ll.addresses);
+          REQUIRE(mock_ul.issue(load(addr_a, 3)));
+          run(50, elements);
+
+          THEN("It hits in the exclusive cache, and moves up")
+          {
+            CHECK(std::size(mock_ll.addresses) == misses_before);
+            CHECK(upper.lookup_way(addr_a) < upper.NUM_WAY);
+            CHECK(lower.lookup_way(addr_a) == lower.NUM_WAY);
+          }
+
+          THEN("The block it displaced above is filled into the exclusive cache")
+          {
+            CHECK(lower.sim_stats.victim_fills == 2);
+            CHECK(lower.lookup_way(addr_b) < lower.NUM_WAY);
+          }
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,209 @@
+#include <catch.hpp>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+
+namespace
+{
+struct next_block_prefetcher : champsim::modules::prefetcher {
+  using prefetcher::prefetcher;
+
+  uint32_t prefetcher_cache_operate(champsim::address addr, champsim::address, uint8_t, bool, access_type type, uint32_t metadata_in)
+  {
+    if (type != access_type::PREFETCH)
+      prefetch_line(champsim::address{addr.to<uint64_t>() + BLOCK_SIZE}, true, metadata_in);
+    return metadata_in;
+  }
+};
+
+struct far_block_prefetcher : champsim::modules::prefetcher {
+  using prefetcher::prefetcher;
+
+  uint32_t prefetcher_cache_operate(champsim::address addr, champsim::address, uint8_t, bool, access_type type, uint32_t metadata_in)
+  {
+    if (type != access_type::PREFETCH)
+      prefetch_line(champsim::address{addr.to<uint64_t>() + 8 * BLOCK_SIZE}, true, metadata_in);
+    return metadata_in;
+  }
+};
+
+void run(long cycles, const std::array<champsim::operable*, 3>& elements)
+{
+  for (long i = 0; i < cycles; ++i)
+    for (auto elem : elements)
+      elem->_operate();
+}
+
+champsim::channel::request_type load(champsim::address addr, uint64_t instr_id)
+{
+  champsim::channel::request_type pkt;
+  pkt.address = addr;
+  pkt.v_address = addr;
+  pkt.type = access_type::LOAD;
+  pkt.instr_id = instr_id;
+  pkt.cpu = 0;
+  return pkt;
+}
+} // namespace
+
+SCENARIO("A prefetch that is filled before the demand is timely")
+{
+  GIVEN("A cache with a filled prefetch")
+  {
+    do_nothing_MRC mock_ll{10};
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l1d}.name("427-uut").upper_levels({&mock_ul.queues}).lower_level(&mock_ll.queues)};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    const champsim::address pf_addr{0xdeadbe40};
+    REQUIRE(uut.prefetch_line(pf_addr, true, 0));
+    run(50, elements);
+
+    WHEN("A demand hits the prefetched block")
+    {
+      REQUIRE(mock_ul.issue(load(pf_addr, 1)));
+      run(20, elements);
+
+      THEN("The prefetch is counted as useful and timely")
+      {
+        CHECK(uut.sim_stats.pf_useful == 1);
+        CHECK(uut.sim_stats.pf_timely == 1);
+        CHECK(uut.sim_stats.pf_late == 0);
+        CHECK(uut.sim_stats.pf_early == 0);
+      }
+
+      THEN("The distance from fill to use is recorded") { CHECK(uut.sim_stats.pf_fill_to_use.total() == 1); }
+    }
+  }
+}
+
+SCENARIO("A prefetch that is still in flight when the demand arrives is late")
+{
+  GIVEN("A cache with an outstanding prefetch")
+  {
+    do_nothing_MRC mock_ll{100};
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l1d}.name("427-uut").upper_levels({&mock_ul.queues}).lower_level(&mock_ll.queues)};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    const champsim::address pf_addr{0xdeadbe40};
+    REQUIRE(uut.prefetch_line(pf_addr, true, 0));
+    run(10, elements);
+    REQUIRE(std::size(uut.MSHR) == 1);
+
+    WHEN("A demand merges with the prefetch")
+    {
+      REQUIRE(mock_ul.issue(load(pf_addr, 1)));
+      run(200, elements);
+
+      THEN("The prefetch is counted as useful and late")
+      {
+        CHECK(uut.sim_stats.pf_useful == 1);
+        CHECK(uut.sim_stats.pf_timely == 0);
+        CHECK(uut.sim_stats.pf_late == 1);
+      }
+
+      THEN("No fill-to-use distance is recorded") { CHECK(uut.sim_stats.pf_fill_to_use.total() == 0); }
+    }
+  }
+}
+
+SCENARIO("A prefetch that is evicted before the demand arrives is early")
+{
+  GIVEN("A single-block cache with a filled prefetch")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l1d}
+                  .name("427-uut")
+                  .sets(1)
+                  .ways(1)
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    const champsim::address pf_addr{0xdeadbe40};
+    REQUIRE(uut.prefetch_line(pf_addr, true, 0));
+    run(20, elements);
+
+    WHEN("Another block evicts the prefetch, and then the prefetched block is demanded")
+    {
+      REQUIRE(mock_ul.issue(load(champsim::address{0xcafebac0}, 1)));
+      run(20, elements);
+      REQUIRE(mock_ul.issue(load(pf_addr, 2)));
+      run(20, elements);
+
+      THEN("The prefetch is counted as useless and early")
+      {
+        CHECK(uut.sim_stats.pf_useless == 1);
+        CHECK(uut.sim_stats.pf_early == 1);
+        CHECK(uut.sim_stats.pf_useful == 0);
+      }
+    }
+  }
+}
+
+SCENARIO("Prefetches are attributed to the module that issued them")
+{
+  GIVEN("A cache with two prefetchers")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l1d}
+                  .name("427-uut")
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)
+                  .prefetcher<::next_block_prefetcher, ::far_block_prefetcher>()};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    THEN("Each module has a named entry")
+    {
+      REQUIRE(std::size(uut.sim_stats.pf_sources) == 2);
+      CHECK_THAT(uut.sim_stats.pf_sources.at(0).name, Catch::Contains("next_block_prefetcher"));
+      CHECK_THAT(uut.sim_stats.pf_sources.at(1).name, Catch::Contains("far_block_prefetcher"));
+    }
+
+    WHEN("A demand triggers both prefetchers, and then hits the next block")
+    {
+      const champsim::address demand_addr{0xdeadbe40};
+      REQUIRE(mock_ul.issue(load(demand_addr, 1)));
+      run(20, elements);
+      REQUIRE(mock_ul.issue(load(champsim::address{demand_addr.to<uint64_t>() + BLOCK_SIZE}, 2)));
+      run(20, elements);
+
+      THEN("Each module is credited with its own prefetches")
+      {
+        REQUIRE(std::size(uut.sim_stats.pf_sources) == 2);
+        CHECK(uut.sim_stats.pf_sources.at(0).issued == 2);
+        CHECK(uut.sim_stats.pf_sources.at(1).issued == 2);
+        CHECK(uut.sim_stats.pf_sources.at(0).useful == 1);
+        CHECK(uut.sim_stats.pf_sources.at(1).useful == 0);
+      }
+    }
+  }
+}
@@ -0,0 +1,151 @@
+#include <catch.hpp>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+
+namespace
+{
+void run(long cycles, const std::array<champsim::operable*, 3>& elements)
+{
+  for (long i = 0; i < cycles; ++i)
+    for (auto elem : elements)
+      elem->_operate();
+}
+} // namespace
+
+SCENARIO("A cache without a prefetch filter queues duplicate prefetches")
+{
+  GIVEN("A cache without a prefetch filter")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l1d}.name("428-uut").upper_levels({&mock_ul.queues}).lower_level(&mock_ll.queues)};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("The same block is prefetched twice")
+    {
+      const champsim::address pf_addr{0xdeadbe40};
+      CHECK(uut.prefetch_line(pf_addr, true, 0));
+      CHECK(uut.prefetch_line(pf_addr, true, 0));
+
+      THEN("Both prefetches are issued")
+      {
+        CHECK(uut.sim_stats.pf_issued == 2);
+        CHECK(uut.sim_stats.pf_filtered_duplicate == 0);
+      }
+    }
+  }
+}
+
+SCENARIO("The prefetch filter drops redundant prefetches")
+{
+  GIVEN("A small cache with a prefetch filter")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l1d}
+                  .name("428-uut")
+                  .sets(1)
+                  .ways(1)
+                  .prefetch_filter_sets(4)
+                  .prefetch_filter_ways(2)
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    const champsim::address pf_addr{0xdeadbe40};
+
+    WHEN("The same block is prefetched twice before it is filled")
+    {
+      CHECK(uut.prefetch_line(pf_addr, true, 0));
+      for (long i = 0; i < 20 && std::empty(uut.MSHR); ++i)
+        run(1, elements);
+      REQUIRE_FALSE(std::empty(uut.MSHR));
+
+      CHECK(uut.prefetch_line(champsim::address{pf_addr.to<uint64_t>() + 4}, true, 0));
+      run(20, elements);
+
+      THEN("The second prefetch is dropped as a duplicate")
+      {
+        CHECK(uut.sim_stats.pf_requested == 2);
+        CHECK(uut.sim_stats.pf_issued == 1);
+        CHECK(uut.sim_stats.pf_filtered_duplicate == 1);
+        CHECK(std::size(mock_ll.addresses) == 1);
+      }
+    }
+
+    WHEN("A block that is in the cache is prefetched")
+    {
+      decltype(mock_ul)::request_type pkt;
+      pkt.address = pf_addr;
+      pkt.v_address = pf_addr;
+      pkt.type = access_type::LOAD;
+      pkt.cpu = 0;
+      REQUIRE(mock_ul.issue(pkt));
+      run(20, elements);
+
+      CHECK(uut.prefetch_line(pf_addr, true, 0));
+
+      THEN("The prefetch is dropped as resident")
+      {
+        CHECK(uut.sim_stats.pf_issued == 0);
+        CHECK(uut.sim_stats.pf_filtered_resident == 1);
+      }
+    }
+
+    WHEN("The same block is prefetched twice in the same cycle")
+    {
+      CHECK(uut.prefetch_line(pf_addr, true, 0));
+      CHECK(uut.prefetch_line(pf_addr, true, 0));
+      run(20, elements);
+
+      THEN("Both prefetches are queued, but only one is sent to the lower level")
+      {
+        CHECK(uut.sim_stats.pf_issued == 2);
+        CHECK(std::size(mock_ll.addresses) == 1);
+      }
+    }
+
+    WHEN("A prefetch does not fill this level")
+    {
+      CHECK(uut.prefetch_line(pf_addr, false, 0));
+      run(20, elements);
+      CHECK(uut.prefetch_line(pf_addr, true, 0));
+
+      THEN("A later prefetch for the block is not filtered")
+      {
+        CHECK(uut.sim_stats.pf_issued == 2);
+        CHECK(uut.sim_stats.pf_filtered_duplicate == 0);
+      }
+    }
+
+    WHEN("A prefetched block is evicted, and then prefetched again")
+    {
+      CHECK(uut.prefetch_line(pf_addr, true, 0));
+      run(20, elements);
+      CHECK(uut.prefetch_line(champsim::address{0xcafebac0}, true, 0));
+      run(20, elements);
+      CHECK(uut.prefetch_line(pf_addr, true, 0));
+
+      THEN("The evicted block is prefetched again")
+      {
+        CHECK(uut.sim_stats.pf_issued == 3);
+        CHECK(uut.sim_stats.pf_filtered_duplicate == 0);
+        CHECK(uut.sim_stats.pf_filtered_resident == 0);
+      }
+    }
+  }
+}
@@ -0,0 +1,219 @@
+#include <catch.hpp>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+#include "prefetch_throttle.h"
+
+namespace
+{
+unsigned observed_degree = 0;
+
+struct eight_block_prefetcher : champsim::modules::prefetcher {
+  using prefetcher::prefetcher;
+
+  uint32_t prefetcher_cache_operate(champsim::address addr, champsim::address, uint8_t, bool, access_type type, uint32_t metadata_in)
+  {
+    observed_degree = recommended_degree(8);
+    if (type != access_type::PREFETCH) {
+      for (uint64_t i = 1; i <= 8; ++i)
+        prefetch_line(champsim::address{addr.to<uint64_t>() + i * BLOCK_SIZE}, true, metadata_in);
+    }
+    return metadata_in;
+  }
+};
+
+void end_interval(champsim::prefetch_throttle& uut, uint64_t interval)
+{
+  for (uint64_t i = 0; i < interval; ++i)
+    uut.record_eviction();
+}
+} // namespace
+
+SCENARIO("The prefetch throttle starts at a moderate level")
+{
+  champsim::prefetch_throttle uut{};
+  CHECK(uut.level() == champsim::prefetch_throttle::initial_level);
+  CHECK(uut.degree() == champsim::prefetch_throttle::levels.at(champsim::prefetch_throttle::initial_level).degree);
+  CHECK(uut.distance() == champsim::prefetch_throttle::levels.at(champsim::prefetch_throttle::initial_level).distance);
+}
+
+SCENARIO("The prefetch throttle adjusts its level at the end of each interval")
+{
+  GIVEN("A prefetch throttle with a short interval")
+  {
+    constexpr uint64_t interval = 16;
+    champsim::prefetch_throttle uut{interval};
+
+    WHEN("Accurate prefetches arrive late")
+    {
+      for (int i = 0; i < 10; ++i) {
+        uut.record_issue();
+        uut.record_use(true);
+      }
+
+      THEN("The level does not change before the interval ends")
+      {
+        end_interval(uut, interval - 1);
+        CHECK(uut.level() == champsim::prefetch_throttle::initial_level);
+      }
+
+      THEN("The throttle becomes more aggressive")
+      {
+        end_interval(uut, interval);
+        CHECK(uut.level() == champsim::prefetch_throttle::initial_level + 1);
+        CHECK(uut.accuracy() > champsim::prefetch_throttle::accuracy_high);
+        CHECK(uut.lateness() > champsim::prefetch_throttle::lateness_threshold);
+      }
+    }
+
+    WHEN("Accurate prefetches arrive on time")
+    {
+      for (int i = 0; i < 10; ++i) {
+        uut.record_issue();
+        uut.record_use(false);
+      }
+      end_interval(uut, interval);
+
+      THEN("The level does not change") { CHECK(uut.level() == champsim::prefetch_throttle::initial_level); }
+    }
+
+    WHEN("Inaccurate prefetches pollute the cache")
+    {
+      for (int i = 0; i < 10; ++i) {
+        uut.record_issue();
+        uut.record_demand_miss(true);
+      }
+      end_interval(uut, interval);
+
+      THEN("The throttle becomes less aggressive")
+      {
+        CHECK(uut.level() == champsim::prefetch_throttle::initial_level - 1);
+        CHECK(uut.pollution() > champsim::prefetch_throttle::pollution_threshold);
+      }
+    }
+
+    WHEN("The level is lowered many times")
+    {
+      for (std::size_t i = 0; i < 2 * std::size(champsim::prefetch_throttle::levels); ++i) {
+        uut.record_issue();
+        uut.record_demand_miss(true);
+        end_interval(uut, interval);
+      }
+
+      THEN("It stops at the most conservative level") { CHECK(uut.level() == 0); }
+    }
+  }
+}
+
+SCENARIO("The prefetch throttle is conservative while DRAM bandwidth is scarce")
+{
+  GIVEN("A prefetch throttle at an aggressive level")
+  {
+    constexpr uint64_t interval = 16;
+    champsim::prefetch_throttle uut{interval};
+    uut.record_issue();
+    uut.record_use(true);
+    end_interval(uut, interval);
+    REQUIRE(uut.degree() > champsim::prefetch_throttle::levels.front().degree);
+
+    WHEN("The DRAM bandwidth is high")
+    {
+      uut.record_bandwidth(champsim::prefetch_throttle::high_bandwidth_bucket);
+
+      THEN("The most conservative degree is recommended")
+      {
+        CHECK(uut.bandwidth_limited());
+        CHECK(uut.degree() == champsim::prefetch_throttle::levels.front().degree);
+      }
+    }
+  }
+}
+
+SCENARIO("A throttled cache limits the prefetches of each activation")
+{
+  GIVEN("A cache with a prefetcher that issues eight prefetches per access")
+  {
+    auto [throttled, expected_degree] = GENERATE(table<bool, unsigned>(
+        {std::tuple{false, 8u}, std::tuple{true, champsim::prefetch_throttle::levels.at(champsim::prefetch_throttle::initial_level).degree}}));
+
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    auto builder = champsim::cache_builder{champsim::defaults::default_l1d}
+                       .name("429-uut")
+                       .upper_levels({&mock_ul.queues})
+                       .lower_level(&mock_ll.queues)
+                       .prefetcher<::eight_block_prefetcher>();
+    if (throttled)
+      builder.set_prefetch_throttle();
+    CACHE uut{builder};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("A demand activates the prefetcher")
+    {
+      decltype(mock_ul)::request_type pkt;
+      pkt.address = champsim::address{0xdeadbe40};
+      pkt.v_address = pkt.address;
+      pkt.type = access_type::LOAD;
+      pkt.cpu = 0;
+      REQUIRE(mock_ul.issue(pkt));
+
+      for (int i = 0; i < 10; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("The prefetcher is told the recommended degree") { CHECK(::observed_degree == expected_degree); }
+
+      THEN("Only the recommended degree of prefetches is issued")
+      {
+        CHECK(uut.sim_stats.pf_issued == expected_degree);
+        CHECK(uut.sim_stats.pf_throttled == 8 - expected_degree);
+      }
+    }
+  }
+}
+
+SCENARIO("Prefetches that are not triggered by an access are clamped per cycle")
+{
+  GIVEN("A throttled cache")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l1d}
+                  .name("429-uut")
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)
+                  .set_prefetch_throttle()};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    const auto degree = champsim::prefetch_throttle::levels.at(champsim::prefetch_throttle::initial_level).degree;
+
+    WHEN("More prefetches than the degree are requested directly")
+    {
+      for (uint64_t i = 1; i <= degree + 1; ++i)
+        uut.prefetch_line(champsim::address{0xdeadbe40 + i * BLOCK_SIZE}, true, 0);
+
+      THEN("The excess prefetch is throttled") { CHECK(uut.sim_stats.pf_throttled == 1); }
+
+      AND_WHEN("The cache operates for a cycle")
+      {
+        for (auto elem : elements)
+          elem->_operate();
+
+        THEN("Prefetches are accepted again") { CHECK(uut.prefetch_line(champsim::address{0xcafebac0}, true, 0)); }
+      }
+    }
+  }
+}
@@ -0,0 +1,233 @@
+#include <catch.hpp>
+#include <map>
+#include <vector>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+#include "prefetch_ensemble.h"
+
+namespace
+{
+std::map<uint32_t, std::vector<uint32_t>> fill_metadata{};
+std::map<uint32_t, std::vector<uint32_t>> operate_metadata{};
+std::map<uint32_t, int> useful_hits{};
+
+// Prefetches the two blocks after the demand that belong to this module, tagged with the module's own metadata
+template <uint32_t id>
+struct tagged_prefetcher : champsim::modules::prefetcher {
+  using prefetcher::prefetcher;
+
+  uint32_t prefetcher_cache_operate(champsim::address addr, champsim::address, uint8_t, bool useful_prefetch, access_type type, uint32_t metadata_in)
+  {
+    operate_metadata[id].push_back(metadata_in);
+    if (useful_prefetch)
+      ++useful_hits[id];
+    if (type != access_type::PREFETCH) {
+      for (uint64_t i = 1; i <= 2; ++i)
+        prefetch_line(champsim::address{addr.to<uint64_t>() + (2 * id + i) * BLOCK_SIZE}, true, id + 5);
+    }
+    return id + 1;
+  }
+
+  uint32_t prefetcher_cache_fill(champsim::address, long, long, uint8_t, champsim::address, uint32_t metadata_in)
+  {
+    fill_metadata[id].push_back(metadata_in);
+    return metadata_in;
+  }
+};
+
+void run(long cycles, const std::array<champsim::operable*, 3>& elements)
+{
+  for (long i = 0; i < cycles; ++i)
+    for (auto elem : elements)
+      elem->_operate();
+}
+
+champsim::channel::request_type load(champsim::address addr, uint64_t instr_id)
+{
+  champsim::channel::request_type pkt;
+  pkt.address = addr;
+  pkt.v_address = addr;
+  pkt.type = access_type::LOAD;
+  pkt.instr_id = instr_id;
+  pkt.cpu = 0;
+  return pkt;
+}
+} // namespace
+
+TEST_CASE("A lone prefetcher owns all of the metadata")
+{
+  CHECK(champsim::metadata_slice_width(1) == 32);
+  CHECK(champsim::get_metadata_slice(0xdeadbeef, 0, 1) == 0xdeadbeef);
+  CHECK(champsim::set_metadata_slice(0xdeadbeef, 0xcafebabe, 0, 1) == 0xcafebabe);
+}
+
+TEST_CASE("Each prefetcher in an ensemble owns a slice of the metadata")
+{
+  CHECK(champsim::metadata_slice_width(2) == 16);
+  CHECK(champsim::metadata_slice_width(3) == 10);
+
+  auto metadata = champsim::set_metadata_slice(0, 0xbeef, 0, 2);
+  metadata = champsim::set_metadata_slice(metadata, 0xdead, 1, 2);
+  CHECK(metadata == 0xdeadbeef);
+  CHECK(champsim::get_metadata_slice(metadata, 0, 2) == 0xbeef);
+  CHECK(champsim::get_metadata_slice(metadata, 1, 2) == 0xdead);
+
+  // Bits beyond the slice do not leak into the neighbouring slice
+  CHECK(champsim::set_metadata_slice(0, 0x1ffff, 0, 2) == 0xffff);
+}
+
+SCENARIO("Prefetchers in an ensemble keep their own metadata and feedback")
+{
+  GIVEN("A cache with two prefetchers")
+  {
+    fill_metadata.clear();
+    operate_metadata.clear();
+    useful_hits.clear();
+
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l1d}
+                  .name("433-uut")
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)
+                  .prefetcher<::tagged_prefetcher<0>, ::tagged_prefetcher<1>>()};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    const champsim::address demand_addr{0xdeadbe40};
+    REQUIRE(mock_ul.issue(load(demand_addr, 1)));
+    run(50, elements);
+
+    THEN("Each prefetcher sees only its own metadata when its prefetches fill")
+    {
+      CHECK(std::count(std::begin(fill_metadata[0]), std::end(fill_metadata[0]), 5) == 2);
+      CHECK(std::count(std::begin(fill_metadata[0]), std::end(fill_metadata[0]), 6) == 0);
+      CHECK(std::count(std::begin(fill_metadata[1]), std::end(fill_metadata[1]), 6) == 2);
+      CHECK(std::count(std::begin(fill_metadata[1]), std::end(fill_metadata[1]), 5) == 0);
+    }
+
+    WHEN("A demand hits the demanded block again")
+    {
+      REQUIRE(mock_ul.issue(load(demand_addr, 2)));
+      for (int i = 0; i < 20; ++i) {
+        uut._operate();
+        mock_ll._operate();
+      }
+
+      THEN("The returned metadata combines the slices of both prefetchers")
+      {
+        REQUIRE(std::size(mock_ul.queues.returned) == 1);
+        CHECK(mock_ul.queues.returned.front().pf_metadata == (1u | (2u << 16)));
+      }
+    }
+
+    WHEN("A demand carries metadata from the upper level")
+    {
+      operate_metadata.clear();
+      auto pkt = load(champsim::address{0xcafeba40}, 2);
+      pkt.pf_metadata = 0x12345678;
+      REQUIRE(mock_ul.issue(pkt));
+      run(20, elements);
+
+      THEN("Each prefetcher sees all of it")
+      {
+        REQUIRE_FALSE(std::empty(operate_metadata[0]));
+        REQUIRE_FALSE(std::empty(operate_metadata[1]));
+        CHECK(operate_metadata[0].front() == 0x12345678);
+        CHECK(operate_metadata[1].front() == 0x12345678);
+      }
+    }
+
+    WHEN("A demand hits a block prefetched by the first prefetcher")
+    {
+      REQUIRE(mock_ul.issue(load(champsim::address{demand_addr.to<uint64_t>() + BLOCK_SIZE}, 2)));
+      run(20, elements);
+
+      THEN("Only the first prefetcher is told the prefetch was useful")
+      {
+        CHECK(useful_hits[0] == 1);
+        CHECK(useful_hits[1] == 0);
+      }
+    }
+  }
+}
+
+SCENARIO("Prefetchers in an ensemble are arbitrated for the prefetch queue")
+{
+  GIVEN("A cache with a two-entry prefetch queue and two prefetchers")
+  {
+    auto [policy, first_winner, second_winner] = GENERATE(table<champsim::prefetch_arbiter::policy, std::size_t, std::size_t>(
+        {std::tuple{champsim::prefetch_arbiter::policy::PRIORITY, 0u, 0u}, std::tuple{champsim::prefetch_arbiter::policy::ROUND_ROBIN, 0u, 1u}}));
+
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l1d}
+                  .name("433-uut")
+                  .pq_size(2)
+                  .prefetch_arbitration(policy)
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)
+                  .prefetcher<::tagged_prefetcher<0>, ::tagged_prefetcher<1>>()};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("A demand makes both prefetchers offer more prefetches than fit in the queue")
+    {
+      REQUIRE(mock_ul.issue(load(champsim::address{0xdeadbe40}, 1)));
+      run(50, elements);
+
+      THEN("The winner's prefetches are issued, and the loser's are dropped")
+      {
+        REQUIRE(std::size(uut.sim_stats.pf_sources) == 2);
+        CHECK(uut.sim_stats.pf_sources.at(first_winner).issued == 2);
+        CHECK(uut.sim_stats.pf_sources.at(1 - first_winner).issued == 0);
+        CHECK(uut.sim_stats.pf_arbitration_dropped == 2);
+      }
+
+      AND_WHEN("Another demand makes them compete again")
+      {
+        REQUIRE(mock_ul.issue(load(champsim::address{0xcafeba40}, 2)));
+        run(50, elements);
+
+        THEN("The policy picks the next winner")
+        {
+          CHECK(uut.sim_stats.pf_sources.at(second_winner).issued - (second_winner == first_winner ? 2 : 0) == 2);
+          CHECK(uut.sim_stats.pf_arbitration_dropped == 4);
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("The selector arbitration policy favours the prefetcher with useful prefetches")
+{
+  champsim::prefetch_arbiter uut{champsim::prefetch_arbiter::policy::SELECTOR, 2};
+  CHECK(uut.rank() == std::vector<std::size_t>{0, 1});
+
+  uut.record_useful(1);
+  uut.record_useless(0);
+  CHECK(uut.rank() == std::vector<std::size_t>{1, 0});
+}
+
+TEST_CASE("The accuracy arbitration policy favours the prefetcher with the most accurate prefetches")
+{
+  champsim::prefetch_arbiter uut{champsim::prefetch_arbiter::policy::ACCURACY, 2};
+  for (int i = 0; i < 4; ++i) {
+    uut.record_issue(0);
+    uut.record_issue(1);
+  }
+  uut.record_useful(1);
+  CHECK(uut.rank() == std::vector<std::size_t>{1, 0});
+}
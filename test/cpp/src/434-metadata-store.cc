@@ -0,0 +1,189 @@
+#include <catch.hpp>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "metadata_store.h"
+#include "mocks.hpp"
+
+SCENARIO("The metadata store holds a fixed number of entries")
+{
+  GIVEN("A store with one set, one reserved way, and two entries per block")
+  {
+    champsim::metadata_store uut{1, 1, 2, false};
+
+    THEN("The store holds two entries") { CHECK(uut.capacity() == 2); }
+
+    WHEN("An entry is written and read back")
+    {
+      auto write_result = uut.write(0xa, 0xb);
+      auto read_result = uut.read(0xa);
+
+      THEN("The value is found on chip")
+      {
+        CHECK_FALSE(write_result.onchip_hit);
+        CHECK_FALSE(write_result.evicted);
+        CHECK(read_result.onchip_hit);
+        REQUIRE(read_result.value.has_value());
+        CHECK(read_result.value.value() == 0xb);
+      }
+    }
+
+    WHEN("An entry is overwritten")
+    {
+      uut.write(0xa, 0xb);
+      auto write_result = uut.write(0xa, 0xc);
+
+      THEN("The entry is replaced in place")
+      {
+        CHECK(write_result.onchip_hit);
+        CHECK_FALSE(write_result.evicted);
+        CHECK(uut.read(0xa).value == std::optional<uint64_t>{0xc});
+      }
+    }
+
+    WHEN("More entries are written than fit")
+    {
+      uut.write(0xa, 0x1);
+      uut.write(0xb, 0x2);
+      auto write_result = uut.write(0xc, 0x3);
+
+      THEN("The least recently used entry is lost")
+      {
+        CHECK(write_result.evicted);
+        CHECK_FALSE(write_result.offchip_write);
+        auto read_result = uut.read(0xa);
+        CHECK_FALSE(read_result.value.has_value());
+        CHECK_FALSE(read_result.offchip_read);
+      }
+    }
+  }
+
+  GIVEN("A store that is backed off chip")
+  {
+    champsim::metadata_store uut{1, 1, 2, true};
+
+    WHEN("An evicted entry is read")
+    {
+      uut.write(0xa, 0x1);
+      uut.write(0xb, 0x2);
+      auto write_result = uut.write(0xc, 0x3);
+      auto read_result = uut.read(0xa);
+
+      THEN("The evicted entry was written to memory, and is read back from it")
+      {
+        CHECK(write_result.offchip_write);
+        CHECK(read_result.offchip_read);
+        CHECK_FALSE(read_result.onchip_hit);
+        CHECK(read_result.value == std::optional<uint64_t>{0x1});
+      }
+
+      THEN("The entry that was read back displaces another entry") { CHECK(read_result.offchip_write); }
+    }
+  }
+}
+
+SCENARIO("A cache reserves ways for the metadata store")
+{
+  GIVEN("A cache builder with eight ways")
+  {
+    auto builder = champsim::cache_builder{champsim::defaults::default_l1d}.name("434-uut").sets(16).ways(8);
+
+    WHEN("Two ways are reserved for metadata")
+    {
+      CACHE uut{builder.metadata_ways(2)};
+
+      THEN("The data array has six ways") { CHECK(uut.NUM_WAY == 6); }
+      THEN("The cache has a metadata store") { CHECK(uut.has_metadata_store()); }
+    }
+
+    WHEN("No ways are reserved for metadata")
+    {
+      CACHE uut{builder};
+
+      THEN("The data array has eight ways") { CHECK(uut.NUM_WAY == 8); }
+      THEN("The cache has no metadata store") { CHECK_FALSE(uut.has_metadata_store()); }
+    }
+
+    WHEN("Every way is reserved for metadata")
+    {
+      THEN("The cache cannot be built") { CHECK_THROWS_AS(CACHE{builder.metadata_ways(8)}, std::invalid_argument); }
+    }
+
+    WHEN("Metadata is kept off chip, but no memory is reserved for it")
+    {
+      THEN("The cache cannot be built") { CHECK_THROWS_AS(CACHE{builder.metadata_ways(1).set_metadata_offchip()}, std::invalid_argument); }
+    }
+  }
+}
+
+SCENARIO("Metadata accesses are counted, and off-chip metadata is sent to the lower level")
+{
+  auto offchip = GENERATE(true, false);
+  GIVEN("A cache with a single-entry metadata store")
+  {
+    do_nothing_MRC mock_ll{10};
+    to_rq_MRP mock_ul;
+    auto builder = champsim::cache_builder{champsim::defaults::default_l1d}
+                       .name("434-uut")
+                       .sets(1)
+                       .ways(2)
+                       .metadata_ways(1)
+                       .metadata_entries_per_block(1)
+                       .metadata_region(champsim::address{0xf0000000})
+                       .upper_levels({&mock_ul.queues})
+                       .lower_level(&mock_ll.queues);
+    if (offchip)
+      builder.set_metadata_offchip();
+    CACHE uut{builder};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("Two entries are written, and the first is read")
+    {
+      uut.metadata_write(0xa, 0x1);
+      uut.metadata_write(0xb, 0x2);
+      auto value = uut.metadata_read(0xa);
+      for (int i = 0; i < 20; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("The accesses are counted")
+      {
+        CHECK(uut.sim_stats.metadata_writes == 2);
+        CHECK(uut.sim_stats.metadata_reads == 1);
+        CHECK(uut.sim_stats.metadata_read_hits == 0);
+      }
+
+      if (offchip) {
+        THEN("The first entry is fetched from off chip, and is not yet available")
+        {
+          CHECK_FALSE(value.has_value());
+          CHECK(uut.sim_stats.metadata_offchip_reads == 1);
+          CHECK(uut.sim_stats.metadata_offchip_writes == 2);
+          CHECK(std::size(mock_ll.addresses) == 3);
+        }
+
+        AND_WHEN("The first entry is read again after the response returns")
+        {
+          auto second_value = uut.metadata_read(0xa);
+
+          THEN("The entry is available") { CHECK(second_value == std::optional<uint64_t>{0x1}); }
+        }
+      } else {
+        THEN("The first entry is lost, and no traffic reaches the lower level")
+        {
+          CHECK_FALSE(value.has_value());
+          CHECK(uut.sim_stats.metadata_evictions == 1);
+          CHECK(uut.sim_stats.metadata_offchip_reads == 0);
+          CHECK(uut.sim_stats.metadata_offchip_writes == 0);
+          CHECK(std::empty(mock_ll.addresses));
+        }
+      }
+    }
+  }
+}
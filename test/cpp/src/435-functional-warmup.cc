@@ -0,0 +1,133 @@
+#include <catch.hpp>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "environment.h"
+#include "functional_warmup.h"
+#include "instr.h"
+#include "mocks.hpp"
+#include "ooo_cpu.h"
+
+namespace
+{
+champsim::channel::request_type request(champsim::address addr, access_type type)
+{
+  champsim::channel::request_type pkt;
+  pkt.address = addr;
+  pkt.v_address = addr;
+  pkt.type = type;
+  pkt.cpu = 0;
+  return pkt;
+}
+
+// A core with split first-level caches over a shared second level, and no virtual memory
+struct test_environment final : champsim::environment {
+  champsim::channel fetch_queues{};
+  champsim::channel data_queues{};
+  champsim::channel l2_queues{};
+  do_nothing_MRC mock_ll{};
+
+  CACHE l1i{champsim::cache_builder{champsim::defaults::default_l1i}.name("435-l1i").upper_levels({&fetch_queues}).lower_level(&l2_queues)};
+  CACHE l1d{champsim::cache_builder{champsim::defaults::default_l1d}.name("435-l1d").upper_levels({&data_queues}).lower_level(&l2_queues)};
+  CACHE l2c{champsim::cache_builder{champsim::defaults::default_l2c}.name("435-l2c").upper_levels({&l2_queues}).lower_level(&mock_ll.queues)};
+  O3_CPU cpu{champsim::core_builder{}.fetch_queues(&fetch_queues).data_queues(&data_queues).l1i(&l1i)};
+
+  std::vector<std::reference_wrapper<O3_CPU>> cpu_view() final { return {std::ref(cpu)}; }
+  std::vector<std::reference_wrapper<CACHE>> cache_view() final { return {std::ref(l1i), std::ref(l1d), std::ref(l2c)}; }
+  std::vector<std::reference_wrapper<PageTableWalker>> ptw_view() final { return {}; }
+  MEMORY_CONTROLLER& dram_view() final { throw std::logic_error{"The functional model does not use DRAM"}; }
+  std::vector<std::reference_wrapper<champsim::operable>> operable_view() final { return {std::ref(cpu), std::ref(l1i), std::ref(l1d), std::ref(l2c)}; }
+};
+} // namespace
+
+SCENARIO("A functional access fills the cache at once")
+{
+  GIVEN("An empty cache with one set of two ways")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}
+                  .name("435-uut")
+                  .sets(1)
+                  .ways(2)
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)};
+
+    const champsim::address addr_a{0xdeadbe40};
+    const champsim::address addr_b{0xcafebac0};
+    const champsim::address addr_c{0xfeedfac0};
+
+    WHEN("A block is loaded twice")
+    {
+      auto first = uut.functional_access(request(addr_a, access_type::LOAD), false);
+      auto second = uut.functional_access(request(addr_a, access_type::LOAD), false);
+
+      THEN("The first access misses and fills the block, and the second hits")
+      {
+        CHECK_FALSE(first.hit);
+        CHECK(second.hit);
+        CHECK(uut.lookup_way(addr_a) < uut.NUM_WAY);
+      }
+
+      THEN("Nothing is sent to the lower level, and no statistics are counted")
+      {
+        CHECK(std::empty(mock_ll.addresses));
+        CHECK(uut.sim_stats.hits.total() == 0);
+        CHECK(uut.sim_stats.misses.total() == 0);
+      }
+    }
+
+    WHEN("A block is written, and then two others are loaded")
+    {
+      uut.functional_access(request(addr_a, access_type::WRITE), false);
+      auto second = uut.functional_access(request(addr_b, access_type::LOAD), false);
+      auto third = uut.functional_access(request(addr_c, access_type::LOAD), false);
+
+      THEN("The written block is evicted dirty, for the caller to write back")
+      {
+        CHECK(std::empty(second.evicted));
+        REQUIRE(std::size(third.evicted) == 1);
+        CHECK(third.evicted.front().address == addr_a);
+        CHECK(third.evicted.front().dirty);
+      }
+    }
+  }
+}
+
+SCENARIO("Functional warmup passes the accesses of each instruction down the hierarchy")
+{
+  GIVEN("A core over a two-level hierarchy")
+  {
+    test_environment env;
+    champsim::functional_warmup uut{env, false};
+
+    const champsim::address ip{0x401000};
+    const champsim::address load_addr{0xdead0040};
+    const champsim::address store_addr{0xbeef0080};
+    auto instr = champsim::test::instruction_with_ip_and_source_memory(ip, load_addr);
+    instr.destination_memory.push_back(store_addr);
+
+    WHEN("An instruction with a load and a store is warmed up")
+    {
+      uut.operate(0, instr);
+
+      THEN("Every level holds the blocks that reached it")
+      {
+        CHECK(env.l1i.lookup_way(ip) < env.l1i.NUM_WAY);
+        CHECK(env.l1d.lookup_way(load_addr) < env.l1d.NUM_WAY);
+        CHECK(env.l1d.lookup_way(store_addr) < env.l1d.NUM_WAY);
+        CHECK(env.l2c.lookup_way(ip) < env.l2c.NUM_WAY);
+        CHECK(env.l2c.lookup_way(load_addr) < env.l2c.NUM_WAY);
+        CHECK(env.l2c.lookup_way(store_addr) < env.l2c.NUM_WAY);
+        CHECK(uut.accesses() == 6);
+      }
+
+      AND_WHEN("The same instruction is warmed up again")
+      {
+        uut.operate(0, instr);
+
+        THEN("The fetch of the same block is not repeated, and the data accesses hit in the first level") { CHECK(uut.accesses() == 8); }
+      }
+    }
+  }
+}
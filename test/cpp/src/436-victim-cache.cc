@@ -0,0 +1,187 @@
+#include <catch.hpp>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+#include "victim_cache.h"
+#include "write_combining_buffer.h"
+
+namespace
+{
+template <std::size_t N>
+void run(long cycles, const std::array<champsim::operable*, N>& elements)
+{
+  for (long i = 0; i < cycles; ++i)
+    for (auto elem : elements)
+      elem->_operate();
+}
+
+champsim::cache_block block_at(champsim::address addr, bool dirty)
+{
+  champsim::cache_block blk;
+  blk.valid = true;
+  blk.dirty = dirty;
+  blk.address = addr;
+  return blk;
+}
+
+champsim::channel::request_type request(champsim::address addr, access_type type)
+{
+  champsim::channel::request_type pkt;
+  pkt.address = addr;
+  pkt.v_address = addr;
+  pkt.type = type;
+  pkt.cpu = 0;
+  pkt.response_requested = (type != access_type::WRITE);
+  return pkt;
+}
+} // namespace
+
+SCENARIO("The victim cache keeps the most recently evicted blocks")
+{
+  GIVEN("A victim cache of two blocks")
+  {
+    champsim::victim_cache uut{2, champsim::data::bits{LOG2_BLOCK_SIZE}};
+    const champsim::address addr_a{0xdeadbe40};
+    const champsim::address addr_b{0xcafebac0};
+
+    WHEN("Two blocks are inserted")
+    {
+      uut.insert(block_at(addr_a, true));
+      uut.insert(block_at(addr_b, false));
+
+      THEN("The older block would be displaced by the next insertion")
+      {
+        REQUIRE(uut.displaced().has_value());
+        CHECK(uut.displaced()->address == addr_a);
+      }
+
+      THEN("A block is found by any address within it, and is removed when it is taken")
+      {
+        auto found = uut.take(champsim::address{addr_a.to<uint64_t>() + 4});
+        REQUIRE(found.has_value());
+        CHECK(found->dirty);
+        CHECK_FALSE(uut.contains(addr_a));
+        CHECK_FALSE(uut.displaced().has_value());
+      }
+    }
+  }
+}
+
+SCENARIO("The write-combining buffer combines writes to the same block")
+{
+  GIVEN("A write-combining buffer of four blocks in front of a busy channel")
+  {
+    champsim::write_combining_buffer uut{4, champsim::data::bits{LOG2_BLOCK_SIZE}};
+    champsim::channel lower{};
+    lower.add_wq(request(champsim::address{0x1000}, access_type::WRITE));
+
+    WHEN("The same block is written twice")
+    {
+      auto first = uut.add(request(champsim::address{0xdeadbe40}, access_type::WRITE));
+      auto second = uut.add(request(champsim::address{0xdeadbe40}, access_type::WRITE));
+
+      THEN("The second write is combined with the first")
+      {
+        CHECK(first == champsim::write_combining_buffer::add_result::ADDED);
+        CHECK(second == champsim::write_combining_buffer::add_result::COMBINED);
+        CHECK(uut.size() == 1);
+      }
+
+      THEN("The write waits while the lower level is busy and the buffer is not half full") { CHECK(uut.drain(lower) == 0); }
+    }
+
+    WHEN("The buffer is filled")
+    {
+      for (uint64_t i = 0; i < 4; ++i)
+        REQUIRE(uut.add(request(champsim::address{0xdeadbe40 + i * BLOCK_SIZE}, access_type::WRITE))
+                == champsim::write_combining_buffer::add_result::ADDED);
+
+      THEN("Further writes are refused") { CHECK(uut.add(request(champsim::address{0xcafebac0}, access_type::WRITE)) == champsim::write_combining_buffer::add_result::FULL); }
+
+      THEN("It drains until it is half full") { CHECK(uut.drain(lower) == 2); }
+    }
+  }
+}
+
+SCENARIO("A cache with a victim cache serves conflict misses from it")
+{
+  GIVEN("A direct-mapped cache with a victim cache of one block")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_llc}
+                  .name("436-uut")
+                  .sets(1)
+                  .ways(1)
+                  .victim_cache_size(1)
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    const champsim::address addr_a{0xdeadbe40};
+    const champsim::address addr_b{0xcafebac0};
+
+    WHEN("Two conflicting blocks are loaded, and then the first again")
+    {
+      REQUIRE(mock_ul.issue(request(addr_a, access_type::LOAD)));
+      run(100, elements);
+      REQUIRE(mock_ul.issue(request(addr_b, access_type::LOAD)));
+      run(100, elements);
+      REQUIRE(mock_ul.issue(request(addr_a, access_type::LOAD)));
+      run(100, elements);
+
+      THEN("The third load is served from the victim cache, without going to the lower level")
+      {
+        CHECK(uut.sim_stats.victim_cache_hits == 1);
+        CHECK(std::size(mock_ll.addresses) == 2);
+        CHECK(uut.lookup_way(addr_a) == 0);
+        CHECK(uut.lookup_way(addr_b) == uut.NUM_WAY);
+      }
+    }
+  }
+}
+
+SCENARIO("A cache with a write-combining buffer combines its writebacks")
+{
+  GIVEN("A direct-mapped cache with a write-combining buffer, over a lower level that does not drain its write queue")
+  {
+    champsim::channel lower{};
+    to_wq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_llc}
+                  .name("436-uut")
+                  .sets(1)
+                  .ways(1)
+                  .write_combining_buffer_size(4)
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&lower)};
+
+    std::array<champsim::operable*, 2> elements{{&uut, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("Two conflicting blocks are written back to it in turn")
+    {
+      for (uint64_t addr : {0xdeadbe40, 0xcafebac0, 0xdeadbe40, 0xcafebac0, 0xdeadbe40}) {
+        REQUIRE(mock_ul.issue(request(champsim::address{addr}, access_type::WRITE)));
+        run(20, elements);
+      }
+
+      THEN("The dirty evictions enter the buffer, and one that is still waiting there is combined")
+      {
+        CHECK(uut.sim_stats.wcb_writes == 4);
+        CHECK(uut.sim_stats.wcb_combined == 1);
+        CHECK(std::size(lower.WQ) == 1);
+      }
+    }
+  }
+}
@@ -0,0 +1,174 @@
+#include <catch.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "cache.h"
+#include "compression_model.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+
+namespace
+{
+void run(long cycles, const std::array<champsim::operable*, 3>& elements)
+{
+  for (long i = 0; i < cycles; ++i)
+    for (auto elem : elements)
+      elem->_operate();
+}
+
+champsim::channel::request_type load(champsim::address addr)
+{
+  champsim::channel::request_type pkt;
+  pkt.address = addr;
+  pkt.v_address = addr;
+  pkt.type = access_type::LOAD;
+  pkt.cpu = 0;
+  return pkt;
+}
+
+std::vector<champsim::address> blocks(std::size_t count)
+{
+  std::vector<champsim::address> retval{};
+  for (uint64_t i = 0; i < count; ++i)
+    retval.emplace_back(0xdead0000 + i * BLOCK_SIZE);
+  return retval;
+}
+} // namespace
+
+SCENARIO("The compression model gives each block a stable compressed size")
+{
+  GIVEN("A model of Base-Delta-Immediate compression")
+  {
+    champsim::compression_model uut{"bdi", "", champsim::data::bits{LOG2_BLOCK_SIZE}};
+
+    THEN("A block has the same size each time, within the size of a block")
+    {
+      for (auto addr : blocks(64)) {
+        CHECK(uut.compressed_size(addr) == uut.compressed_size(champsim::address{addr.to<uint64_t>() + 8}));
+        CHECK(uut.compressed_size(addr) >= 1);
+        CHECK(uut.segments(addr) <= uut.block_segments());
+      }
+    }
+
+    WHEN("Sizes are read from a file")
+    {
+      std::istringstream sizes{"# block size\ndead0000 12\ndead0040 200\n"};
+      uut.read_sizes(sizes);
+
+      THEN("The listed blocks take their sizes from the file, rounded up to segments")
+      {
+        CHECK(uut.compressed_size(champsim::address{0xdead0000}) == 12);
+        CHECK(uut.segments(champsim::address{0xdead0000}) == 2);
+        CHECK(uut.compressed_size(champsim::address{0xdead0040}) == BLOCK_SIZE);
+      }
+    }
+  }
+
+  GIVEN("An unknown model") { THEN("It is rejected") { CHECK_THROWS_AS((champsim::compression_model{"lz", "", champsim::data::bits{LOG2_BLOCK_SIZE}}), std::invalid_argument); } }
+}
+
+SCENARIO("A compressed cache holds more blocks than ways")
+{
+  GIVEN("A two-way compressed cache with four tags per way, in which every block compresses to a quarter")
+  {
+    const auto size_file = (std::filesystem::temp_directory_path() / "437-sizes.txt").string();
+    {
+      std::ofstream sizes{size_file};
+      for (auto addr : blocks(9))
+        sizes << std::hex << addr.to<uint64_t>() << std::dec << " " << BLOCK_SIZE / 4 << "\n";
+    }
+
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_llc}
+                  .name("437-uut")
+                  .sets(1)
+                  .ways(2)
+                  .compression_size_file(size_file)
+                  .compression_tag_factor(4)
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)};
+    std::remove(size_file.c_str());
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    THEN("Each set has four tags for each way") { CHECK(uut.NUM_WAY == 8); }
+
+    WHEN("Eight blocks are loaded")
+    {
+      for (auto addr : blocks(8)) {
+        REQUIRE(mock_ul.issue(load(addr)));
+        run(100, elements);
+      }
+      uut.end_phase(0);
+
+      THEN("All of them stay in the cache, at four times its capacity")
+      {
+        for (auto addr : blocks(8))
+          CHECK(uut.lookup_way(addr) < uut.NUM_WAY);
+        CHECK(uut.sim_stats.compressed_fills == 8);
+        CHECK(uut.sim_stats.compressed_fill_bytes == 8 * BLOCK_SIZE / 4);
+        CHECK(uut.sim_stats.compression_evictions == 0);
+        CHECK(uut.sim_stats.resident_blocks == 8);
+        CHECK(uut.sim_stats.capacity_blocks == 2);
+      }
+    }
+  }
+
+  GIVEN("A two-way compressed cache with two tags per way, in which no block compresses")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_llc}
+                  .name("437-uut")
+                  .sets(1)
+                  .ways(2)
+                  .compression_model("none")
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("Three blocks are loaded")
+    {
+      const auto addrs = blocks(3);
+      for (auto addr : addrs) {
+        REQUIRE(mock_ul.issue(load(addr)));
+        run(100, elements);
+      }
+      uut.end_phase(0);
+
+      THEN("The third fills a free tag, but the oldest block leaves the data array")
+      {
+        CHECK(uut.sim_stats.compression_evictions == 1);
+        CHECK(uut.lookup_way(addrs.at(0)) == uut.NUM_WAY);
+        CHECK(uut.lookup_way(addrs.at(1)) < uut.NUM_WAY);
+        CHECK(uut.lookup_way(addrs.at(2)) < uut.NUM_WAY);
+        CHECK(uut.sim_stats.resident_blocks == 2);
+      }
+    }
+  }
+
+  GIVEN("A compressed cache with a victim cache")
+  {
+    THEN("It is rejected")
+    {
+      CHECK_THROWS_AS(
+          (CACHE{champsim::cache_builder{champsim::defaults::default_llc}.name("437-uut").compression_model("bdi").victim_cache_size(4)}),
+          std::invalid_argument);
+    }
+  }
+}
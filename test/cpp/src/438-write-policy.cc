@@ -0,0 +1,125 @@
+#include <catch.hpp>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+
+namespace
+{
+void run(long cycles, const std::array<champsim::operable*, 2>& elements)
+{
+  for (long i = 0; i < cycles; ++i)
+    for (auto elem : elements)
+      elem->_operate();
+}
+
+champsim::channel::request_type store(champsim::address addr, bool full_line)
+{
+  champsim::channel::request_type pkt;
+  pkt.address = addr;
+  pkt.v_address = addr;
+  pkt.type = access_type::WRITE;
+  pkt.cpu = 0;
+  pkt.response_requested = false;
+  pkt.full_line = full_line;
+  return pkt;
+}
+} // namespace
+
+SCENARIO("A cache that does not allocate on writes sends its store misses on to the lower level")
+{
+  GIVEN("A first-level data cache without write allocation")
+  {
+    champsim::channel lower{};
+    to_wq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l1d}
+                  .name("438-uut")
+                  .reset_write_allocate()
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&lower)};
+
+    std::array<champsim::operable*, 2> elements{{&uut, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("A store misses")
+    {
+      const champsim::address addr{0xdeadbe40};
+      REQUIRE(mock_ul.issue(store(addr, false)));
+      run(20, elements);
+
+      THEN("The store is written to the lower level, without a read for ownership or a fill")
+      {
+        CHECK(std::empty(lower.RQ));
+        REQUIRE(std::size(lower.WQ) == 1);
+        CHECK(lower.WQ.front().type == access_type::WRITE);
+        CHECK(uut.lookup_way(addr) == uut.NUM_WAY);
+        CHECK(uut.sim_stats.writes_not_allocated == 1);
+      }
+    }
+  }
+
+  GIVEN("An exclusive cache without write allocation")
+  {
+    THEN("It is rejected")
+    {
+      CHECK_THROWS_AS((CACHE{champsim::cache_builder{champsim::defaults::default_llc}
+                                 .name("438-uut")
+                                 .inclusion(champsim::inclusion_policy::EXCLUSIVE)
+                                 .reset_write_allocate()}),
+                      std::invalid_argument);
+    }
+  }
+}
+
+SCENARIO("A cache with full-line write elision fills full-line store misses without reading the block")
+{
+  GIVEN("A first-level data cache with full-line write elision")
+  {
+    champsim::channel lower{};
+    to_wq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l1d}
+                  .name("438-uut")
+                  .set_full_line_write_elision()
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&lower)};
+
+    std::array<champsim::operable*, 2> elements{{&uut, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("A full-line store misses")
+    {
+      const champsim::address addr{0xdeadbe40};
+      REQUIRE(mock_ul.issue(store(addr, true)));
+      run(20, elements);
+
+      THEN("The block is filled at once, without a read for ownership")
+      {
+        CHECK(std::empty(lower.RQ));
+        CHECK(uut.lookup_way(addr) < uut.NUM_WAY);
+        CHECK(uut.sim_stats.rfo_elided == 1);
+      }
+    }
+
+    WHEN("A partial store misses")
+    {
+      const champsim::address addr{0xcafebac0};
+      REQUIRE(mock_ul.issue(store(addr, false)));
+      run(20, elements);
+
+      THEN("The block is read for ownership")
+      {
+        REQUIRE(std::size(lower.RQ) == 1);
+        CHECK(lower.RQ.front().type == access_type::RFO);
+        CHECK(uut.sim_stats.rfo_elided == 0);
+      }
+    }
+  }
+}
@@ -277,3 +277,52 @@ SCENARIO("The replacement policy notes the correct eviction information")
     }
   }
 }
+
+SCENARIO("The replacement policy is triggered once for a miss that waits for an MSHR")
+{
+  GIVEN("A cache with a single MSHR")
+  {
+    release_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}
+                  .name("442d-uut")
+                  .sets(1)
+                  .ways(2)
+                  .mshr_size(1)
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)
+                  .offset_bits(champsim::data::bits{})
+                  .replacement<update_state_collector, lru>()};
+
+    std::array<champsim::operable*, 3> elements{{&mock_ll, &mock_ul, &uut}};
+
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("Two loads miss, and the second cannot be given an MSHR")
+    {
+      ::replacement_update_state_collector[&uut].clear();
+
+      decltype(mock_ul)::request_type test;
+      test.address = champsim::address{0xdeadbeef};
+      test.cpu = 0;
+      test.type = access_type::LOAD;
+      REQUIRE(mock_ul.issue(test));
+      test.address = champsim::address{0xcafebabe};
+      REQUIRE(mock_ul.issue(test));
+
+      for (auto i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("Only the miss that was handled has updated the replacement policy")
+      {
+        REQUIRE_THAT(::replacement_update_state_collector[&uut], Catch::Matchers::SizeIs(1));
+        CHECK(::replacement_update_state_collector[&uut].at(0).full_addr == champsim::address{0xdeadbeef});
+      }
+    }
+  }
+}
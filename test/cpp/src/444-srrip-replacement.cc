@@ -1,6 +1,7 @@
 #include <catch.hpp>
 
 #include "../replacement/srrip/srrip.h"
+#include "msl/packed_rrpv.h"
 
 TEST_CASE("SRRIP matches the performance in the published work")
 {
@@ -23,3 +24,40 @@ TEST_CASE("SRRIP matches the performance in the published work")
   REQUIRE(victim_b3 == 2);
   uut.update(victim_b3, false); // b3
 }
+
+TEMPLATE_TEST_CASE("Packed RRPVs choose and age like an unpacked set", "", champsim::msl::packed_rrpv<2>, champsim::msl::packed_rrpv<3>)
+{
+  auto ways = GENERATE(16l, 100l);
+  constexpr auto max_rrpv = TestType::max_rrpv;
+  TestType uut{2, ways};
+  std::vector<unsigned> reference(static_cast<std::size_t>(ways), max_rrpv);
+
+  uint64_t lcg = 1;
+  for (int i = 0; i < 1000; ++i) {
+    lcg = lcg * 6364136223846793005ULL + 1442695040888963407ULL;
+    if ((lcg >> 62) == 0) {
+      auto expected = std::max_element(std::begin(reference), std::end(reference));
+      auto diff = max_rrpv - *expected;
+      std::transform(std::begin(reference), std::end(reference), std::begin(reference), [diff](auto x) { return x + diff; });
+      REQUIRE(uut.victim(1) == std::distance(std::begin(reference), expected));
+    } else {
+      auto way = static_cast<long>((lcg >> 33) % static_cast<uint64_t>(ways));
+      auto value = static_cast<unsigned>((lcg >> 20) % (max_rrpv + 1));
+      uut.set(1, way, value);
+      reference.at(static_cast<std::size_t>(way)) = value;
+    }
+  }
+
+  for (long way = 0; way < ways; ++way) {
+    CHECK(uut.get(1, way) == reference.at(static_cast<std::size_t>(way)));
+    CHECK(uut.get(0, way) == max_rrpv);
+  }
+
+  CHECK(uut.max_way(1) == std::distance(std::begin(reference), std::max_element(std::begin(reference), std::end(reference))));
+
+  uut.increment_below(1, max_rrpv - 1);
+  for (long way = 0; way < ways; ++way) {
+    auto expected = reference.at(static_cast<std::size_t>(way));
+    CHECK(uut.get(1, way) == (expected < max_rrpv - 1 ? expected + 1 : expected));
+  }
+}
@@ -0,0 +1,212 @@
+#include <catch.hpp>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+#include "modules.h"
+#include "way_partition.h"
+
+namespace
+{
+void run(long cycles, const std::array<champsim::operable*, 3>& elements)
+{
+  for (long i = 0; i < cycles; ++i)
+    for (auto elem : elements)
+      elem->_operate();
+}
+
+champsim::channel::request_type load(champsim::address addr, uint32_t cpu, uint64_t instr_id)
+{
+  champsim::channel::request_type pkt;
+  pkt.address = addr;
+  pkt.v_address = addr;
+  pkt.type = access_type::LOAD;
+  pkt.instr_id = instr_id;
+  pkt.cpu = cpu;
+  return pkt;
+}
+
+struct unrestricted_replacement : champsim::modules::replacement {
+  using replacement::replacement;
+  long find_victim(uint32_t, uint64_t, long, const CACHE::BLOCK*, champsim::address, champsim::address, access_type) { return 0; }
+};
+} // namespace
+
+SCENARIO("A static way partition restricts each core to its mask")
+{
+  GIVEN("A partition of eight ways between two cores")
+  {
+    champsim::way_partition uut{1, 8, std::vector<champsim::way_partition::mask_type>{0x0f, 0xf0}};
+
+    THEN("Each core may only fill the ways in its mask")
+    {
+      CHECK(uut.allows(0, 0));
+      CHECK_FALSE(uut.allows(0, 4));
+      CHECK(uut.allows(1, 4));
+      CHECK_FALSE(uut.allows(1, 3));
+    }
+
+    THEN("A core without a mask may fill any way") { CHECK(uut.mask(2) == 0xff); }
+
+    THEN("The allocation counts the ways of each mask") { CHECK(uut.allocation() == std::vector<uint64_t>{4, 4}); }
+  }
+
+  GIVEN("A mask with no ways of the cache")
+  {
+    THEN("The partition is rejected")
+    {
+      CHECK_THROWS_AS((champsim::way_partition{1, 4, std::vector<champsim::way_partition::mask_type>{0x3, 0x30}}), std::invalid_argument);
+    }
+  }
+}
+
+SCENARIO("A utility-based partition gives the ways to the core that would hit in them")
+{
+  GIVEN("A utility-based partition of eight ways")
+  {
+    champsim::way_partition uut{1, 8, uint64_t{1000}};
+
+    THEN("Before the first interval ends, every core may fill any way") { CHECK(uut.mask(0) == 0xff); }
+
+    WHEN("One core reuses six blocks, and the other streams")
+    {
+      uint64_t stream = 0x1000;
+      for (uint64_t i = 0; i < 500; ++i) {
+        uut.record_access(0, 0, i % 6);
+        uut.record_access(1, 0, stream++);
+      }
+
+      THEN("The reusing core is given all but one way")
+      {
+        CHECK(uut.repartitions() == 1);
+        CHECK(uut.allocation() == std::vector<uint64_t>{7, 1});
+        CHECK(uut.mask(0) == 0x7f);
+        CHECK(uut.mask(1) == 0x80);
+      }
+    }
+  }
+}
+
+SCENARIO("A cache with a way partition fills each core's blocks into its own ways")
+{
+  GIVEN("A four-way cache, split between two cores")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_llc}
+                  .name("445-uut")
+                  .sets(1)
+                  .ways(4)
+                  .way_partition({0b0011, 0b1100})
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("The first core loads four blocks, and the second loads one")
+    {
+      std::vector<champsim::address> addrs{};
+      for (uint64_t i = 0; i < 4; ++i) {
+        addrs.emplace_back(0xdead0000 + i * BLOCK_SIZE);
+        REQUIRE(mock_ul.issue(load(addrs.back(), 0, i)));
+        run(100, elements);
+      }
+      const champsim::address other{0xcafe0000};
+      REQUIRE(mock_ul.issue(load(other, 1, 4)));
+      run(100, elements);
+      uut.end_phase(0);
+
+      THEN("The first core keeps only two blocks, in its own ways")
+      {
+        CHECK(uut.lookup_way(addrs.at(0)) == uut.NUM_WAY);
+        CHECK(uut.lookup_way(addrs.at(1)) == uut.NUM_WAY);
+        CHECK(uut.lookup_way(addrs.at(2)) < 2);
+        CHECK(uut.lookup_way(addrs.at(3)) < 2);
+      }
+
+      THEN("The second core's block is in its own ways") { CHECK(uut.lookup_way(other) >= 2); }
+
+      THEN("The occupancy and partition of each core are reported")
+      {
+        CHECK(uut.sim_stats.occupancy == std::vector<uint64_t>{2, 1});
+        CHECK(uut.sim_stats.partition_ways == std::vector<uint64_t>{2, 2});
+      }
+    }
+
+    WHEN("The first core loads two blocks, reuses the first, and loads a third")
+    {
+      const champsim::address first{0xdead0000};
+      const champsim::address second{0xdead0040};
+      const champsim::address third{0xdead0080};
+      REQUIRE(mock_ul.issue(load(first, 0, 0)));
+      run(100, elements);
+      REQUIRE(mock_ul.issue(load(second, 0, 1)));
+      run(100, elements);
+      REQUIRE(mock_ul.issue(load(first, 0, 2)));
+      run(100, elements);
+      REQUIRE(mock_ul.issue(load(third, 0, 3)));
+      run(100, elements);
+
+      THEN("The replacement policy chooses the least recently used block of the partition")
+      {
+        CHECK(uut.lookup_way(first) < 2);
+        CHECK(uut.lookup_way(second) == uut.NUM_WAY);
+        CHECK(uut.lookup_way(third) < 2);
+      }
+    }
+  }
+
+  GIVEN("A replacement policy that does not accept the allowed ways")
+  {
+    THEN("A partitioned cache is rejected")
+    {
+      CHECK_THROWS_AS((CACHE{champsim::cache_builder{champsim::defaults::default_llc}
+                                 .name("445-unrestricted")
+                                 .sets(1)
+                                 .ways(4)
+                                 .way_partition({0b0011, 0b1100})
+                                 .replacement<unrestricted_replacement>()}),
+                      std::invalid_argument);
+    }
+  }
+}
+
+SCENARIO("A utility monitor counts each access once")
+{
+  GIVEN("A cache with a utility-based partition and a single MSHR")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_llc}
+                  .name("445-uut")
+                  .sets(1)
+                  .ways(4)
+                  .mshr_size(1)
+                  .set_utility_partition()
+                  .utility_partition_interval(4)
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("A second miss waits for the MSHR")
+    {
+      REQUIRE(mock_ul.issue(load(champsim::address{0xdead0000}, 0, 0)));
+      REQUIRE(mock_ul.issue(load(champsim::address{0xbeef0000}, 0, 1)));
+      run(100, elements);
+      uut.end_phase(0);
+
+      THEN("Its retries are not counted, so the interval has not ended") { CHECK(uut.sim_stats.repartitions == 0); }
+    }
+  }
+}
@@ -0,0 +1,59 @@
+#include <catch.hpp>
+
+#include "../replacement/drrip/drrip.h"
+#include "../replacement/hawkeye/hawkeye.h"
+#include "../replacement/lru/lru.h"
+#include "../replacement/mockingjay/mockingjay.h"
+#include "../replacement/ship/ship.h"
+#include "../replacement/srrip/srrip.h"
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+
+/*
+ * The cost of each replacement policy per access to a last-level cache, on a common access stream. Hits update the replacement state,
+ * and misses also choose a victim and fill it. The reciprocal of the mean is the policy's throughput in accesses per second.
+ */
+TEMPLATE_TEST_CASE("replacement throughput", "", lru, srrip, drrip, ship, hawkeye, mockingjay)
+{
+  do_nothing_MRC mock_ll;
+  to_rq_MRP mock_ul;
+  CACHE uut{champsim::cache_builder{champsim::defaults::default_llc}
+                .name("446-uut")
+                .upper_levels({&mock_ul.queues})
+                .lower_level(&mock_ll.queues)
+                .replacement<TestType>()};
+  uut.impl_initialize_replacement();
+
+  // About half of the accesses hit, spread over every set and way
+  struct access {
+    long set;
+    long way;
+    bool hit;
+    champsim::address addr;
+    champsim::address ip;
+  };
+  std::vector<access> accesses{};
+  uint64_t lcg = 1;
+  for (uint64_t i = 0; i < 16384; ++i) {
+    lcg = lcg * 6364136223846793005ULL + 1442695040888963407ULL;
+    auto set = static_cast<long>((lcg >> 33) % static_cast<uint64_t>(uut.NUM_SET));
+    auto way = static_cast<long>((lcg >> 17) % static_cast<uint64_t>(uut.NUM_WAY));
+    accesses.push_back({set, way, ((lcg >> 60) & 1) != 0, champsim::address{lcg >> 16}, champsim::address{0x400000 + 0x40 * ((lcg >> 50) % 64)}});
+  }
+
+  BENCHMARK_ADVANCED("replacement accesses")(Catch::Benchmark::Chronometer meter)
+  {
+    meter.measure([&](int i) {
+      const auto& acc = accesses.at(static_cast<std::size_t>(i) % std::size(accesses));
+      auto way = acc.way;
+      if (!acc.hit) {
+        way = uut.impl_find_victim(0, 0, acc.set, &uut.block.at(static_cast<std::size_t>(acc.set * uut.NUM_WAY)), acc.ip, acc.addr, access_type::LOAD);
+        uut.impl_replacement_cache_fill(0, acc.set, way, acc.addr, acc.ip, {}, access_type::LOAD);
+      }
+      uut.impl_update_replacement_state(0, acc.set, way, acc.addr, acc.ip, {}, access_type::LOAD, acc.hit);
+      return way;
+    });
+  };
+  SUCCEED();
+}
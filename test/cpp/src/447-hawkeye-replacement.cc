@@ -0,0 +1,108 @@
+#include <catch.hpp>
+
+#include "../replacement/hawkeye/hawkeye.h"
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+
+namespace
+{
+champsim::address block_in_set_zero(uint64_t n) { return champsim::address{champsim::block_number{n * 4}}; }
+} // namespace
+
+SCENARIO("OPTgen keeps a line only while the cache has room for it")
+{
+  GIVEN("OPTgen for a two-line set")
+  {
+    hawkeye::optgen uut{8, 2};
+
+    WHEN("Three lines are accessed in turn, twice")
+    {
+      auto a = uut.access();
+      auto b = uut.access();
+      auto c = uut.access();
+
+      uut.access();
+      auto a_hit = uut.should_cache(a);
+      uut.access();
+      auto b_hit = uut.should_cache(b);
+      uut.access();
+      auto c_hit = uut.should_cache(c);
+
+      THEN("OPT keeps the first two lines, and not the third")
+      {
+        CHECK(a_hit);
+        CHECK(b_hit);
+        CHECK_FALSE(c_hit);
+      }
+    }
+
+    WHEN("A line is reused after the history has passed")
+    {
+      auto a = uut.access();
+      for (int i = 0; i < 8; ++i)
+        uut.access();
+
+      THEN("OPT does not keep it") { CHECK_FALSE(uut.should_cache(a)); }
+    }
+  }
+}
+
+SCENARIO("Hawkeye learns which PCs are cache-friendly")
+{
+  GIVEN("Hawkeye on a small cache")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE cache{champsim::cache_builder{champsim::defaults::default_llc}
+                    .name("447-uut")
+                    .sets(4)
+                    .ways(4)
+                    .upper_levels({&mock_ul.queues})
+                    .lower_level(&mock_ll.queues)};
+    hawkeye uut{&cache};
+
+    const champsim::address reuse_ip{0x401000};
+    const champsim::address stream_ip{0x402000};
+    const champsim::address prefetch_ip{0x403000};
+
+    WHEN("One PC reuses two lines while another streams")
+    {
+      for (uint64_t i = 0; i < 400; ++i) {
+        uut.update_replacement_state(0, 0, 0, block_in_set_zero(i % 2), reuse_ip, {}, access_type::LOAD, false);
+        uut.update_replacement_state(0, 0, 0, block_in_set_zero(1000 + i), stream_ip, {}, access_type::LOAD, false);
+      }
+
+      THEN("The reusing PC is cache-friendly, and the streaming PC is cache-averse")
+      {
+        CHECK(uut.predict(reuse_ip, false));
+        CHECK_FALSE(uut.predict(stream_ip, false));
+      }
+    }
+
+    WHEN("Every line that a PC demands is next accessed by a prefetch")
+    {
+      for (uint64_t i = 0; i < 400; ++i) {
+        uut.update_replacement_state(0, 0, 0, block_in_set_zero(i % 2), reuse_ip, {}, access_type::LOAD, false);
+        uut.update_replacement_state(0, 0, 0, block_in_set_zero(i % 2), prefetch_ip, {}, access_type::PREFETCH, false);
+      }
+
+      THEN("The demanding PC is cache-averse, since the prefetch brings the line back") { CHECK_FALSE(uut.predict(reuse_ip, false)); }
+    }
+
+    WHEN("A cache-averse line and a cache-friendly line are filled")
+    {
+      for (uint64_t i = 0; i < 400; ++i) {
+        uut.update_replacement_state(0, 0, 0, block_in_set_zero(i % 2), reuse_ip, {}, access_type::LOAD, false);
+        uut.update_replacement_state(0, 0, 0, block_in_set_zero(1000 + i), stream_ip, {}, access_type::LOAD, false);
+      }
+      for (long way = 0; way < 4; ++way)
+        uut.replacement_cache_fill(0, 1, way, block_in_set_zero(0), reuse_ip, {}, access_type::LOAD);
+      uut.replacement_cache_fill(0, 1, 2, block_in_set_zero(2000), stream_ip, {}, access_type::LOAD);
+
+      THEN("The cache-averse line is the victim") { CHECK(uut.find_victim(0, 0, 1, nullptr, reuse_ip, block_in_set_zero(3000), access_type::LOAD) == 2); }
+    }
+
+    THEN("The storage is reported") { CHECK(uut.storage_bits() > 0); }
+  }
+}
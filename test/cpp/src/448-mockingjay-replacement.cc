@@ -0,0 +1,75 @@
+#include <catch.hpp>
+
+#include "../replacement/mockingjay/mockingjay.h"
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+
+namespace
+{
+champsim::address block_in_set_zero(uint64_t n) { return champsim::address{champsim::block_number{n * 4}}; }
+} // namespace
+
+SCENARIO("Mockingjay predicts the reuse distance of each PC")
+{
+  GIVEN("Mockingjay on a small cache")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE cache{champsim::cache_builder{champsim::defaults::default_llc}
+                    .name("448-uut")
+                    .sets(4)
+                    .ways(4)
+                    .upper_levels({&mock_ul.queues})
+                    .lower_level(&mock_ll.queues)};
+    mockingjay uut{&cache};
+
+    const champsim::address reuse_ip{0x401000};
+    const champsim::address stream_ip{0x402000};
+
+    THEN("An untrained PC is predicted to be reused late") { CHECK(uut.predict(reuse_ip, false, 0) == mockingjay::INF_ETR - 1); }
+
+    WHEN("One PC reuses two lines while another streams")
+    {
+      for (uint64_t i = 0; i < 400; ++i) {
+        uut.update_replacement_state(0, 0, 0, block_in_set_zero(i % 2), reuse_ip, {}, access_type::LOAD, false);
+        uut.update_replacement_state(0, 0, 0, block_in_set_zero(1000 + i), stream_ip, {}, access_type::LOAD, false);
+      }
+
+      THEN("The reusing PC is predicted to be reused soon, and the streaming PC never")
+      {
+        CHECK(uut.predict(reuse_ip, false, 0) < 4);
+        CHECK(uut.predict(stream_ip, false, 0) == mockingjay::INF_ETR);
+      }
+
+      THEN("Prefetches by the same PC are predicted separately") { CHECK(uut.predict(reuse_ip, true, 0) == mockingjay::INF_ETR - 1); }
+
+      AND_WHEN("A set is filled by the reusing PC")
+      {
+        for (long way = 0; way < 4; ++way)
+          uut.replacement_cache_fill(0, 1, way, block_in_set_zero(way), reuse_ip, {}, access_type::LOAD);
+
+        THEN("A line from the streaming PC bypasses the cache")
+        {
+          CHECK(uut.find_victim(0, 0, 1, nullptr, stream_ip, block_in_set_zero(3000), access_type::LOAD) == cache.NUM_WAY);
+        }
+
+        THEN("A writeback from the streaming PC does not bypass")
+        {
+          CHECK(uut.find_victim(0, 0, 1, nullptr, stream_ip, block_in_set_zero(3000), access_type::WRITE) < cache.NUM_WAY);
+        }
+      }
+
+      AND_WHEN("A line from the streaming PC is among the lines of a set")
+      {
+        for (long way = 0; way < 4; ++way)
+          uut.replacement_cache_fill(0, 1, way, block_in_set_zero(way), reuse_ip, {}, access_type::LOAD);
+        uut.replacement_cache_fill(0, 1, 3, block_in_set_zero(2000), stream_ip, {}, access_type::WRITE);
+
+        THEN("It is the victim") { CHECK(uut.find_victim(0, 0, 1, nullptr, reuse_ip, block_in_set_zero(3000), access_type::LOAD) == 3); }
+      }
+    }
+
+    THEN("The storage is reported") { CHECK(uut.storage_bits() > 0); }
+  }
+}
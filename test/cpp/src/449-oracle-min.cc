@@ -0,0 +1,250 @@
+#include <catch.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+
+#include "../replacement/oracle_min/oracle_min.h"
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+#include "next_use_index.h"
+
+namespace
+{
+void run(long cycles, const std::array<champsim::operable*, 3>& elements)
+{
+  for (long i = 0; i < cycles; ++i)
+    for (auto elem : elements)
+      elem->_operate();
+}
+
+std::string temp_index(std::string_view name) { return (std::filesystem::temp_directory_path() / name).string(); }
+
+void write_index(const std::string& path, long sets, const std::vector<std::pair<long, uint64_t>>& stream,
+                 std::size_t run_capacity = champsim::next_use_index::recorder::default_run_capacity)
+{
+  champsim::next_use_index::recorder recorder{path, sets, run_capacity};
+  for (auto [set, block] : stream)
+    recorder.record(set, block);
+}
+} // namespace
+
+SCENARIO("The next-use index finds the next demand access to a block")
+{
+  GIVEN("An index of a stream over two sets")
+  {
+    const auto path = temp_index("449-index.min");
+    write_index(path, 2, {{0, 0x10}, {1, 0x21}, {0, 0x12}, {0, 0x10}, {1, 0x21}, {0, 0x14}});
+    champsim::next_use_index uut{path};
+
+    THEN("Every access is indexed") { CHECK(uut.size() == 6); }
+
+    THEN("The positions are counted within each set")
+    {
+      CHECK(uut.next_use(0x10, 0) == 0);
+      CHECK(uut.next_use(0x10, 1) == 2);
+      CHECK(uut.next_use(0x21, 1) == 1);
+      CHECK(uut.next_use(0x14, 0) == 3);
+    }
+
+    THEN("A block that is not used again is never used")
+    {
+      CHECK(uut.next_use(0x10, 3) == champsim::next_use_index::never);
+      CHECK(uut.next_use(0x99, 0) == champsim::next_use_index::never);
+    }
+
+    std::remove(path.c_str());
+  }
+
+  GIVEN("An index recorded in runs of two records")
+  {
+    const auto path = temp_index("449-runs.min");
+    write_index(path, 2, {{0, 0x10}, {1, 0x21}, {0, 0x12}, {0, 0x10}, {1, 0x21}, {0, 0x14}, {0, 0x10}}, 2);
+    champsim::next_use_index uut{path};
+
+    THEN("The runs are merged into one index")
+    {
+      CHECK(uut.size() == 7);
+      CHECK(uut.next_use(0x10, 1) == 2);
+      CHECK(uut.next_use(0x10, 3) == 4);
+      CHECK(uut.next_use(0x21, 1) == 1);
+      CHECK(uut.next_use(0x14, 0) == 3);
+    }
+
+    THEN("The runs are not left behind") { CHECK_FALSE(std::filesystem::exists(path + ".runs")); }
+
+    std::remove(path.c_str());
+  }
+
+  GIVEN("A file that is not an index")
+  {
+    const auto path = temp_index("449-not-an-index.min");
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    std::fputs("Cycle,IP,Address,Type,Result\n", file);
+    std::fclose(file);
+
+    THEN("It is rejected") { CHECK_THROWS_AS(champsim::next_use_index{path}, std::runtime_error); }
+
+    std::remove(path.c_str());
+  }
+}
+
+SCENARIO("The MIN oracle evicts the line used furthest in the future")
+{
+  GIVEN("An oracle on a two-way cache, and a recorded stream")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE cache{champsim::cache_builder{champsim::defaults::default_llc}
+                    .name("449-uut")
+                    .sets(1)
+                    .ways(2)
+                    .upper_levels({&mock_ul.queues})
+                    .lower_level(&mock_ll.queues)};
+
+    const champsim::address a{champsim::block_number{0x10}};
+    const champsim::address b{champsim::block_number{0x11}};
+    const champsim::address c{champsim::block_number{0x12}};
+    const champsim::address d{champsim::block_number{0x13}};
+
+    const auto path = temp_index("449-oracle.min");
+    write_index(path, 1, {{0, 0x10}, {0, 0x11}, {0, 0x12}, {0, 0x10}, {0, 0x12}, {0, 0x13}});
+    oracle_min uut{&cache, path};
+
+    std::array<champsim::cache_block, 2> set{};
+    auto access = [&](champsim::address addr, long way) {
+      uut.update_replacement_state(0, 0, way, addr, champsim::address{}, champsim::address{}, access_type::LOAD, way < 2);
+    };
+    auto fill = [&](champsim::address addr, long way) {
+      uut.replacement_cache_fill(0, 0, way, addr, champsim::address{}, champsim::address{}, access_type::LOAD);
+      set.at(static_cast<std::size_t>(way)).valid = true;
+      set.at(static_cast<std::size_t>(way)).address = addr;
+    };
+
+    access(a, 2);
+    fill(a, 0);
+    access(b, 2);
+    fill(b, 1);
+
+    THEN("Each line knows its next use") { CHECK(uut.next_use(0, 0) == 3); }
+
+    WHEN("A block that is used again soon misses")
+    {
+      access(c, 2);
+
+      THEN("The block that is never used again is evicted")
+      {
+        CHECK(uut.find_victim(0, 0, 0, std::data(set), champsim::address{}, c, access_type::LOAD) == 1);
+      }
+
+      AND_WHEN("The rest of the stream is replayed, up to a block that is never used again")
+      {
+        fill(c, 1);
+        access(a, 0);
+        access(c, 1);
+        access(d, 2);
+
+        THEN("The block bypasses the cache") { CHECK(uut.find_victim(0, 0, 0, std::data(set), champsim::address{}, d, access_type::LOAD) == 2); }
+
+        THEN("Every access matched the recording")
+        {
+          CHECK(uut.next_use(0, 0) == champsim::next_use_index::never);
+          CHECK(uut.next_use(0, 1) == champsim::next_use_index::never);
+        }
+      }
+    }
+
+    std::remove(path.c_str());
+  }
+}
+
+SCENARIO("A cache records its demand stream for the oracle")
+{
+  GIVEN("A cache that is told to record its demand accesses")
+  {
+    const auto dir = std::filesystem::temp_directory_path().string();
+    setenv("CHAMPSIM_ORACLE_RECORD", "449-record", 1);
+    setenv("CHAMPSIM_TRACE_DIR", dir.c_str(), 1);
+    setenv("CHAMPSIM_TRACE_ID", "449", 1);
+    const auto path = champsim::next_use_index::default_path("449-record");
+
+    WHEN("Three loads are made, one of them twice")
+    {
+      {
+        do_nothing_MRC mock_ll;
+        to_rq_MRP mock_ul;
+        CACHE uut{champsim::cache_builder{champsim::defaults::default_l1d}.name("449-record").upper_levels({&mock_ul.queues}).lower_level(&mock_ll.queues)};
+
+        std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+        for (auto elem : elements) {
+          elem->initialize();
+          elem->warmup = false;
+          elem->begin_phase();
+        }
+
+        for (uint64_t addr : {0xdeadbe40, 0xcafebac0, 0xdeadbe40}) {
+          decltype(mock_ul)::request_type pkt;
+          pkt.address = champsim::address{addr};
+          pkt.v_address = pkt.address;
+          pkt.type = access_type::LOAD;
+          REQUIRE(mock_ul.issue(pkt));
+          run(100, elements);
+        }
+        CHECK(uut.prefetch_line(champsim::address{0xfeedfac0}, true, 0));
+        run(100, elements);
+      }
+      unsetenv("CHAMPSIM_ORACLE_RECORD");
+
+      THEN("The index holds the demand accesses, but not the prefetch")
+      {
+        champsim::next_use_index index{path};
+        CHECK(index.size() == 3);
+        CHECK(index.next_use(champsim::block_number{champsim::address{0xfeedfac0}}.to<uint64_t>(), 0) == champsim::next_use_index::never);
+      }
+
+      std::remove(path.c_str());
+    }
+
+    WHEN("A second load must wait for the only MSHR")
+    {
+      {
+        release_MRC mock_ll;
+        to_rq_MRP mock_ul;
+        CACHE uut{champsim::cache_builder{champsim::defaults::default_l1d}
+                      .name("449-record")
+                      .mshr_size(1)
+                      .upper_levels({&mock_ul.queues})
+                      .lower_level(&mock_ll.queues)};
+
+        std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+        for (auto elem : elements) {
+          elem->initialize();
+          elem->warmup = false;
+          elem->begin_phase();
+        }
+
+        for (uint64_t addr : {0xdeadbe40, 0xcafebac0}) {
+          decltype(mock_ul)::request_type pkt;
+          pkt.address = champsim::address{addr};
+          pkt.v_address = pkt.address;
+          pkt.type = access_type::LOAD;
+          REQUIRE(mock_ul.issue(pkt));
+        }
+        run(100, elements);
+      }
+      unsetenv("CHAMPSIM_ORACLE_RECORD");
+
+      THEN("Only the load that was handled is recorded, however often the other was retried")
+      {
+        champsim::next_use_index index{path};
+        CHECK(index.size() == 1);
+      }
+
+      std::remove(path.c_str());
+    }
+
+    unsetenv("CHAMPSIM_ORACLE_RECORD");
+    unsetenv("CHAMPSIM_TRACE_DIR");
+    unsetenv("CHAMPSIM_TRACE_ID");
+  }
+}
@@ -0,0 +1,89 @@
+#include <catch.hpp>
+#include <random>
+
+#include "../../../prefetcher/pythia/feature_knowledge.h"
+#include "../../../prefetcher/pythia/pythia.h"
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+
+namespace
+{
+State random_state(std::mt19937_64& rng)
+{
+  State state{};
+  state.reset();
+  state.pc = rng() % 64;
+  state.delta = static_cast<int32_t>(rng() % 32) - 16;
+  return state;
+}
+} // namespace
+
+TEST_CASE("Retrieving the Q-values of all actions at once matches retrieving them one at a time")
+{
+  auto feature = GENERATE(F_PC, F_PC_Delta);
+  const auto num_actions = static_cast<uint32_t>(PYTHIA::actions.size());
+  FeatureKnowledge uut{feature, PYTHIA::alpha, PYTHIA::gamma, num_actions, 3, 128, 2, 1};
+  std::mt19937_64 rng{static_cast<uint64_t>(feature)};
+
+  // Train the table with random transitions
+  for (int i = 0; i < 10000; ++i) {
+    auto state1 = random_state(rng);
+    auto state2 = random_state(rng);
+    auto reward = static_cast<int32_t>(rng() % 41) - 20;
+    uut.updateQ(&state1, static_cast<uint32_t>(rng() % num_actions), reward, &state2, static_cast<uint32_t>(rng() % num_actions));
+  }
+
+  REQUIRE(uut.getRowStride() >= num_actions);
+  REQUIRE(uut.getRowStride() % 16 == 0);
+
+  for (int i = 0; i < 1000; ++i) {
+    auto state = random_state(rng);
+    std::vector<float> q_values(uut.getRowStride());
+    uut.retrieveQ(&state, q_values.data());
+
+    float max_q_value = 0.0;
+    uint32_t selected_action = 0;
+    for (uint32_t action = 0; action < num_actions; ++action) {
+      auto q_value = uut.retrieveQ(&state, action);
+      REQUIRE(q_values.at(action) == q_value);
+      if (q_value > max_q_value) {
+        max_q_value = q_value;
+        selected_action = action;
+      }
+    }
+
+    REQUIRE(uut.getMaxAction(&state) == selected_action);
+  }
+}
+
+TEST_CASE("pythia benchmark")
+{
+  BENCHMARK_ADVANCED("pythia::prefetcher_cache_operate()")(Catch::Benchmark::Chronometer meter)
+  {
+    do_nothing_MRC mock_ll;
+    do_nothing_MRC mock_lt;
+    to_rq_MRP mock_ul{[](auto x, auto y) {
+      return x.v_address == y.v_address;
+    }};
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}
+                  .name("454-uut-benchmark[pythia::prefetcher_cache_operate()]")
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)
+                  .lower_translate(&mock_lt.queues)
+                  .prefetcher<pythia>()};
+    uut.impl_prefetcher_initialize();
+
+    // A mix of streams over a few pages, so that the state features vary between accesses
+    std::vector<champsim::address> addrs{};
+    for (uint64_t i = 0; i < 4096; ++i)
+      addrs.emplace_back(0x10000000 + ((i % 8) << LOG2_PAGE_SIZE) + (((i / 8) * (1 + i % 3)) % 64 << LOG2_BLOCK_SIZE));
+
+    meter.measure([&](int i) {
+      auto addr = addrs.at(static_cast<std::size_t>(i) % std::size(addrs));
+      return uut.impl_prefetcher_cache_operate(addr, champsim::address{0x400000 + 4 * (static_cast<uint64_t>(i) % 16)}, false, false, access_type::LOAD,
+                                               uint32_t{});
+    });
+  };
+  SUCCEED();
+}
@@ -0,0 +1,82 @@
+#include <catch.hpp>
+#include <tuple>
+
+#include "../../../prefetcher/pythia/pythia.h"
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+
+namespace
+{
+struct pythia_trace_result {
+  uint64_t pf_requested;
+  uint64_t requests_hash;
+  std::size_t lower_level_requests;
+  uint64_t lower_level_hash;
+};
+
+uint64_t fnv1a(uint64_t hash, uint64_t value)
+{
+  constexpr uint64_t prime = 1099511628211ULL;
+  return (hash ^ value) * prime;
+}
+
+/*
+ * Replay a fixed stream of L2 accesses into Pythia: several interleaved streams with different strides and PCs,
+ * spread over more pages than the signature table holds.
+ */
+pythia_trace_result replay_access_stream()
+{
+  do_nothing_MRC mock_ll{20};
+  do_nothing_MRC mock_lt;
+  to_rq_MRP mock_ul;
+  CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}
+                .name("455-uut")
+                .upper_levels({&mock_ul.queues})
+                .lower_level(&mock_ll.queues)
+                .lower_translate(&mock_lt.queues)
+                .prefetcher<pythia>()};
+
+  std::array<champsim::operable*, 4> elements{{&mock_ll, &mock_lt, &mock_ul, &uut}};
+  for (auto elem : elements) {
+    elem->initialize();
+    elem->warmup = false;
+    elem->begin_phase();
+  }
+
+  constexpr uint64_t offset_basis = 14695981039346656037ULL;
+  pythia_trace_result result{0, offset_basis, 0, offset_basis};
+  uint64_t lcg = 1;
+  for (uint64_t i = 0; i < 20000; ++i) {
+    lcg = lcg * 6364136223846793005ULL + 1442695040888963407ULL;
+    auto stream = (lcg >> 33) % 4;
+    auto page = 0x10000 + stream * 0x1000 + (i / 128) % 96;
+    auto offset = (i * (stream + 1) + (lcg >> 60)) % 64;
+    champsim::address addr{(page << LOG2_PAGE_SIZE) + (offset << LOG2_BLOCK_SIZE)};
+    champsim::address ip{0x400000 + 0x40 * stream + 4 * ((lcg >> 40) % 2)};
+
+    auto before = uut.sim_stats.pf_requested;
+    std::ignore = uut.impl_prefetcher_cache_operate(addr, ip, false, false, access_type::LOAD, 0);
+    result.requests_hash = fnv1a(result.requests_hash, uut.sim_stats.pf_requested - before);
+
+    for (auto elem : elements)
+      elem->_operate();
+  }
+
+  result.pf_requested = uut.sim_stats.pf_requested;
+  result.lower_level_requests = std::size(mock_ll.addresses);
+  for (auto addr : mock_ll.addresses)
+    result.lower_level_hash = fnv1a(result.lower_level_hash, addr.to<uint64_t>());
+  return result;
+}
+} // namespace
+
+TEST_CASE("Pythia makes the same prefetch decisions as the pointer-based tracking tables")
+{
+  // Recorded from the implementation that kept the prefetch tracker and signature table in deques of heap-allocated entries
+  auto result = replay_access_stream();
+  CHECK(result.pf_requested == 16364);
+  CHECK(result.requests_hash == 0x7966773228da50d5);
+  CHECK(result.lower_level_requests == 13465);
+  CHECK(result.lower_level_hash == 0x5f9aada09ee68a7f);
+}
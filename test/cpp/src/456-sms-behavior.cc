@@ -0,0 +1,83 @@
+#include <catch.hpp>
+#include <tuple>
+
+#include "../../../prefetcher/sms/sms.h"
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+
+namespace
+{
+constexpr unsigned region_bits = 11; // 2KB spatial regions
+
+champsim::address region_address(uint64_t region, uint64_t offset) { return champsim::address{(region << region_bits) + (offset << LOG2_BLOCK_SIZE)}; }
+} // namespace
+
+SCENARIO("The sms prefetcher replays the spatial pattern of a previous generation")
+{
+  GIVEN("A cache whose prefetcher has recorded the pattern of one region")
+  {
+    do_nothing_MRC mock_ll;
+    do_nothing_MRC mock_lt;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}
+                  .name("456-uut")
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)
+                  .lower_translate(&mock_lt.queues)
+                  .prefetcher<sms>()};
+
+    std::array<champsim::operable*, 4> elements{{&mock_ll, &mock_lt, &mock_ul, &uut}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    const champsim::address trigger_ip{0xcafecafe};
+    const uint64_t trained_region = 0x1000;
+    const std::array<uint64_t, 3> pattern{{3, 5, 9}};
+
+    std::ignore = uut.impl_prefetcher_cache_operate(region_address(trained_region, 0), trigger_ip, false, false, access_type::LOAD, 0);
+    for (auto offset : pattern)
+      std::ignore = uut.impl_prefetcher_cache_operate(region_address(trained_region, offset), trigger_ip, false, false, access_type::LOAD, 0);
+
+    // End the generation by displacing the region from its accumulation table set with regions accessed by other IPs
+    for (uint64_t i = 1; i <= 8; ++i) {
+      auto region = trained_region + 4 * i;
+      champsim::address other_ip{0x400000 + 4 * i};
+      std::ignore = uut.impl_prefetcher_cache_operate(region_address(region, 0), other_ip, false, false, access_type::LOAD, 0);
+      std::ignore = uut.impl_prefetcher_cache_operate(region_address(region, 1), other_ip, false, false, access_type::LOAD, 0);
+    }
+
+    WHEN("The same IP triggers a new region at the same offset")
+    {
+      const uint64_t new_region = 0x2001;
+      std::ignore = uut.impl_prefetcher_cache_operate(region_address(new_region, 0), trigger_ip, false, false, access_type::LOAD, 0);
+
+      for (auto i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("The blocks of the recorded pattern are prefetched in the new region")
+      {
+        std::vector<champsim::address> expected{};
+        for (auto offset : pattern)
+          expected.push_back(region_address(new_region, offset));
+        std::vector<champsim::address> actual{std::begin(mock_ll.addresses), std::end(mock_ll.addresses)};
+        REQUIRE_THAT(actual, Catch::Matchers::UnorderedEquals(expected));
+      }
+    }
+
+    WHEN("A different IP triggers a new region")
+    {
+      std::ignore = uut.impl_prefetcher_cache_operate(region_address(0x2001, 0), champsim::address{0xbeefbeef}, false, false, access_type::LOAD, 0);
+
+      for (auto i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("Nothing is prefetched") { REQUIRE(std::empty(mock_ll.addresses)); }
+    }
+  }
+}
@@ -0,0 +1,52 @@
+#include <catch.hpp>
+
+#include "../../../prefetcher/ip_stride/ip_stride.h"
+#include "../../../prefetcher/next_line/next_line.h"
+#include "../../../prefetcher/pythia/pythia.h"
+#include "../../../prefetcher/sms/sms.h"
+#include "../../../prefetcher/va_ampm_lite/va_ampm_lite.h"
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+
+/*
+ * The cost of each prefetcher per access, on a common access stream. The reciprocal of the mean is the prefetcher's
+ * throughput in accesses per second, which bounds how fast the simulator can run with that prefetcher attached.
+ */
+TEMPLATE_TEST_CASE("prefetcher throughput", "", next_line, ip_stride, va_ampm_lite, sms, pythia)
+{
+  BENCHMARK_ADVANCED("prefetcher accesses")(Catch::Benchmark::Chronometer meter)
+  {
+    do_nothing_MRC mock_ll;
+    do_nothing_MRC mock_lt;
+    to_rq_MRP mock_ul{[](auto x, auto y) {
+      return x.v_address == y.v_address;
+    }};
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}
+                  .name("457-uut-benchmark")
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)
+                  .lower_translate(&mock_lt.queues)
+                  .prefetcher<TestType>()};
+    uut.impl_prefetcher_initialize();
+
+    // A mix of strided streams from a few IPs over more pages than fit in most prefetchers' tables
+    std::vector<std::pair<champsim::address, champsim::address>> accesses{};
+    uint64_t lcg = 1;
+    for (uint64_t i = 0; i < 16384; ++i) {
+      lcg = lcg * 6364136223846793005ULL + 1442695040888963407ULL;
+      auto stream = (lcg >> 33) % 8;
+      auto page = 0x10000 + stream * 0x1000 + (i / 256) % 128;
+      auto offset = (i * (stream + 1)) % 64;
+      accesses.emplace_back(champsim::address{(page << LOG2_PAGE_SIZE) + (offset << LOG2_BLOCK_SIZE)}, champsim::address{0x400000 + 0x40 * stream});
+    }
+
+    meter.measure([&](int i) {
+      auto [addr, ip] = accesses.at(static_cast<std::size_t>(i) % std::size(accesses));
+      auto result = uut.impl_prefetcher_cache_operate(addr, ip, false, false, access_type::LOAD, uint32_t{});
+      uut.impl_prefetcher_cycle_operate();
+      return result;
+    });
+  };
+  SUCCEED();
+}
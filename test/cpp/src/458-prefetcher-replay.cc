@@ -0,0 +1,96 @@
+#include <catch.hpp>
+#include <sstream>
+
+#include "../../../prefetcher/next_line/next_line.h"
+#include "../../../tools/prefetcher_replay/prefetcher_replay.h"
+
+namespace
+{
+// A sequential stream of loads from one IP, one block every few cycles
+std::vector<champsim::replay::record> sequential_records(uint64_t count, long spacing)
+{
+  std::vector<champsim::replay::record> records{};
+  for (uint64_t i = 0; i < count; ++i) {
+    records.push_back({static_cast<long>(i) * spacing + 1000, champsim::address{0x401000}, champsim::address{0x10000000 + (i << LOG2_BLOCK_SIZE)},
+                       access_type::LOAD, false});
+  }
+  return records;
+}
+} // namespace
+
+TEST_CASE("Replay records are read from the cache access stream format")
+{
+  std::istringstream stream{"Cycle,IP,Address,Type,Result\n"
+                            "1200,401000,deadbe40,LOAD,MISS\n"
+                            "1210,401004,deadbe80,RFO,HIT\n"
+                            "1230,0,deadbec0,PREFETCH,MISS\n"};
+  auto records = champsim::replay::read_records(stream);
+
+  REQUIRE(std::size(records) == 3);
+  CHECK(records.at(0).cycle == 1200);
+  CHECK(records.at(0).ip == champsim::address{0x401000});
+  CHECK(records.at(0).address == champsim::address{0xdeadbe40});
+  CHECK(records.at(0).type == access_type::LOAD);
+  CHECK_FALSE(records.at(0).hit);
+  CHECK(records.at(1).type == access_type::RFO);
+  CHECK(records.at(1).hit);
+  CHECK(records.at(2).type == access_type::PREFETCH);
+}
+
+TEST_CASE("Malformed replay records are rejected")
+{
+  std::istringstream stream{"1200,401000,deadbe40,FETCH,MISS\n"};
+  CHECK_THROWS_AS(champsim::replay::read_records(stream), std::invalid_argument);
+}
+
+TEST_CASE("Replaying a stream without a prefetcher issues no prefetches")
+{
+  auto result = champsim::replay::replay_with<no>(sequential_records(1000, 20), {});
+
+  CHECK(result.accesses == 1000);
+  CHECK(result.stats.pf_issued == 0);
+  CHECK(result.demand_miss_rate() == 1.0);
+}
+
+TEST_CASE("Replaying a sequential stream through a next-line prefetcher finds useful prefetches")
+{
+  auto result = champsim::replay::replay_with<next_line>(sequential_records(1000, 20), {});
+
+  CHECK(result.accesses == 1000);
+  CHECK(result.stats.pf_issued > 0);
+  CHECK(result.stats.pf_useful > 0);
+  CHECK(result.stats.pf_late <= result.stats.pf_useful);
+  CHECK(result.demand_miss_rate() < 1.0);
+}
+
+TEST_CASE("Prefetches are late when accesses arrive faster than the memory latency")
+{
+  // next_line prefetches 20 blocks ahead, so a block arrives in time only if 20 accesses take longer than the memory latency
+  champsim::replay::options opts{};
+  opts.memory_latency = 200;
+  auto timely = champsim::replay::replay_with<next_line>(sequential_records(1000, 400), opts);
+  auto rushed = champsim::replay::replay_with<next_line>(sequential_records(1000, 5), opts);
+
+  CHECK(timely.stats.pf_late == 0);
+  CHECK(rushed.stats.pf_late > 0);
+}
+
+TEST_CASE("Recorded prefetches are not replayed")
+{
+  auto records = sequential_records(100, 20);
+  records.at(10).type = access_type::PREFETCH;
+  auto result = champsim::replay::replay_with<no>(records, {});
+
+  CHECK(result.accesses == 99);
+  CHECK(result.skipped == 1);
+}
+
+TEST_CASE("Prefetchers can be registered for replay by name")
+{
+  champsim::replay::registration<next_line> registered{"458-next_line"};
+  auto& registry = champsim::replay::registry();
+
+  REQUIRE(registry.count("458-next_line") == 1);
+  auto result = registry.at("458-next_line")(sequential_records(100, 20), {});
+  CHECK(result.accesses == 100);
+}
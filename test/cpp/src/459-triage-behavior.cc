@@ -0,0 +1,111 @@
+#include <catch.hpp>
+
+#include "../../../prefetcher/triage/triage.h"
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+
+namespace
+{
+void run(long cycles, const std::array<champsim::operable*, 3>& elements)
+{
+  for (long i = 0; i < cycles; ++i)
+    for (auto elem : elements)
+      elem->_operate();
+}
+
+void replay(to_rq_MRP& mock_ul, const std::array<champsim::operable*, 3>& elements, int rounds)
+{
+  static uint64_t id = 1;
+  for (int round = 0; round < rounds; ++round) {
+    for (uint64_t block : {0x1000, 0x2345, 0x0777, 0x4242, 0x1999, 0x3003}) {
+      to_rq_MRP::request_type pkt;
+      pkt.address = champsim::address{champsim::block_number{block}};
+      pkt.v_address = pkt.address;
+      pkt.ip = champsim::address{0xcafecafe};
+      pkt.instr_id = id++;
+      pkt.cpu = 0;
+      REQUIRE(mock_ul.issue(pkt));
+      run(30, elements);
+    }
+  }
+}
+} // namespace
+
+SCENARIO("The triage prefetcher learns a repeating miss sequence")
+{
+  GIVEN("A single-set cache with a metadata store and three data ways")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l1d}
+                  .name("459-uut")
+                  .sets(1)
+                  .ways(4)
+                  .metadata_ways(1)
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)
+                  .prefetcher<triage>()};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("The sequence is seen once")
+    {
+      replay(mock_ul, elements, 1);
+
+      THEN("The correlations are recorded, but nothing is prefetched")
+      {
+        CHECK(uut.sim_stats.metadata_writes > 0);
+        CHECK(uut.sim_stats.pf_issued == 0);
+      }
+    }
+
+    WHEN("The sequence repeats")
+    {
+      replay(mock_ul, elements, 3);
+
+      THEN("The recorded successors are prefetched, and are useful")
+      {
+        CHECK(uut.sim_stats.metadata_read_hits > 0);
+        CHECK(uut.sim_stats.pf_issued > 0);
+        CHECK(uut.sim_stats.pf_useful > 0);
+      }
+    }
+  }
+
+  GIVEN("A cache without a metadata store")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l1d}
+                  .name("459-uut")
+                  .sets(1)
+                  .ways(4)
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)
+                  .prefetcher<triage>()};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("The sequence repeats")
+    {
+      replay(mock_ul, elements, 3);
+
+      THEN("Nothing is recorded or prefetched")
+      {
+        CHECK(uut.sim_stats.metadata_writes == 0);
+        CHECK(uut.sim_stats.pf_issued == 0);
+      }
+    }
+  }
+}
@@ -224,4 +224,52 @@ TEST_CASE("Multicore stats are tracked separately")
   expected.at(line_index_cpu1) = expected_line_cpu1;
 
   REQUIRE_THAT(champsim::plain_printer::format(given), Catch::Matchers::RangeEquals(expected));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Prefetch timeliness is printed when prefetches are classified")
+{
+  cache_stats given{};
+  given.name = "test_cache";
+  given.pf_useful = 3;
+  given.pf_timely = 2;
+  given.pf_late = 1;
+  given.pf_early = 4;
+  given.pf_fill_to_use.set(0, 1);
+  given.pf_fill_to_use.set(5, 1);
+  given.mshr_return.set({access_type::PREFETCH, 0}, 1);
+
+  std::vector<std::string> expected{"cpu0->test_cache TOTAL        ACCESS:          0 HIT:          0 MISS:          0 MSHR_MERGE:          0",
+                                    "cpu0->test_cache LOAD         ACCESS:          0 HIT:          0 MISS:          0 MSHR_MERGE:          0",
+                                    "cpu0->test_cache RFO          ACCESS:          0 HIT:          0 MISS:          0 MSHR_MERGE:          0",
+                                    "cpu0->test_cache PREFETCH     ACCESS:          0 HIT:          0 MISS:          0 MSHR_MERGE:          0",
+                                    "cpu0->test_cache WRITE        ACCESS:          0 HIT:          0 MISS:          0 MSHR_MERGE:          0",
+                                    "cpu0->test_cache TRANSLATION  ACCESS:          0 HIT:          0 MISS:          0 MSHR_MERGE:          0",
+                                    "cpu0->test_cache PREFETCH REQUESTED:          0 ISSUED:          0 USEFUL:          3 USELESS:          0",
+                                    "cpu0->test_cache PREFETCH TIMELY:          2 LATE:          1 EARLY:          4",
+                                    "cpu0->test_cache PREFETCH FILL TO USE CYCLES <1: 1 <32: 1",
+                                    "cpu0->test_cache AVERAGE MISS LATENCY: - cycles"};
+
+  REQUIRE_THAT(champsim::plain_printer::format(given), Catch::Matchers::RangeEquals(expected));
+}
+
+TEST_CASE("Prefetches are attributed to each module when several are combined")
+{
+  cache_stats given{};
+  given.name = "test_cache";
+  given.pf_issued = 5;
+  given.pf_sources = {{"first", 3, 2, 1, 0}, {"second", 2, 0, 0, 1}};
+  given.mshr_return.set({access_type::PREFETCH, 0}, 1);
+
+  std::vector<std::string> expected{"cpu0->test_cache TOTAL        ACCESS:          0 HIT:          0 MISS:          0 MSHR_MERGE:          0",
+                                    "cpu0->test_cache LOAD         ACCESS:          0 HIT:          0 MISS:          0 MSHR_MERGE:          0",
+                                    "cpu0->test_cache RFO          ACCESS:          0 HIT:          0 MISS:          0 MSHR_MERGE:          0",
+                                    "cpu0->test_cache PREFETCH     ACCESS:          0 HIT:          0 MISS:          0 MSHR_MERGE:          0",
+                                    "cpu0->test_cache WRITE        ACCESS:          0 HIT:          0 MISS:          0 MSHR_MERGE:          0",
+                                    "cpu0->test_cache TRANSLATION  ACCESS:          0 HIT:          0 MISS:          0 MSHR_MERGE:          0",
+                                    "cpu0->test_cache PREFETCH REQUESTED:          0 ISSUED:          5 USEFUL:          0 USELESS:          0",
+                                    "cpu0->test_cache PREFETCHER first ISSUED:          3 USEFUL:          2 LATE:          1 USELESS:          0",
+                                    "cpu0->test_cache PREFETCHER second ISSUED:          2 USEFUL:          0 LATE:          0 USELESS:          1",
+                                    "cpu0->test_cache AVERAGE MISS LATENCY: - cycles"};
+
+  REQUIRE_THAT(champsim::plain_printer::format(given), Catch::Matchers::RangeEquals(expected));
+}
@@ -0,0 +1,62 @@
+#include <catch.hpp>
+
+#include "dram_controller.h"
+#include "vmem.h"
+
+SCENARIO("The virtual memory can reserve physical memory that translations do not use")
+{
+  GIVEN("A shuffled virtual memory")
+  {
+    constexpr unsigned levels = 5;
+    constexpr champsim::data::bytes pte_page_size{1ull << 12};
+    MEMORY_CONTROLLER dram{champsim::chrono::picoseconds{3200},
+                           champsim::chrono::picoseconds{6400},
+                           std::size_t{18},
+                           std::size_t{18},
+                           std::size_t{18},
+                           std::size_t{38},
+                           champsim::chrono::microseconds{64000},
+                           {},
+                           64,
+                           64,
+                           1,
+                           champsim::data::bytes{8},
+                           1024,
+                           1024,
+                           4,
+                           4,
+                           4,
+                           8192};
+    VirtualMemory uut{pte_page_size, levels, std::chrono::nanoseconds{6400}, dram, 804};
+    std::size_t original_size = uut.available_ppages();
+
+    WHEN("A region of sixteen pages is reserved")
+    {
+      const champsim::data::bytes region_size{16 * PAGE_SIZE};
+      auto base = uut.reserve_region(region_size);
+      auto end = base + region_size;
+
+      THEN("The pages are removed from the available pages") { REQUIRE(original_size - 16 == uut.available_ppages()); }
+
+      THEN("The region begins on a page boundary") { REQUIRE(champsim::page_offset{base}.to<uint64_t>() == 0); }
+
+      THEN("No translation falls in the region")
+      {
+        for (uint64_t vpage = 0; vpage < 1024; ++vpage) {
+          auto [ppage, delay] = uut.va_to_pa(0, champsim::page_number{vpage});
+          champsim::address paddr{ppage};
+          REQUIRE((paddr < base || paddr >= end));
+        }
+      }
+
+      AND_WHEN("Another region is reserved")
+      {
+        auto other_base = uut.reserve_region(champsim::data::bytes{1});
+
+        THEN("The size is rounded up to a whole page") { REQUIRE(original_size - 17 == uut.available_ppages()); }
+
+        THEN("The regions do not overlap") { REQUIRE((other_base + champsim::data::bytes{PAGE_SIZE} <= base || other_base >= end)); }
+      }
+    }
+  }
+}
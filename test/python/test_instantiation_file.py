@@ -74,6 +74,15 @@ class CpuBuilderTest(unittest.TestCase):
     def test_mispredict_penalty(self):
         self.get_element_diff(['.mispredict_penalty(1)'], mispredict_penalty=1)
 
+    def test_ssit_size(self):
+        self.get_element_diff(['.ssit_size(1)'], ssit_size=1)
+
+    def test_lfst_size(self):
+        self.get_element_diff(['.lfst_size(1)'], lfst_size=1)
+
+    def test_memory_violation_penalty(self):
+        self.get_element_diff(['.memory_violation_penalty(1)'], memory_violation_penalty=1)
+
     def test_decode_latency(self):
         self.get_element_diff(['.decode_latency(1)'], decode_latency=1)
 
@@ -112,6 +121,53 @@ class CpuBuilderTest(unittest.TestCase):
         self.get_element_diff(['.btb<class a_class>()'], _btb_data=[{ 'name': 'a', 'class': 'a_class' }])
         self.get_element_diff(['.btb<class a_class, class b_class>()'], _btb_data=[{ 'name': 'a', 'class': 'a_class' }, { 'name': 'b', 'class': 'b_class' }])
 
+    def test_btb_levels(self):
+        self.get_element_diff(['.btb_level(1, 16, 0)', '.btb_level(64, 4, 1)'], btb_levels=[{ 'sets': 1, 'ways': 16 }, { 'sets': 64, 'ways': 4, 'latency': 1 }])
+
+class FixedShapeCpuTests(unittest.TestCase):
+
+    def setUp(self):
+        self.caches = [{ 'name': 'test_L1I' }, { 'name': 'test_L1D' }]
+        self.ul_pairs = [('test_L1I', 'test_cpu'), ('test_L1D', 'test_cpu')]
+        self.cpu = { 'name': 'test_cpu', '_index': 0, 'L1I': 'test_L1I', 'L1D': 'test_L1D', 'rob_size': 1, 'DIB': { 'ways': 2 }, 'fixed_shape': True }
+
+    def test_shape_holds_dimensions(self):
+        shape = [l.strip() for l in config.instantiation_file.get_cpu_shape(self.cpu)]
+        self.assertIn('.rob_size(1)', shape)
+        self.assertIn('.dib_way(2)', shape)
+
+    def test_shape_holds_btb_levels(self):
+        cpu = { **self.cpu, 'btb_levels': [{ 'sets': 64, 'ways': 4, 'latency': 1 }] }
+        shape = [l.strip() for l in config.instantiation_file.get_cpu_shape(cpu)]
+        builder = [l.strip() for l in config.instantiation_file.get_cpu_builder(cpu, self.caches, self.ul_pairs, build_id='abc')]
+        self.assertIn('.btb_level(64, 4, 1)', shape)
+        self.assertNotIn('.btb_level(64, 4, 1)', builder)
+
+    def test_shape_does_not_hold_system_parts(self):
+        shape = [l.strip() for l in config.instantiation_file.get_cpu_shape(self.cpu)]
+        self.assertFalse(any(l.startswith(('.l1i', '.fetch_queues', '.data_queues', '.index')) for l in shape))
+
+    def test_builder_starts_from_shape(self):
+        builder = [l.strip() for l in config.instantiation_file.get_cpu_builder(self.cpu, self.caches, self.ul_pairs, build_id='abc')]
+        self.assertEqual(builder[0], 'champsim::core_builder{ champsim::configured::core_shape_abc_0 }')
+        self.assertIn('.index(0)', builder)
+        self.assertNotIn('.rob_size(1)', builder)
+        self.assertNotIn('.dib_way(2)', builder)
+
+    def test_cpu_type(self):
+        self.assertEqual(config.instantiation_file.get_cpu_type(self.cpu, 'abc'), 'champsim::fixed_core<champsim::configured::core_shape_abc_0>')
+        self.assertEqual(config.instantiation_file.get_cpu_type({ **self.cpu, 'fixed_shape': False }, 'abc'), 'O3_CPU')
+
+    def test_header_without_fixed_cores_uses_list(self):
+        header = list(config.instantiation_file.get_instantiation_header(1, { 'block_size': 64, 'page_size': 4096 }, 'abc', cores=[{ **self.cpu, 'fixed_shape': False }]))
+        self.assertIn('std::forward_list<O3_CPU> cores;', (l.strip() for l in header))
+
+    def test_header_with_fixed_cores_uses_tuple(self):
+        other_cpu = { 'name': 'other_cpu', '_index': 1 }
+        header = list(config.instantiation_file.get_instantiation_header(2, { 'block_size': 64, 'page_size': 4096 }, 'abc', cores=[self.cpu, other_cpu]))
+        self.assertIn('std::tuple<O3_CPU, champsim::fixed_core<champsim::configured::core_shape_abc_0>> cores;', (l.strip() for l in header))
+        self.assertIn('inline constexpr auto core_shape_abc_0 =', (l.strip() for l in header))
+
 class CacheBuilderTests(unittest.TestCase):
 
     def get_element_diff(self, added_lines, **kwargs):
@@ -172,6 +228,10 @@ class CacheBuilderTests(unittest.TestCase):
         self.get_element_diff(['.set_virtual_prefetch()'], virtual_prefetch=True)
         self.get_element_diff(['.reset_virtual_prefetch()'], virtual_prefetch=False)
 
+    def test_metadata_offchip(self):
+        self.get_element_diff(['.set_metadata_offchip()', '.metadata_region(vmem.reserve_region(CACHE::metadata_region_size))'], metadata_offchip=True)
+        self.get_element_diff(['.reset_metadata_offchip()'], metadata_offchip=False)
+
     def test_prefetch_activate(self):
         self.get_element_diff(['.prefetch_activate(access_type::LOAD)'], prefetch_activate=['LOAD'])
         self.get_element_diff(['.prefetch_activate(access_type::LOAD, access_type::WRITE)'], prefetch_activate=['LOAD', 'WRITE'])
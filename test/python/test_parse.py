@@ -321,6 +321,15 @@ class ParseNormalizedTests(unittest.TestCase):
                 module_names = [c.get(module_key) for c in caches]
                 self.assertNotIn(None, module_names)
 
+    def test_caches_keep_each_listed_prefetcher_once(self):
+        test_config = config.parse.NormalizedConfiguration({ 'L1D': { 'prefetcher': ['first', 'second'] } })
+
+        result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
+        caches = result[0]['caches']
+
+        l1d = caches[[c['name'] for c in caches].index(result[0]['cores'][0]['L1D'])]
+        self.assertEqual(len(l1d['_prefetcher_data']), 2)
+
 class NormalizeConfigTest(unittest.TestCase):
 
     def test_empty_config_creates_defaults(self):
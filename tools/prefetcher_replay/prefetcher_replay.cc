@@ -0,0 +1,183 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "prefetcher_replay.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+
+#include "inf_stream.h"
+
+namespace
+{
+access_type parse_access_type(std::string_view name)
+{
+  auto found = std::find(std::begin(access_type_names), std::end(access_type_names), name);
+  if (found == std::end(access_type_names))
+    throw std::invalid_argument{"Unknown access type in replay record: " + std::string{name}};
+  return static_cast<access_type>(std::distance(std::begin(access_type_names), found));
+}
+
+champsim::replay::record parse_record(const std::string& line)
+{
+  std::array<std::string, 5> fields{};
+  std::istringstream line_stream{line};
+  for (auto& field : fields) {
+    if (!std::getline(line_stream, field, ','))
+      throw std::invalid_argument{"Malformed replay record: " + line};
+  }
+
+  champsim::replay::record retval{};
+  retval.cycle = std::stol(fields[0]);
+  retval.ip = champsim::address{std::stoull(fields[1], nullptr, 16)};
+  retval.address = champsim::address{std::stoull(fields[2], nullptr, 16)};
+  retval.type = parse_access_type(fields[3]);
+  retval.hit = (fields[4] == "HIT");
+  return retval;
+}
+} // namespace
+
+std::vector<champsim::replay::record> champsim::replay::read_records(std::istream& stream)
+{
+  std::vector<record> retval{};
+  std::string line;
+  while (std::getline(stream, line)) {
+    if (std::empty(line) || line.rfind("Cycle", 0) == 0)
+      continue; // skip the header
+    retval.push_back(parse_record(line));
+  }
+  return retval;
+}
+
+std::vector<champsim::replay::record> champsim::replay::read_records(const std::string& fname)
+{
+  if (fname.size() > 3 && fname.substr(std::size(fname) - 3) == ".gz") {
+    champsim::inf_istream<champsim::decomp_tags::gzip_tag_t<>> compressed{fname};
+    std::istream stream{compressed.buffer.get()};
+    return read_records(stream);
+  }
+
+  std::ifstream stream{fname};
+  if (!stream.good())
+    throw std::invalid_argument{"Could not open replay file " + fname};
+  return read_records(stream);
+}
+
+double champsim::replay::result::demand_miss_rate() const
+{
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  for (auto type : {access_type::LOAD, access_type::RFO, access_type::WRITE, access_type::TRANSLATION}) {
+    hits += stats.hits.value_or(std::pair<access_type, std::size_t>{type, 0}, 0);
+    misses += stats.misses.value_or(std::pair<access_type, std::size_t>{type, 0}, 0);
+  }
+  return (hits + misses) > 0 ? static_cast<double>(misses) / static_cast<double>(hits + misses) : 0;
+}
+
+double champsim::replay::result::accesses_per_second() const { return seconds > 0 ? static_cast<double>(accesses) / seconds : 0; }
+
+double champsim::replay::result::prefetches_per_second() const { return seconds > 0 ? static_cast<double>(stats.pf_issued) / seconds : 0; }
+
+long champsim::replay::fixed_latency_memory::operate()
+{
+  ++cycle;
+  long progress = 0;
+  for (auto* queue : {&queues.RQ, &queues.PQ, &queues.WQ}) {
+    for (const auto& pkt : *queue) {
+      if (pkt.response_requested) {
+        champsim::channel::response_type response{pkt};
+        response.data = pkt.address; // identity translation
+        inflight.push_back({response, cycle + latency});
+      }
+      ++progress;
+    }
+    queue->clear();
+  }
+
+  auto end = std::find_if(std::begin(inflight), std::end(inflight), [this](const auto& x) { return x.ready_cycle > cycle; });
+  std::transform(std::begin(inflight), end, std::back_inserter(queues.returned), [](const auto& x) { return x.response; });
+  progress += std::distance(std::begin(inflight), end);
+  inflight.erase(std::begin(inflight), end);
+
+  return progress;
+}
+
+champsim::replay::result champsim::replay::replay(CACHE& uut, champsim::channel& upper, fixed_latency_memory& lower, fixed_latency_memory& translate,
+                                                  const std::vector<record>& records, const options& opts)
+{
+  std::array<champsim::operable*, 3> elements{{&lower, &translate, &uut}};
+  for (auto* elem : elements) {
+    elem->initialize();
+    elem->warmup = false;
+    elem->begin_phase();
+  }
+
+  result retval{};
+  const long base_cycle = std::empty(records) ? 0 : records.front().cycle;
+  auto next = std::begin(records);
+
+  auto start = std::chrono::steady_clock::now();
+  long cycle = 0;
+  for (long drain_cycles = 0; next != std::end(records) || !std::empty(upper.RQ) || !std::empty(upper.WQ) || drain_cycles < 2 * opts.memory_latency;
+       ++cycle) {
+    if (next == std::end(records))
+      ++drain_cycles;
+
+    for (bool accepted = true; accepted && next != std::end(records) && (!opts.preserve_timing || next->cycle - base_cycle <= cycle);) {
+      if (next->type == access_type::PREFETCH) {
+        ++retval.skipped;
+        ++next;
+        continue;
+      }
+
+      champsim::channel::request_type pkt{};
+      pkt.address = next->address;
+      pkt.v_address = next->address;
+      pkt.ip = next->ip;
+      pkt.type = next->type;
+      pkt.cpu = 0;
+      pkt.instr_id = retval.accesses;
+      pkt.response_requested = (next->type != access_type::WRITE);
+
+      accepted = (next->type == access_type::WRITE) ? upper.add_wq(pkt) : upper.add_rq(pkt);
+      if (accepted) {
+        ++retval.accesses;
+        ++next;
+      }
+    }
+
+    for (auto* elem : elements)
+      elem->_operate();
+    upper.returned.clear();
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  retval.cycles = cycle;
+  retval.seconds = std::chrono::duration<double>(end - start).count();
+  retval.stats = uut.sim_stats;
+  return retval;
+}
+
+std::map<std::string, champsim::replay::replay_function>& champsim::replay::registry()
+{
+  static std::map<std::string, replay_function> prefetchers{};
+  return prefetchers;
+}
@@ -0,0 +1,130 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PREFETCHER_REPLAY_H
+#define PREFETCHER_REPLAY_H
+
+#include <cstdint>
+#include <deque>
+#include <istream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "access_type.h"
+#include "address.h"
+#include "cache.h"
+#include "channel.h"
+#include "defaults.hpp"
+#include "operable.h"
+
+namespace champsim::replay
+{
+/**
+ * One tag lookup from the access stream that a cache writes when CHAMPSIM_TRACE selects it.
+ */
+struct record {
+  long cycle = 0;
+  champsim::address ip{};
+  champsim::address address{};
+  access_type type = access_type::LOAD;
+  bool hit = false;
+};
+
+/**
+ * Read a recorded access stream, in the CSV format written by CACHE (Cycle,IP,Address,Type,Result).
+ * Files ending in .gz are decompressed.
+ */
+std::vector<record> read_records(std::istream& stream);
+std::vector<record> read_records(const std::string& fname);
+
+enum class cache_level { L1D, L2C };
+
+struct options {
+  cache_level level = cache_level::L2C;
+  long memory_latency = 100; // cycles for the level below to return a block
+  std::size_t queue_size = 32;
+
+  // When set, each access is issued no earlier than its recorded cycle. Otherwise, accesses are issued as soon as the queues accept them.
+  bool preserve_timing = true;
+};
+
+struct result {
+  uint64_t accesses = 0;
+  uint64_t skipped = 0; // recorded prefetches, which are regenerated by the prefetcher under test instead
+  long cycles = 0;
+  double seconds = 0;
+  cache_stats stats{};
+
+  [[nodiscard]] double demand_miss_rate() const;
+  [[nodiscard]] double accesses_per_second() const;
+  [[nodiscard]] double prefetches_per_second() const;
+};
+
+/**
+ * The level below the replayed cache, which returns every request after a fixed latency.
+ * Translation requests are answered with the identity mapping.
+ */
+class fixed_latency_memory : public champsim::operable
+{
+  struct pending {
+    champsim::channel::response_type response;
+    long ready_cycle;
+  };
+
+  std::deque<pending> inflight{};
+  long latency;
+  long cycle = 0;
+
+public:
+  champsim::channel queues{};
+
+  explicit fixed_latency_memory(long lat) : latency(lat) {}
+  long operate() override;
+};
+
+/**
+ * Replay the records into a cache that was built with the given channels. The cache's statistics are returned.
+ */
+result replay(CACHE& uut, champsim::channel& upper, fixed_latency_memory& lower, fixed_latency_memory& translate, const std::vector<record>& records,
+              const options& opts);
+
+template <typename P>
+result replay_with(const std::vector<record>& records, const options& opts)
+{
+  champsim::channel upper{opts.queue_size, opts.queue_size, opts.queue_size, champsim::data::bits{LOG2_BLOCK_SIZE}, false};
+  fixed_latency_memory lower{opts.memory_latency};
+  fixed_latency_memory translate{1};
+
+  auto builder = (opts.level == cache_level::L1D) ? champsim::defaults::default_l1d : champsim::defaults::default_l2c;
+  CACHE uut{builder.name("replay").upper_levels({&upper}).lower_level(&lower.queues).lower_translate(&translate.queues).template prefetcher<P>()};
+  return replay(uut, upper, lower, translate, records, opts);
+}
+
+using replay_function = result (*)(const std::vector<record>&, const options&);
+
+/**
+ * The prefetchers that can be replayed, by module name
+ */
+std::map<std::string, replay_function>& registry();
+
+template <typename P>
+struct registration {
+  explicit registration(const std::string& name) { registry().emplace(name, &replay_with<P>); }
+};
+} // namespace champsim::replay
+
+#endif
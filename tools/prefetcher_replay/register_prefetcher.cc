@@ -0,0 +1,16 @@
+/*
+ * Registers one prefetcher module with the replay tool. This file is compiled once per module, with
+ * REPLAY_PREFETCHER naming the module and REPLAY_PREFETCHER_HEADER naming its header, because the
+ * modules' headers cannot all be included in one translation unit.
+ */
+
+#include "prefetcher_replay.h"
+#include REPLAY_PREFETCHER_HEADER
+
+#define REPLAY_STRINGIFY_IMPL(x) #x
+#define REPLAY_STRINGIFY(x) REPLAY_STRINGIFY_IMPL(x)
+
+namespace
+{
+champsim::replay::registration<REPLAY_PREFETCHER> registered{REPLAY_STRINGIFY(REPLAY_PREFETCHER)};
+}
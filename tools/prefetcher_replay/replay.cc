@@ -0,0 +1,103 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <exception>
+#include <string>
+#include <vector>
+#include <CLI/CLI.hpp>
+#include <fmt/core.h>
+
+#include "champsim.h"
+#include "prefetcher_replay.h"
+
+// Like the tests, the replay tool has no configured environment
+const std::size_t NUM_CPUS = 1;
+
+const unsigned BLOCK_SIZE = 64;
+const unsigned PAGE_SIZE = 4096;
+
+int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
+{
+  CLI::App app{"Replay a recorded cache access stream through prefetcher modules"};
+
+  champsim::replay::options opts{};
+  std::string level_name = "L2C";
+  bool ignore_timing{false};
+  bool list_prefetchers{false};
+  std::vector<std::string> prefetcher_names;
+  std::string record_name;
+
+  app.add_flag("--list", list_prefetchers, "List the prefetchers that can be replayed");
+  app.add_option("-p,--prefetcher", prefetcher_names, "The prefetchers to replay. If not specified, all prefetchers are replayed");
+  app.add_option("--level", level_name, "The cache to model, with ChampSim's default configuration")->check(CLI::IsMember({"L1D", "L2C"}));
+  app.add_option("--memory-latency", opts.memory_latency, "The latency of the level below the cache, in cycles")->check(CLI::PositiveNumber);
+  app.add_flag("--ignore-timing", ignore_timing, "Issue accesses as fast as the cache accepts them, rather than at their recorded cycles");
+  auto* record_option =
+      app.add_option("records", record_name, "The access stream written under CHAMPSIM_TRACE (.csv or .csv.gz)")->check(CLI::ExistingFile);
+
+  CLI11_PARSE(app, argc, argv);
+
+  const auto& registry = champsim::replay::registry();
+  if (list_prefetchers) {
+    for (const auto& [name, func] : registry)
+      fmt::print("{}\n", name);
+    return 0;
+  }
+
+  if (record_option->count() == 0) {
+    fmt::print(stderr, "An access stream is required\n");
+    return 1;
+  }
+
+  if (std::empty(prefetcher_names)) {
+    for (const auto& [name, func] : registry)
+      prefetcher_names.push_back(name);
+  }
+
+  opts.level = (level_name == "L1D") ? champsim::replay::cache_level::L1D : champsim::replay::cache_level::L2C;
+  opts.preserve_timing = !ignore_timing;
+
+  auto records = champsim::replay::read_records(record_name);
+  auto recorded_prefetches = std::count_if(std::begin(records), std::end(records), [](const auto& x) { return x.type == access_type::PREFETCH; });
+  fmt::print("Replaying {} accesses at the {}. {} recorded prefetches are left to the prefetcher under test.\n\n", std::size(records) - recorded_prefetches,
+             level_name, recorded_prefetches);
+  fmt::print("{:<20} {:>12} {:>12} {:>12} {:>12} {:>12} {:>12} {:>14} {:>14}\n", "prefetcher", "requested", "issued", "useful", "late", "useless",
+             "miss rate", "accesses/s", "prefetches/s");
+
+  for (const auto& name : prefetcher_names) {
+    auto func = registry.find(name);
+    if (func == std::end(registry)) {
+      fmt::print(stderr, "Unknown prefetcher: {}\n", name);
+      return 1;
+    }
+
+    champsim::replay::result result{};
+    try {
+      result = func->second(records, opts);
+    } catch (const std::exception& err) {
+      // Some modules assume the cache they are attached to, and fail elsewhere
+      fmt::print("{:<20} failed: {}\n", name, err.what());
+      continue;
+    }
+
+    fmt::print("{:<20} {:>12} {:>12} {:>12} {:>12} {:>12} {:>12.4f} {:>14.0f} {:>14.0f}\n", name, result.stats.pf_requested, result.stats.pf_issued,
+               result.stats.pf_useful, result.stats.pf_late, result.stats.pf_useless, result.demand_miss_rate(), result.accesses_per_second(),
+               result.prefetches_per_second());
+  }
+
+  return 0;
+}